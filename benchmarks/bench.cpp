@@ -0,0 +1,727 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "binary-io/array-coding.hpp"
+#include "binary-io/binary-io.hpp"
+#include "binary-io/checksum.hpp"
+#include "binary-io/frame-pipeline.hpp"
+#include "command_protocol_protocol.hpp"
+#include "nanobench.h"
+#include "sensor_telemetry_protocol.hpp"
+
+/// Throughput benchmarks for the reader/writer primitives and for the
+/// headers bio-gen produces from generator/protocols/*.yaml. Primitive cases
+/// are reported in bytes/s; protocol round trips are reported both in
+/// bytes/s and msgs/s so regressions show up in either dimension.
+
+namespace {
+
+using ankerl::nanobench::Bench;
+using ankerl::nanobench::doNotOptimizeAway;
+
+constexpr size_t kBufferSize = 64 * 1024;
+constexpr size_t kMessageCount = 1024;
+
+std::vector<uint8_t> make_buffer(size_t size) {
+  std::vector<uint8_t> buf(size);
+  uint32_t x = 0x12345678u;
+  for (auto& b : buf) {
+    x = x * 1664525u + 1013904223u;
+    b = static_cast<uint8_t>(x >> 24);
+  }
+  return buf;
+}
+
+Bench make_bench(const std::string& title, const char* unit, size_t batch) {
+  Bench bench;
+  bench.title(title).unit(unit).batch(batch).warmup(10).relative(false);
+  return bench;
+}
+
+// ---------------------------------------------------------------------------
+// Primitive reads and writes
+// ---------------------------------------------------------------------------
+
+template <typename Reader, typename T>
+void bench_read(Bench& bench, const std::string& name,
+                bio::Status (Reader::*read)(T&)) {
+  const auto buf = make_buffer(kBufferSize);
+  const size_t count = buf.size() / sizeof(T);
+  bench.run(name, [&] {
+    Reader reader(buf.data(), buf.size());
+    T value{};
+    bool ok = true;
+    for (size_t i = 0; i < count; ++i) {
+      ok &= static_cast<bool>((reader.*read)(value));
+      doNotOptimizeAway(value);
+    }
+    doNotOptimizeAway(ok);
+  });
+}
+
+template <typename Writer, typename T>
+void bench_write(Bench& bench, const std::string& name,
+                 bio::Status (Writer::*write)(T)) {
+  std::vector<uint8_t> buf(kBufferSize);
+  const size_t count = buf.size() / sizeof(T);
+  bench.run(name, [&] {
+    Writer writer(buf.data(), buf.size());
+    bool ok = true;
+    for (size_t i = 0; i < count; ++i) {
+      ok &= static_cast<bool>((writer.*write)(static_cast<T>(i)));
+    }
+    doNotOptimizeAway(ok);
+    doNotOptimizeAway(buf.data());
+  });
+}
+
+template <typename Reader, typename T>
+void bench_read_array(Bench& bench, const std::string& name,
+                      bio::Status (Reader::*read)(T*, size_t)) {
+  const auto buf = make_buffer(kBufferSize);
+  std::vector<T> out(buf.size() / sizeof(T));
+  bench.run(name, [&] {
+    Reader reader(buf.data(), buf.size());
+    const bio::Status s = (reader.*read)(out.data(), out.size());
+    doNotOptimizeAway(s.ok);
+    doNotOptimizeAway(out.data());
+  });
+}
+
+template <typename Writer, typename T>
+void bench_write_array(Bench& bench, const std::string& name,
+                       bio::Status (Writer::*write)(const T*, size_t)) {
+  std::vector<uint8_t> buf(kBufferSize);
+  std::vector<T> in(buf.size() / sizeof(T));
+  for (size_t i = 0; i < in.size(); ++i) in[i] = static_cast<T>(i);
+  bench.run(name, [&] {
+    Writer writer(buf.data(), buf.size());
+    const bio::Status s = (writer.*write)(in.data(), in.size());
+    doNotOptimizeAway(s.ok);
+    doNotOptimizeAway(buf.data());
+  });
+}
+
+template <typename Reader>
+void bench_reads(const std::string& prefix) {
+  auto bench = make_bench(prefix + " reads", "byte", kBufferSize);
+  bench_read(bench, prefix + "::read_u8", &Reader::read_u8);
+  bench_read(bench, prefix + "::read_u16", &Reader::read_u16);
+  bench_read(bench, prefix + "::read_u32", &Reader::read_u32);
+  bench_read(bench, prefix + "::read_u64", &Reader::read_u64);
+  bench_read(bench, prefix + "::read_i8", &Reader::read_i8);
+  bench_read(bench, prefix + "::read_i16", &Reader::read_i16);
+  bench_read(bench, prefix + "::read_i32", &Reader::read_i32);
+  bench_read(bench, prefix + "::read_i64", &Reader::read_i64);
+  bench_read(bench, prefix + "::read_f32", &Reader::read_f32);
+  bench_read(bench, prefix + "::read_f64", &Reader::read_f64);
+  bench_read_array(bench, prefix + "::read_u16_array", &Reader::read_u16_array);
+  bench_read_array(bench, prefix + "::read_u32_array", &Reader::read_u32_array);
+  bench_read_array(bench, prefix + "::read_f32_array", &Reader::read_f32_array);
+  bench_read_array(bench, prefix + "::read_f64_array", &Reader::read_f64_array);
+}
+
+template <typename Writer>
+void bench_writes(const std::string& prefix) {
+  auto bench = make_bench(prefix + " writes", "byte", kBufferSize);
+  bench_write(bench, prefix + "::write_u8", &Writer::write_u8);
+  bench_write(bench, prefix + "::write_u16", &Writer::write_u16);
+  bench_write(bench, prefix + "::write_u32", &Writer::write_u32);
+  bench_write(bench, prefix + "::write_u64", &Writer::write_u64);
+  bench_write(bench, prefix + "::write_i8", &Writer::write_i8);
+  bench_write(bench, prefix + "::write_i16", &Writer::write_i16);
+  bench_write(bench, prefix + "::write_i32", &Writer::write_i32);
+  bench_write(bench, prefix + "::write_i64", &Writer::write_i64);
+  bench_write(bench, prefix + "::write_f32", &Writer::write_f32);
+  bench_write(bench, prefix + "::write_f64", &Writer::write_f64);
+  bench_write_array(bench, prefix + "::write_u16_array",
+                    &Writer::write_u16_array);
+  bench_write_array(bench, prefix + "::write_u32_array",
+                    &Writer::write_u32_array);
+  bench_write_array(bench, prefix + "::write_f32_array",
+                    &Writer::write_f32_array);
+  bench_write_array(bench, prefix + "::write_f64_array",
+                    &Writer::write_f64_array);
+}
+
+// ---------------------------------------------------------------------------
+// Codecs against shift-based reference code
+// ---------------------------------------------------------------------------
+
+/// The portable baseline the codecs replace: assemble a value a byte at a
+/// time with shifts.
+template <typename T, bool kLittle>
+T shift_load(const uint8_t* p) {
+  T v = 0;
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    const size_t byte = kLittle ? i : sizeof(T) - 1 - i;
+    v |= static_cast<T>(static_cast<T>(p[byte]) << (8 * i));
+  }
+  return v;
+}
+
+template <typename T, bool kLittle>
+void shift_store(uint8_t* p, T v) {
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    const size_t byte = kLittle ? i : sizeof(T) - 1 - i;
+    p[byte] = static_cast<uint8_t>(v >> (8 * i));
+  }
+}
+
+template <typename Codec, typename T>
+T codec_load(const uint8_t* p) {
+  if constexpr (sizeof(T) == 2) {
+    return Codec::LoadU16(p);
+  } else if constexpr (sizeof(T) == 4) {
+    return Codec::LoadU32(p);
+  } else {
+    return Codec::LoadU64(p);
+  }
+}
+
+template <typename Codec, typename T>
+void codec_store(uint8_t* p, T v) {
+  if constexpr (sizeof(T) == 2) {
+    Codec::StoreU16(p, v);
+  } else if constexpr (sizeof(T) == 4) {
+    Codec::StoreU32(p, v);
+  } else {
+    Codec::StoreU64(p, v);
+  }
+}
+
+/// Load every T of @p buf, folding the values so the loop is not dropped.
+template <typename T, typename Load>
+void bench_load_loop(Bench& bench, const std::string& name,
+                     const std::vector<uint8_t>& buf, Load load) {
+  bench.run(name, [&] {
+    T acc = 0;
+    for (size_t i = 0; i + sizeof(T) <= buf.size(); i += sizeof(T)) {
+      acc ^= load(buf.data() + i);
+    }
+    doNotOptimizeAway(acc);
+  });
+}
+
+/// Store a T at every slot of @p buf.
+template <typename T, typename Store>
+void bench_store_loop(Bench& bench, const std::string& name,
+                      std::vector<uint8_t>& buf, Store store) {
+  bench.run(name, [&] {
+    for (size_t i = 0; i + sizeof(T) <= buf.size(); i += sizeof(T)) {
+      store(buf.data() + i, static_cast<T>(i * 0x9E3779B97F4A7C15u));
+    }
+    doNotOptimizeAway(buf.data());
+  });
+}
+
+/// Shift loops and @p Codec on the same buffers, for one width and order.
+template <typename Codec, typename T, bool kLittle>
+void bench_codec_width(Bench& bench, const std::string& codec,
+                       const std::vector<uint8_t>& src,
+                       std::vector<uint8_t>& dst) {
+  const std::string bits = std::to_string(8 * sizeof(T));
+  const std::string order = kLittle ? "le" : "be";
+  bench_load_loop<T>(bench, "shift load u" + bits + " " + order, src,
+                     shift_load<T, kLittle>);
+  bench_load_loop<T>(bench, codec + "::LoadU" + bits, src,
+                     codec_load<Codec, T>);
+  bench_store_loop<T>(bench, "shift store u" + bits + " " + order, dst,
+                      shift_store<T, kLittle>);
+  bench_store_loop<T>(bench, codec + "::StoreU" + bits, dst,
+                      codec_store<Codec, T>);
+}
+
+template <typename Codec, bool kLittle>
+void bench_codec(const std::string& codec) {
+  auto bench = make_bench(codec + " vs shifts", "byte", kBufferSize);
+  const auto src = make_buffer(kBufferSize);
+  std::vector<uint8_t> dst(kBufferSize);
+  // Both paths must agree before their timings mean anything.
+  for (size_t i = 0; i + 8 <= src.size(); i += 8) {
+    if (codec_load<Codec, uint64_t>(src.data() + i) !=
+        shift_load<uint64_t, kLittle>(src.data() + i)) {
+      std::fprintf(stderr, "%s disagrees with the shift loads\n",
+                   codec.c_str());
+      return;
+    }
+  }
+  bench_codec_width<Codec, uint16_t, kLittle>(bench, codec, src, dst);
+  bench_codec_width<Codec, uint32_t, kLittle>(bench, codec, src, dst);
+  bench_codec_width<Codec, uint64_t, kLittle>(bench, codec, src, dst);
+}
+
+void bench_bytes() {
+  auto bench = make_bench("read_bytes / skip", "byte", kBufferSize);
+  const auto buf = make_buffer(kBufferSize);
+  for (size_t chunk : {16, 256, 4096}) {
+    std::vector<uint8_t> out(chunk);
+    bench.run("read_bytes(" + std::to_string(chunk) + ")", [&] {
+      bio::LEReader reader(buf.data(), buf.size());
+      while (reader.read_bytes(out.data(), out.size())) {
+        doNotOptimizeAway(out.data());
+      }
+    });
+  }
+  for (size_t chunk : {1, 16}) {
+    bench.run("skip(" + std::to_string(chunk) + ")", [&] {
+      bio::LEReader reader(buf.data(), buf.size());
+      while (reader.skip(chunk)) {
+      }
+      doNotOptimizeAway(reader.position());
+    });
+  }
+}
+
+void bench_checksums() {
+  auto bench = make_bench("checksums", "byte", kBufferSize);
+  const auto buf = make_buffer(kBufferSize);
+  bench.run("crc32", [&] {
+    doNotOptimizeAway(bio::crc32(buf.data(), buf.size()));
+  });
+  bench.run("crc32c", [&] {
+    doNotOptimizeAway(bio::crc32c(buf.data(), buf.size()));
+  });
+  bench.run("LECrc32Reader::read_u32", [&] {
+    bio::LECrc32Reader reader(buf.data(), buf.size());
+    uint32_t value = 0;
+    while (reader.read_u32(value)) {
+      doNotOptimizeAway(value);
+    }
+    doNotOptimizeAway(reader.checksum());
+  });
+}
+
+/// Encode kMessageCount varints whose magnitudes are below 2^max_bits.
+std::vector<uint8_t> make_varints(unsigned max_bits) {
+  std::vector<uint8_t> buf(kMessageCount * 10);
+  bio::LEWriter writer(buf.data(), buf.size());
+  uint64_t x = 0x9E3779B97F4A7C15u;
+  for (size_t i = 0; i < kMessageCount; ++i) {
+    x = x * 6364136223846793005u + 1442695040888963407u;
+    static_cast<void>(writer.write_varuint((x >> 1) >> (63 - max_bits)));
+  }
+  buf.resize(writer.position());
+  return buf;
+}
+
+void bench_varints() {
+  auto bench = make_bench("varints", "value", kMessageCount);
+  for (unsigned bits : {7, 14, 28, 63}) {
+    const auto buf = make_varints(bits);
+    bench.run("read_varuint(<2^" + std::to_string(bits) + ")", [&] {
+      bio::LEReader reader(buf.data(), buf.size());
+      uint64_t value = 0;
+      while (reader.read_varuint(value)) {
+        doNotOptimizeAway(value);
+      }
+    });
+  }
+  std::vector<uint8_t> out(kMessageCount * 10);
+  bench.run("write_varint", [&] {
+    bio::LEWriter writer(out.data(), out.size());
+    for (size_t i = 0; i < kMessageCount; ++i) {
+      const auto v = static_cast<int64_t>(i * 40503u) - 20000000;
+      static_cast<void>(writer.write_varint(v));
+    }
+    doNotOptimizeAway(writer.position());
+  });
+}
+
+/// A timestamp series: a steady 10 ms tick with a few ms of jitter.
+std::vector<uint32_t> make_timestamps() {
+  std::vector<uint32_t> v(kMessageCount);
+  uint32_t x = 0x12345678u;
+  uint32_t t = 1700000000u;
+  for (auto& e : v) {
+    x = x * 1664525u + 1013904223u;
+    t += 10 + (x >> 30);
+    e = t;
+  }
+  return v;
+}
+
+void bench_array_coding() {
+  auto bench = make_bench("array coding", "value", kMessageCount);
+  const auto stamps = make_timestamps();
+  std::vector<uint8_t> buf(stamps.size() * sizeof(uint32_t) + 16);
+  std::vector<uint32_t> out(stamps.size());
+  bench.run("write_delta_array(u32)", [&] {
+    bio::LEWriter writer(buf.data(), buf.size());
+    static_cast<void>(
+        bio::write_delta_array(writer, stamps.data(), stamps.size()));
+    doNotOptimizeAway(writer.position());
+  });
+  bench.run("read_delta_array(u32)", [&] {
+    bio::LEReader reader(buf.data(), buf.size());
+    static_cast<void>(bio::read_delta_array(reader, out.data(), out.size()));
+    doNotOptimizeAway(out.back());
+  });
+  bench.run("write_for_array(u32)", [&] {
+    bio::LEWriter writer(buf.data(), buf.size());
+    static_cast<void>(
+        bio::write_for_array(writer, stamps.data(), stamps.size()));
+    doNotOptimizeAway(writer.position());
+  });
+  bench.run("read_for_array(u32)", [&] {
+    bio::LEReader reader(buf.data(), buf.size());
+    static_cast<void>(bio::read_for_array(reader, out.data(), out.size()));
+    doNotOptimizeAway(out.back());
+  });
+}
+
+// ---------------------------------------------------------------------------
+// Generated protocol round trips
+// ---------------------------------------------------------------------------
+
+/// Serialize @p message back to back into a buffer large enough for
+/// kMessageCount copies; returns the encoded stream.
+template <typename Writer, typename Message>
+std::vector<uint8_t> encode_stream(const Message& message) {
+  std::vector<uint8_t> buf(Message::kWireSize * kMessageCount);
+  Writer writer(buf.data(), buf.size());
+  for (size_t i = 0; i < kMessageCount; ++i) {
+    if (!message.serialize(writer)) {
+      std::fprintf(stderr, "benchmark setup: serialize failed\n");
+    }
+  }
+  return buf;
+}
+
+template <typename Reader, typename Writer, typename Message>
+void bench_protocol(const std::string& name, const Message& message) {
+  const auto stream = encode_stream<Writer>(message);
+  std::vector<uint8_t> out(stream.size());
+
+  const auto parse_all = [&] {
+    Reader reader(stream.data(), stream.size());
+    Message decoded;
+    bool ok = true;
+    for (size_t i = 0; i < kMessageCount; ++i) {
+      ok &= static_cast<bool>(decoded.parse(reader));
+      doNotOptimizeAway(decoded);
+    }
+    doNotOptimizeAway(ok);
+  };
+  const auto serialize_all = [&] {
+    Writer writer(out.data(), out.size());
+    bool ok = true;
+    for (size_t i = 0; i < kMessageCount; ++i) {
+      ok &= static_cast<bool>(message.serialize(writer));
+    }
+    doNotOptimizeAway(ok);
+    doNotOptimizeAway(out.data());
+  };
+
+  auto bytes = make_bench("protocols", "byte", stream.size());
+  bytes.run(name + " parse", parse_all);
+  bytes.run(name + " serialize", serialize_all);
+
+  auto msgs = make_bench("protocols", "msg", kMessageCount);
+  msgs.run(name + " parse", parse_all);
+  msgs.run(name + " serialize", serialize_all);
+}
+
+sensor::SensorFrame make_sensor_frame() {
+  sensor::SensorFrame frame;
+  frame.header.magic = 0xFEEDFACE;
+  frame.header.version = 1;
+  frame.header.msg_type = sensor::MessageType::Accelerometer;
+  frame.header.sample_rate = 5;
+  frame.header.filter_enable = true;
+  frame.header.channel = 3;
+  frame.header.sequence = 42;
+  frame.header.payload_length = static_cast<uint16_t>(frame.data.size());
+  for (size_t i = 0; i < frame.data.size(); ++i) {
+    frame.data[i] = static_cast<uint8_t>(i);
+  }
+  return frame;
+}
+
+/// Routing on two header fields: a view decodes just those, parse() decodes
+/// the whole frame.
+void bench_view_routing(const sensor::SensorFrame& frame) {
+  const auto stream = encode_stream<sensor::LEWriter>(frame);
+  constexpr size_t kSize = sensor::SensorFrame::kWireSize;
+  auto bench = make_bench("protocols", "msg", kMessageCount);
+  bench.run("sensor::SensorFrame route via parse", [&] {
+    sensor::LEReader reader(stream.data(), stream.size());
+    sensor::SensorFrame decoded;
+    size_t routed = 0;
+    for (size_t i = 0; i < kMessageCount; ++i) {
+      static_cast<void>(decoded.parse(reader));
+      routed += decoded.header.msg_type == sensor::MessageType::Log
+                    ? 0
+                    : decoded.header.payload_length;
+    }
+    doNotOptimizeAway(routed);
+  });
+  bench.run("sensor::SensorFrame route via view", [&] {
+    size_t routed = 0;
+    for (size_t i = 0; i < kMessageCount; ++i) {
+      const sensor::SensorFrameView view(stream.data() + i * kSize);
+      const auto header = view.header();
+      routed += header.msg_type() == sensor::MessageType::Log
+                    ? 0
+                    : header.payload_length();
+    }
+    doNotOptimizeAway(routed);
+  });
+}
+
+/// Ingesting temperature readings, then counting those above a threshold:
+/// stored as parsed structs, and in the generated column-wise batch.
+void bench_batch() {
+  sensor::TemperaturePayload reading;
+  reading.sensor_id = 3;
+  std::vector<uint8_t> stream(sensor::TemperaturePayload::kWireSize *
+                              kMessageCount);
+  sensor::LEWriter writer(stream.data(), stream.size());
+  for (size_t i = 0; i < kMessageCount; ++i) {
+    reading.temperature = static_cast<float>(i % 40);
+    static_cast<void>(reading.serialize(writer));
+  }
+  std::vector<sensor::TemperaturePayload> rows(kMessageCount);
+  auto columns =
+      std::make_unique<sensor::TemperaturePayloadBatch<kMessageCount>>();
+  auto bench = make_bench("protocols", "msg", kMessageCount);
+  bench.run("sensor::TemperaturePayload ingest+scan via parse", [&] {
+    sensor::LEReader reader(stream.data(), stream.size());
+    for (auto& row : rows) static_cast<void>(row.parse(reader));
+    size_t hot = 0;
+    for (const auto& row : rows) hot += row.temperature > 30.0f;
+    doNotOptimizeAway(hot);
+  });
+  bench.run("sensor::TemperaturePayload ingest+scan via parse_batch", [&] {
+    sensor::LEReader reader(stream.data(), stream.size());
+    columns->clear();
+    static_cast<void>(columns->parse_batch(reader, kMessageCount));
+    size_t hot = 0;
+    for (size_t i = 0; i < columns->size; ++i) {
+      hot += columns->temperature[i] > 30.0f;
+    }
+    doNotOptimizeAway(hot);
+  });
+  bench.run("sensor::TemperaturePayload scan rows", [&] {
+    size_t hot = 0;
+    for (const auto& row : rows) hot += row.temperature > 30.0f;
+    doNotOptimizeAway(hot);
+  });
+  bench.run("sensor::TemperaturePayload scan column", [&] {
+    size_t hot = 0;
+    for (size_t i = 0; i < columns->size; ++i) {
+      hot += columns->temperature[i] > 30.0f;
+    }
+    doNotOptimizeAway(hot);
+  });
+}
+
+/// A capture of header + payload records split by bio::split_frames() and
+/// decoded by bio::decode_frames() on one thread and on every core.
+void bench_pipeline() {
+  struct Record {
+    sensor::FrameHeader header;
+    sensor::AccelerometerPayload sample;
+  };
+  constexpr size_t kFrames = 64 * 1024;
+  constexpr size_t kFrameSize = sensor::FrameHeader::kWireSize +
+                                sensor::AccelerometerPayload::kWireSize;
+  std::vector<uint8_t> capture(kFrames * kFrameSize);
+  sensor::LEWriter writer(capture.data(), capture.size());
+  for (size_t i = 0; i < kFrames; ++i) {
+    Record record;
+    record.header.magic = 0xFEEDFACE;
+    record.header.msg_type = sensor::MessageType::Accelerometer;
+    record.header.sequence = static_cast<uint16_t>(i);
+    record.header.payload_length = sensor::AccelerometerPayload::kWireSize;
+    record.sample.x = static_cast<float>(i);
+    static_cast<void>(record.header.serialize(writer));
+    static_cast<void>(record.sample.serialize(writer));
+  }
+  const bio::ByteView data(capture.data(), capture.size());
+  constexpr bio::FrameFormat kFormat{0xFEEDFACE, 0,
+                                     sensor::FrameHeader::kWireSize, 11, 2};
+  const auto split = bio::split_frames<bio::LittleEndianCodec>(data, kFormat);
+  const auto decode = [](sensor::LEReader& reader, Record& out) {
+    const sensor::Status s = out.header.parse(reader);
+    if (!s) return s;
+    return out.sample.parse(reader);
+  };
+
+  auto bench = make_bench("pipeline", "msg", kFrames);
+  bio::FrameSplit scratch;
+  std::vector<Record> records;
+  std::vector<size_t> thread_counts{1};
+  if (std::thread::hardware_concurrency() > 1) {
+    thread_counts.push_back(std::thread::hardware_concurrency());
+  }
+  for (size_t threads : thread_counts) {
+    const std::string suffix = " x" + std::to_string(threads);
+    bench.run("split_frames" + suffix, [&] {
+      bio::split_frames<bio::LittleEndianCodec>(data, kFormat, scratch,
+                                                threads);
+      doNotOptimizeAway(scratch.frames.size());
+    });
+    bench.run("decode_frames" + suffix, [&] {
+      doNotOptimizeAway(bio::decode_frames<sensor::LEReader>(
+          data, split.frames, records, decode, threads));
+    });
+  }
+}
+
+cmd::StatusResponse make_status_response() {
+  cmd::StatusResponse response;
+  response.error = cmd::ErrorCode::None;
+  response.motor_count = 4;
+  response.rpms = {1200, -800, 0, 3000};
+  response.voltage = 24.5f;
+  response.current = 3.25f;
+  return response;
+}
+
+cmd::SetConfigPayload make_set_config() {
+  cmd::SetConfigPayload config;
+  config.entry_count = static_cast<uint8_t>(config.entries.size());
+  for (size_t i = 0; i < config.entries.size(); ++i) {
+    config.entries[i].key = static_cast<uint16_t>(i);
+    config.entries[i].value = static_cast<uint32_t>(i * 1000);
+  }
+  return config;
+}
+
+/// A mixed command stream demultiplexed by the generated CommandDispatch and
+/// by the equivalent hand-written switch on the parsed header.
+void bench_dispatch() {
+  const cmd::CommandId ids[] = {cmd::CommandId::Ping, cmd::CommandId::SetSpeed,
+                                cmd::CommandId::GetStatus,
+                                cmd::CommandId::SetConfig};
+  const auto status = make_status_response();
+  const auto config = make_set_config();
+  cmd::SetSpeedPayload speed;
+  speed.motor_id = 1;
+  speed.target_rpm = 1500;
+
+  std::vector<uint8_t> buf(
+      (cmd::CommandHeader::kWireSize + cmd::SetConfigPayload::kWireSize) *
+      kMessageCount);
+  cmd::BEWriter writer(buf.data(), buf.size());
+  bool ok = true;
+  for (size_t i = 0; i < kMessageCount; ++i) {
+    cmd::CommandHeader header;
+    header.sync = 0xAA55;
+    header.command = ids[i % 4];
+    switch (header.command) {
+      case cmd::CommandId::SetSpeed:
+        header.payload_size = cmd::SetSpeedPayload::kWireSize;
+        ok &= static_cast<bool>(header.serialize(writer));
+        ok &= static_cast<bool>(speed.serialize(writer));
+        break;
+      case cmd::CommandId::GetStatus:
+        header.payload_size = cmd::StatusResponse::kWireSize;
+        ok &= static_cast<bool>(header.serialize(writer));
+        ok &= static_cast<bool>(status.serialize(writer));
+        break;
+      case cmd::CommandId::SetConfig:
+        header.payload_size = cmd::SetConfigPayload::kWireSize;
+        ok &= static_cast<bool>(header.serialize(writer));
+        ok &= static_cast<bool>(config.serialize(writer));
+        break;
+      default:
+        header.payload_size = 0;
+        ok &= static_cast<bool>(header.serialize(writer));
+        break;
+    }
+  }
+  if (!ok) {
+    std::fprintf(stderr, "benchmark setup: serialize failed\n");
+  }
+  const size_t size = writer.position();
+
+  auto bench = make_bench("protocols", "msg", kMessageCount);
+  bench.run("cmd::CommandDispatch visit", [&] {
+    cmd::BEReader reader(buf.data(), size);
+    bool all = true;
+    for (size_t i = 0; i < kMessageCount; ++i) {
+      all &= static_cast<bool>(cmd::CommandDispatch::visit(
+          reader, [](const cmd::CommandHeader& header, const auto& payload) {
+            doNotOptimizeAway(header);
+            doNotOptimizeAway(payload);
+          }));
+    }
+    doNotOptimizeAway(all);
+  });
+  bench.run("cmd::CommandDispatch parse", [&] {
+    cmd::BEReader reader(buf.data(), size);
+    cmd::CommandHeader header;
+    cmd::CommandDispatch::Payload payload;
+    bool all = true;
+    for (size_t i = 0; i < kMessageCount; ++i) {
+      all &= static_cast<bool>(
+          cmd::CommandDispatch::parse(reader, header, payload));
+      doNotOptimizeAway(payload);
+    }
+    doNotOptimizeAway(all);
+  });
+  bench.run("cmd::CommandHeader hand-written switch", [&] {
+    cmd::BEReader reader(buf.data(), size);
+    cmd::CommandHeader header;
+    cmd::SetSpeedPayload set_speed;
+    cmd::StatusResponse get_status;
+    cmd::SetConfigPayload set_config;
+    bool all = true;
+    for (size_t i = 0; i < kMessageCount; ++i) {
+      all &= static_cast<bool>(header.parse(reader));
+      doNotOptimizeAway(header);
+      switch (header.command) {
+        case cmd::CommandId::SetSpeed:
+          all &= static_cast<bool>(set_speed.parse(reader));
+          doNotOptimizeAway(set_speed);
+          break;
+        case cmd::CommandId::GetStatus:
+          all &= static_cast<bool>(get_status.parse(reader));
+          doNotOptimizeAway(get_status);
+          break;
+        case cmd::CommandId::SetConfig:
+          all &= static_cast<bool>(set_config.parse(reader));
+          doNotOptimizeAway(set_config);
+          break;
+        default:
+          all &= static_cast<bool>(reader.skip(header.payload_size));
+          break;
+      }
+    }
+    doNotOptimizeAway(all);
+  });
+}
+
+}  // namespace
+
+int main() {
+  bench_reads<bio::LEReader>("LEReader");
+  bench_reads<bio::BEReader>("BEReader");
+  bench_writes<bio::LEWriter>("LEWriter");
+  bench_writes<bio::BEWriter>("BEWriter");
+  bench_codec<bio::LittleEndianCodec, true>("LittleEndianCodec");
+  bench_codec<bio::BigEndianCodec, false>("BigEndianCodec");
+  bench_bytes();
+  bench_checksums();
+  bench_varints();
+  bench_array_coding();
+
+  bench_protocol<sensor::LEReader, sensor::LEWriter>("sensor::SensorFrame",
+                                                     make_sensor_frame());
+  bench_view_routing(make_sensor_frame());
+  bench_batch();
+  bench_protocol<cmd::BEReader, cmd::BEWriter>("cmd::StatusResponse",
+                                               make_status_response());
+  bench_protocol<cmd::BEReader, cmd::BEWriter>("cmd::SetConfigPayload",
+                                               make_set_config());
+  bench_dispatch();
+  bench_pipeline();
+  return 0;
+}
@@ -8,13 +8,25 @@
 #include <iostream>
 #include <optional>
 #include <string>
-#include <vector>
 
 #include "binary-io/binary-io.hpp"
+#include "binary-io/mapped-file.hpp"
+#include "binary-io/stream-reader.hpp"
+#include "zip_index.hpp"
+#include "zip_validate.hpp"
 
 /// This example is intentionally minimal and does not implement a full ZIP file
-/// parser. It only reads the local file headers and does not support data
-/// descriptors, central directory records, or other ZIP features.
+/// parser; it lists entries and extracts stored (uncompressed) files.
+///
+/// The archive is memory-mapped and indexed through its central directory
+/// (see zip_index.hpp), so any entry is reached without scanning the archive.
+/// Where mapping fails the local file headers are walked front to back
+/// through a fixed 4 KiB streaming window instead; that path does not
+/// support data descriptors. Either way memory use does not depend on the
+/// archive size.
+///
+/// Indexed entries are independent, so their CRCs are checked in parallel
+/// (see zip_validate.hpp).
 
 static constexpr uint32_t kZipMagicNumber = 0x04034b50;
 
@@ -40,91 +52,146 @@ struct ZipHeader {
   }
 };
 
-std::vector<uint8_t> load_zip_file() {
-  const auto path{std::filesystem::path{SOURCE_DIR} / "sample-1.zip"};
-  auto file = std::ifstream{path, std::ios::binary};
-  auto buffer = std::vector<uint8_t>{};
-  if (file) {
-    buffer = {std::istreambuf_iterator<char>{file},
-              std::istreambuf_iterator<char>{}};
-  }
-  std::cout << "Read " << buffer.size() << " bytes from " << path << "\n";
-  return buffer;
-}
-
-bool read_date_time(bio::LEReader& reader, std::string& timestamp) {
+template <typename Reader>
+bio::Status read_date_time(Reader& reader, std::string& timestamp) {
   uint16_t time = 0;
   uint16_t date = 0;
-  bool ok = true;
-  ok = ok && reader.read_u16(time);
-  ok = ok && reader.read_u16(date);
-
-  if (ok) {
-    // MS-DOS date/time format
-    const auto hours = (time >> 11) & 0x1F;
-    const auto minutes = (time >> 5) & 0x3F;
-    const auto seconds = (time & 0x1F) * 2;
-    const auto year = ((date >> 9) & 0x7F) + 1980;
-    const auto month = (date >> 5) & 0x0F;
-    const auto day = date & 0x1F;
-    char buf[20];
-    std::snprintf(buf, sizeof(buf), "%d-%02d-%02d %02d:%02d:%02d", year, month,
-                  day, hours, minutes, seconds);
-    timestamp = buf;
-  }
-  return ok;
+  bio::Status s = reader.read_u16(time);
+  if (!s) return s;
+  s = reader.read_u16(date);
+  if (!s) return s;
+
+  // MS-DOS date/time format
+  const auto hours = (time >> 11) & 0x1F;
+  const auto minutes = (time >> 5) & 0x3F;
+  const auto seconds = (time & 0x1F) * 2;
+  const auto year = ((date >> 9) & 0x7F) + 1980;
+  const auto month = (date >> 5) & 0x0F;
+  const auto day = date & 0x1F;
+  char buf[20];
+  std::snprintf(buf, sizeof(buf), "%d-%02d-%02d %02d:%02d:%02d", year, month,
+                day, hours, minutes, seconds);
+  timestamp = buf;
+  return bio::Status::Ok();
 }
 
-bool parse_file_header(bio::LEReader& reader, ZipHeader& header) {
+/// Parse one local file header. Returns at the first failure; the Status
+/// carries its position, so a corrupt archive is located without re-parsing.
+template <typename Reader>
+bio::Status parse_file_header(Reader& reader, ZipHeader& header) {
   uint16_t flags{0};
   uint16_t file_name_length{0};
   uint16_t extra_field_length{0};
 
-  bool ok = true;
-
-  ok = ok && reader.read_u32(header.magic_number);
-  ok = ok && reader.read_u16(header.version);
-  ok = ok && reader.read_u16(flags);
-
+  bio::Status s = reader.read_u32(header.magic_number);
+  if (!s) return s;
+  if (header.magic_number != kZipMagicNumber) {
+    return bio::Status::BadMagic(reader.position() - 4);
+  }
+  s = reader.read_u16(header.version);
+  if (!s) return s;
+  s = reader.read_u16(flags);
+  if (!s) return s;
   header.flags = std::bitset<16>(flags);
 
-  ok = ok && reader.read_u16(header.compression_method);
-  ok = ok && read_date_time(reader, header.timestamp);
-  ok = ok && reader.read_u32(header.crc32);
-  ok = ok && reader.read_u32(header.compressed_size);
-  ok = ok && reader.read_u32(header.uncompressed_size);
-  ok = ok && reader.read_u16(file_name_length);
-  ok = ok && reader.read_u16(extra_field_length);
-
+  s = reader.read_u16(header.compression_method);
+  if (!s) return s;
+  s = read_date_time(reader, header.timestamp);
+  if (!s) return s;
+  s = reader.read_u32(header.crc32);
+  if (!s) return s;
+  s = reader.read_u32(header.compressed_size);
+  if (!s) return s;
+  s = reader.read_u32(header.uncompressed_size);
+  if (!s) return s;
+  s = reader.read_u16(file_name_length);
+  if (!s) return s;
+  s = reader.read_u16(extra_field_length);
+  if (!s) return s;
+
+  // The window is reused by later reads, so the name is copied out of it.
   header.file_name.resize(file_name_length);
+  s = reader.read_bytes(header.file_name.data(), file_name_length);
+  if (!s) return s;
+  return reader.skip(extra_field_length);
+}
 
-  ok = ok && reader.read_bytes(header.file_name.data(), file_name_length);
-  ok = ok && reader.skip(extra_field_length);
-
-  ok = ok && header.magic_number == kZipMagicNumber;
+template <typename Reader>
+bio::Status parse_file_entry(Reader& reader, ZipHeader& header) {
+  const bio::Status s = parse_file_header(reader, header);
+  if (!s) return s;
+  return reader.skip(header.compressed_size);
+}
 
-  return ok;
+template <typename Reader>
+void print_entries(Reader& reader) {
+  for (;;) {
+    ZipHeader header;
+    const bio::Status s = parse_file_entry(reader, header);
+    if (!s) {
+      // Normally a BadMagic at the start of the central directory.
+      std::cout << "Stopped at byte " << s.position << ": "
+                << bio::to_string(s.code) << "\n";
+      return;
+    }
+    header.print();
+  }
 }
 
-std::optional<ZipHeader> parse_file_entry(bio::LEReader& reader) {
-  auto header = ZipHeader{};
-  bool ok = parse_file_header(reader, header);
-  ok = ok && reader.skip(header.compressed_size);
-  if (ok) {
-    return header;
+bool map_zip_file(const std::filesystem::path& path) {
+  bio::MappedFile file;
+  if (!file.open(path.string().c_str())) {
+    return false;
+  }
+  zip::ZipIndex index;
+  if (!index.build(file.data(), file.size())) {
+    std::cerr << "Not a ZIP archive: " << path << "\n";
+    return true;
+  }
+  std::cout << "Indexed " << index.entries().size() << " entries from "
+            << path << "\n";
+  for (const auto& entry : index.entries()) {
+    std::cout << entry.name << " (" << entry.uncompressed_size << " bytes, "
+              << "method " << entry.compression_method << ")\n";
+  }
+
+  zip::ThreadPool pool;
+  const auto report = zip::validate(index, pool);
+  std::cout << "Validated on " << pool.size() << " threads: " << report.ok
+            << " ok, " << report.not_verified << " not verified, "
+            << report.failed.size() << " failed\n";
+
+  // Random access: jump straight to one entry's data.
+  const auto* entry = index.find("hello_world.txt");
+  bio::ByteView content;
+  if (entry != nullptr && entry->compression_method == 0 &&
+      index.data(*entry, content)) {
+    std::cout << entry->name << ": ";
+    std::cout.write(reinterpret_cast<const char*>(content.data()),
+                    static_cast<std::streamsize>(content.size()));
+    std::cout << "\n";
   }
-  return std::nullopt;
+  return true;
 }
 
-void parse_zip_file(const std::vector<uint8_t>& buffer) {
-  bio::LEReader reader{buffer.data(), buffer.size()};
-  while (auto header = parse_file_entry(reader)) {
-    header->print();
+void stream_zip_file(const std::filesystem::path& path) {
+  auto file = std::ifstream{path, std::ios::binary};
+  if (!file) {
+    std::cerr << "Could not open " << path << "\n";
+    return;
   }
+  bio::IStreamSource source{file};
+  uint8_t window[4096];
+  bio::LEStreamReader<bio::IStreamSource> reader{source, window,
+                                                 sizeof(window)};
+  print_entries(reader);
+  std::cout << "Read " << reader.position() << " bytes from " << path << "\n";
 }
 
 int main() {
-  const auto buffer = load_zip_file();
-  parse_zip_file(buffer);
+  const auto path{std::filesystem::path{SOURCE_DIR} / "sample-1.zip"};
+  if (!map_zip_file(path)) {
+    stream_zip_file(path);
+  }
   return 0;
 }
@@ -0,0 +1,193 @@
+#ifndef ZIP_EXAMPLE_THREAD_POOL_HPP_
+#define ZIP_EXAMPLE_THREAD_POOL_HPP_
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Fixed-size thread pool running parallel loops with range stealing.
+///
+/// parallel_for() splits [0, count) into one contiguous range per worker.
+/// A worker takes small batches from the front of its own range; once that
+/// runs dry it steals the back half of the largest remaining range. This
+/// keeps neighbouring indices on one core while still balancing loops whose
+/// iterations differ wildly in cost, such as ZIP entries of very different
+/// sizes.
+
+namespace zip {
+
+class ThreadPool {
+ public:
+  /// Start a pool with @p threads workers, including the calling thread;
+  /// 0 picks std::thread::hardware_concurrency().
+  explicit ThreadPool(size_t threads = 0) {
+    if (threads == 0) {
+      threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    ranges_ = std::make_unique<Range[]>(threads);
+    workers_.reserve(threads - 1);
+    for (size_t i = 1; i < threads; ++i) {
+      workers_.emplace_back([this, i] { run(i); });
+    }
+  }
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /// Number of workers, including the calling thread.
+  size_t size() const { return workers_.size() + 1; }
+
+  /// Call @p fn(index, worker) for every index in [0, count) and wait for
+  /// all calls to finish. @p worker is in [0, size()) and identifies the
+  /// thread, so callers can keep per-worker state without locking. Not
+  /// reentrant: @p fn must not call parallel_for() on the same pool.
+  void parallel_for(size_t count,
+                    const std::function<void(size_t, size_t)>& fn) {
+    const size_t n = size();
+    for (size_t i = 0; i < n; ++i) {
+      std::lock_guard<std::mutex> lock{ranges_[i].mutex};
+      ranges_[i].begin = count * i / n;
+      ranges_[i].end = count * (i + 1) / n;
+    }
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      job_ = &fn;
+      active_ = n - 1;
+      ++generation_;
+    }
+    wake_.notify_all();
+    work(0);
+    std::unique_lock<std::mutex> lock{mutex_};
+    done_.wait(lock, [this] { return active_ == 0; });
+    job_ = nullptr;
+  }
+
+ private:
+  /// Iterations taken from the own range per lock acquisition.
+  static constexpr size_t kBatch = 16;
+
+  struct Range {
+    std::mutex mutex;
+    size_t begin = 0;
+    size_t end = 0;
+  };
+
+  void run(size_t worker) {
+    uint64_t seen = 0;
+    for (;;) {
+      {
+        std::unique_lock<std::mutex> lock{mutex_};
+        wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+        if (stopping_) {
+          return;
+        }
+        seen = generation_;
+      }
+      work(worker);
+      {
+        std::lock_guard<std::mutex> lock{mutex_};
+        --active_;
+      }
+      done_.notify_one();
+    }
+  }
+
+  void work(size_t worker) {
+    size_t begin = 0;
+    size_t end = 0;
+    for (;;) {
+      if (!take(worker, begin, end)) {
+        if (!steal(worker)) {
+          return;
+        }
+        continue;
+      }
+      for (size_t i = begin; i < end; ++i) {
+        (*job_)(i, worker);
+      }
+    }
+  }
+
+  /// Pop up to kBatch indices from the front of the worker's own range.
+  bool take(size_t worker, size_t& begin, size_t& end) {
+    Range& own = ranges_[worker];
+    std::lock_guard<std::mutex> lock{own.mutex};
+    if (own.begin == own.end) {
+      return false;
+    }
+    begin = own.begin;
+    end = std::min(own.end, own.begin + kBatch);
+    own.begin = end;
+    return true;
+  }
+
+  /// Move the back half of the largest other range into the worker's own.
+  bool steal(size_t worker) {
+    for (;;) {
+      size_t victim = worker;
+      size_t largest = 0;
+      for (size_t i = 0; i < size(); ++i) {
+        if (i == worker) {
+          continue;
+        }
+        std::lock_guard<std::mutex> lock{ranges_[i].mutex};
+        const size_t left = ranges_[i].end - ranges_[i].begin;
+        if (left > largest) {
+          largest = left;
+          victim = i;
+        }
+      }
+      if (victim == worker) {
+        return false;
+      }
+      Range& from = ranges_[victim];
+      Range& own = ranges_[worker];
+      // Lock in index order so two thieves cannot deadlock.
+      std::unique_lock<std::mutex> first{
+          victim < worker ? from.mutex : own.mutex};
+      std::unique_lock<std::mutex> second{
+          victim < worker ? own.mutex : from.mutex};
+      const size_t left = from.end - from.begin;
+      if (left == 0) {
+        continue;  // Drained since the scan; look again.
+      }
+      const size_t split = from.end - (left + 1) / 2;
+      own.begin = split;
+      own.end = from.end;
+      from.end = split;
+      return true;
+    }
+  }
+
+  std::vector<std::thread> workers_{};
+  std::unique_ptr<Range[]> ranges_{};
+  const std::function<void(size_t, size_t)>* job_{nullptr};
+
+  std::mutex mutex_{};
+  std::condition_variable wake_{};
+  std::condition_variable done_{};
+  uint64_t generation_{0};
+  size_t active_{0};
+  bool stopping_{false};
+};
+
+}  // namespace zip
+
+#endif  // ZIP_EXAMPLE_THREAD_POOL_HPP_
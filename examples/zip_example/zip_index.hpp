@@ -0,0 +1,238 @@
+#ifndef ZIP_EXAMPLE_ZIP_INDEX_HPP_
+#define ZIP_EXAMPLE_ZIP_INDEX_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "binary-io/binary-io.hpp"
+
+/// Random-access index over a ZIP archive held in memory (typically a
+/// bio::MappedFile). build() locates the End Of Central Directory record,
+/// walks the central directory once and keeps the entries sorted by name, so
+/// find() is a binary search and data() jumps straight to an entry's bytes.
+/// Sizes come from the central directory, so entries written with data
+/// descriptors resolve correctly. ZIP64 archives (more than 65535 entries or
+/// offsets past 4 GiB) are supported; multi-disk archives are not.
+///
+/// Entry names point into the archive buffer, which must outlive the index.
+
+namespace zip {
+
+/// One central-directory record.
+struct ZipEntry {
+  std::string_view name{};
+  uint64_t compressed_size{0};
+  uint64_t uncompressed_size{0};
+  uint64_t local_header_offset{0};
+  uint32_t crc32{0};
+  uint16_t compression_method{0};
+  uint16_t flags{0};
+};
+
+class ZipIndex {
+ public:
+  static constexpr uint32_t kLocalHeaderMagic = 0x04034b50;
+  static constexpr uint32_t kCentralHeaderMagic = 0x02014b50;
+  static constexpr uint32_t kEndOfCentralDirMagic = 0x06054b50;
+  static constexpr uint32_t kZip64EndOfCentralDirMagic = 0x06064b50;
+  static constexpr uint32_t kZip64LocatorMagic = 0x07064b50;
+
+  /// Index the archive in @p data; returns false if it is not a valid,
+  /// single-disk ZIP archive.
+  bool build(const uint8_t* data, size_t size) {
+    data_ = data;
+    size_ = size;
+    entries_.clear();
+
+    CentralDirectory dir;
+    bool ok = find_central_directory(dir);
+    ok = ok && dir.offset <= size_ && dir.size <= size_ - dir.offset;
+    // Every record holds at least its fixed 46 bytes, which bounds the
+    // reservation for a corrupt entry count.
+    ok = ok && dir.entries <= dir.size / kCentralHeaderSize;
+    if (!ok) {
+      return false;
+    }
+
+    entries_.reserve(static_cast<size_t>(dir.entries));
+    bio::LEReader reader{data_ + dir.offset, static_cast<size_t>(dir.size)};
+    for (uint64_t i = 0; i < dir.entries; ++i) {
+      ZipEntry entry;
+      if (!parse_central_header(reader, entry)) {
+        entries_.clear();
+        return false;
+      }
+      entries_.push_back(entry);
+    }
+    std::sort(entries_.begin(), entries_.end(),
+              [](const ZipEntry& a, const ZipEntry& b) {
+                return a.name < b.name;
+              });
+    return true;
+  }
+
+  /// All entries, sorted by name.
+  const std::vector<ZipEntry>& entries() const { return entries_; }
+
+  /// Look up an entry by its full path; returns nullptr if absent.
+  const ZipEntry* find(std::string_view name) const {
+    const auto it = std::lower_bound(
+        entries_.begin(), entries_.end(), name,
+        [](const ZipEntry& e, std::string_view n) { return e.name < n; });
+    if (it == entries_.end() || it->name != name) {
+      return nullptr;
+    }
+    return &*it;
+  }
+
+  /// Resolve the (possibly compressed) bytes of @p entry by reading its
+  /// local header, whose name and extra field lengths may differ from the
+  /// central directory's.
+  bool data(const ZipEntry& entry, bio::ByteView& out) const {
+    if (entry.local_header_offset > size_) {
+      return false;
+    }
+    const auto offset = static_cast<size_t>(entry.local_header_offset);
+    bio::LEReader reader{data_ + offset, size_ - offset};
+    if (!reader.ensure(kLocalHeaderSize) ||
+        reader.load_u32_at(0) != kLocalHeaderMagic) {
+      return false;
+    }
+    const size_t skip = size_t{reader.load_u16_at(26)} + reader.load_u16_at(28);
+    reader.advance(kLocalHeaderSize);
+    return reader.skip(skip) &&
+           entry.compressed_size <= reader.remaining() &&
+           reader.read_view(out, static_cast<size_t>(entry.compressed_size));
+  }
+
+ private:
+  static constexpr size_t kLocalHeaderSize = 30;
+  static constexpr size_t kCentralHeaderSize = 46;
+  static constexpr size_t kEndOfCentralDirSize = 22;
+  static constexpr size_t kZip64EndOfCentralDirSize = 56;
+  static constexpr size_t kZip64LocatorSize = 20;
+  static constexpr uint16_t kZip64ExtraId = 0x0001;
+
+  struct CentralDirectory {
+    uint64_t entries{0};
+    uint64_t size{0};
+    uint64_t offset{0};
+  };
+
+  /// Scan backwards for the EOCD record; it is followed by a comment of up
+  /// to 64 KiB, so only that tail needs to be searched.
+  bool find_central_directory(CentralDirectory& dir) const {
+    if (size_ < kEndOfCentralDirSize) {
+      return false;
+    }
+    const size_t last = size_ - kEndOfCentralDirSize;
+    const size_t first = last > 0xFFFF ? last - 0xFFFF : 0;
+    for (size_t pos = last + 1; pos-- > first;) {
+      bio::LEReader reader{data_ + pos, size_ - pos};
+      if (reader.load_u32_at(0) != kEndOfCentralDirMagic ||
+          pos + kEndOfCentralDirSize + reader.load_u16_at(20) != size_) {
+        continue;
+      }
+      const uint16_t disk = reader.load_u16_at(4);
+      const uint16_t cd_disk = reader.load_u16_at(6);
+      dir.entries = reader.load_u16_at(10);
+      dir.size = reader.load_u32_at(12);
+      dir.offset = reader.load_u32_at(16);
+      if (dir.entries == 0xFFFF || dir.size == 0xFFFFFFFF ||
+          dir.offset == 0xFFFFFFFF) {
+        return find_zip64_central_directory(pos, dir);
+      }
+      return disk == 0 && cd_disk == 0;
+    }
+    return false;
+  }
+
+  bool find_zip64_central_directory(size_t eocd, CentralDirectory& dir) const {
+    if (eocd < kZip64LocatorSize) {
+      return false;
+    }
+    bio::LEReader locator{data_ + eocd - kZip64LocatorSize, kZip64LocatorSize};
+    if (locator.load_u32_at(0) != kZip64LocatorMagic ||
+        locator.load_u32_at(16) > 1) {
+      return false;
+    }
+    const uint64_t offset = locator.load_u64_at(8);
+    if (offset > size_ || size_ - offset < kZip64EndOfCentralDirSize) {
+      return false;
+    }
+    bio::LEReader reader{data_ + offset, kZip64EndOfCentralDirSize};
+    if (reader.load_u32_at(0) != kZip64EndOfCentralDirMagic ||
+        reader.load_u32_at(16) != 0 || reader.load_u32_at(20) != 0) {
+      return false;
+    }
+    dir.entries = reader.load_u64_at(32);
+    dir.size = reader.load_u64_at(40);
+    dir.offset = reader.load_u64_at(48);
+    return true;
+  }
+
+  bool parse_central_header(bio::LEReader& reader, ZipEntry& entry) const {
+    if (!reader.ensure(kCentralHeaderSize) ||
+        reader.load_u32_at(0) != kCentralHeaderMagic) {
+      return false;
+    }
+    entry.flags = reader.load_u16_at(8);
+    entry.compression_method = reader.load_u16_at(10);
+    entry.crc32 = reader.load_u32_at(16);
+    entry.compressed_size = reader.load_u32_at(20);
+    entry.uncompressed_size = reader.load_u32_at(24);
+    const uint16_t name_length = reader.load_u16_at(28);
+    const uint16_t extra_length = reader.load_u16_at(30);
+    const uint16_t comment_length = reader.load_u16_at(32);
+    entry.local_header_offset = reader.load_u32_at(42);
+    reader.advance(kCentralHeaderSize);
+
+    bio::ByteView extra;
+    bool ok = true;
+    ok = ok && reader.read_string_view(entry.name, name_length);
+    ok = ok && reader.read_view(extra, extra_length);
+    ok = ok && reader.skip(comment_length);
+    return ok && apply_zip64_extra(extra, entry);
+  }
+
+  /// The ZIP64 extra field carries, in this order, whichever of the three
+  /// 32-bit fields were saturated to 0xFFFFFFFF.
+  static bool apply_zip64_extra(bio::ByteView extra, ZipEntry& entry) {
+    bio::LEReader reader{extra.data(), extra.size()};
+    while (reader.remaining() >= 4) {
+      uint16_t id = 0;
+      uint16_t length = 0;
+      bio::ByteView body;
+      bool ok = reader.read_u16(id) && reader.read_u16(length);
+      ok = ok && reader.read_view(body, length);
+      if (!ok) {
+        return false;
+      }
+      if (id != kZip64ExtraId) {
+        continue;
+      }
+      bio::LEReader field{body.data(), body.size()};
+      uint64_t* const targets[] = {&entry.uncompressed_size,
+                                   &entry.compressed_size,
+                                   &entry.local_header_offset};
+      for (uint64_t* target : targets) {
+        if (*target == 0xFFFFFFFF && !field.read_u64(*target)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    return true;
+  }
+
+  const uint8_t* data_{nullptr};
+  size_t size_{0};
+  std::vector<ZipEntry> entries_{};
+};
+
+}  // namespace zip
+
+#endif  // ZIP_EXAMPLE_ZIP_INDEX_HPP_
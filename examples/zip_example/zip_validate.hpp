@@ -0,0 +1,90 @@
+#ifndef ZIP_EXAMPLE_ZIP_VALIDATE_HPP_
+#define ZIP_EXAMPLE_ZIP_VALIDATE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "binary-io/binary-io.hpp"
+#include "binary-io/checksum.hpp"
+#include "thread_pool.hpp"
+#include "zip_index.hpp"
+
+/// Parallel integrity check over an indexed archive.
+///
+/// Entries are independent once the central directory is indexed, so they
+/// are spread across a ThreadPool. The archive buffer is shared read-only;
+/// every ZipIndex::data() call builds its own LEReader over it, so workers
+/// need no synchronization beyond the per-worker tallies merged at the end.
+
+namespace zip {
+
+enum class EntryStatus : uint8_t {
+  Ok,           ///< Local header valid and CRC matches.
+  BadHeader,    ///< Local header missing or data out of bounds.
+  BadCrc,       ///< Stored data does not match the recorded CRC or size.
+  NotVerified,  ///< Compressed entry; header checked, CRC needs inflating.
+};
+
+struct ValidationReport {
+  size_t ok{0};
+  size_t not_verified{0};
+  std::vector<size_t> failed{};  ///< Indices into ZipIndex::entries().
+};
+
+/// Check a single entry; safe to call concurrently on a shared index.
+inline EntryStatus validate_entry(const ZipIndex& index,
+                                  const ZipEntry& entry) {
+  bio::ByteView data;
+  if (!index.data(entry, data)) {
+    return EntryStatus::BadHeader;
+  }
+  if (entry.compression_method != 0) {
+    return EntryStatus::NotVerified;
+  }
+  if (data.size() != entry.uncompressed_size ||
+      bio::crc32(data.data(), data.size()) != entry.crc32) {
+    return EntryStatus::BadCrc;
+  }
+  return EntryStatus::Ok;
+}
+
+/// Validate every entry of @p index on @p pool.
+inline ValidationReport validate(const ZipIndex& index, ThreadPool& pool) {
+  // One cache line per worker so the tallies do not false-share.
+  struct alignas(64) Tally {
+    ValidationReport report;
+  };
+  const auto& entries = index.entries();
+  std::vector<Tally> partial(pool.size());
+  pool.parallel_for(entries.size(), [&](size_t i, size_t worker) {
+    ValidationReport& report = partial[worker].report;
+    switch (validate_entry(index, entries[i])) {
+      case EntryStatus::Ok:
+        ++report.ok;
+        break;
+      case EntryStatus::NotVerified:
+        ++report.not_verified;
+        break;
+      case EntryStatus::BadHeader:
+      case EntryStatus::BadCrc:
+        report.failed.push_back(i);
+        break;
+    }
+  });
+
+  ValidationReport total;
+  for (const auto& [report] : partial) {
+    total.ok += report.ok;
+    total.not_verified += report.not_verified;
+    total.failed.insert(total.failed.end(), report.failed.begin(),
+                        report.failed.end());
+  }
+  std::sort(total.failed.begin(), total.failed.end());
+  return total;
+}
+
+}  // namespace zip
+
+#endif  // ZIP_EXAMPLE_ZIP_VALIDATE_HPP_
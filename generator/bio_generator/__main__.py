@@ -31,6 +31,23 @@ def _build_parser() -> argparse.ArgumentParser:
         default=pathlib.Path("."),
         help="Output directory for generated headers (default: current directory).",
     )
+    p.add_argument(
+        "--shared-runtime",
+        action="store_true",
+        help=(
+            "Include binary-io/binary-io.hpp and use the bio:: runtime instead "
+            "of writing a per-protocol <name>_io.hpp."
+        ),
+    )
+    p.add_argument(
+        "--instrument",
+        action="store_true",
+        help=(
+            "Emit InstrumentProbe hooks in every parse()/serialize() and per "
+            "field; they compile away unless the reader or writer has an "
+            "enabled instrumentation policy."
+        ),
+    )
     p.add_argument(
         "-v", "--verbose",
         action="store_true",
@@ -60,7 +77,9 @@ def main(argv: List[str] | None = None) -> int:
 
     for proto in protocols:
         source = str(input_path.name)
-        paths = generate_to_file(proto, output_dir, source_file=source)
+        paths = generate_to_file(proto, output_dir, source_file=source,
+                                 shared_runtime=args.shared_runtime,
+                                 instrument=args.instrument)
         if args.verbose:
             for p in paths:
                 print(f"Generated {p}")
@@ -4,15 +4,20 @@ from __future__ import annotations
 
 import pathlib
 import re
+from types import SimpleNamespace
 from typing import Any, Dict, List, Tuple
 
 from jinja2 import Environment, BaseLoader
 
 from .types import (
     BITFIELD_TYPES,
+    BIT_ORDERS,
     BYTE_ORDERS,
+    INTEGER_PRIMITIVES,
     PRIMITIVES,
+    VARINT_TYPES,
     BitDef,
+    DispatchDef,
     EnumDef,
     FieldDef,
     ProtocolDef,
@@ -29,6 +34,8 @@ def _cpp_type(type_name: str, proto: ProtocolDef) -> str:
     """Map a YAML type name to its C++ type string."""
     if type_name in PRIMITIVES:
         return PRIMITIVES[type_name].cpp_type
+    if type_name in VARINT_TYPES:
+        return VARINT_TYPES[type_name].cpp_type
     if type_name in proto.enum_map:
         return type_name
     if type_name in proto.struct_map:
@@ -65,7 +72,9 @@ def _bitfield_member_type(b: BitDef, proto: ProtocolDef | None = None) -> str:
         return "uint8_t"
     if b.width <= 16:
         return "uint16_t"
-    return "uint32_t"
+    if b.width <= 32:
+        return "uint32_t"
+    return "uint64_t"
 
 
 # ---------------------------------------------------------------------------
@@ -80,33 +89,118 @@ IO_TEMPLATE = r"""// ===========================================================
 #ifndef {{ io_guard }}
 #define {{ io_guard }}
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+
+#if defined(__has_include)
+#if __has_include(<bit>)
+#include <bit>
+#endif
+#endif
+
+// constexpr in C++20 builds, where std::bit_cast replaces memcpy punning.
+// binary-io.hpp defines the same macro.
+#ifndef BIO_CONSTEXPR20
+#if defined(__cpp_lib_bit_cast) && defined(__cpp_lib_is_constant_evaluated)
+#define BIO_CONSTEXPR20 constexpr
+#else
+#define BIO_CONSTEXPR20
+#endif
+#endif
 {% if namespace %}
 namespace {{ namespace }} {
 {% endif %}
-/// Result type indicating success or failure of a read/write operation.
+/// Why an operation failed.
+enum class StatusCode : uint8_t { Ok, OutOfRange, BadMagic, BadEnum, ChecksumMismatch };
+
+/// Result type indicating success or failure of a read/write operation. A
+/// failure records its code, the byte position where it was detected and, in
+/// parse(), the id of the failing field (see the protocol's *_field_name()).
+/// Eight bytes, returned in a register.
 struct [[nodiscard]] Status {
+    static constexpr uint32_t kNoPosition = UINT32_MAX;
+
     bool ok;
+    StatusCode code = StatusCode::Ok;
+    uint16_t field = 0;
+    uint32_t position = kNoPosition;
 
     constexpr explicit operator bool() const { return ok; }
     static constexpr Status Ok() { return {true}; }
-    static constexpr Status OutOfRange() { return {false}; }
+    static constexpr Status Failure(StatusCode code, size_t position = kNoPosition) {
+        return {false, code, 0, position < kNoPosition ? static_cast<uint32_t>(position) : kNoPosition};
+    }
+    static constexpr Status OutOfRange(size_t position = kNoPosition) {
+        return Failure(StatusCode::OutOfRange, position);
+    }
+    static constexpr Status BadMagic(size_t position = kNoPosition) {
+        return Failure(StatusCode::BadMagic, position);
+    }
+    static constexpr Status BadEnum(size_t position = kNoPosition) {
+        return Failure(StatusCode::BadEnum, position);
+    }
+    static constexpr Status ChecksumMismatch(size_t position = kNoPosition) {
+        return Failure(StatusCode::ChecksumMismatch, position);
+    }
+    /// Attribute a failure to field @p id unless a nested field already is.
+    constexpr Status in_field(uint16_t id) const {
+        Status s = *this;
+        if (!s.ok && s.field == 0) s.field = id;
+        return s;
+    }
 };
 
+namespace detail {
+
+constexpr bool IsConstantEvaluated() {
+#if defined(__cpp_lib_is_constant_evaluated)
+    return std::is_constant_evaluated();
+#else
+    return false;
+#endif
+}
+template <typename To, typename From>
+BIO_CONSTEXPR20 inline To BitCast(const From& from) {
+    static_assert(sizeof(To) == sizeof(From), "BitCast needs equal sizes");
+#if defined(__cpp_lib_bit_cast)
+    return std::bit_cast<To>(from);
+#else
+    To to;
+    std::memcpy(&to, &from, sizeof(to));
+    return to;
+#endif
+}
+template <typename T>
+inline constexpr bool kIsByte = std::is_same_v<T, uint8_t> || std::is_same_v<T, int8_t> || std::is_same_v<T, char>;
+// memcpy() at run time, a byte loop under constant evaluation.
+template <typename To, typename From>
+BIO_CONSTEXPR20 inline void CopyBytes(To* dst, const From* src, size_t len) {
+    if (IsConstantEvaluated()) {
+        for (size_t i = 0; i < len; ++i) dst[i] = BitCast<To>(src[i]);
+    } else if (len != 0) {
+        std::memcpy(dst, src, len);
+    }
+}
+
+}  // namespace detail
+
 struct LittleEndianCodec {
-    static inline uint16_t LoadU16(const uint8_t* p) {
+    static constexpr uint16_t LoadU16(const uint8_t* p) {
         return static_cast<uint16_t>(static_cast<uint16_t>(p[0]) |
                                      (static_cast<uint16_t>(p[1]) << 8));
     }
-    static inline uint32_t LoadU32(const uint8_t* p) {
+    static constexpr uint32_t LoadU32(const uint8_t* p) {
         return (static_cast<uint32_t>(p[0]) << 0) |
                (static_cast<uint32_t>(p[1]) << 8) |
                (static_cast<uint32_t>(p[2]) << 16) |
                (static_cast<uint32_t>(p[3]) << 24);
     }
-    static inline uint64_t LoadU64(const uint8_t* p) {
+    static constexpr uint64_t LoadU64(const uint8_t* p) {
         return (static_cast<uint64_t>(p[0]) << 0) |
                (static_cast<uint64_t>(p[1]) << 8) |
                (static_cast<uint64_t>(p[2]) << 16) |
@@ -116,17 +210,17 @@ struct LittleEndianCodec {
                (static_cast<uint64_t>(p[6]) << 48) |
                (static_cast<uint64_t>(p[7]) << 56);
     }
-    static inline void StoreU16(uint8_t* p, uint16_t v) {
+    static constexpr void StoreU16(uint8_t* p, uint16_t v) {
         p[0] = static_cast<uint8_t>((v >> 0) & 0xFFu);
         p[1] = static_cast<uint8_t>((v >> 8) & 0xFFu);
     }
-    static inline void StoreU32(uint8_t* p, uint32_t v) {
+    static constexpr void StoreU32(uint8_t* p, uint32_t v) {
         p[0] = static_cast<uint8_t>((v >> 0) & 0xFFu);
         p[1] = static_cast<uint8_t>((v >> 8) & 0xFFu);
         p[2] = static_cast<uint8_t>((v >> 16) & 0xFFu);
         p[3] = static_cast<uint8_t>((v >> 24) & 0xFFu);
     }
-    static inline void StoreU64(uint8_t* p, uint64_t v) {
+    static constexpr void StoreU64(uint8_t* p, uint64_t v) {
         p[0] = static_cast<uint8_t>((v >> 0) & 0xFFu);
         p[1] = static_cast<uint8_t>((v >> 8) & 0xFFu);
         p[2] = static_cast<uint8_t>((v >> 16) & 0xFFu);
@@ -139,17 +233,17 @@ struct LittleEndianCodec {
 };
 
 struct BigEndianCodec {
-    static inline uint16_t LoadU16(const uint8_t* p) {
+    static constexpr uint16_t LoadU16(const uint8_t* p) {
         return static_cast<uint16_t>((static_cast<uint16_t>(p[0]) << 8) |
                                      static_cast<uint16_t>(p[1]));
     }
-    static inline uint32_t LoadU32(const uint8_t* p) {
+    static constexpr uint32_t LoadU32(const uint8_t* p) {
         return (static_cast<uint32_t>(p[0]) << 24) |
                (static_cast<uint32_t>(p[1]) << 16) |
                (static_cast<uint32_t>(p[2]) << 8) |
                (static_cast<uint32_t>(p[3]) << 0);
     }
-    static inline uint64_t LoadU64(const uint8_t* p) {
+    static constexpr uint64_t LoadU64(const uint8_t* p) {
         return (static_cast<uint64_t>(p[0]) << 56) |
                (static_cast<uint64_t>(p[1]) << 48) |
                (static_cast<uint64_t>(p[2]) << 40) |
@@ -159,17 +253,17 @@ struct BigEndianCodec {
                (static_cast<uint64_t>(p[6]) << 8) |
                (static_cast<uint64_t>(p[7]) << 0);
     }
-    static inline void StoreU16(uint8_t* p, uint16_t v) {
+    static constexpr void StoreU16(uint8_t* p, uint16_t v) {
         p[0] = static_cast<uint8_t>((v >> 8) & 0xFFu);
         p[1] = static_cast<uint8_t>((v >> 0) & 0xFFu);
     }
-    static inline void StoreU32(uint8_t* p, uint32_t v) {
+    static constexpr void StoreU32(uint8_t* p, uint32_t v) {
         p[0] = static_cast<uint8_t>((v >> 24) & 0xFFu);
         p[1] = static_cast<uint8_t>((v >> 16) & 0xFFu);
         p[2] = static_cast<uint8_t>((v >> 8) & 0xFFu);
         p[3] = static_cast<uint8_t>((v >> 0) & 0xFFu);
     }
-    static inline void StoreU64(uint8_t* p, uint64_t v) {
+    static constexpr void StoreU64(uint8_t* p, uint64_t v) {
         p[0] = static_cast<uint8_t>((v >> 56) & 0xFFu);
         p[1] = static_cast<uint8_t>((v >> 48) & 0xFFu);
         p[2] = static_cast<uint8_t>((v >> 40) & 0xFFu);
@@ -181,194 +275,1501 @@ struct BigEndianCodec {
     }
 };
 
+/// LEB128 varint coding shared by the readers and writers.
+struct VarintCodec {
+    static constexpr size_t kMaxBytes = 10;
+
+    static constexpr unsigned ctz(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctzll(v));
+#else
+        unsigned n = 0;
+        for (; (v & 1) == 0; v >>= 1) ++n;
+        return n;
+#endif
+    }
+    // Returns the encoded length, or 0 if truncated or wider than 64 bits.
+    // With 8 bytes readable, one word load and a bit scan find the end.
+    static constexpr size_t decode(const uint8_t* p, size_t n, uint64_t& out) {
+        if (n != 0 && p[0] < 0x80) { out = p[0]; return 1; }
+        if (n >= 8) {
+            const uint64_t word = LittleEndianCodec::LoadU64(p);
+            const uint64_t stops = ~word & 0x8080808080808080u;
+            const unsigned last = stops != 0 ? ctz(stops) : 63;
+            uint64_t v = word & 0x7F7F7F7F7F7F7F7Fu & (~uint64_t{0} >> (63 - last));
+            v = (v & 0x007F007F007F007Fu) | ((v & 0x7F007F007F007F00u) >> 1);
+            v = (v & 0x00003FFF00003FFFu) | ((v & 0x3FFF00003FFF0000u) >> 2);
+            v = (v & 0x000000000FFFFFFFu) | ((v & 0x0FFFFFFF00000000u) >> 4);
+            if (stops != 0) { out = v; return last / 8 + 1; }
+            if (n < 9) return 0;
+            const uint64_t b8 = p[8];
+            if (b8 < 0x80) { out = v | (b8 << 56); return 9; }
+            if (n < 10 || p[9] > 1) return 0;
+            out = v | ((b8 & 0x7F) << 56) | (uint64_t{p[9]} << 63);
+            return 10;
+        }
+        uint64_t v = 0;
+        for (size_t i = 0; i < n; ++i) {
+            v |= static_cast<uint64_t>(p[i] & 0x7F) << (7 * i);
+            if (p[i] < 0x80) { out = v; return i + 1; }
+        }
+        return 0;
+    }
+    static constexpr size_t encode(uint8_t* p, uint64_t v) {
+        size_t len = 0;
+        for (; v >= 0x80; v >>= 7) p[len++] = static_cast<uint8_t>(v | 0x80);
+        p[len++] = static_cast<uint8_t>(v);
+        return len;
+    }
+    static constexpr size_t size(uint64_t v) {
+        size_t len = 1;
+        for (; v >= 0x80; v >>= 7) ++len;
+        return len;
+    }
+    static constexpr uint64_t zigzag(int64_t v) {
+        return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+    }
+    static constexpr int64_t unzigzag(uint64_t v) {
+        return static_cast<int64_t>((v >> 1) ^ (~(v & 1) + 1));
+    }
+};
+
+/// Default instrumentation policy: every hook is a no-op. A policy is a
+/// stateless type with these three static members; probes in code generated
+/// with --instrument report to the policy of the reader or writer.
+struct NoInstrument {
+    static constexpr bool kEnabled = false;
+    static constexpr uint64_t Now() { return 0; }
+    static constexpr void Record(const char*, size_t, bool, uint64_t) {}
+};
+
+namespace detail {
+template <typename Stream, typename = void>
+struct InstrumentOf { using type = NoInstrument; };
+template <typename Stream>
+struct InstrumentOf<Stream, std::void_t<typename Stream::instrument_type>> { using type = typename Stream::instrument_type; };
+}  // namespace detail
+
+template <typename Stream>
+using InstrumentOfT = typename detail::InstrumentOf<Stream>::type;
+
+/// Reports one call to the policy of Stream on destruction: bytes moved,
+/// whether succeed() was reached, and the elapsed clock. Empty if disabled.
+template <typename Stream, typename Instrument = InstrumentOfT<Stream>, bool = Instrument::kEnabled>
+class InstrumentProbe {
+public:
+    constexpr InstrumentProbe(const Stream&, const char*) {}
+    constexpr void succeed() {}
+};
+
+template <typename Stream, typename Instrument>
+class InstrumentProbe<Stream, Instrument, true> {
+public:
+    InstrumentProbe(const Stream& stream, const char* site)
+        : stream_(stream), site_(site), start_(stream.position()), begin_(Instrument::Now()) {}
+    InstrumentProbe(const InstrumentProbe&) = delete;
+    InstrumentProbe& operator=(const InstrumentProbe&) = delete;
+    ~InstrumentProbe() { Instrument::Record(site_, stream_.position() - start_, ok_, Instrument::Now() - begin_); }
+    void succeed() { ok_ = true; }
+
+private:
+    const Stream& stream_;
+    const char* site_;
+    size_t start_;
+    uint64_t begin_;
+    bool ok_ = false;
+};
+
 /// Byte reader that deserialises from a flat buffer.
-template <typename Codec>
+template <typename Codec, typename Instrument = NoInstrument>
 class ByteReaderT {
 public:
+    using codec_type = Codec;
+    using instrument_type = Instrument;
+
     ByteReaderT(const void* data, size_t size)
         : p_(static_cast<const uint8_t*>(data)), n_(size), size_(size) {}
+    template <typename Byte, typename = std::enable_if_t<std::is_same_v<Byte, uint8_t>>>
+    BIO_CONSTEXPR20 ByteReaderT(const Byte* data, size_t size) : p_(data), n_(size), size_(size) {}
 
-    size_t remaining() const { return n_; }
-    size_t position() const { return size_ - n_; }
+    BIO_CONSTEXPR20 size_t remaining() const { return n_; }
+    BIO_CONSTEXPR20 size_t position() const { return size_ - n_; }
 
-    Status read_u8(uint8_t& out) {
-        if (1 > n_) return Status::OutOfRange();
+    BIO_CONSTEXPR20 Status read_u8(uint8_t& out) {
+        if (1 > n_) return Status::OutOfRange(position());
         out = *p_++;
         --n_;
         return Status::Ok();
     }
-    Status read_u16(uint16_t& out) {
-        if (sizeof(uint16_t) > n_) return Status::OutOfRange();
+    BIO_CONSTEXPR20 Status read_u16(uint16_t& out) {
+        if (sizeof(uint16_t) > n_) return Status::OutOfRange(position());
         out = Codec::LoadU16(p_);
         p_ += sizeof(uint16_t);
         n_ -= sizeof(uint16_t);
         return Status::Ok();
     }
-    Status read_u32(uint32_t& out) {
-        if (sizeof(uint32_t) > n_) return Status::OutOfRange();
+    BIO_CONSTEXPR20 Status read_u32(uint32_t& out) {
+        if (sizeof(uint32_t) > n_) return Status::OutOfRange(position());
         out = Codec::LoadU32(p_);
         p_ += sizeof(uint32_t);
         n_ -= sizeof(uint32_t);
         return Status::Ok();
     }
-    Status read_u64(uint64_t& out) {
-        if (sizeof(uint64_t) > n_) return Status::OutOfRange();
+    BIO_CONSTEXPR20 Status read_u64(uint64_t& out) {
+        if (sizeof(uint64_t) > n_) return Status::OutOfRange(position());
         out = Codec::LoadU64(p_);
         p_ += sizeof(uint64_t);
         n_ -= sizeof(uint64_t);
         return Status::Ok();
     }
-    Status read_i8(int8_t& out) {
+    BIO_CONSTEXPR20 Status read_i8(int8_t& out) {
         uint8_t bits = 0;
-        if (!read_u8(bits)) return Status::OutOfRange();
-        std::memcpy(&out, &bits, sizeof(bits));
+        if (!read_u8(bits)) return Status::OutOfRange(position());
+        out = detail::BitCast<int8_t>(bits);
         return Status::Ok();
     }
-    Status read_i16(int16_t& out) {
+    BIO_CONSTEXPR20 Status read_i16(int16_t& out) {
         uint16_t bits = 0;
-        if (!read_u16(bits)) return Status::OutOfRange();
-        std::memcpy(&out, &bits, sizeof(bits));
+        if (!read_u16(bits)) return Status::OutOfRange(position());
+        out = detail::BitCast<int16_t>(bits);
         return Status::Ok();
     }
-    Status read_i32(int32_t& out) {
+    BIO_CONSTEXPR20 Status read_i32(int32_t& out) {
         uint32_t bits = 0;
-        if (!read_u32(bits)) return Status::OutOfRange();
-        std::memcpy(&out, &bits, sizeof(bits));
+        if (!read_u32(bits)) return Status::OutOfRange(position());
+        out = detail::BitCast<int32_t>(bits);
         return Status::Ok();
     }
-    Status read_i64(int64_t& out) {
+    BIO_CONSTEXPR20 Status read_i64(int64_t& out) {
         uint64_t bits = 0;
-        if (!read_u64(bits)) return Status::OutOfRange();
-        std::memcpy(&out, &bits, sizeof(bits));
+        if (!read_u64(bits)) return Status::OutOfRange(position());
+        out = detail::BitCast<int64_t>(bits);
         return Status::Ok();
     }
-    Status read_f32(float& out) {
+    BIO_CONSTEXPR20 Status read_f32(float& out) {
         static_assert(sizeof(float) == 4, "float must be 32-bit");
         uint32_t bits = 0;
-        if (!read_u32(bits)) return Status::OutOfRange();
-        std::memcpy(&out, &bits, sizeof(bits));
+        if (!read_u32(bits)) return Status::OutOfRange(position());
+        out = detail::BitCast<float>(bits);
         return Status::Ok();
     }
-    Status read_f64(double& out) {
+    BIO_CONSTEXPR20 Status read_f64(double& out) {
         static_assert(sizeof(double) == 8, "double must be 64-bit");
         uint64_t bits = 0;
-        if (!read_u64(bits)) return Status::OutOfRange();
-        std::memcpy(&out, &bits, sizeof(bits));
+        if (!read_u64(bits)) return Status::OutOfRange(position());
+        out = detail::BitCast<double>(bits);
         return Status::Ok();
     }
-    Status read_bytes(void* out, size_t len) {
-        if (len > n_) return Status::OutOfRange();
-        std::memcpy(out, p_, len);
+    BIO_CONSTEXPR20 Status read_varuint(uint64_t& out) {
+        const size_t len = VarintCodec::decode(p_, n_, out);
+        if (len == 0) return Status::OutOfRange(position());
         p_ += len;
         n_ -= len;
         return Status::Ok();
     }
-    Status skip(size_t len) {
-        if (len > n_) return Status::OutOfRange();
+    BIO_CONSTEXPR20 Status read_varint(int64_t& out) {
+        uint64_t bits = 0;
+        if (!read_varuint(bits)) return Status::OutOfRange(position());
+        out = VarintCodec::unzigzag(bits);
+        return Status::Ok();
+    }
+    BIO_CONSTEXPR20 Status read_u8_array(uint8_t* out, size_t count) { return read_bytes(out, count); }
+    BIO_CONSTEXPR20 Status read_i8_array(int8_t* out, size_t count) { return read_bytes(out, count); }
+    BIO_CONSTEXPR20 Status read_u16_array(uint16_t* out, size_t count) { return read_array(out, count); }
+    BIO_CONSTEXPR20 Status read_i16_array(int16_t* out, size_t count) { return read_array(out, count); }
+    BIO_CONSTEXPR20 Status read_u32_array(uint32_t* out, size_t count) { return read_array(out, count); }
+    BIO_CONSTEXPR20 Status read_i32_array(int32_t* out, size_t count) { return read_array(out, count); }
+    BIO_CONSTEXPR20 Status read_u64_array(uint64_t* out, size_t count) { return read_array(out, count); }
+    BIO_CONSTEXPR20 Status read_i64_array(int64_t* out, size_t count) { return read_array(out, count); }
+    BIO_CONSTEXPR20 Status read_f32_array(float* out, size_t count) { return read_array(out, count); }
+    BIO_CONSTEXPR20 Status read_f64_array(double* out, size_t count) { return read_array(out, count); }
+    Status read_bytes(void* out, size_t len) { return read_bytes(static_cast<uint8_t*>(out), len); }
+    template <typename Byte, typename = std::enable_if_t<detail::kIsByte<Byte>>>
+    BIO_CONSTEXPR20 Status read_bytes(Byte* out, size_t len) {
+        if (len > n_) return Status::OutOfRange(position());
+        detail::CopyBytes(out, p_, len);
         p_ += len;
         n_ -= len;
         return Status::Ok();
     }
-
+    BIO_CONSTEXPR20 Status skip(size_t len) {
+        if (len > n_) return Status::OutOfRange(position());
+        p_ += len;
+        n_ -= len;
+        return Status::Ok();
+    }
+    // Lookahead and repositioning without copying the reader.
+    BIO_CONSTEXPR20 Status peek_u8(uint8_t& out, size_t offset = 0) const {
+        if (1 > n_ || offset > n_ - 1) return Status::OutOfRange(position());
+        out = load_u8_at(offset);
+        return Status::Ok();
+    }
+    BIO_CONSTEXPR20 Status peek_u16(uint16_t& out, size_t offset = 0) const {
+        if (2 > n_ || offset > n_ - 2) return Status::OutOfRange(position());
+        out = load_u16_at(offset);
+        return Status::Ok();
+    }
+    BIO_CONSTEXPR20 Status peek_u32(uint32_t& out, size_t offset = 0) const {
+        if (4 > n_ || offset > n_ - 4) return Status::OutOfRange(position());
+        out = load_u32_at(offset);
+        return Status::Ok();
+    }
+    BIO_CONSTEXPR20 Status peek_u64(uint64_t& out, size_t offset = 0) const {
+        if (8 > n_ || offset > n_ - 8) return Status::OutOfRange(position());
+        out = load_u64_at(offset);
+        return Status::Ok();
+    }
+    BIO_CONSTEXPR20 Status peek_i8(int8_t& out, size_t offset = 0) const {
+        if (1 > n_ || offset > n_ - 1) return Status::OutOfRange(position());
+        out = load_i8_at(offset);
+        return Status::Ok();
+    }
+    BIO_CONSTEXPR20 Status peek_i16(int16_t& out, size_t offset = 0) const {
+        if (2 > n_ || offset > n_ - 2) return Status::OutOfRange(position());
+        out = load_i16_at(offset);
+        return Status::Ok();
+    }
+    BIO_CONSTEXPR20 Status peek_i32(int32_t& out, size_t offset = 0) const {
+        if (4 > n_ || offset > n_ - 4) return Status::OutOfRange(position());
+        out = load_i32_at(offset);
+        return Status::Ok();
+    }
+    BIO_CONSTEXPR20 Status peek_i64(int64_t& out, size_t offset = 0) const {
+        if (8 > n_ || offset > n_ - 8) return Status::OutOfRange(position());
+        out = load_i64_at(offset);
+        return Status::Ok();
+    }
+    class Checkpoint {
+        friend class ByteReaderT;
+        BIO_CONSTEXPR20 Checkpoint(const uint8_t* p, size_t n) : p_(p), n_(n) {}
+        const uint8_t* p_;
+        size_t n_;
+    };
+    BIO_CONSTEXPR20 Checkpoint checkpoint() const { return Checkpoint(p_, n_); }
+    BIO_CONSTEXPR20 void rewind(Checkpoint saved) { p_ = saved.p_; n_ = saved.n_; }
+    BIO_CONSTEXPR20 Status seek(size_t pos) {
+        if (pos > size_) return Status::OutOfRange(position());
+        p_ = p_ - position() + pos;
+        n_ = size_ - pos;
+        return Status::Ok();
+    }
+    // Unchecked access relative to the cursor: ensure() once, load/store
+    // at constant offsets, then advance() past the record.
+    BIO_CONSTEXPR20 Status ensure(size_t len) const {
+        if (len > n_) return Status::OutOfRange(position());
+        return Status::Ok();
+    }
+    BIO_CONSTEXPR20 void advance(size_t len) {
+        p_ += len;
+        n_ -= len;
+    }
+    BIO_CONSTEXPR20 uint8_t load_u8_at(size_t offset) const { uint8_t v = 0; load_elems(p_ + offset, &v, 1); return v; }
+    BIO_CONSTEXPR20 uint16_t load_u16_at(size_t offset) const { uint16_t v = 0; load_elems(p_ + offset, &v, 1); return v; }
+    BIO_CONSTEXPR20 uint32_t load_u32_at(size_t offset) const { uint32_t v = 0; load_elems(p_ + offset, &v, 1); return v; }
+    BIO_CONSTEXPR20 uint64_t load_u64_at(size_t offset) const { uint64_t v = 0; load_elems(p_ + offset, &v, 1); return v; }
+    BIO_CONSTEXPR20 int8_t load_i8_at(size_t offset) const { int8_t v = 0; load_elems(p_ + offset, &v, 1); return v; }
+    BIO_CONSTEXPR20 int16_t load_i16_at(size_t offset) const { int16_t v = 0; load_elems(p_ + offset, &v, 1); return v; }
+    BIO_CONSTEXPR20 int32_t load_i32_at(size_t offset) const { int32_t v = 0; load_elems(p_ + offset, &v, 1); return v; }
+    BIO_CONSTEXPR20 int64_t load_i64_at(size_t offset) const { int64_t v = 0; load_elems(p_ + offset, &v, 1); return v; }
+    BIO_CONSTEXPR20 float load_f32_at(size_t offset) const { float v = 0; load_elems(p_ + offset, &v, 1); return v; }
+    BIO_CONSTEXPR20 double load_f64_at(size_t offset) const { double v = 0; load_elems(p_ + offset, &v, 1); return v; }
+    void load_bytes_at(size_t offset, void* out, size_t len) const { std::memcpy(out, p_ + offset, len); }
+    template <typename Byte, typename = std::enable_if_t<detail::kIsByte<Byte>>>
+    BIO_CONSTEXPR20 void load_bytes_at(size_t offset, Byte* out, size_t len) const { detail::CopyBytes(out, p_ + offset, len); }
+    BIO_CONSTEXPR20 void load_u16_array_at(size_t offset, uint16_t* out, size_t count) const { load_elems(p_ + offset, out, count); }
+    BIO_CONSTEXPR20 void load_u32_array_at(size_t offset, uint32_t* out, size_t count) const { load_elems(p_ + offset, out, count); }
+    BIO_CONSTEXPR20 void load_u64_array_at(size_t offset, uint64_t* out, size_t count) const { load_elems(p_ + offset, out, count); }
+    BIO_CONSTEXPR20 void load_i16_array_at(size_t offset, int16_t* out, size_t count) const { load_elems(p_ + offset, out, count); }
+    BIO_CONSTEXPR20 void load_i32_array_at(size_t offset, int32_t* out, size_t count) const { load_elems(p_ + offset, out, count); }
+    BIO_CONSTEXPR20 void load_i64_array_at(size_t offset, int64_t* out, size_t count) const { load_elems(p_ + offset, out, count); }
+    BIO_CONSTEXPR20 void load_f32_array_at(size_t offset, float* out, size_t count) const { load_elems(p_ + offset, out, count); }
+    BIO_CONSTEXPR20 void load_f64_array_at(size_t offset, double* out, size_t count) const { load_elems(p_ + offset, out, count); }
+    // Searching relative to the cursor: the offset of the first copy of a
+    // pattern starting at least `from` bytes in, or npos. memchr() finds
+    // the candidates, memcmp() verifies them.
+    static constexpr size_t npos = static_cast<size_t>(-1);
+    size_t find_bytes(const void* pattern, size_t len, size_t from = 0) const {
+        const auto* needle = static_cast<const uint8_t*>(pattern);
+        for (size_t i = from; i < n_ && len <= n_ - i;) {
+            const void* hit = std::memchr(p_ + i, needle[0], n_ - i - len + 1);
+            if (hit == nullptr) break;
+            i = static_cast<size_t>(static_cast<const uint8_t*>(hit) - p_);
+            if (std::memcmp(p_ + i, needle, len) == 0) return i;
+            ++i;
+        }
+        return npos;
+    }
+    size_t find_u8(uint8_t value, size_t from = 0) const { return find_bytes(&value, 1, from); }
+    size_t find_u16(uint16_t value, size_t from = 0) const { uint8_t b[2]; Codec::StoreU16(b, value); return find_bytes(b, 2, from); }
+    size_t find_u32(uint32_t value, size_t from = 0) const { uint8_t b[4]; Codec::StoreU32(b, value); return find_bytes(b, 4, from); }
+    size_t find_u64(uint64_t value, size_t from = 0) const { uint8_t b[8]; Codec::StoreU64(b, value); return find_bytes(b, 8, from); }
 private:
+    template <typename T>
+    BIO_CONSTEXPR20 Status read_array(T* out, size_t count) {
+        if (count > n_ / sizeof(T)) return Status::OutOfRange(position());
+        load_elems(p_, out, count);
+        p_ += count * sizeof(T);
+        n_ -= count * sizeof(T);
+        return Status::Ok();
+    }
+    template <typename> friend class ChunkedReaderT;
+    template <typename T>
+    static BIO_CONSTEXPR20 void load_elems(const uint8_t* p, T* out, size_t count) {
+        for (size_t i = 0; i < count; ++i, p += sizeof(T)) {
+            if constexpr (sizeof(T) == 1) {
+                out[i] = detail::BitCast<T>(*p);
+            } else if constexpr (sizeof(T) == 2) {
+                out[i] = detail::BitCast<T>(Codec::LoadU16(p));
+            } else if constexpr (sizeof(T) == 4) {
+                out[i] = detail::BitCast<T>(Codec::LoadU32(p));
+            } else {
+                out[i] = detail::BitCast<T>(Codec::LoadU64(p));
+            }
+        }
+    }
+
     const uint8_t* p_;
     size_t n_;
     size_t size_;
 };
 
 /// Byte writer that serializes primitives into a fixed-size buffer.
+/// One contiguous piece of a non-contiguous input.
+struct ByteSegment {
+    const void* data;
+    size_t size;
+};
+
+/// Reader over a list of segments (ring-buffer halves, DMA chains). Reads
+/// inside one segment take the fast path; values that straddle a boundary
+/// are stitched through a stack buffer.
 template <typename Codec>
+class ChunkedReaderT {
+public:
+    using codec_type = Codec;
+
+    ChunkedReaderT(const ByteSegment* segments, size_t count) : segments_(segments), count_(count) {
+        for (size_t i = 0; i < count; ++i) size_ += segments[i].size;
+        if (count != 0) {
+            p_ = static_cast<const uint8_t*>(segments[0].data);
+            n_ = segments[0].size;
+        }
+        rest_ = size_ - n_;
+    }
+
+    size_t remaining() const { return n_ + rest_; }
+    size_t position() const { return size_ - remaining(); }
+
+    Status read_u8(uint8_t& out) { return read_one(out); }
+    Status read_u16(uint16_t& out) { return read_one(out); }
+    Status read_u32(uint32_t& out) { return read_one(out); }
+    Status read_u64(uint64_t& out) { return read_one(out); }
+    Status read_i8(int8_t& out) { return read_one(out); }
+    Status read_i16(int16_t& out) { return read_one(out); }
+    Status read_i32(int32_t& out) { return read_one(out); }
+    Status read_i64(int64_t& out) { return read_one(out); }
+    Status read_f32(float& out) { return read_one(out); }
+    Status read_f64(double& out) { return read_one(out); }
+    Status read_varuint(uint64_t& out) {
+        size_t len = VarintCodec::decode(p_, n_, out);
+        if (len == 0 && n_ < VarintCodec::kMaxBytes && rest_ != 0) {
+            uint8_t tmp[VarintCodec::kMaxBytes];
+            const size_t avail = remaining() < sizeof(tmp) ? remaining() : sizeof(tmp);
+            ChunkedReaderT at = *this;
+            at.gather(tmp, avail);
+            len = VarintCodec::decode(tmp, avail, out);
+        }
+        if (len == 0) return Status::OutOfRange(position());
+        advance(len);
+        return Status::Ok();
+    }
+    Status read_varint(int64_t& out) {
+        uint64_t bits = 0;
+        if (!read_varuint(bits)) return Status::OutOfRange(position());
+        out = VarintCodec::unzigzag(bits);
+        return Status::Ok();
+    }
+    Status read_u8_array(uint8_t* out, size_t count) { return read_array(out, count); }
+    Status read_u16_array(uint16_t* out, size_t count) { return read_array(out, count); }
+    Status read_u32_array(uint32_t* out, size_t count) { return read_array(out, count); }
+    Status read_u64_array(uint64_t* out, size_t count) { return read_array(out, count); }
+    Status read_i8_array(int8_t* out, size_t count) { return read_array(out, count); }
+    Status read_i16_array(int16_t* out, size_t count) { return read_array(out, count); }
+    Status read_i32_array(int32_t* out, size_t count) { return read_array(out, count); }
+    Status read_i64_array(int64_t* out, size_t count) { return read_array(out, count); }
+    Status read_f32_array(float* out, size_t count) { return read_array(out, count); }
+    Status read_f64_array(double* out, size_t count) { return read_array(out, count); }
+    Status read_bytes(void* out, size_t len) {
+        if (len > remaining()) return Status::OutOfRange(position());
+        gather(static_cast<uint8_t*>(out), len);
+        return Status::Ok();
+    }
+    Status skip(size_t len) {
+        if (len > remaining()) return Status::OutOfRange(position());
+        advance(len);
+        return Status::Ok();
+    }
+    // Lookahead and repositioning without copying the reader.
+    Status peek_u8(uint8_t& out, size_t offset = 0) const {
+        if (1 > remaining() || offset > remaining() - 1) return Status::OutOfRange(position());
+        out = load_u8_at(offset);
+        return Status::Ok();
+    }
+    Status peek_u16(uint16_t& out, size_t offset = 0) const {
+        if (2 > remaining() || offset > remaining() - 2) return Status::OutOfRange(position());
+        out = load_u16_at(offset);
+        return Status::Ok();
+    }
+    Status peek_u32(uint32_t& out, size_t offset = 0) const {
+        if (4 > remaining() || offset > remaining() - 4) return Status::OutOfRange(position());
+        out = load_u32_at(offset);
+        return Status::Ok();
+    }
+    Status peek_u64(uint64_t& out, size_t offset = 0) const {
+        if (8 > remaining() || offset > remaining() - 8) return Status::OutOfRange(position());
+        out = load_u64_at(offset);
+        return Status::Ok();
+    }
+    Status peek_i8(int8_t& out, size_t offset = 0) const {
+        if (1 > remaining() || offset > remaining() - 1) return Status::OutOfRange(position());
+        out = load_i8_at(offset);
+        return Status::Ok();
+    }
+    Status peek_i16(int16_t& out, size_t offset = 0) const {
+        if (2 > remaining() || offset > remaining() - 2) return Status::OutOfRange(position());
+        out = load_i16_at(offset);
+        return Status::Ok();
+    }
+    Status peek_i32(int32_t& out, size_t offset = 0) const {
+        if (4 > remaining() || offset > remaining() - 4) return Status::OutOfRange(position());
+        out = load_i32_at(offset);
+        return Status::Ok();
+    }
+    Status peek_i64(int64_t& out, size_t offset = 0) const {
+        if (8 > remaining() || offset > remaining() - 8) return Status::OutOfRange(position());
+        out = load_i64_at(offset);
+        return Status::Ok();
+    }
+    class Checkpoint {
+        friend class ChunkedReaderT;
+        Checkpoint(size_t index, const uint8_t* p, size_t n, size_t rest) : index_(index), p_(p), n_(n), rest_(rest) {}
+        size_t index_;
+        const uint8_t* p_;
+        size_t n_;
+        size_t rest_;
+    };
+    Checkpoint checkpoint() const { return Checkpoint(index_, p_, n_, rest_); }
+    void rewind(Checkpoint saved) { index_ = saved.index_; p_ = saved.p_; n_ = saved.n_; rest_ = saved.rest_; }
+    Status seek(size_t pos) {
+        if (pos > size_) return Status::OutOfRange(position());
+        index_ = 0;
+        p_ = count_ != 0 ? static_cast<const uint8_t*>(segments_[0].data) : nullptr;
+        n_ = count_ != 0 ? segments_[0].size : 0;
+        rest_ = size_ - n_;
+        advance(pos);
+        return Status::Ok();
+    }
+    Status ensure(size_t len) const {
+        if (len > remaining()) return Status::OutOfRange(position());
+        return Status::Ok();
+    }
+    void advance(size_t len) {
+        while (len > n_) {
+            len -= n_;
+            next_segment();
+        }
+        p_ += len;
+        n_ -= len;
+    }
+    uint8_t load_u8_at(size_t offset) const { uint8_t v; load_array_at(offset, &v, 1); return v; }
+    uint16_t load_u16_at(size_t offset) const { uint16_t v; load_array_at(offset, &v, 1); return v; }
+    uint32_t load_u32_at(size_t offset) const { uint32_t v; load_array_at(offset, &v, 1); return v; }
+    uint64_t load_u64_at(size_t offset) const { uint64_t v; load_array_at(offset, &v, 1); return v; }
+    int8_t load_i8_at(size_t offset) const { int8_t v; load_array_at(offset, &v, 1); return v; }
+    int16_t load_i16_at(size_t offset) const { int16_t v; load_array_at(offset, &v, 1); return v; }
+    int32_t load_i32_at(size_t offset) const { int32_t v; load_array_at(offset, &v, 1); return v; }
+    int64_t load_i64_at(size_t offset) const { int64_t v; load_array_at(offset, &v, 1); return v; }
+    float load_f32_at(size_t offset) const { float v; load_array_at(offset, &v, 1); return v; }
+    double load_f64_at(size_t offset) const { double v; load_array_at(offset, &v, 1); return v; }
+    void load_bytes_at(size_t offset, void* out, size_t len) const {
+        ChunkedReaderT at = *this;
+        at.advance(offset);
+        at.gather(static_cast<uint8_t*>(out), len);
+    }
+    void load_u16_array_at(size_t offset, uint16_t* out, size_t count) const { load_array_at(offset, out, count); }
+    void load_u32_array_at(size_t offset, uint32_t* out, size_t count) const { load_array_at(offset, out, count); }
+    void load_u64_array_at(size_t offset, uint64_t* out, size_t count) const { load_array_at(offset, out, count); }
+    void load_i16_array_at(size_t offset, int16_t* out, size_t count) const { load_array_at(offset, out, count); }
+    void load_i32_array_at(size_t offset, int32_t* out, size_t count) const { load_array_at(offset, out, count); }
+    void load_i64_array_at(size_t offset, int64_t* out, size_t count) const { load_array_at(offset, out, count); }
+    void load_f32_array_at(size_t offset, float* out, size_t count) const { load_array_at(offset, out, count); }
+    void load_f64_array_at(size_t offset, double* out, size_t count) const { load_array_at(offset, out, count); }
+
+private:
+    template <typename T>
+    Status read_one(T& out) {
+        if (sizeof(T) <= n_) {
+            ByteReaderT<Codec>::load_elems(p_, &out, 1);
+            p_ += sizeof(T);
+            n_ -= sizeof(T);
+            return Status::Ok();
+        }
+        if (sizeof(T) > remaining()) return Status::OutOfRange(position());
+        uint8_t tmp[sizeof(T)];
+        gather(tmp, sizeof(T));
+        ByteReaderT<Codec>::load_elems(tmp, &out, 1);
+        return Status::Ok();
+    }
+    template <typename T>
+    Status read_array(T* out, size_t count) {
+        if (count > remaining() / sizeof(T)) return Status::OutOfRange(position());
+        while (count != 0) {
+            const size_t run = n_ / sizeof(T) < count ? n_ / sizeof(T) : count;
+            if (run != 0) {
+                ByteReaderT<Codec>::load_elems(p_, out, run);
+                p_ += run * sizeof(T);
+                n_ -= run * sizeof(T);
+                out += run;
+                count -= run;
+            } else {
+                uint8_t tmp[sizeof(T)];
+                gather(tmp, sizeof(T));
+                ByteReaderT<Codec>::load_elems(tmp, out, 1);
+                ++out;
+                --count;
+            }
+        }
+        return Status::Ok();
+    }
+    template <typename T>
+    void load_array_at(size_t offset, T* out, size_t count) const {
+        if (offset + count * sizeof(T) <= n_) {
+            ByteReaderT<Codec>::load_elems(p_ + offset, out, count);
+            return;
+        }
+        ChunkedReaderT at = *this;
+        at.advance(offset);
+        static_cast<void>(at.read_array(out, count));
+    }
+    void gather(uint8_t* out, size_t len) {
+        while (len > n_) {
+            if (n_ != 0) std::memcpy(out, p_, n_);
+            out += n_;
+            len -= n_;
+            next_segment();
+        }
+        if (len != 0) std::memcpy(out, p_, len);
+        p_ += len;
+        n_ -= len;
+    }
+    void next_segment() {
+        ++index_;
+        p_ = static_cast<const uint8_t*>(segments_[index_].data);
+        n_ = segments_[index_].size;
+        rest_ -= n_;
+    }
+
+    const ByteSegment* segments_;
+    size_t count_;
+    size_t index_ = 0;
+    const uint8_t* p_ = nullptr;
+    size_t n_ = 0;
+    size_t rest_ = 0;
+    size_t size_ = 0;
+};
+
+template <typename Codec, typename Instrument = NoInstrument>
 class ByteWriterT {
 public:
+    using codec_type = Codec;
+    using instrument_type = Instrument;
+
     ByteWriterT(void* data, size_t size)
         : p_(static_cast<uint8_t*>(data)), n_(size), size_(size) {}
+    template <typename Byte, typename = std::enable_if_t<std::is_same_v<Byte, uint8_t>>>
+    BIO_CONSTEXPR20 ByteWriterT(Byte* data, size_t size) : p_(data), n_(size), size_(size) {}
+    // Copies share the buffer but never grow it.
+    BIO_CONSTEXPR20 ByteWriterT(const ByteWriterT& o) : p_(o.p_), n_(o.n_), size_(o.size_) {}
+    BIO_CONSTEXPR20 ByteWriterT& operator=(const ByteWriterT& o) { p_ = o.p_; n_ = o.n_; size_ = o.size_; grow_ = nullptr; return *this; }
 
-    size_t remaining() const { return n_; }
-    size_t position() const { return size_ - n_; }
+    BIO_CONSTEXPR20 size_t remaining() const { return n_; }
+    BIO_CONSTEXPR20 size_t position() const { return size_ - n_; }
 
-    Status write_u8(uint8_t v) {
-        if (1 > n_) return Status::OutOfRange();
+    BIO_CONSTEXPR20 Status write_u8(uint8_t v) {
+        if (1 > n_ && !grow(1)) return Status::OutOfRange(position());
         *p_++ = v;
         --n_;
         return Status::Ok();
     }
-    Status write_u16(uint16_t v) {
-        if (sizeof(uint16_t) > n_) return Status::OutOfRange();
+    BIO_CONSTEXPR20 Status write_u16(uint16_t v) {
+        if (sizeof(uint16_t) > n_ && !grow(sizeof(uint16_t))) return Status::OutOfRange(position());
         Codec::StoreU16(p_, v);
         p_ += sizeof(uint16_t);
         n_ -= sizeof(uint16_t);
         return Status::Ok();
     }
-    Status write_u32(uint32_t v) {
-        if (sizeof(uint32_t) > n_) return Status::OutOfRange();
+    BIO_CONSTEXPR20 Status write_u32(uint32_t v) {
+        if (sizeof(uint32_t) > n_ && !grow(sizeof(uint32_t))) return Status::OutOfRange(position());
         Codec::StoreU32(p_, v);
         p_ += sizeof(uint32_t);
         n_ -= sizeof(uint32_t);
         return Status::Ok();
     }
-    Status write_u64(uint64_t v) {
-        if (sizeof(uint64_t) > n_) return Status::OutOfRange();
+    BIO_CONSTEXPR20 Status write_u64(uint64_t v) {
+        if (sizeof(uint64_t) > n_ && !grow(sizeof(uint64_t))) return Status::OutOfRange(position());
         Codec::StoreU64(p_, v);
         p_ += sizeof(uint64_t);
         n_ -= sizeof(uint64_t);
         return Status::Ok();
     }
-    Status write_i8(int8_t v) {
-        uint8_t bits = 0;
-        std::memcpy(&bits, &v, sizeof(bits));
+    BIO_CONSTEXPR20 Status write_i8(int8_t v) {
+        const auto bits = detail::BitCast<uint8_t>(v);
         return write_u8(bits);
     }
-    Status write_i16(int16_t v) {
-        uint16_t bits = 0;
-        std::memcpy(&bits, &v, sizeof(bits));
+    BIO_CONSTEXPR20 Status write_i16(int16_t v) {
+        const auto bits = detail::BitCast<uint16_t>(v);
         return write_u16(bits);
     }
-    Status write_i32(int32_t v) {
-        uint32_t bits = 0;
-        std::memcpy(&bits, &v, sizeof(bits));
+    BIO_CONSTEXPR20 Status write_i32(int32_t v) {
+        const auto bits = detail::BitCast<uint32_t>(v);
         return write_u32(bits);
     }
-    Status write_i64(int64_t v) {
-        uint64_t bits = 0;
-        std::memcpy(&bits, &v, sizeof(bits));
+    BIO_CONSTEXPR20 Status write_i64(int64_t v) {
+        const auto bits = detail::BitCast<uint64_t>(v);
         return write_u64(bits);
     }
-    Status write_f32(float v) {
+    BIO_CONSTEXPR20 Status write_f32(float v) {
         static_assert(sizeof(float) == 4, "float must be 32-bit");
-        uint32_t bits = 0;
-        std::memcpy(&bits, &v, sizeof(bits));
+        const auto bits = detail::BitCast<uint32_t>(v);
         return write_u32(bits);
     }
-    Status write_f64(double v) {
+    BIO_CONSTEXPR20 Status write_f64(double v) {
         static_assert(sizeof(double) == 8, "double must be 64-bit");
-        uint64_t bits = 0;
-        std::memcpy(&bits, &v, sizeof(bits));
+        const auto bits = detail::BitCast<uint64_t>(v);
         return write_u64(bits);
     }
-    Status write_bytes(const void* in, size_t len) {
-        if (len > n_) return Status::OutOfRange();
-        std::memcpy(p_, in, len);
+    BIO_CONSTEXPR20 Status write_varuint(uint64_t v) {
+        if (n_ < VarintCodec::kMaxBytes) {
+            const size_t len = VarintCodec::size(v);
+            if (len > n_ && !grow(len)) return Status::OutOfRange(position());
+        }
+        const size_t len = VarintCodec::encode(p_, v);
         p_ += len;
         n_ -= len;
         return Status::Ok();
     }
-    Status skip(size_t len) {
-        if (len > n_) return Status::OutOfRange();
+    BIO_CONSTEXPR20 Status write_varint(int64_t v) { return write_varuint(VarintCodec::zigzag(v)); }
+    BIO_CONSTEXPR20 Status write_u8_array(const uint8_t* in, size_t count) { return write_bytes(in, count); }
+    BIO_CONSTEXPR20 Status write_i8_array(const int8_t* in, size_t count) { return write_bytes(in, count); }
+    BIO_CONSTEXPR20 Status write_u16_array(const uint16_t* in, size_t count) { return write_array(in, count); }
+    BIO_CONSTEXPR20 Status write_i16_array(const int16_t* in, size_t count) { return write_array(in, count); }
+    BIO_CONSTEXPR20 Status write_u32_array(const uint32_t* in, size_t count) { return write_array(in, count); }
+    BIO_CONSTEXPR20 Status write_i32_array(const int32_t* in, size_t count) { return write_array(in, count); }
+    BIO_CONSTEXPR20 Status write_u64_array(const uint64_t* in, size_t count) { return write_array(in, count); }
+    BIO_CONSTEXPR20 Status write_i64_array(const int64_t* in, size_t count) { return write_array(in, count); }
+    BIO_CONSTEXPR20 Status write_f32_array(const float* in, size_t count) { return write_array(in, count); }
+    BIO_CONSTEXPR20 Status write_f64_array(const double* in, size_t count) { return write_array(in, count); }
+    Status write_bytes(const void* in, size_t len) { return write_bytes(static_cast<const uint8_t*>(in), len); }
+    template <typename Byte, typename = std::enable_if_t<detail::kIsByte<Byte>>>
+    BIO_CONSTEXPR20 Status write_bytes(const Byte* in, size_t len) {
+        if (len > n_ && !grow(len)) return Status::OutOfRange(position());
+        detail::CopyBytes(p_, in, len);
+        p_ += len;
+        n_ -= len;
+        return Status::Ok();
+    }
+    BIO_CONSTEXPR20 Status skip(size_t len) {
+        if (len > n_ && !grow(len)) return Status::OutOfRange(position());
         p_ += len;
         n_ -= len;
         return Status::Ok();
     }
+    // Unchecked access relative to the cursor: ensure() once, load/store
+    // at constant offsets, then advance() past the record.
+    BIO_CONSTEXPR20 Status ensure(size_t len) {
+        if (len > n_ && !grow(len)) return Status::OutOfRange(position());
+        return Status::Ok();
+    }
+    BIO_CONSTEXPR20 void advance(size_t len) {
+        p_ += len;
+        n_ -= len;
+    }
+    BIO_CONSTEXPR20 void store_u8_at(size_t offset, uint8_t v) { store_elems(p_ + offset, &v, 1); }
+    BIO_CONSTEXPR20 void store_u16_at(size_t offset, uint16_t v) { store_elems(p_ + offset, &v, 1); }
+    BIO_CONSTEXPR20 void store_u32_at(size_t offset, uint32_t v) { store_elems(p_ + offset, &v, 1); }
+    BIO_CONSTEXPR20 void store_u64_at(size_t offset, uint64_t v) { store_elems(p_ + offset, &v, 1); }
+    BIO_CONSTEXPR20 void store_i8_at(size_t offset, int8_t v) { store_elems(p_ + offset, &v, 1); }
+    BIO_CONSTEXPR20 void store_i16_at(size_t offset, int16_t v) { store_elems(p_ + offset, &v, 1); }
+    BIO_CONSTEXPR20 void store_i32_at(size_t offset, int32_t v) { store_elems(p_ + offset, &v, 1); }
+    BIO_CONSTEXPR20 void store_i64_at(size_t offset, int64_t v) { store_elems(p_ + offset, &v, 1); }
+    BIO_CONSTEXPR20 void store_f32_at(size_t offset, float v) { store_elems(p_ + offset, &v, 1); }
+    BIO_CONSTEXPR20 void store_f64_at(size_t offset, double v) { store_elems(p_ + offset, &v, 1); }
+    void store_bytes_at(size_t offset, const void* in, size_t len) { std::memcpy(p_ + offset, in, len); }
+    template <typename Byte, typename = std::enable_if_t<detail::kIsByte<Byte>>>
+    BIO_CONSTEXPR20 void store_bytes_at(size_t offset, const Byte* in, size_t len) { detail::CopyBytes(p_ + offset, in, len); }
+    BIO_CONSTEXPR20 void store_u16_array_at(size_t offset, const uint16_t* in, size_t count) { store_elems(p_ + offset, in, count); }
+    BIO_CONSTEXPR20 void store_u32_array_at(size_t offset, const uint32_t* in, size_t count) { store_elems(p_ + offset, in, count); }
+    BIO_CONSTEXPR20 void store_u64_array_at(size_t offset, const uint64_t* in, size_t count) { store_elems(p_ + offset, in, count); }
+    BIO_CONSTEXPR20 void store_i16_array_at(size_t offset, const int16_t* in, size_t count) { store_elems(p_ + offset, in, count); }
+    BIO_CONSTEXPR20 void store_i32_array_at(size_t offset, const int32_t* in, size_t count) { store_elems(p_ + offset, in, count); }
+    BIO_CONSTEXPR20 void store_i64_array_at(size_t offset, const int64_t* in, size_t count) { store_elems(p_ + offset, in, count); }
+    BIO_CONSTEXPR20 void store_f32_array_at(size_t offset, const float* in, size_t count) { store_elems(p_ + offset, in, count); }
+    BIO_CONSTEXPR20 void store_f64_array_at(size_t offset, const double* in, size_t count) { store_elems(p_ + offset, in, count); }
+
+protected:
+    using GrowFn = bool (*)(ByteWriterT& writer, size_t len);
+    ByteWriterT(void* data, size_t size, GrowFn grow_fn)
+        : p_(static_cast<uint8_t*>(data)), n_(size), size_(size), grow_(grow_fn) {}
+    BIO_CONSTEXPR20 void rebind(uint8_t* data, size_t size) {
+        const size_t pos = position();
+        p_ = data + pos;
+        n_ = size - pos;
+        size_ = size;
+    }
+    BIO_CONSTEXPR20 void rewind() {
+        p_ -= position();
+        n_ = size_;
+    }
 
 private:
+    BIO_CONSTEXPR20 bool grow(size_t len) { return grow_ != nullptr && grow_(*this, len); }
+    template <typename T>
+    BIO_CONSTEXPR20 Status write_array(const T* in, size_t count) {
+        if (count > n_ / sizeof(T) && (count > SIZE_MAX / sizeof(T) || !grow(count * sizeof(T)))) return Status::OutOfRange(position());
+        store_elems(p_, in, count);
+        p_ += count * sizeof(T);
+        n_ -= count * sizeof(T);
+        return Status::Ok();
+    }
+    template <typename T>
+    static BIO_CONSTEXPR20 void store_elems(uint8_t* p, const T* in, size_t count) {
+        for (size_t i = 0; i < count; ++i, p += sizeof(T)) {
+            if constexpr (sizeof(T) == 1) {
+                *p = detail::BitCast<uint8_t>(in[i]);
+            } else if constexpr (sizeof(T) == 2) {
+                Codec::StoreU16(p, detail::BitCast<uint16_t>(in[i]));
+            } else if constexpr (sizeof(T) == 4) {
+                Codec::StoreU32(p, detail::BitCast<uint32_t>(in[i]));
+            } else {
+                Codec::StoreU64(p, detail::BitCast<uint64_t>(in[i]));
+            }
+        }
+    }
+
     uint8_t* p_;
     size_t n_;
     size_t size_;
+    GrowFn grow_ = nullptr;
+};
+
+/// Measure-only writer: same interface as ByteWriterT, stores nothing and
+/// only counts bytes.
+template <typename Codec>
+class SizeCounterT {
+public:
+    using codec_type = Codec;
+
+    BIO_CONSTEXPR20 size_t size() const { return n_; }
+    BIO_CONSTEXPR20 size_t position() const { return n_; }
+    BIO_CONSTEXPR20 size_t remaining() const { return SIZE_MAX - n_; }
+    BIO_CONSTEXPR20 void clear() { n_ = 0; }
+
+    BIO_CONSTEXPR20 Status write_u8(uint8_t) { return add(1); }
+    BIO_CONSTEXPR20 Status write_u16(uint16_t) { return add(2); }
+    BIO_CONSTEXPR20 Status write_u32(uint32_t) { return add(4); }
+    BIO_CONSTEXPR20 Status write_u64(uint64_t) { return add(8); }
+    BIO_CONSTEXPR20 Status write_i8(int8_t) { return add(1); }
+    BIO_CONSTEXPR20 Status write_i16(int16_t) { return add(2); }
+    BIO_CONSTEXPR20 Status write_i32(int32_t) { return add(4); }
+    BIO_CONSTEXPR20 Status write_i64(int64_t) { return add(8); }
+    BIO_CONSTEXPR20 Status write_f32(float) { return add(4); }
+    BIO_CONSTEXPR20 Status write_f64(double) { return add(8); }
+    BIO_CONSTEXPR20 Status write_varuint(uint64_t v) { return add(VarintCodec::size(v)); }
+    BIO_CONSTEXPR20 Status write_varint(int64_t v) { return add(VarintCodec::size(VarintCodec::zigzag(v))); }
+    BIO_CONSTEXPR20 Status write_u8_array(const uint8_t*, size_t count) { return add(count * 1); }
+    BIO_CONSTEXPR20 Status write_u16_array(const uint16_t*, size_t count) { return add(count * 2); }
+    BIO_CONSTEXPR20 Status write_u32_array(const uint32_t*, size_t count) { return add(count * 4); }
+    BIO_CONSTEXPR20 Status write_u64_array(const uint64_t*, size_t count) { return add(count * 8); }
+    BIO_CONSTEXPR20 Status write_i8_array(const int8_t*, size_t count) { return add(count * 1); }
+    BIO_CONSTEXPR20 Status write_i16_array(const int16_t*, size_t count) { return add(count * 2); }
+    BIO_CONSTEXPR20 Status write_i32_array(const int32_t*, size_t count) { return add(count * 4); }
+    BIO_CONSTEXPR20 Status write_i64_array(const int64_t*, size_t count) { return add(count * 8); }
+    BIO_CONSTEXPR20 Status write_f32_array(const float*, size_t count) { return add(count * 4); }
+    BIO_CONSTEXPR20 Status write_f64_array(const double*, size_t count) { return add(count * 8); }
+    BIO_CONSTEXPR20 Status write_bytes(const void*, size_t len) { return add(len); }
+    BIO_CONSTEXPR20 Status skip(size_t len) { return add(len); }
+    BIO_CONSTEXPR20 Status ensure(size_t) { return Status::Ok(); }
+    BIO_CONSTEXPR20 void advance(size_t len) { n_ += len; }
+    BIO_CONSTEXPR20 void store_u8_at(size_t, uint8_t) {}
+    BIO_CONSTEXPR20 void store_u16_at(size_t, uint16_t) {}
+    BIO_CONSTEXPR20 void store_u32_at(size_t, uint32_t) {}
+    BIO_CONSTEXPR20 void store_u64_at(size_t, uint64_t) {}
+    BIO_CONSTEXPR20 void store_i8_at(size_t, int8_t) {}
+    BIO_CONSTEXPR20 void store_i16_at(size_t, int16_t) {}
+    BIO_CONSTEXPR20 void store_i32_at(size_t, int32_t) {}
+    BIO_CONSTEXPR20 void store_i64_at(size_t, int64_t) {}
+    BIO_CONSTEXPR20 void store_f32_at(size_t, float) {}
+    BIO_CONSTEXPR20 void store_f64_at(size_t, double) {}
+    BIO_CONSTEXPR20 void store_bytes_at(size_t, const void*, size_t) {}
+    BIO_CONSTEXPR20 void store_u16_array_at(size_t, const uint16_t*, size_t) {}
+    BIO_CONSTEXPR20 void store_u32_array_at(size_t, const uint32_t*, size_t) {}
+    BIO_CONSTEXPR20 void store_u64_array_at(size_t, const uint64_t*, size_t) {}
+    BIO_CONSTEXPR20 void store_i16_array_at(size_t, const int16_t*, size_t) {}
+    BIO_CONSTEXPR20 void store_i32_array_at(size_t, const int32_t*, size_t) {}
+    BIO_CONSTEXPR20 void store_i64_array_at(size_t, const int64_t*, size_t) {}
+    BIO_CONSTEXPR20 void store_f32_array_at(size_t, const float*, size_t) {}
+    BIO_CONSTEXPR20 void store_f64_array_at(size_t, const double*, size_t) {}
+
+private:
+    BIO_CONSTEXPR20 Status add(size_t len) {
+        n_ += len;
+        return Status::Ok();
+    }
+
+    size_t n_ = 0;
+};
+
+/// Writer that owns its buffer and grows it geometrically; usable wherever
+/// an LEWriter/BEWriter reference is expected.
+template <typename Codec, typename Allocator = std::allocator<uint8_t>>
+class DynamicByteWriterT : public ByteWriterT<Codec> {
+    using Base = ByteWriterT<Codec>;
+    using Traits = std::allocator_traits<Allocator>;
+
+public:
+    explicit DynamicByteWriterT(size_t initial_capacity = 0, const Allocator& alloc = Allocator())
+        : Base(nullptr, 0, &DynamicByteWriterT::grow_hook), alloc_(alloc) { reserve(initial_capacity); }
+    DynamicByteWriterT(const DynamicByteWriterT&) = delete;
+    DynamicByteWriterT& operator=(const DynamicByteWriterT&) = delete;
+    ~DynamicByteWriterT() { if (capacity_ != 0) Traits::deallocate(alloc_, data_, capacity_); }
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return this->position(); }
+    size_t capacity() const { return capacity_; }
+    void clear() { this->rewind(); }
+    void reserve(size_t capacity) {
+        if (capacity <= capacity_) return;
+        uint8_t* data = Traits::allocate(alloc_, capacity);
+        const size_t used = size();
+        if (used != 0) std::memcpy(data, data_, used);
+        std::memset(data + used, 0, capacity - used);
+        if (capacity_ != 0) Traits::deallocate(alloc_, data_, capacity_);
+        data_ = data;
+        capacity_ = capacity;
+        this->rebind(data_, capacity_);
+    }
+
+private:
+    static bool grow_hook(Base& base, size_t len) {
+        auto& self = static_cast<DynamicByteWriterT&>(base);
+        const size_t used = self.size();
+        if (len > SIZE_MAX - used) return false;
+        size_t capacity = self.capacity_ < 64 ? 64 : self.capacity_;
+        while (capacity < used + len) {
+            if (capacity > SIZE_MAX / 2) { capacity = used + len; break; }
+            capacity *= 2;
+        }
+        self.reserve(capacity);
+        return true;
+    }
+
+    Allocator alloc_;
+    uint8_t* data_ = nullptr;
+    size_t capacity_ = 0;
+};
+
+/// Bit-order policies for packed_bits fields.
+struct MsbFirst {};
+struct LsbFirst {};
+
+/// Unchecked reader for packed bit fields; the caller bounds the buffer.
+template <typename Order>
+class BitReaderT {
+    static constexpr bool kMsb = std::is_same_v<Order, MsbFirst>;
+
+public:
+    BitReaderT(const void* data, size_t size)
+        : p_(static_cast<const uint8_t*>(data)), end_(p_ + size) {}
+    template <typename Byte, typename = std::enable_if_t<std::is_same_v<Byte, uint8_t>>>
+    BIO_CONSTEXPR20 BitReaderT(const Byte* data, size_t size) : p_(data), end_(data + size) {}
+
+    BIO_CONSTEXPR20 uint64_t take_bits(unsigned width) {
+        if (width > 56) {
+            if constexpr (kMsb) {
+                const uint64_t hi = take_bits(width - 32);
+                return (hi << 32) | take_bits(32);
+            } else {
+                const uint64_t lo = take_bits(32);
+                return lo | (take_bits(width - 32) << 32);
+            }
+        }
+        if (width > bits_) refill();
+        uint64_t v;
+        if constexpr (kMsb) {
+            v = acc_ >> (64 - width);
+            acc_ <<= width;
+        } else {
+            v = acc_ & (~uint64_t{0} >> (64 - width));
+            acc_ >>= width;
+        }
+        bits_ -= width;
+        return v;
+    }
+
+private:
+    BIO_CONSTEXPR20 void refill() {
+        if (end_ - p_ >= 8) {
+            if constexpr (kMsb) acc_ |= BigEndianCodec::LoadU64(p_) >> bits_;
+            else acc_ |= LittleEndianCodec::LoadU64(p_) << bits_;
+            p_ += (63 - bits_) >> 3;
+            bits_ |= 56;
+            return;
+        }
+        for (; bits_ <= 56 && p_ != end_; bits_ += 8) {
+            if constexpr (kMsb) acc_ |= static_cast<uint64_t>(*p_++) << (56 - bits_);
+            else acc_ |= static_cast<uint64_t>(*p_++) << bits_;
+        }
+    }
+
+    const uint8_t* p_;
+    const uint8_t* end_;
+    uint64_t acc_ = 0;
+    unsigned bits_ = 0;
+};
+
+/// Unchecked writer for packed bit fields; call flush() after the last one.
+template <typename Order>
+class BitWriterT {
+    static constexpr bool kMsb = std::is_same_v<Order, MsbFirst>;
+
+public:
+    BitWriterT(void* data, size_t /*size*/) : p_(static_cast<uint8_t*>(data)) {}
+    template <typename Byte, typename = std::enable_if_t<std::is_same_v<Byte, uint8_t>>>
+    BIO_CONSTEXPR20 BitWriterT(Byte* data, size_t /*size*/) : p_(data) {}
+
+    BIO_CONSTEXPR20 void put_bits(unsigned width, uint64_t value) {
+        if (width > 56) {
+            if constexpr (kMsb) {
+                put_bits(width - 32, value >> 32);
+                put_bits(32, value);
+            } else {
+                put_bits(32, value);
+                put_bits(width - 32, value >> 32);
+            }
+            return;
+        }
+        value &= ~uint64_t{0} >> (64 - width);
+        if (bits_ + width > 64) drain();
+        if constexpr (kMsb) acc_ |= value << (64 - bits_ - width);
+        else acc_ |= value << bits_;
+        bits_ += width;
+    }
+    BIO_CONSTEXPR20 void flush() {
+        bits_ = (bits_ + 7) & ~7u;
+        drain();
+    }
+
+private:
+    BIO_CONSTEXPR20 void drain() {
+        for (; bits_ >= 8; bits_ -= 8) {
+            if constexpr (kMsb) { *p_++ = static_cast<uint8_t>(acc_ >> 56); acc_ <<= 8; }
+            else { *p_++ = static_cast<uint8_t>(acc_); acc_ >>= 8; }
+        }
+    }
+
+    uint8_t* p_;
+    uint64_t acc_ = 0;
+    unsigned bits_ = 0;
+};
+
+/// Delta and frame-of-reference coding for `encoding:` array fields:
+/// a raw reference value, a u8 bit width, then the values packed LSB first
+/// in blocks of 64 (zigzag deltas, or offsets from the minimum).
+struct ArrayCodec {
+    static constexpr size_t kBlock = 64;
+
+    static constexpr size_t bytes(size_t n, unsigned width) { return (n * width + 7) / 8; }
+    static constexpr unsigned width(uint64_t all) {
+        unsigned w = 0;
+        for (; all != 0; all >>= 1) ++w;
+        return w;
+    }
+    template <typename U>
+    static constexpr U zigzag(U d) {
+        return static_cast<U>(static_cast<U>(d << 1) ^ static_cast<U>(0 - (d >> (8 * sizeof(U) - 1))));
+    }
+    template <typename U>
+    static constexpr U unzigzag(U z) { return static_cast<U>(static_cast<U>(z >> 1) ^ static_cast<U>(0 - (z & 1))); }
+    template <typename Writer, typename U>
+    static BIO_CONSTEXPR20 Status put(Writer& writer, U v) {
+        if constexpr (sizeof(U) == 1) return writer.write_u8(v);
+        else if constexpr (sizeof(U) == 2) return writer.write_u16(v);
+        else if constexpr (sizeof(U) == 4) return writer.write_u32(v);
+        else return writer.write_u64(v);
+    }
+    template <typename Reader, typename U>
+    static BIO_CONSTEXPR20 Status get(Reader& reader, U& v) {
+        if constexpr (sizeof(U) == 1) return reader.read_u8(v);
+        else if constexpr (sizeof(U) == 2) return reader.read_u16(v);
+        else if constexpr (sizeof(U) == 4) return reader.read_u32(v);
+        else return reader.read_u64(v);
+    }
+    // Writes the reference, the width and value(0) ... value(n - 1).
+    template <typename Writer, typename U, typename Value>
+    static BIO_CONSTEXPR20 Status write(Writer& writer, U ref, unsigned width, size_t n, Value value) {
+        Status s = put(writer, ref);
+        if (!s) return s;
+        s = writer.write_u8(static_cast<uint8_t>(width));
+        if (!s || width == 0) return s;
+        uint8_t packed[kBlock * 8];
+        for (size_t i = 0; i < n; i += kBlock) {
+            const size_t m = n - i < kBlock ? n - i : kBlock;
+            uint8_t* out = packed;
+            uint64_t acc = 0;
+            unsigned bits = 0;
+            for (size_t j = 0; j < m; ++j) {
+                const auto v = static_cast<uint64_t>(value(i + j));
+                acc |= v << bits;
+                bits += width;
+                if (bits >= 64) {
+                    LittleEndianCodec::StoreU64(out, acc);
+                    out += 8;
+                    bits -= 64;
+                    acc = bits == 0 ? 0 : v >> (width - bits);
+                }
+            }
+            for (; bits > 0; bits = bits > 8 ? bits - 8 : 0) { *out++ = static_cast<uint8_t>(acc); acc >>= 8; }
+            s = writer.write_bytes(packed, bytes(m, width));
+            if (!s) return s;
+        }
+        return Status::Ok();
+    }
+    template <typename Reader, typename U>
+    static BIO_CONSTEXPR20 Status header(Reader& reader, U& ref, unsigned& width) {
+        uint8_t w = 0;
+        Status s = get(reader, ref);
+        if (!s) return s;
+        s = reader.read_u8(w);
+        if (!s) return s;
+        if (w > 8 * sizeof(U)) return Status::OutOfRange(reader.position() - 1);
+        width = w;
+        return Status::Ok();
+    }
+    // Reads n values after the header, calling take(i, value) in order.
+    template <typename U, typename Reader, typename Take>
+    static BIO_CONSTEXPR20 Status read(Reader& reader, unsigned width, size_t n, Take take) {
+        if (width == 0) {
+            for (size_t i = 0; i < n; ++i) take(i, U{0});
+            return Status::Ok();
+        }
+        const uint64_t mask = ~uint64_t{0} >> (64 - width);
+        uint8_t packed[kBlock * 8 + 16] = {};
+        for (size_t i = 0; i < n; i += kBlock) {
+            const size_t m = n - i < kBlock ? n - i : kBlock;
+            const Status s = reader.read_bytes(packed, bytes(m, width));
+            if (!s) return s;
+            for (size_t j = 0; j < m; ++j) {
+                const size_t bit = j * width;
+                const unsigned shift = bit % 8;
+                uint64_t v = LittleEndianCodec::LoadU64(packed + bit / 8) >> shift;
+                if (width > 56 && shift != 0) v |= static_cast<uint64_t>(packed[bit / 8 + 8]) << (64 - shift);
+                take(i + j, static_cast<U>(v & mask));
+            }
+        }
+        return Status::Ok();
+    }
+};
+
+template <typename Writer, typename T>
+BIO_CONSTEXPR20 Status write_delta_array(Writer& writer, const T* in, size_t n) {
+    using U = std::make_unsigned_t<T>;
+    if (n == 0) return Status::Ok();
+    const auto delta = [in](size_t i) {
+        return ArrayCodec::zigzag(static_cast<U>(static_cast<U>(in[i + 1]) - static_cast<U>(in[i])));
+    };
+    U all = 0;
+    for (size_t i = 0; i + 1 < n; ++i) all |= delta(i);
+    return ArrayCodec::write(writer, static_cast<U>(in[0]), ArrayCodec::width(all), n - 1, delta);
+}
+
+template <typename Reader, typename T>
+BIO_CONSTEXPR20 Status read_delta_array(Reader& reader, T* out, size_t n) {
+    using U = std::make_unsigned_t<T>;
+    if (n == 0) return Status::Ok();
+    U sum = 0;
+    unsigned width = 0;
+    const Status s = ArrayCodec::header(reader, sum, width);
+    if (!s) return s;
+    out[0] = static_cast<T>(sum);
+    return ArrayCodec::read<U>(reader, width, n - 1, [&](size_t i, U z) {
+        sum = static_cast<U>(sum + ArrayCodec::unzigzag(z));
+        out[i + 1] = static_cast<T>(sum);
+    });
+}
+
+template <typename Writer, typename T>
+BIO_CONSTEXPR20 Status write_for_array(Writer& writer, const T* in, size_t n) {
+    using U = std::make_unsigned_t<T>;
+    if (n == 0) return Status::Ok();
+    T lo = in[0];
+    T hi = in[0];
+    for (size_t i = 1; i < n; ++i) {
+        lo = in[i] < lo ? in[i] : lo;
+        hi = in[i] > hi ? in[i] : hi;
+    }
+    const auto base = static_cast<U>(lo);
+    return ArrayCodec::write(writer, base, ArrayCodec::width(static_cast<U>(static_cast<U>(hi) - base)), n,
+                             [in, base](size_t i) { return static_cast<U>(static_cast<U>(in[i]) - base); });
+}
+
+template <typename Reader, typename T>
+BIO_CONSTEXPR20 Status read_for_array(Reader& reader, T* out, size_t n) {
+    using U = std::make_unsigned_t<T>;
+    if (n == 0) return Status::Ok();
+    U base = 0;
+    unsigned width = 0;
+    const Status s = ArrayCodec::header(reader, base, width);
+    if (!s) return s;
+    return ArrayCodec::read<U>(reader, width, n, [&](size_t i, U v) {
+        out[i] = static_cast<T>(static_cast<U>(v + base));
+    });
+}
+
+// Compile-time field descriptors. Fixed-size structs list one per wire field
+// in kFields; decode() and encode() fold over them with one bounds check and
+// constant-offset loads and stores.
+enum class WireType : uint8_t { U8, U16, U32, U64, I8, I16, I32, I64, F32, F64, Bytes, Struct, Bits, Padding };
+
+template <typename T, typename = void>
+inline constexpr bool kHasFields = false;
+template <typename T>
+inline constexpr bool kHasFields<T, std::void_t<decltype(T::kFields)>> = true;
+
+namespace detail {
+
+template <typename M> struct MemberPointer;
+template <typename Owner, typename Value>
+struct MemberPointer<Value Owner::*> { using owner = Owner; using value = Value; };
+
+template <typename T>
+struct ArrayTraits { using element_type = T; static constexpr bool kIsArray = false; static constexpr size_t kCount = 1; };
+template <typename T, size_t N>
+struct ArrayTraits<std::array<T, N>> { using element_type = T; static constexpr bool kIsArray = true; static constexpr size_t kCount = N; };
+
+template <WireType W> struct WireValue {};
+template <> struct WireValue<WireType::U8> { using type = uint8_t; };
+template <> struct WireValue<WireType::U16> { using type = uint16_t; };
+template <> struct WireValue<WireType::U32> { using type = uint32_t; };
+template <> struct WireValue<WireType::U64> { using type = uint64_t; };
+template <> struct WireValue<WireType::I8> { using type = int8_t; };
+template <> struct WireValue<WireType::I16> { using type = int16_t; };
+template <> struct WireValue<WireType::I32> { using type = int32_t; };
+template <> struct WireValue<WireType::I64> { using type = int64_t; };
+template <> struct WireValue<WireType::F32> { using type = float; };
+template <> struct WireValue<WireType::F64> { using type = double; };
+template <> struct WireValue<WireType::Bytes> { using type = uint8_t; };
+template <WireType W>
+using WireValueT = typename WireValue<W>::type;
+
+template <WireType W, typename Reader>
+BIO_CONSTEXPR20 WireValueT<W> LoadWireAt(const Reader& reader, size_t at) {
+    if constexpr (W == WireType::U8) return reader.load_u8_at(at);
+    else if constexpr (W == WireType::U16) return reader.load_u16_at(at);
+    else if constexpr (W == WireType::U32) return reader.load_u32_at(at);
+    else if constexpr (W == WireType::U64) return reader.load_u64_at(at);
+    else if constexpr (W == WireType::I8) return reader.load_i8_at(at);
+    else if constexpr (W == WireType::I16) return reader.load_i16_at(at);
+    else if constexpr (W == WireType::I32) return reader.load_i32_at(at);
+    else if constexpr (W == WireType::I64) return reader.load_i64_at(at);
+    else if constexpr (W == WireType::F32) return reader.load_f32_at(at);
+    else return reader.load_f64_at(at);
+}
+template <WireType W, typename Writer>
+BIO_CONSTEXPR20 void StoreWireAt(Writer& writer, size_t at, WireValueT<W> v) {
+    if constexpr (W == WireType::U8) writer.store_u8_at(at, v);
+    else if constexpr (W == WireType::U16) writer.store_u16_at(at, v);
+    else if constexpr (W == WireType::U32) writer.store_u32_at(at, v);
+    else if constexpr (W == WireType::U64) writer.store_u64_at(at, v);
+    else if constexpr (W == WireType::I8) writer.store_i8_at(at, v);
+    else if constexpr (W == WireType::I16) writer.store_i16_at(at, v);
+    else if constexpr (W == WireType::I32) writer.store_i32_at(at, v);
+    else if constexpr (W == WireType::I64) writer.store_i64_at(at, v);
+    else if constexpr (W == WireType::F32) writer.store_f32_at(at, v);
+    else writer.store_f64_at(at, v);
+}
+template <WireType W, typename Reader, typename T>
+BIO_CONSTEXPR20 void LoadWireArrayAt(const Reader& reader, size_t at, T* out, size_t count) {
+    if constexpr (W == WireType::U16) reader.load_u16_array_at(at, out, count);
+    else if constexpr (W == WireType::U32) reader.load_u32_array_at(at, out, count);
+    else if constexpr (W == WireType::U64) reader.load_u64_array_at(at, out, count);
+    else if constexpr (W == WireType::I16) reader.load_i16_array_at(at, out, count);
+    else if constexpr (W == WireType::I32) reader.load_i32_array_at(at, out, count);
+    else if constexpr (W == WireType::I64) reader.load_i64_array_at(at, out, count);
+    else if constexpr (W == WireType::F32) reader.load_f32_array_at(at, out, count);
+    else reader.load_f64_array_at(at, out, count);
+}
+template <WireType W, typename Writer, typename T>
+BIO_CONSTEXPR20 void StoreWireArrayAt(Writer& writer, size_t at, const T* in, size_t count) {
+    if constexpr (W == WireType::U16) writer.store_u16_array_at(at, in, count);
+    else if constexpr (W == WireType::U32) writer.store_u32_array_at(at, in, count);
+    else if constexpr (W == WireType::U64) writer.store_u64_array_at(at, in, count);
+    else if constexpr (W == WireType::I16) writer.store_i16_array_at(at, in, count);
+    else if constexpr (W == WireType::I32) writer.store_i32_array_at(at, in, count);
+    else if constexpr (W == WireType::I64) writer.store_i64_array_at(at, in, count);
+    else if constexpr (W == WireType::F32) writer.store_f32_array_at(at, in, count);
+    else writer.store_f64_array_at(at, in, count);
+}
+// Raw value to member type, through an enum's decode_*() function if given.
+template <typename V, auto Decode, typename Raw>
+constexpr V FromWire(Raw raw) {
+    if constexpr (!std::is_null_pointer_v<decltype(Decode)>) return Decode(raw);
+    else return static_cast<V>(raw);
+}
+
+template <typename T, typename Reader>
+BIO_CONSTEXPR20 Status LoadFields(const Reader& reader, size_t base, T& obj);
+template <typename T, typename Writer>
+BIO_CONSTEXPR20 void StoreFields(Writer& writer, size_t base, const T& obj);
+
+}  // namespace detail
+
+/// A member at byte Offset: a scalar, an enum, a std::array of them, bytes,
+/// or a nested struct (or array of structs) with its own kFields.
+template <auto Member, WireType Wire, size_t Offset, auto Decode = nullptr>
+struct Field {
+    using owner_type = typename detail::MemberPointer<decltype(Member)>::owner;
+    using value_type = typename detail::MemberPointer<decltype(Member)>::value;
+    using element_type = typename detail::ArrayTraits<value_type>::element_type;
+    static constexpr auto member = Member;
+    static constexpr WireType wire = Wire;
+    static constexpr size_t offset = Offset;
+    static constexpr size_t count = detail::ArrayTraits<value_type>::kCount;
+    static constexpr size_t size = [] {
+        if constexpr (Wire == WireType::Struct) return count * element_type::kWireSize;
+        else return count * sizeof(detail::WireValueT<Wire>);
+    }();
+
+    const char* name;
+    uint16_t id = 0;
+
+    template <typename Reader>
+    BIO_CONSTEXPR20 Status load(const Reader& reader, size_t base, owner_type& obj) const {
+        auto& dst = obj.*Member;
+        const size_t at = base + Offset;
+        if constexpr (Wire == WireType::Struct) {
+            if constexpr (detail::ArrayTraits<value_type>::kIsArray) {
+                for (size_t i = 0; i < count; ++i) {
+                    Status s = detail::LoadFields(reader, at + i * element_type::kWireSize, dst[i]);
+                    if (!s) return s;
+                }
+                return Status::Ok();
+            } else {
+                return detail::LoadFields(reader, at, dst);
+            }
+        } else if constexpr (!detail::ArrayTraits<value_type>::kIsArray) {
+            dst = detail::FromWire<value_type, Decode>(detail::LoadWireAt<Wire>(reader, at));
+        } else if constexpr (std::is_enum_v<element_type>) {
+            for (size_t i = 0; i < count; ++i) {
+                dst[i] = detail::FromWire<element_type, Decode>(
+                    detail::LoadWireAt<Wire>(reader, at + i * sizeof(detail::WireValueT<Wire>)));
+            }
+        } else if constexpr (sizeof(element_type) == 1) {
+            reader.load_bytes_at(at, dst.data(), dst.size());
+        } else {
+            detail::LoadWireArrayAt<Wire>(reader, at, dst.data(), dst.size());
+        }
+        return Status::Ok();
+    }
+    template <typename Writer>
+    BIO_CONSTEXPR20 void store(Writer& writer, size_t base, const owner_type& obj) const {
+        const auto& src = obj.*Member;
+        const size_t at = base + Offset;
+        using Raw = detail::WireValueT<Wire == WireType::Struct ? WireType::U8 : Wire>;
+        if constexpr (Wire == WireType::Struct) {
+            if constexpr (detail::ArrayTraits<value_type>::kIsArray) {
+                for (size_t i = 0; i < count; ++i) detail::StoreFields(writer, at + i * element_type::kWireSize, src[i]);
+            } else {
+                detail::StoreFields(writer, at, src);
+            }
+        } else if constexpr (!detail::ArrayTraits<value_type>::kIsArray) {
+            detail::StoreWireAt<Wire>(writer, at, static_cast<Raw>(src));
+        } else if constexpr (std::is_enum_v<element_type>) {
+            for (size_t i = 0; i < count; ++i) detail::StoreWireAt<Wire>(writer, at + i * sizeof(Raw), static_cast<Raw>(src[i]));
+        } else if constexpr (sizeof(element_type) == 1) {
+            writer.store_bytes_at(at, src.data(), src.size());
+        } else {
+            detail::StoreWireArrayAt<Wire>(writer, at, src.data(), src.size());
+        }
+    }
+};
+
+/// A scalar or enum whose raw value must equal Value; decoding stores it,
+/// then fails with BadMagic on a mismatch.
+template <auto Member, WireType Wire, size_t Offset, auto Value, auto Decode = nullptr>
+struct Expected {
+    using owner_type = typename detail::MemberPointer<decltype(Member)>::owner;
+    using value_type = typename detail::MemberPointer<decltype(Member)>::value;
+    using element_type = value_type;
+    using raw_type = detail::WireValueT<Wire>;
+    static constexpr auto member = Member;
+    static constexpr WireType wire = Wire;
+    static constexpr size_t offset = Offset;
+    static constexpr size_t count = 1;
+    static constexpr size_t size = sizeof(raw_type);
+    static constexpr raw_type expected = static_cast<raw_type>(Value);
+
+    const char* name;
+    uint16_t id = 0;
+
+    template <typename Reader>
+    BIO_CONSTEXPR20 Status load(const Reader& reader, size_t base, owner_type& obj) const {
+        const raw_type raw = detail::LoadWireAt<Wire>(reader, base + Offset);
+        obj.*Member = detail::FromWire<value_type, Decode>(raw);
+        if (raw != expected) return Status::BadMagic(reader.position() + base + Offset);
+        return Status::Ok();
+    }
+    template <typename Writer>
+    BIO_CONSTEXPR20 void store(Writer& writer, size_t base, const owner_type& obj) const {
+        detail::StoreWireAt<Wire>(writer, base + Offset, static_cast<raw_type>(obj.*Member));
+    }
+};
+
+/// Width bits from bit Shift (LSB first) of a Bits field, stored in Member.
+template <auto Member, unsigned Shift, unsigned Width, auto Decode = nullptr>
+struct Bit {
+    using value_type = typename detail::MemberPointer<decltype(Member)>::value;
+    static constexpr auto member = Member;
+    static constexpr unsigned shift = Shift;
+    static constexpr unsigned width = Width;
+    static constexpr uint64_t mask = (uint64_t{1} << Width) - 1;
+
+    template <typename Raw>
+    static constexpr value_type Extract(Raw raw) {
+        const auto bits = static_cast<Raw>((raw >> Shift) & mask);
+        if constexpr (std::is_same_v<value_type, bool>) return bits != 0;
+        else return detail::FromWire<value_type, Decode>(bits);
+    }
+};
+
+/// An unsigned integer at Offset split into Bit slices.
+template <WireType Wire, size_t Offset, typename... Slices>
+struct Bits {
+    using raw_type = detail::WireValueT<Wire>;
+    static_assert(std::is_unsigned_v<raw_type>, "Bits need an unsigned type");
+    static constexpr WireType wire = WireType::Bits;
+    static constexpr size_t offset = Offset;
+    static constexpr size_t count = 1;
+    static constexpr size_t size = sizeof(raw_type);
+
+    const char* name;
+    uint16_t id = 0;
+
+    template <typename Reader, typename T>
+    BIO_CONSTEXPR20 Status load(const Reader& reader, size_t base, T& obj) const {
+        const raw_type raw = detail::LoadWireAt<Wire>(reader, base + Offset);
+        static_cast<void>(raw);
+        ((obj.*Slices::member = Slices::Extract(raw)), ...);
+        return Status::Ok();
+    }
+    template <typename Writer, typename T>
+    BIO_CONSTEXPR20 void store(Writer& writer, size_t base, const T& obj) const {
+        raw_type raw = 0;
+        ((raw |= static_cast<raw_type>((static_cast<raw_type>(obj.*Slices::member) & Slices::mask) << Slices::shift)), ...);
+        detail::StoreWireAt<Wire>(writer, base + Offset, raw);
+    }
 };
 
+/// Size reserved bytes at Offset, skipped on decode and untouched on encode.
+template <size_t Offset, size_t Size>
+struct Padding {
+    static constexpr WireType wire = WireType::Padding;
+    static constexpr size_t offset = Offset;
+    static constexpr size_t count = Size;
+    static constexpr size_t size = Size;
+
+    const char* name;
+    uint16_t id = 0;
+
+    template <typename Reader, typename T>
+    constexpr Status load(const Reader&, size_t, T&) const { return Status::Ok(); }
+    template <typename Writer, typename T>
+    constexpr void store(Writer&, size_t, const T&) const {}
+};
+
+namespace detail {
+
+template <typename T, typename Reader>
+BIO_CONSTEXPR20 Status LoadFields(const Reader& reader, size_t base, T& obj) {
+    return std::apply([&](const auto&... field) {
+        Status s = Status::Ok();
+        static_cast<void>(((s = field.load(reader, base, obj).in_field(field.id)).ok && ...));
+        return s;
+    }, T::kFields);
+}
+template <typename T, typename Writer>
+BIO_CONSTEXPR20 void StoreFields(Writer& writer, size_t base, const T& obj) {
+    std::apply([&](const auto&... field) { (field.store(writer, base, obj), ...); }, T::kFields);
+}
+template <typename T, typename = void>
+struct CodecOf { using type = void; };
+template <typename T>
+struct CodecOf<T, std::void_t<typename T::codec_type>> { using type = typename T::codec_type; };
+template <typename T, typename Stream>
+constexpr void CheckCodec() {
+    using Codec = typename CodecOf<T>::type;
+    static_assert(std::is_void_v<Codec> || std::is_same_v<Codec, typename Stream::codec_type>,
+                  "stream byte order does not match the struct");
+}
+
+}  // namespace detail
+
+/// Decode out from reader: with kFields one bounds check and constant-offset
+/// loads (the reader is not advanced on failure), otherwise out.parse().
+template <typename T, typename Reader>
+BIO_CONSTEXPR20 Status decode(Reader& reader, T& out) {
+    if constexpr (kHasFields<T>) {
+        detail::CheckCodec<T, Reader>();
+        Status s = reader.ensure(T::kWireSize);
+        if (!s) return s;
+        s = detail::LoadFields(reader, 0, out);
+        if (!s) return s;
+        reader.advance(T::kWireSize);
+        return Status::Ok();
+    } else {
+        return out.parse(reader);
+    }
+}
+/// Encode value into writer: with kFields one bounds check and
+/// constant-offset stores, otherwise value.serialize().
+template <typename T, typename Writer>
+BIO_CONSTEXPR20 Status encode(Writer& writer, const T& value) {
+    if constexpr (kHasFields<T>) {
+        detail::CheckCodec<T, Writer>();
+        Status s = writer.ensure(T::kWireSize);
+        if (!s) return s;
+        detail::StoreFields(writer, 0, value);
+        writer.advance(T::kWireSize);
+        return Status::Ok();
+    } else {
+        return value.serialize(writer);
+    }
+}
+/// Call fn with every descriptor in T::kFields, in wire order.
+template <typename T, typename Fn>
+constexpr void for_each_field(Fn&& fn) {
+    std::apply([&](const auto&... field) { (fn(field), ...); }, T::kFields);
+}
+
 using LEReader = ByteReaderT<LittleEndianCodec>;
 using BEReader = ByteReaderT<BigEndianCodec>;
+using LEChunkedReader = ChunkedReaderT<LittleEndianCodec>;
+using BEChunkedReader = ChunkedReaderT<BigEndianCodec>;
 using LEWriter = ByteWriterT<LittleEndianCodec>;
 using BEWriter = ByteWriterT<BigEndianCodec>;
+using DynamicLEWriter = DynamicByteWriterT<LittleEndianCodec>;
+using DynamicBEWriter = DynamicByteWriterT<BigEndianCodec>;
+using LESizeCounter = SizeCounterT<LittleEndianCodec>;
+using BESizeCounter = SizeCounterT<BigEndianCodec>;
 {% if namespace %}
 
 }  // namespace {{ namespace }}
@@ -389,14 +1790,29 @@ HEADER_TEMPLATE = r"""// =======================================================
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <tuple>
+#include <type_traits>
+{%- if proto.dispatchers %}
+#include <utility>
+#include <variant>
+{%- endif %}
 
+{%- if shared_runtime %}
+#include <binary-io/array-coding.hpp>
+#include <binary-io/binary-io.hpp>
+#include <binary-io/reflect.hpp>
+{%- else %}
 #include "{{ io_include }}"
+{%- endif %}
 {%- for inc in proto.includes %}
 #include "{{ inc }}"
 {%- endfor %}
 {% if proto.namespace %}
 namespace {{ proto.namespace }} {
 {% endif %}
+{%- if shared_runtime %}
+{{ render_shared_runtime() }}
+{% endif %}
 // ---------------------------------------------------------------------------
 // Forward declarations
 // ---------------------------------------------------------------------------
@@ -419,8 +1835,16 @@ enum class {{ enum.name }} : {{ enum.cpp_underlying }} {
     {{ v.name }} = {{ hex_literal(v.value) }},
 {%- endfor %}
 };
+
+{{ render_enum_decoder(enum) }}
 {% endfor %}
 
+// ---------------------------------------------------------------------------
+// Field ids
+// ---------------------------------------------------------------------------
+
+{{ render_field_names(proto) }}
+
 // ---------------------------------------------------------------------------
 // Structs
 // ---------------------------------------------------------------------------
@@ -432,7 +1856,7 @@ struct {{ s.name }} {
 {%- for f in s.fields %}
 {%- if f.kind == TypeKind.PADDING %}
     // {{ f.name }}: {{ f.pad_size }} byte(s) padding (not stored)
-{%- elif f.kind == TypeKind.BITFIELD %}
+{%- elif f.kind in (TypeKind.BITFIELD, TypeKind.PACKED_BITS) %}
 {%- if f.description %}
     /// {{ f.description }}
 {%- endif %}
@@ -475,27 +1899,386 @@ struct {{ s.name }} {
 {%- endif %}
 {%- endfor %}
 
+{%- set wire_size = proto.fixed_wire_size(s) %}
+{%- if wire_size is not none %}
+
+    /// Encoded size in bytes; every field sits at a fixed offset.
+    static constexpr size_t kWireSize = {{ wire_size }};
+{%- set descriptors = render_field_descriptors(s, proto) %}
+{%- if descriptors %}
+
+{{ descriptors }}
+{%- endif %}
+
     /// Parse this struct from a binary reader.
+    /// @tparam Reader {{ proto.reader_alias }} or {{ proto.reader_alias[:2] }}ChunkedReader.
     /// @return Status::Ok() on success.
-    Status parse({{ proto.reader_alias }}& reader) {
-        Status s = Status::Ok();
-{% for f in s.fields %}
-{{ render_parse_field(f, proto, s) }}
+    template <typename Reader>
+    BIO_CONSTEXPR20 Status parse(Reader& reader) {
+        static_assert(std::is_same_v<typename Reader::codec_type, {{ proto.codec_name }}>,
+                      "reader byte order does not match the protocol");
+{%- if instrument %}
+        InstrumentProbe<Reader> _probe(reader, "{{ probe_site(s, "parse", proto) }}");
+{%- endif %}
+        Status s = reader.ensure(kWireSize);
+        if (!s) return s;
+        s = parse_unchecked(reader, 0);
+        if (!s) return s;
+        reader.advance(kWireSize);
+{%- if instrument %}
+        _probe.succeed();
+{%- endif %}
+        return Status::Ok();
+    }
+
+    /// Parse from @p offset bytes past the reader's cursor without bounds
+    /// checks; the caller must have ensured offset + kWireSize bytes.
+    template <typename Reader>
+    BIO_CONSTEXPR20 Status parse_unchecked(const Reader& reader, size_t offset) {
+{%- if only_padding(s) %}
+        static_cast<void>(reader);
+        static_cast<void>(offset);
+{%- endif %}
+{% for f, pos in field_offsets(s, proto) %}
+{{ render_parse_field_fixed(f, pos, proto, s) }}
 {% endfor %}
         return Status::Ok();
     }
 
     /// Serialize this struct into a binary writer.
+    /// @tparam Writer {{ proto.writer_alias }}, Dynamic{{ proto.writer_alias }} or {{ proto.writer_alias[:2] }}SizeCounter.
     /// @return Status::Ok() on success.
-    Status serialize({{ proto.writer_alias }}& writer) const {
-        Status s = Status::Ok();
-{% for f in s.fields %}
-{{ render_serialize_field(f, proto, s) }}
-{% endfor %}
+    template <typename Writer>
+    BIO_CONSTEXPR20 Status serialize(Writer& writer) const {
+        static_assert(std::is_same_v<typename Writer::codec_type, {{ proto.codec_name }}>,
+                      "writer byte order does not match the protocol");
+{%- if instrument %}
+        InstrumentProbe<Writer> _probe(writer, "{{ probe_site(s, "serialize", proto) }}");
+{%- endif %}
+        Status s = writer.ensure(kWireSize);
+        if (!s) return s;
+        serialize_unchecked(writer, 0);
+        writer.advance(kWireSize);
+{%- if instrument %}
+        _probe.succeed();
+{%- endif %}
         return Status::Ok();
     }
-};
+
+    /// Serialize at @p offset bytes past the writer's cursor without bounds
+    /// checks; the caller must have ensured offset + kWireSize bytes.
+    template <typename Writer>
+    BIO_CONSTEXPR20 void serialize_unchecked(Writer& writer, size_t offset) const {
+{%- if only_padding(s) %}
+        static_cast<void>(writer);
+        static_cast<void>(offset);
+{%- endif %}
+{% for f, pos in field_offsets(s, proto) %}
+{{ render_serialize_field_fixed(f, pos, proto) }}
 {% endfor %}
+    }
+
+    /// Number of bytes serialize() writes.
+    constexpr size_t serialized_size() const { return kWireSize; }
+{%- else %}
+
+    /// Parse this struct from a binary reader.
+    /// @tparam Reader {{ proto.reader_alias }} or {{ proto.reader_alias[:2] }}ChunkedReader.
+    /// @return Status::Ok() on success.
+    template <typename Reader>
+    BIO_CONSTEXPR20 Status parse(Reader& reader) {
+        static_assert(std::is_same_v<typename Reader::codec_type, {{ proto.codec_name }}>,
+                      "reader byte order does not match the protocol");
+{%- if instrument %}
+        InstrumentProbe<Reader> _probe(reader, "{{ probe_site(s, "parse", proto) }}");
+{%- endif %}
+        Status s = Status::Ok();
+{% for f in s.fields %}
+{{ probe_field(render_parse_field(f, proto, s), s, f, "parse", proto, instrument) }}
+{% endfor %}
+{%- if instrument %}
+        _probe.succeed();
+{%- endif %}
+        return Status::Ok();
+    }
+
+    /// Serialize this struct into a binary writer.
+    /// @tparam Writer {{ proto.writer_alias }}, Dynamic{{ proto.writer_alias }} or {{ proto.writer_alias[:2] }}SizeCounter.
+    /// @return Status::Ok() on success.
+    template <typename Writer>
+    BIO_CONSTEXPR20 Status serialize(Writer& writer) const {
+        static_assert(std::is_same_v<typename Writer::codec_type, {{ proto.codec_name }}>,
+                      "writer byte order does not match the protocol");
+{%- if instrument %}
+        InstrumentProbe<Writer> _probe(writer, "{{ probe_site(s, "serialize", proto) }}");
+{%- endif %}
+        Status s = Status::Ok();
+{% for f in s.fields %}
+{{ probe_field(render_serialize_field(f, proto, s), s, f, "serialize", proto, instrument) }}
+{% endfor %}
+{%- if instrument %}
+        _probe.succeed();
+{%- endif %}
+        return Status::Ok();
+    }
+
+    /// Number of bytes serialize() writes for the current field values.
+    BIO_CONSTEXPR20 size_t serialized_size() const {
+        SizeCounterT<{{ proto.codec_name }}> counter;
+        static_cast<void>(serialize(counter));
+        return counter.size();
+    }
+{%- endif %}
+{%- set resync = render_resync(s, proto) %}
+{%- if resync %}
+
+{{ resync }}
+{%- endif %}
+};
+{%- if wire_size is not none %}
+
+/// Read-only view of an encoded {{ s.name }}. Each accessor decodes its field
+/// in place at a constant offset, so only the fields touched are decoded.
+class {{ s.name }}View {
+public:
+    static constexpr size_t kWireSize = {{ s.name }}::kWireSize;
+
+    /// Wrap the kWireSize encoded bytes at @p data, which must stay readable
+    /// for the lifetime of the view. Bounds are the caller's to check.
+    explicit {{ s.name }}View(const uint8_t* data) : p_(data) {}
+
+    /// The encoded bytes this view reads from.
+    const uint8_t* wire() const { return p_; }
+
+    /// Decode every field into @p out, including expected-value checks.
+    Status decode({{ s.name }}& out) const { return out.parse_unchecked(reader(), 0); }
+{{ render_view_accessors(s, proto) }}
+
+private:
+    ByteReaderT<{{ proto.codec_name }}> reader() const {
+        return ByteReaderT<{{ proto.codec_name }}>(p_, kWireSize);
+    }
+
+    const uint8_t* p_;
+};
+{%- endif %}
+{%- if s.batch %}
+
+/// Column-wise storage for up to Capacity {{ s.name }} frames. Each field has
+/// its own contiguous column, nested struct fields flattened as `outer_inner`,
+/// so a scan over one field reads only that field's values.
+template <size_t Capacity>
+struct {{ s.name }}Batch {
+    static constexpr size_t kCapacity = Capacity;
+    static constexpr size_t kWireSize = {{ s.name }}::kWireSize;
+
+    /// Number of frames held; rows [0, size) of every column are valid.
+    size_t size = 0;
+
+{{ render_batch_columns(s, proto) }}
+
+    /// Decode up to @p max_frames back-to-back frames from @p reader into the
+    /// next rows, with one bounds check for the whole run. Stops early when
+    /// the batch is full or fewer whole frames remain; a trailing partial
+    /// frame is left unread.
+    /// @return Status::Ok(), or the first failure. Frames before the failing
+    ///         one are kept in the columns and consumed from @p reader.
+    template <typename Reader>
+    Status parse_batch(Reader& reader, size_t max_frames) {
+        static_assert(std::is_same_v<typename Reader::codec_type, {{ proto.codec_name }}>,
+                      "reader byte order does not match the protocol");
+        size_t n = reader.remaining() / kWireSize;
+        if (n > max_frames) n = max_frames;
+        if (n > Capacity - size) n = Capacity - size;
+        // A local cursor, so column stores cannot alias the caller's reader.
+        Reader frame = reader;
+        const size_t end = size + n;
+        for (size_t j = size; j < end; ++j) {
+{{ render_batch_loads(s, proto) }}
+            frame.advance(kWireSize);
+        }
+        reader.advance(n * kWireSize);
+        size = end;
+        return Status::Ok();
+    }
+
+    /// Drop every frame, keeping the column storage.
+    void clear() { size = 0; }
+{%- if batch_can_fail(s, proto) %}
+
+private:
+    template <typename Reader>
+    Status fail(Reader& reader, size_t j, Status s) {
+        reader.advance((j - size) * kWireSize);
+        size = j;
+        return s;
+    }
+{%- endif %}
+};
+{%- endif %}
+{% endfor %}
+{%- if proto.dispatchers %}
+// ---------------------------------------------------------------------------
+// Dispatchers
+// ---------------------------------------------------------------------------
+{% for d in proto.dispatchers %}
+{%- set info = dispatch_info(d, proto) %}
+{%- if d.description %}
+/// {{ d.description }}
+{%- endif %}
+/// Parses a {{ d.header }}, then the payload its `{{ d.discriminator }}` field selects
+/// through a {{ "jump table" if info.table else "switch" }} on the raw wire value.
+struct {{ d.name }} {
+    /// A routed payload struct, or std::monostate for header-only and
+    /// unknown message types.
+    using Payload = std::variant<{{ (["std::monostate"] + d.payloads) | join(", ") }}>;
+
+    /// Parse one message into @p header and @p payload. A fixed-size payload
+    /// already held by @p payload is parsed in place rather than rebuilt.
+{%- if d.length %}
+    /// Every message consumes exactly `{{ d.length }}` payload bytes: bytes the
+    /// routed struct does not read are skipped.
+    /// @return Status::Ok() on success; unknown types skip `{{ d.length }}` bytes and leave std::monostate. A payload that reads past `{{ d.length }}` fails with OutOfRange.
+    template <typename Reader>
+    static Status parse(Reader& reader, {{ d.header }}& header, Payload& payload) {
+        return run(reader, header, [&](Reader& r, auto tag) {
+            using P = typename decltype(tag)::type;
+            const size_t start = static_cast<size_t>(r.position());
+            if constexpr (std::is_same_v<P, std::monostate>) {
+                payload.template emplace<std::monostate>();
+            } else {
+                P* held = nullptr;
+                if constexpr (kParsesInPlace<P>) held = std::get_if<P>(&payload);
+                const Status s = held ? held->parse(r) : payload.template emplace<P>().parse(r);
+                if (!s) return s;
+            }
+            return fit(r, header, start);
+        });
+    }
+{%- else %}
+    /// @return Status::Ok() on success; unknown types fail with BadEnum, since their size is not known.
+    template <typename Reader>
+    static Status parse(Reader& reader, {{ d.header }}& header, Payload& payload) {
+        return run(reader, header, [&](Reader& r, auto tag) {
+            using P = typename decltype(tag)::type;
+            if constexpr (std::is_same_v<P, std::monostate>) {
+                payload.template emplace<std::monostate>();
+                return Status::Ok();
+            } else {
+                if constexpr (kParsesInPlace<P>) {
+                    if (P* held = std::get_if<P>(&payload)) return held->parse(r);
+                }
+                return payload.template emplace<P>().parse(r);
+            }
+        });
+    }
+{%- endif %}
+
+    /// Parse one message and call @p visitor(header, payload) with the
+    /// decoded payload struct, or std::monostate for header-only and unknown
+    /// message types.
+    template <typename Reader, typename Visitor>
+    static Status visit(Reader& reader, Visitor&& visitor) {
+        {{ d.header }} header;
+        return run(reader, header, [&](Reader& r, auto tag) {
+{%- if d.length %}
+            const size_t start = static_cast<size_t>(r.position());
+{%- endif %}
+            typename decltype(tag)::type payload{};
+            if constexpr (!std::is_same_v<decltype(payload), std::monostate>) {
+                const Status s = payload.parse(r);
+                if (!s) return s;
+            }
+{%- if d.length %}
+            const Status s = fit(r, header, start);
+            if (!s) return s;
+{%- endif %}
+            visitor(std::as_const(header), std::as_const(payload));
+            return Status::Ok();
+        });
+    }
+
+    /// Read the next message's `{{ d.discriminator }}` without consuming anything, to pick
+    /// a handler or buffer before parse(). Values with no enumerator are
+    /// returned as-is rather than mapped to a default.
+    template <typename Reader>
+    static Status peek(const Reader& reader, {{ info.enum_type }}& {{ d.discriminator }}) {
+        {{ info.raw_type }} raw = 0;
+        const Status s = reader.peek_{{ info.raw_yaml }}(raw, {{ info.offset }});
+        if (!s) return s.in_field({{ info.discriminator_id }});
+        {{ d.discriminator }} = static_cast<{{ info.enum_type }}>(raw);
+        return Status::Ok();
+    }
+
+private:
+    template <typename P>
+    struct Tag { using type = P; };
+
+    /// Fixed-size payloads overwrite every field when parsed, so a held one
+    /// can be reused; conditional fields would keep stale values.
+    template <typename P>
+    static constexpr bool kParsesInPlace = {{ info.in_place }};
+
+    template <typename P, typename Reader, typename Body>
+    static Status route(Reader& reader, const {{ d.header }}&, Body& body) {
+        return body(reader, Tag<P>{});
+    }
+{% if d.length %}
+    /// Skip what a payload parsed from @p start left of its `{{ d.length }}` bytes.
+    template <typename Reader>
+    static Status fit(Reader& reader, const {{ d.header }}& header, size_t start) {
+        const size_t used = static_cast<size_t>(reader.position()) - start;
+        const size_t length = header.{{ d.length }};
+        if (used > length) return Status::OutOfRange(start + length).in_field({{ info.length_id }});
+        const Status s = reader.skip(length - used);
+        if (!s) return s.in_field({{ info.length_id }});
+        return Status::Ok();
+    }
+
+    /// The body's fit() skips the whole payload.
+    template <typename Reader, typename Body>
+    static Status unknown(Reader& reader, const {{ d.header }}&, Body& body) {
+        return body(reader, Tag<std::monostate>{});
+    }
+{% else %}
+    template <typename Reader, typename Body>
+    static Status unknown(Reader& reader, const {{ d.header }}&, Body&) {
+        return Status::BadEnum(reader.position() - {{ d.header }}::kWireSize + {{ info.offset }})
+            .in_field({{ info.discriminator_id }});
+    }
+{% endif %}
+    template <typename Reader, typename Body>
+    static Status run(Reader& reader, {{ d.header }}& header, Body&& body) {
+        Status s = reader.ensure({{ d.header }}::kWireSize);
+        if (!s) return s;
+        const {{ info.raw_type }} raw = reader.load_{{ info.raw_yaml }}_at({{ info.offset }});
+        s = header.parse_unchecked(reader, 0);
+        if (!s) return s;
+        reader.advance({{ d.header }}::kWireSize);
+{%- if info.table %}
+        using Handler = Status (*)(Reader&, const {{ d.header }}&, Body&);
+        static constexpr Handler kTable[] = {
+{%- for value, label, payload in info.table %}
+            {{ "&route<" + payload + ", Reader, Body>," if label else "&unknown<Reader, Body>," }}  // {{ value }}{{ " " + label if label else "" }}
+{%- endfor %}
+        };
+        const auto index = static_cast<size_t>(raw - {{ info.base }});
+        if (index < sizeof(kTable) / sizeof(kTable[0])) {
+            return kTable[index](reader, header, body);
+        }
+        return unknown<Reader, Body>(reader, header, body);
+{%- else %}
+        switch (raw) {
+{%- for r in d.routes %}
+            case {{ hex_literal(r.value.value) }}: return route<{{ r.payload or "std::monostate" }}, Reader, Body>(reader, header, body);
+{%- endfor %}
+            default: return unknown<Reader, Body>(reader, header, body);
+        }
+{%- endif %}
+    }
+};
+{% endfor %}
+{%- endif %}
 {%- if proto.namespace %}
 
 }  // namespace {{ proto.namespace }}
@@ -516,24 +2299,192 @@ def _indent(code: str, level: int = 2) -> str:
     return "\n".join(prefix + line if line.strip() else "" for line in lines)
 
 
-def _enum_switch(target: str, raw_expr: str, enum_def: EnumDef) -> str:
-    """Generate a switch statement that safely converts a raw integer to an enum.
+def enum_decoder_name(enum_def: EnumDef) -> str:
+    """Name of the generated function mapping raw values to *enum_def*."""
+    return "decode_" + _to_snake_case(enum_def.name)
+
 
-    Uses the first declared value as the ``default`` to avoid UB from
-    ``static_cast`` with an out-of-range value.
+def _enum_assign(target: str, raw_expr: str, enum_def: EnumDef,
+                 narrow: bool = False) -> str:
+    """Assign the enum decoded from *raw_expr* to *target*.
+
+    *narrow* casts a wider expression (a shifted bitfield container, a bit
+    reader result) to the underlying type first.
+    """
+    if narrow:
+        raw_expr = f"static_cast<{enum_def.cpp_underlying}>({raw_expr})"
+    return f"{target} = {enum_decoder_name(enum_def)}({raw_expr});"
+
+
+# Multiplier candidates tried per table size when searching for a perfect
+# hash of a sparse enum; failing that, the decoder falls back to a switch.
+PERFECT_HASH_TRIES = 4096
+
+
+def _perfect_hash(keys: list[int], bits: int) -> tuple[int, int] | None:
+    """Find an odd multiplier *m* and table size 2**k for which
+    ``(key * m mod 2**bits) >> (bits - k)`` is distinct for every key."""
+    modulus = 1 << bits
+    k = max(1, (len(keys) - 1).bit_length())
+    for k in range(k, k + 3):
+        m = 0x9E3779B97F4A7C15 % modulus | 1
+        for _ in range(PERFECT_HASH_TRIES):
+            if len({(key * m % modulus) >> (bits - k) for key in keys}) == len(keys):
+                return m, k
+            m = (m * 6364136223846793005 + 1442695040888963407) % modulus | 1
+    return None
+
+
+def render_enum_decoder(enum_def: EnumDef) -> str:
+    """Return the constexpr function mapping a raw value to *enum_def*.
+
+    Values that are not enumerators map to the first declared value, which
+    also avoids storing unnamed values. The membership test is chosen from
+    the value set: one unsigned compare for a contiguous range, a 64-bit
+    mask for values within 64 codes of each other, otherwise a perfect hash
+    into a table of keys, so the check is branch-free for any enum.
+    """
+    name = enum_def.name
+    raw_type = enum_def.cpp_underlying
+    first = f"{name}::{enum_def.values[0].name}"
+    bits = 64 if PRIMITIVES[enum_def.underlying_type].size == 8 else 32
+    word = f"uint{bits}_t"
+    suffix = "ull" if bits == 64 else "u"
+
+    def lit(v: int) -> str:
+        return f"0x{v % (1 << bits):X}{suffix}"
+
+    values = sorted({v.value for v in enum_def.values})
+    lo, hi = values[0], values[-1]
+    span = hi - lo + 1
+    cast = f"static_cast<{name}>(raw)"
+    wide = f"static_cast<{word}>(raw)"
+    offset = f"{wide} - {lit(lo)}" if lo else wide
+
+    prelude = ""
+    if span == len(values):
+        body = [f"return {offset} < {lit(span)} ? {cast} : {first};"]
+    elif span <= 64:
+        mask = sum(1 << (v - lo) for v in values)
+        # Mask bits past the span are clear, so d < 64 bounds the shift
+        # without a second compare.
+        body = [
+            f"const {word} d = {offset};",
+            f"return ((0x{mask:X}ull >> (d & 63u)) & (d < 64u)) != 0 "
+            f"? {cast} : {first};",
+        ]
+    else:
+        found = _perfect_hash([v % (1 << bits) for v in values], bits)
+        if found is None:
+            body = [f"switch (raw) {{"]
+            body += [f"    case {_hex_literal(v)}: return {cast};"
+                     for v in values]
+            body += [f"    default: return {first};", "}"]
+        else:
+            m, k = found
+            table = [lo % (1 << bits)] * (1 << k)
+            for v in values:
+                table[((v % (1 << bits)) * m % (1 << bits)) >> (bits - k)] = (
+                    v % (1 << bits))
+            keys = f"k{name}Keys"
+            prelude = (
+                "namespace detail {\n"
+                f"inline constexpr {word} {keys}[{len(table)}] = {{"
+                + ", ".join(lit(t) for t in table) + "};\n"
+                "}  // namespace detail\n\n"
+            )
+            body = [
+                f"const {word} e = {wide};",
+                f"return detail::{keys}[(e * {lit(m)}) >> {bits - k}] == e "
+                f"? {cast} : {first};",
+            ]
+    return (
+        prelude
+        + f"/// Map a raw wire value to {name}; other values map to {first}.\n"
+        + f"constexpr {name} {enum_decoder_name(enum_def)}({raw_type} raw) {{\n"
+        + "".join(f"    {line}\n" for line in body)
+        + "}"
+    )
+
+
+def _bitfield_unpack_lines(f: FieldDef, tmp: str, proto: ProtocolDef,
+                           target: str = "{}") -> list[str]:
+    """Assign each bit-slice member of *f* from the raw container *tmp*.
+
+    *target* formats a slice name into the lvalue assigned.
     """
-    lines = [f"switch ({raw_expr}) {{"]
-    for v in enum_def.values:
+    lines = []
+    for b in f.bits:
+        mask = (1 << b.width) - 1
+        member_type = _bitfield_member_type(b, proto)
+        dest = target.format(b.name)
+        if b.enum_type and b.enum_type in proto.enum_map:
+            enum_def = proto.enum_map[b.enum_type]
+            raw_expr = f"({tmp} >> {b.offset}) & 0x{mask:X}"
+            lines.append(_enum_assign(dest, raw_expr, enum_def, narrow=True))
+        elif member_type == "bool":
+            lines.append(
+                f"{dest} = (({tmp} >> {b.offset}) & 0x{mask:X}) != 0;"
+            )
+        else:
+            lines.append(
+                f"{dest} = static_cast<{member_type}>"
+                f"(({tmp} >> {b.offset}) & 0x{mask:X});"
+            )
+    return lines
+
+
+def _bitfield_pack_lines(f: FieldDef, tmp: str) -> list[str]:
+    """OR each bit-slice member of *f* into the raw container *tmp*."""
+    prim = BITFIELD_TYPES[f.type]
+    lines = []
+    for b in f.bits:
+        mask = (1 << b.width) - 1
         lines.append(
-            f"    case {_hex_literal(v.value)}: "
-            f"{target} = {enum_def.name}::{v.name}; break;"
+            f"{tmp} |= static_cast<{prim.cpp_type}>"
+            f"((static_cast<{prim.cpp_type}>({b.name}) & 0x{mask:X}) << {b.offset});"
         )
-    default_val = enum_def.values[0]
-    lines.append(
-        f"    default: {target} = {enum_def.name}::{default_val.name}; break;"
-    )
-    lines.append("}")
-    return "\n".join(lines)
+    return lines
+
+
+def _packed_unpack_lines(f: FieldDef, buf: str, proto: ProtocolDef,
+                         target: str = "{}", bits: str = "") -> list[str]:
+    """Assign each slice of the packed_bits field *f* from the bytes in *buf*.
+
+    *target* formats a slice name into the lvalue assigned; *bits* names
+    the local bit reader.
+    """
+    order = BIT_ORDERS[f.bit_order]
+    bits = bits or f"_{f.name}_bits"
+    lines = [f"BitReaderT<{order}> {bits}({buf}, sizeof({buf}));"]
+    for b in f.bits:
+        member_type = _bitfield_member_type(b, proto)
+        raw_expr = f"{bits}.take_bits({b.width})"
+        dest = target.format(b.name)
+        if b.enum_type and b.enum_type in proto.enum_map:
+            lines.append(_enum_assign(dest, raw_expr,
+                                      proto.enum_map[b.enum_type], narrow=True))
+        elif member_type == "bool":
+            lines.append(f"{dest} = {raw_expr} != 0;")
+        else:
+            lines.append(f"{dest} = static_cast<{member_type}>({raw_expr});")
+    return lines
+
+
+def _packed_pack_lines(f: FieldDef, buf: str) -> list[str]:
+    """Pack each slice of the packed_bits field *f* into the bytes of *buf*."""
+    order = BIT_ORDERS[f.bit_order]
+    bits = f"_{f.name}_bits"
+    lines = [
+        f"uint8_t {buf}[{f.packed_size}];",
+        f"BitWriterT<{order}> {bits}({buf}, sizeof({buf}));",
+    ]
+    for b in f.bits:
+        lines.append(
+            f"{bits}.put_bits({b.width}, static_cast<uint64_t>({b.name}));"
+        )
+    lines.append(f"{bits}.flush();")
+    return lines
 
 
 def _wrap_condition(code: str, condition: str | None) -> str:
@@ -543,9 +2494,52 @@ def _wrap_condition(code: str, condition: str | None) -> str:
     return code
 
 
+def field_ids(proto: ProtocolDef) -> Dict[Tuple[str, str], int]:
+    """Number every struct field of *proto* from 1, in declaration order.
+
+    Failed parses report the id in ``Status::field``; the generated
+    ``*_field_name()`` maps it back to ``Struct.field``.
+    """
+    ids: Dict[Tuple[str, str], int] = {}
+    for s in proto.structs:
+        for f in s.fields:
+            ids[(s.name, f.name)] = len(ids) + 1
+    return ids
+
+
+def field_name_function(proto: ProtocolDef) -> str:
+    """Name of the generated function mapping field ids to names."""
+    return _to_snake_case(proto.name) + "_field_name"
+
+
+def render_field_names(proto: ProtocolDef) -> str:
+    """Return the function mapping a ``Status::field`` id to its name."""
+    cases = "".join(
+        f'        case {fid}: return "{s}.{f}";\n'
+        for (s, f), fid in field_ids(proto).items()
+    )
+    return (
+        f"/// Return \"Struct.field\" for a Status::field id reported by this\n"
+        f"/// protocol, or nullptr for 0 and unknown ids.\n"
+        f"constexpr const char* {field_name_function(proto)}(uint16_t id) {{\n"
+        f"    switch (id) {{\n"
+        f"{cases}"
+        f"        default: return nullptr;\n"
+        f"    }}\n"
+        f"}}"
+    )
+
+
+def _attribute_failures(code: str, field_id: int) -> str:
+    """Tag every failure *code* returns with *field_id*."""
+    return re.sub(r"return (s|Status::\w+\([^;]*\));",
+                  rf"return \1.in_field({field_id});", code)
+
+
 def render_parse_field(f: FieldDef, proto: ProtocolDef, struct: StructDef) -> str:
     """Return indented C++ code to parse one field."""
     code = _render_parse_field_inner(f, proto, struct)
+    code = _attribute_failures(code, field_ids(proto)[(struct.name, f.name)])
     code = _wrap_condition(code, f.condition)
     return _indent(code)
 
@@ -554,16 +2548,19 @@ def _render_parse_field_inner(f: FieldDef, proto: ProtocolDef, struct: StructDef
     if f.kind == TypeKind.PADDING:
         return f"s = reader.skip({f.pad_size});\nif (!s) return s;"
 
-    if f.kind == TypeKind.PRIMITIVE:
-        prim = PRIMITIVES[f.type]
+    if f.kind in (TypeKind.PRIMITIVE, TypeKind.VARINT):
+        prim = PRIMITIVES.get(f.type) or VARINT_TYPES[f.type]
         lines = [
             f"s = reader.{prim.read_method}({f.name});",
             "if (!s) return s;",
         ]
         if f.expected is not None:
+            # Varints have no fixed size; report the end of the value.
+            at = ("reader.position()" if f.kind == TypeKind.VARINT
+                  else f"reader.position() - {prim.size}")
             lines.append(
                 f"if ({f.name} != {_format_expected(f.expected)}) "
-                f"return Status::OutOfRange();"
+                f"return Status::BadMagic({at});"
             )
         return "\n".join(lines)
 
@@ -576,11 +2573,11 @@ def _render_parse_field_inner(f: FieldDef, proto: ProtocolDef, struct: StructDef
             f"s = reader.{prim.read_method}({tmp});",
             "if (!s) return s;",
         ]
-        lines.append(_enum_switch(f.name, tmp, enum_def))
+        lines.append(_enum_assign(f.name, tmp, enum_def))
         if f.expected is not None:
             lines.append(
                 f"if ({tmp} != {_format_expected(f.expected)}) "
-                f"return Status::OutOfRange();"
+                f"return Status::BadMagic(reader.position() - {prim.size});"
             )
         return "\n".join(lines)
 
@@ -595,22 +2592,17 @@ def _render_parse_field_inner(f: FieldDef, proto: ProtocolDef, struct: StructDef
             f"s = reader.{prim.read_method}({tmp});",
             "if (!s) return s;",
         ]
-        for b in f.bits:
-            mask = (1 << b.width) - 1
-            member_type = _bitfield_member_type(b, proto)
-            if b.enum_type and b.enum_type in proto.enum_map:
-                enum_def = proto.enum_map[b.enum_type]
-                raw_expr = f"({tmp} >> {b.offset}) & 0x{mask:X}"
-                lines.append(_enum_switch(b.name, raw_expr, enum_def))
-            elif member_type == "bool":
-                lines.append(
-                    f"{b.name} = (({tmp} >> {b.offset}) & 0x{mask:X}) != 0;"
-                )
-            else:
-                lines.append(
-                    f"{b.name} = static_cast<{member_type}>"
-                    f"(({tmp} >> {b.offset}) & 0x{mask:X});"
-                )
+        lines.extend(_bitfield_unpack_lines(f, tmp, proto))
+        return "\n".join(lines)
+
+    if f.kind == TypeKind.PACKED_BITS:
+        buf = f"_{f.name}_buf"
+        lines = [
+            f"uint8_t {buf}[{f.packed_size}];",
+            f"s = reader.read_bytes({buf}, sizeof({buf}));",
+            "if (!s) return s;",
+        ]
+        lines.extend(_packed_unpack_lines(f, buf, proto))
         return "\n".join(lines)
 
     if f.kind == TypeKind.BYTES:
@@ -627,25 +2619,28 @@ def _render_parse_field_inner(f: FieldDef, proto: ProtocolDef, struct: StructDef
 
     if f.kind == TypeKind.ARRAY:
         elem_type = f.element_type or "uint8_t"
+        if f.encoding:
+            return (
+                f"s = read_{f.encoding}_array(reader, {f.name}.data(), "
+                f"{f.name}.size());\n"
+                f"if (!s) return s;"
+            )
         if elem_type in PRIMITIVES:
             prim = PRIMITIVES[elem_type]
             return (
-                f"for (auto& elem : {f.name}) {{\n"
-                f"    s = reader.{prim.read_method}(elem);\n"
-                f"    if (!s) return s;\n"
-                f"}}"
+                f"s = reader.{prim.read_array_method}"
+                f"({f.name}.data(), {f.name}.size());\n"
+                f"if (!s) return s;"
             )
         elif elem_type in proto.enum_map:
             enum_def = proto.enum_map[elem_type]
             prim = PRIMITIVES[enum_def.underlying_type]
-            switch_code = _enum_switch("elem", "_tmp", enum_def)
-            switch_lines = "\n".join("    " + l for l in switch_code.split("\n"))
             return (
                 f"for (auto& elem : {f.name}) {{\n"
                 f"    {prim.cpp_type} _tmp{{}};\n"
                 f"    s = reader.{prim.read_method}(_tmp);\n"
                 f"    if (!s) return s;\n"
-                f"{switch_lines}\n"
+                f"    {_enum_assign('elem', '_tmp', enum_def)}\n"
                 f"}}"
             )
         else:
@@ -671,8 +2666,8 @@ def _render_serialize_field_inner(f: FieldDef, proto: ProtocolDef, struct: Struc
     if f.kind == TypeKind.PADDING:
         return f"s = writer.skip({f.pad_size});\nif (!s) return s;"
 
-    if f.kind == TypeKind.PRIMITIVE:
-        prim = PRIMITIVES[f.type]
+    if f.kind in (TypeKind.PRIMITIVE, TypeKind.VARINT):
+        prim = PRIMITIVES.get(f.type) or VARINT_TYPES[f.type]
         return (
             f"s = writer.{prim.write_method}({f.name});\n"
             f"if (!s) return s;"
@@ -694,16 +2689,18 @@ def _render_serialize_field_inner(f: FieldDef, proto: ProtocolDef, struct: Struc
         prim = BITFIELD_TYPES[f.type]
         tmp = f"_{f.name}_raw"
         lines = [f"{prim.cpp_type} {tmp}{{}};"]
-        for b in f.bits:
-            mask = (1 << b.width) - 1
-            lines.append(
-                f"{tmp} |= static_cast<{prim.cpp_type}>"
-                f"((static_cast<{prim.cpp_type}>({b.name}) & 0x{mask:X}) << {b.offset});"
-            )
+        lines.extend(_bitfield_pack_lines(f, tmp))
         lines.append(f"s = writer.{prim.write_method}({tmp});")
         lines.append("if (!s) return s;")
         return "\n".join(lines)
 
+    if f.kind == TypeKind.PACKED_BITS:
+        buf = f"_{f.name}_buf"
+        lines = _packed_pack_lines(f, buf)
+        lines.append(f"s = writer.write_bytes({buf}, sizeof({buf}));")
+        lines.append("if (!s) return s;")
+        return "\n".join(lines)
+
     if f.kind == TypeKind.BYTES:
         return (
             f"s = writer.write_bytes({f.name}.data(), {f.name}.size());\n"
@@ -718,13 +2715,18 @@ def _render_serialize_field_inner(f: FieldDef, proto: ProtocolDef, struct: Struc
 
     if f.kind == TypeKind.ARRAY:
         elem_type = f.element_type or "uint8_t"
+        if f.encoding:
+            return (
+                f"s = write_{f.encoding}_array(writer, {f.name}.data(), "
+                f"{f.name}.size());\n"
+                f"if (!s) return s;"
+            )
         if elem_type in PRIMITIVES:
             prim = PRIMITIVES[elem_type]
             return (
-                f"for (const auto& elem : {f.name}) {{\n"
-                f"    s = writer.{prim.write_method}(elem);\n"
-                f"    if (!s) return s;\n"
-                f"}}"
+                f"s = writer.{prim.write_array_method}"
+                f"({f.name}.data(), {f.name}.size());\n"
+                f"if (!s) return s;"
             )
         elif elem_type in proto.enum_map:
             enum_def = proto.enum_map[elem_type]
@@ -747,6 +2749,756 @@ def _render_serialize_field_inner(f: FieldDef, proto: ProtocolDef, struct: Struc
     return f"// TODO: unsupported field kind {f.kind} for '{f.name}'"
 
 
+# ---------------------------------------------------------------------------
+# Fixed-layout helpers: one bounds check per struct, constant field offsets
+# ---------------------------------------------------------------------------
+
+def field_offsets(struct: StructDef, proto: ProtocolDef) -> list[tuple[FieldDef, int]]:
+    """Pair every field of a fixed-size *struct* with its byte offset."""
+    result = []
+    pos = 0
+    for f in struct.fields:
+        result.append((f, pos))
+        pos += proto._fixed_field_size(f)
+    return result
+
+
+def _offset_expr(pos: int) -> str:
+    return f"offset + {pos}" if pos else "offset"
+
+
+def _element_size(type_name: str, proto: ProtocolDef) -> str:
+    if type_name in proto.struct_map:
+        return f"{type_name}::kWireSize"
+    return str(proto._fixed_type_size(type_name))
+
+
+def render_parse_field_fixed(f: FieldDef, pos: int, proto: ProtocolDef,
+                             struct: StructDef) -> str:
+    """Return indented C++ code that loads one field at a constant offset."""
+    code = _render_parse_field_fixed_inner(f, pos, proto)
+    return _indent(_attribute_failures(
+        code, field_ids(proto)[(struct.name, f.name)]))
+
+
+def _render_parse_field_fixed_inner(f: FieldDef, pos: int, proto: ProtocolDef) -> str:
+    at = _offset_expr(pos)
+
+    if f.kind == TypeKind.PADDING:
+        return f"// {f.name}: {f.pad_size} byte(s) padding"
+
+    if f.kind == TypeKind.PRIMITIVE:
+        prim = PRIMITIVES[f.type]
+        lines = [f"{f.name} = reader.load_{f.type}_at({at});"]
+        if f.expected is not None:
+            lines.append(
+                f"if ({f.name} != {_format_expected(f.expected)}) "
+                f"return Status::BadMagic(reader.position() + {at});"
+            )
+        return "\n".join(lines)
+
+    if f.kind == TypeKind.ENUM:
+        enum_def = proto.enum_map[f.type]
+        prim = PRIMITIVES[enum_def.underlying_type]
+        tmp = f"_{f.name}_raw"
+        lines = [
+            f"const {prim.cpp_type} {tmp} = "
+            f"reader.load_{enum_def.underlying_type}_at({at});",
+            _enum_assign(f.name, tmp, enum_def),
+        ]
+        if f.expected is not None:
+            lines.append(
+                f"if ({tmp} != {_format_expected(f.expected)}) "
+                f"return Status::BadMagic(reader.position() + {at});"
+            )
+        return "\n".join(lines)
+
+    if f.kind == TypeKind.STRUCT:
+        return (
+            f"if (Status s = {f.name}.parse_unchecked(reader, {at}); !s) "
+            f"return s;"
+        )
+
+    if f.kind == TypeKind.BITFIELD:
+        prim = BITFIELD_TYPES[f.type]
+        tmp = f"_{f.name}_raw"
+        lines = [f"const {prim.cpp_type} {tmp} = reader.load_{prim.yaml_name}_at({at});"]
+        lines.extend(_bitfield_unpack_lines(f, tmp, proto))
+        return "\n".join(lines)
+
+    if f.kind == TypeKind.PACKED_BITS:
+        buf = f"_{f.name}_buf"
+        lines = [
+            f"uint8_t {buf}[{f.packed_size}];",
+            f"reader.load_bytes_at({at}, {buf}, sizeof({buf}));",
+        ]
+        lines.extend(_packed_unpack_lines(f, buf, proto))
+        return "\n".join(lines)
+
+    if f.kind in (TypeKind.BYTES, TypeKind.STRING):
+        return f"reader.load_bytes_at({at}, {f.name}.data(), {f.name}.size());"
+
+    if f.kind == TypeKind.ARRAY:
+        elem_type = f.element_type or "u8"
+        step = _element_size(elem_type, proto)
+        if elem_type in PRIMITIVES:
+            prim = PRIMITIVES[elem_type]
+            if prim.size == 1:
+                return (
+                    f"reader.load_bytes_at({at}, {f.name}.data(), {f.name}.size());"
+                )
+            return (
+                f"reader.load_{elem_type}_array_at("
+                f"{at}, {f.name}.data(), {f.name}.size());"
+            )
+        if elem_type in proto.enum_map:
+            enum_def = proto.enum_map[elem_type]
+            prim = PRIMITIVES[enum_def.underlying_type]
+            return (
+                f"for (size_t i = 0; i < {f.name}.size(); ++i) {{\n"
+                f"    const {prim.cpp_type} _tmp = reader.load_"
+                f"{enum_def.underlying_type}_at({at} + i * {step});\n"
+                f"    {_enum_assign(f'{f.name}[i]', '_tmp', enum_def)}\n"
+                f"}}"
+            )
+        return (
+            f"for (size_t i = 0; i < {f.name}.size(); ++i) {{\n"
+            f"    Status s = {f.name}[i].parse_unchecked(reader, {at} + i * {step});\n"
+            f"    if (!s) return s;\n"
+            f"}}"
+        )
+
+    return f"// TODO: unsupported field kind {f.kind} for '{f.name}'"
+
+
+def render_serialize_field_fixed(f: FieldDef, pos: int, proto: ProtocolDef) -> str:
+    """Return indented C++ code that stores one field at a constant offset."""
+    return _indent(_render_serialize_field_fixed_inner(f, pos, proto))
+
+
+def _render_serialize_field_fixed_inner(f: FieldDef, pos: int, proto: ProtocolDef) -> str:
+    at = _offset_expr(pos)
+
+    if f.kind == TypeKind.PADDING:
+        return f"// {f.name}: {f.pad_size} byte(s) padding"
+
+    if f.kind == TypeKind.PRIMITIVE:
+        return f"writer.store_{f.type}_at({at}, {f.name});"
+
+    if f.kind == TypeKind.ENUM:
+        enum_def = proto.enum_map[f.type]
+        prim = PRIMITIVES[enum_def.underlying_type]
+        return (
+            f"writer.store_{enum_def.underlying_type}_at("
+            f"{at}, static_cast<{prim.cpp_type}>({f.name}));"
+        )
+
+    if f.kind == TypeKind.STRUCT:
+        return f"{f.name}.serialize_unchecked(writer, {at});"
+
+    if f.kind == TypeKind.BITFIELD:
+        prim = BITFIELD_TYPES[f.type]
+        tmp = f"_{f.name}_raw"
+        lines = [f"{prim.cpp_type} {tmp}{{}};"]
+        lines.extend(_bitfield_pack_lines(f, tmp))
+        lines.append(f"writer.store_{prim.yaml_name}_at({at}, {tmp});")
+        return "\n".join(lines)
+
+    if f.kind == TypeKind.PACKED_BITS:
+        buf = f"_{f.name}_buf"
+        lines = _packed_pack_lines(f, buf)
+        lines.append(f"writer.store_bytes_at({at}, {buf}, sizeof({buf}));")
+        return "\n".join(lines)
+
+    if f.kind in (TypeKind.BYTES, TypeKind.STRING):
+        return f"writer.store_bytes_at({at}, {f.name}.data(), {f.name}.size());"
+
+    if f.kind == TypeKind.ARRAY:
+        elem_type = f.element_type or "u8"
+        step = _element_size(elem_type, proto)
+        if elem_type in PRIMITIVES:
+            prim = PRIMITIVES[elem_type]
+            if prim.size == 1:
+                return (
+                    f"writer.store_bytes_at({at}, {f.name}.data(), {f.name}.size());"
+                )
+            return (
+                f"writer.store_{elem_type}_array_at("
+                f"{at}, {f.name}.data(), {f.name}.size());"
+            )
+        if elem_type in proto.enum_map:
+            enum_def = proto.enum_map[elem_type]
+            prim = PRIMITIVES[enum_def.underlying_type]
+            return (
+                f"for (size_t i = 0; i < {f.name}.size(); ++i) {{\n"
+                f"    writer.store_{enum_def.underlying_type}_at("
+                f"{at} + i * {step}, static_cast<{prim.cpp_type}>({f.name}[i]));\n"
+                f"}}"
+            )
+        return (
+            f"for (size_t i = 0; i < {f.name}.size(); ++i) {{\n"
+            f"    {f.name}[i].serialize_unchecked(writer, {at} + i * {step});\n"
+            f"}}"
+        )
+
+    return f"// TODO: unsupported field kind {f.kind} for '{f.name}'"
+
+
+# ---------------------------------------------------------------------------
+# Field descriptors: the layout of a fixed-size struct as a constexpr tuple
+# ---------------------------------------------------------------------------
+
+def _wire_type(type_name: str, proto: ProtocolDef) -> str:
+    """WireType enumerator for one element of *type_name*."""
+    if type_name in proto.enum_map:
+        type_name = proto.enum_map[type_name].underlying_type
+    if type_name in proto.struct_map:
+        return "WireType::Struct"
+    return f"WireType::{type_name.upper()}"
+
+
+def _decoder_arg(type_name: str | None, proto: ProtocolDef) -> str:
+    """Trailing Decode argument for an enum-typed descriptor, else ''."""
+    if type_name and type_name in proto.enum_map:
+        return f", &{enum_decoder_name(proto.enum_map[type_name])}"
+    return ""
+
+
+def has_field_descriptors(struct: StructDef, proto: ProtocolDef) -> bool:
+    """Whether *struct* gets kFields: a fixed layout with no packed_bits
+    fields, whose nested structs have descriptors too."""
+    if proto.fixed_wire_size(struct) is None:
+        return False
+    for f in struct.fields:
+        if f.kind == TypeKind.PACKED_BITS:
+            return False
+        nested = f.element_type if f.kind == TypeKind.ARRAY else f.type
+        if nested in proto.struct_map and not has_field_descriptors(
+                proto.struct_map[nested], proto):
+            return False
+    return True
+
+
+def _field_descriptor(f: FieldDef, pos: int, struct: StructDef,
+                      proto: ProtocolDef, field_id: int) -> str:
+    member = f"&{struct.name}::{f.name}"
+    meta = f'{{"{f.name}", {field_id}}}'
+    if f.kind == TypeKind.PADDING:
+        return f"Padding<{pos}, {f.pad_size or 0}>{meta}"
+    if f.kind == TypeKind.BITFIELD:
+        slices = [
+            f"Bit<&{struct.name}::{b.name}, {b.offset}, {b.width}"
+            f"{_decoder_arg(b.enum_type, proto)}>"
+            for b in f.bits
+        ]
+        wire = _wire_type(BITFIELD_TYPES[f.type].yaml_name, proto)
+        return f"Bits<{wire}, {pos}, {', '.join(slices)}>{meta}"
+    if f.kind in (TypeKind.BYTES, TypeKind.STRING):
+        return f"Field<{member}, WireType::Bytes, {pos}>{meta}"
+    elem = (f.element_type or "u8") if f.kind == TypeKind.ARRAY else f.type
+    wire = _wire_type(elem, proto)
+    decode = _decoder_arg(elem, proto)
+    if f.expected is not None:
+        return (f"Expected<{member}, {wire}, {pos}, "
+                f"{_format_expected(f.expected)}{decode}>{meta}")
+    return f"Field<{member}, {wire}, {pos}{decode}>{meta}"
+
+
+def render_field_descriptors(struct: StructDef, proto: ProtocolDef) -> str:
+    """Return the codec_type alias and kFields tuple of a fixed-size
+    *struct*, or '' if it has none (see has_field_descriptors())."""
+    if not has_field_descriptors(struct, proto):
+        return ""
+    ids = field_ids(proto)
+    entries = [
+        _field_descriptor(f, pos, struct, proto, ids[(struct.name, f.name)])
+        for f, pos in field_offsets(struct, proto)
+    ]
+    lines = [
+        "/// Wire layout for decode(), encode() and for_each_field().",
+        f"using codec_type = {proto.codec_name};",
+    ]
+    if entries:
+        lines.append("static constexpr auto kFields = std::make_tuple(")
+        lines.extend(f"    {e}," for e in entries)
+        lines[-1] = lines[-1][:-1] + ");"
+    else:
+        lines.append("static constexpr auto kFields = std::make_tuple();")
+    return _indent("\n".join(lines), 1)
+
+
+# ---------------------------------------------------------------------------
+# View accessors: decode single fields of a fixed-size struct in place
+# ---------------------------------------------------------------------------
+
+def render_view_accessors(struct: StructDef, proto: ProtocolDef) -> str:
+    """Return the accessor methods of the View class for a fixed-size *struct*."""
+    blocks = []
+    for f, pos in field_offsets(struct, proto):
+        if f.kind == TypeKind.PADDING:
+            continue
+        blocks.extend(_view_field_accessors(f, pos, proto))
+    return "\n".join("\n" + _indent(b, 1) for b in blocks)
+
+
+def _view_return(cpp_type: str, raw_expr: str, enum_def: EnumDef | None,
+                 narrow: bool = False) -> str:
+    """Return a function body converting *raw_expr* to *cpp_type*."""
+    if enum_def is not None:
+        if narrow:
+            raw_expr = f"static_cast<{enum_def.cpp_underlying}>({raw_expr})"
+        return f"    return {enum_decoder_name(enum_def)}({raw_expr});"
+    if cpp_type == "bool":
+        return f"    return ({raw_expr}) != 0;"
+    return f"    return static_cast<{cpp_type}>({raw_expr});"
+
+
+def _view_accessor(doc: str, signature: str, body: str) -> str:
+    lines = [f"/// {doc}"] if doc else []
+    lines.append(f"{signature} const {{")
+    lines.append(body)
+    lines.append("}")
+    return "\n".join(lines)
+
+
+def _view_field_accessors(f: FieldDef, pos: int, proto: ProtocolDef) -> list[str]:
+    at = str(pos)
+
+    if f.kind == TypeKind.PRIMITIVE:
+        prim = PRIMITIVES[f.type]
+        return [_view_accessor(
+            f.description, f"{prim.cpp_type} {f.name}()",
+            f"    return reader().load_{f.type}_at({at});")]
+
+    if f.kind == TypeKind.ENUM:
+        enum_def = proto.enum_map[f.type]
+        raw = f"reader().load_{enum_def.underlying_type}_at({at})"
+        return [_view_accessor(
+            f.description, f"{f.type} {f.name}()",
+            _view_return(f.type, raw, enum_def))]
+
+    if f.kind == TypeKind.STRUCT:
+        return [_view_accessor(
+            f.description, f"{f.type}View {f.name}()",
+            f"    return {f.type}View(p_ + {at});")]
+
+    if f.kind == TypeKind.BITFIELD:
+        prim = BITFIELD_TYPES[f.type]
+        accessors = []
+        for b in f.bits:
+            mask = (1 << b.width) - 1
+            raw = f"(reader().load_{prim.yaml_name}_at({at}) >> {b.offset}) & 0x{mask:X}"
+            accessors.append(_view_accessor(
+                b.description, f"{_bitfield_member_type(b, proto)} {b.name}()",
+                _view_return(_bitfield_member_type(b, proto), raw,
+                             proto.enum_map.get(b.enum_type or ""),
+                             narrow=True)))
+        return accessors
+
+    if f.kind == TypeKind.PACKED_BITS:
+        # Each slice spans at most nine bytes; read just those, dropping the
+        # leading bits of the first byte.
+        order = BIT_ORDERS[f.bit_order]
+        accessors = []
+        for b in f.bits:
+            first = b.offset // 8
+            span = (b.offset + b.width - 1) // 8 - first + 1
+            lead = b.offset % 8
+            body = [f"    BitReaderT<{order}> bits(p_ + {pos + first}, {span});"]
+            if lead:
+                body.append(f"    static_cast<void>(bits.take_bits({lead}));")
+            body.append(_view_return(
+                _bitfield_member_type(b, proto), f"bits.take_bits({b.width})",
+                proto.enum_map.get(b.enum_type or ""), narrow=True))
+            accessors.append(_view_accessor(
+                b.description, f"{_bitfield_member_type(b, proto)} {b.name}()",
+                "\n".join(body)))
+        return accessors
+
+    if f.kind in (TypeKind.BYTES, TypeKind.STRING):
+        ptr = "uint8_t" if f.kind == TypeKind.BYTES else "char"
+        cast = (f"p_ + {at}" if ptr == "uint8_t"
+                else f"reinterpret_cast<const char*>(p_ + {at})")
+        return [
+            _view_accessor(f.description, f"const {ptr}* {f.name}()",
+                           f"    return {cast};"),
+            f"static constexpr size_t {f.name}_size() {{ return {f.length}; }}",
+        ]
+
+    if f.kind == TypeKind.ARRAY:
+        elem_type = f.element_type or "u8"
+        step = _element_size(elem_type, proto)
+        elem_at = f"{at} + i * {step}" if pos else f"i * {step}"
+        if elem_type in PRIMITIVES:
+            prim = PRIMITIVES[elem_type]
+            accessor = _view_accessor(
+                f.description, f"{prim.cpp_type} {f.name}(size_t i)",
+                f"    return reader().load_{elem_type}_at({elem_at});")
+        elif elem_type in proto.enum_map:
+            enum_def = proto.enum_map[elem_type]
+            raw = f"reader().load_{enum_def.underlying_type}_at({elem_at})"
+            accessor = _view_accessor(
+                f.description, f"{elem_type} {f.name}(size_t i)",
+                _view_return(elem_type, raw, enum_def))
+        else:
+            accessor = _view_accessor(
+                f.description, f"{elem_type}View {f.name}(size_t i)",
+                f"    return {elem_type}View(p_ + {elem_at});")
+        return [
+            accessor,
+            f"static constexpr size_t {f.name}_size() {{ return {f.length}; }}",
+        ]
+
+    return [f"// TODO: unsupported field kind {f.kind} for '{f.name}'"]
+
+
+# ---------------------------------------------------------------------------
+# Resync: skip corrupt input to the next place a struct's magic matches
+# ---------------------------------------------------------------------------
+
+def _resync_checks(struct: StructDef, proto: ProtocolDef, base: int = 0
+                   ) -> tuple[list[tuple[FieldDef, int, str]], bool]:
+    """Collect (field, offset, primitive) for the expected-value fields of
+    *struct* that sit at a constant offset, looking into nested structs.
+
+    The walk stops at the first field whose size or presence varies, since
+    nothing after it has a constant offset; the flag says whether it got
+    through the whole struct.
+    """
+    checks = []
+    pos = base
+    for f in struct.fields:
+        if f.condition:
+            return checks, False
+        if f.kind == TypeKind.STRUCT:
+            nested, complete = _resync_checks(proto.struct_map[f.type], proto,
+                                              pos)
+            checks.extend(nested)
+            if not complete:
+                return checks, False
+        elif f.expected is not None and f.kind == TypeKind.PRIMITIVE:
+            checks.append((f, pos, f.type))
+        elif f.expected is not None and f.kind == TypeKind.ENUM:
+            checks.append((f, pos, proto.enum_map[f.type].underlying_type))
+        size = proto._fixed_field_size(f)
+        if size is None:
+            return checks, False
+        pos += size
+    return checks, True
+
+
+def _at_expr(pos: int) -> str:
+    return f"at + {pos}" if pos else "at"
+
+
+def render_resync(struct: StructDef, proto: ProtocolDef) -> str:
+    """Return the static resync() member for *struct*, or an empty string
+    if it has no integer expected field at a constant offset to search for.
+
+    The widest such field is the search pattern; the others are compared
+    at each candidate before it is accepted.
+    """
+    checks, _ = _resync_checks(struct, proto)
+    anchors = [c for c in checks if c[2] in INTEGER_PRIMITIVES]
+    if not anchors:
+        return ""
+    anchor = max(anchors, key=lambda c: PRIMITIVES[c[2]].size)
+    f, offset, prim = anchor
+    size = PRIMITIVES[prim].size
+    value = _hex_literal(int(f.expected) & ((1 << (8 * size)) - 1))
+    search = f"find_u{size * 8}({value}, {_at_expr(offset)})"
+    others = [c for c in checks if c is not anchor]
+    end = max(pos + PRIMITIVES[p].size for _, pos, p in checks)
+
+    lines = [
+        "    /// Move @p reader's cursor to the next position past it where the",
+        f"    /// expected fields of a {struct.name} match, e.g. after parse() "
+        "failed",
+        "    /// there. Other fields are not checked, so parse() may still "
+        "fail.",
+    ]
+    if others:
+        lines += [
+            "    /// A candidate too close to the end to check is accepted; "
+            "parse()",
+            "    /// then reports it as cut off.",
+        ]
+    lines += [
+        f"    /// @tparam Reader {proto.reader_alias}.",
+        "    /// @return Status::Ok(), or Status::OutOfRange() with the cursor",
+        "    ///         unchanged if no candidate remains.",
+        "    template <typename Reader>",
+        "    static Status resync(Reader& reader) {",
+        "        static_assert(std::is_same_v<typename Reader::codec_type, "
+        f"{proto.codec_name}>,",
+        '                      "reader byte order does not match the '
+        'protocol");',
+    ]
+    if not others:
+        lines += [
+            f"        const size_t hit = reader.find_u{size * 8}({value}, "
+            f"{1 + offset});",
+            "        if (hit == Reader::npos) "
+            "return Status::OutOfRange(reader.position());",
+            f"        reader.advance({f'hit - {offset}' if offset else 'hit'});",
+            "        return Status::Ok();",
+            "    }",
+        ]
+        return "\n".join(lines)
+    conds = [
+        f"reader.load_{p}_at({_at_expr(pos)}) == "
+        f"{_format_expected(c.expected)}"
+        for c, pos, p in others
+    ]
+    lines += [
+        "        for (size_t at = 1;; ++at) {",
+        f"            at = reader.{search};",
+        "            if (at == Reader::npos) "
+        "return Status::OutOfRange(reader.position());",
+    ]
+    if offset:
+        lines.append(f"            at -= {offset};")
+    lines.append(f"            if (reader.remaining() - at < {end} ||")
+    lines.append("                (" + " &&\n                 ".join(conds)
+                 + ")) {")
+    lines += [
+        "                reader.advance(at);",
+        "                return Status::Ok();",
+        "            }",
+        "        }",
+        "    }",
+    ]
+    return "\n".join(lines)
+
+
+# ---------------------------------------------------------------------------
+# Batches: struct-of-arrays columns filled from many frames
+# ---------------------------------------------------------------------------
+
+def _batch_leaves(struct: StructDef, proto: ProtocolDef, prefix: str = "",
+                  base: int = 0) -> list[tuple[FieldDef, int, str, StructDef]]:
+    """Flatten *struct* into (field, offset, column prefix, owner) tuples.
+
+    Nested structs are expanded into their own fields, prefixed with the
+    member name, so each scalar gets its own column. Padding is dropped.
+    """
+    leaves = []
+    for f, pos in field_offsets(struct, proto):
+        if f.kind == TypeKind.PADDING:
+            continue
+        if f.kind == TypeKind.STRUCT:
+            leaves.extend(_batch_leaves(proto.struct_map[f.type], proto,
+                                        f"{prefix}{f.name}_", base + pos))
+        else:
+            leaves.append((f, base + pos, prefix, struct))
+    return leaves
+
+
+def _batch_element_type(f: FieldDef, proto: ProtocolDef) -> str:
+    """C++ type of one frame's entry in the column for *f*."""
+    if f.kind == TypeKind.BYTES:
+        return f"std::array<uint8_t, {f.length}>"
+    if f.kind == TypeKind.STRING:
+        return f"std::array<char, {f.length}>"
+    if f.kind == TypeKind.ARRAY:
+        elem_type = f.element_type or "u8"
+        return f"std::array<{_cpp_type(elem_type, proto)}, {f.length}>"
+    return _cpp_type(f.type, proto)
+
+
+def render_batch_columns(struct: StructDef, proto: ProtocolDef) -> str:
+    """Return the column members of the Batch class for *struct*."""
+    lines = []
+    for f, _, prefix, _ in _batch_leaves(struct, proto):
+        if f.kind in (TypeKind.BITFIELD, TypeKind.PACKED_BITS):
+            columns = [(b.description, _bitfield_member_type(b, proto), b.name)
+                       for b in f.bits]
+        else:
+            columns = [(f.description, _batch_element_type(f, proto), f.name)]
+        for doc, cpp, name in columns:
+            if doc:
+                lines.append(f"    /// {doc}")
+            lines.append(f"    std::array<{cpp}, Capacity> {prefix}{name}{{}};")
+    return "\n".join(lines)
+
+
+def render_batch_loads(struct: StructDef, proto: ProtocolDef) -> str:
+    """Return the loop body that decodes the frame under ``frame`` into
+    column row ``j``."""
+    ids = field_ids(proto)
+    blocks = []
+    for f, pos, prefix, owner in _batch_leaves(struct, proto):
+        code = _batch_field_loads(f, pos, prefix, proto)
+        blocks.append(_attribute_failures(code, ids[(owner.name, f.name)]))
+    # A failure keeps the frames before row j; see fail().
+    body = "\n".join(blocks)
+    body = re.sub(r"return ([^;]*\.in_field\(\d+\));",
+                  r"return fail(reader, j, \1);", body)
+    return _indent(body, 3)
+
+
+def batch_can_fail(struct: StructDef, proto: ProtocolDef) -> bool:
+    """Whether decoding a frame into the batch columns can fail, through an
+    expected value or a nested struct, so that the Batch needs fail()."""
+    return "return fail(reader, j," in render_batch_loads(struct, proto)
+
+
+def _batch_field_loads(f: FieldDef, pos: int, prefix: str,
+                       proto: ProtocolDef) -> str:
+    col = f"{prefix}{f.name}[j]"
+    at = str(pos)
+    where = f"frame.position() + {at}" if pos else "frame.position()"
+
+    if f.kind == TypeKind.PRIMITIVE:
+        lines = [f"{col} = frame.load_{f.type}_at({at});"]
+        if f.expected is not None:
+            lines.append(
+                f"if ({col} != {_format_expected(f.expected)}) "
+                f"return Status::BadMagic({where});"
+            )
+        return "\n".join(lines)
+
+    if f.kind == TypeKind.ENUM:
+        enum_def = proto.enum_map[f.type]
+        raw = f"frame.load_{enum_def.underlying_type}_at({at})"
+        if f.expected is None:
+            return _enum_assign(col, raw, enum_def)
+        prim = PRIMITIVES[enum_def.underlying_type]
+        tmp = f"_{prefix}{f.name}_raw"
+        return "\n".join([
+            f"const {prim.cpp_type} {tmp} = {raw};",
+            _enum_assign(col, tmp, enum_def),
+            f"if ({tmp} != {_format_expected(f.expected)}) "
+            f"return Status::BadMagic({where});",
+        ])
+
+    if f.kind == TypeKind.BITFIELD:
+        prim = BITFIELD_TYPES[f.type]
+        tmp = f"_{prefix}{f.name}_raw"
+        lines = [f"const {prim.cpp_type} {tmp} = frame.load_{prim.yaml_name}_at({at});"]
+        lines.extend(_bitfield_unpack_lines(f, tmp, proto, prefix + "{}[j]"))
+        return "\n".join(lines)
+
+    if f.kind == TypeKind.PACKED_BITS:
+        buf = f"_{prefix}{f.name}_buf"
+        lines = [
+            f"uint8_t {buf}[{f.packed_size}];",
+            f"frame.load_bytes_at({at}, {buf}, sizeof({buf}));",
+        ]
+        lines.extend(_packed_unpack_lines(f, buf, proto, prefix + "{}[j]",
+                                          f"_{prefix}{f.name}_bits"))
+        return "\n".join(lines)
+
+    if f.kind in (TypeKind.BYTES, TypeKind.STRING):
+        return f"frame.load_bytes_at({at}, {col}.data(), {col}.size());"
+
+    if f.kind == TypeKind.ARRAY:
+        elem_type = f.element_type or "u8"
+        step = _element_size(elem_type, proto)
+        if elem_type in PRIMITIVES:
+            if PRIMITIVES[elem_type].size == 1:
+                return f"frame.load_bytes_at({at}, {col}.data(), {col}.size());"
+            return (
+                f"frame.load_{elem_type}_array_at({at}, {col}.data(), {col}.size());"
+            )
+        if elem_type in proto.enum_map:
+            enum_def = proto.enum_map[elem_type]
+            raw = f"frame.load_{enum_def.underlying_type}_at({at} + k * {step})"
+            return (
+                f"for (size_t k = 0; k < {col}.size(); ++k) {{\n"
+                f"    {_enum_assign(f'{col}[k]', raw, enum_def)}\n"
+                f"}}"
+            )
+        return (
+            f"for (size_t k = 0; k < {col}.size(); ++k) {{\n"
+            f"    Status s = {col}[k].parse_unchecked(frame, {at} + k * {step});\n"
+            f"    if (!s) return s;\n"
+            f"}}"
+        )
+
+    return f"// TODO: unsupported field kind {f.kind} for '{f.name}'"
+
+
+# ---------------------------------------------------------------------------
+# Dispatchers
+# ---------------------------------------------------------------------------
+
+# Routed values spanning more than this many codes use a switch instead of a
+# jump table, so sparse enums do not produce huge tables.
+MAX_DISPATCH_TABLE = 256
+
+
+def dispatch_info(d: DispatchDef, proto: ProtocolDef) -> SimpleNamespace:
+    """Return the template inputs for dispatcher *d*: the raw discriminator
+    type and offset, and the jump-table rows (empty for a switch)."""
+    header = proto.struct_map[d.header]
+    offsets = {f.name: pos for f, pos in field_offsets(header, proto)}
+    ids = field_ids(proto)
+    disc = next(f for f in header.fields if f.name == d.discriminator)
+    underlying = proto.enum_map[disc.type].underlying_type
+
+    by_value = {r.value.value: r for r in d.routes}
+    lo, hi = min(by_value), max(by_value)
+    table = []
+    if hi - lo < MAX_DISPATCH_TABLE:
+        for value in range(lo, hi + 1):
+            r = by_value.get(value)
+            table.append((
+                _hex_literal(value),
+                r.value.name if r else "",
+                (r.payload or "std::monostate") if r else "",
+            ))
+    fixed = [p for p in d.payloads
+             if proto.fixed_wire_size(proto.struct_map[p]) is not None]
+    return SimpleNamespace(
+        in_place=" || ".join(f"std::is_same_v<P, {p}>" for p in fixed) or "false",
+        enum_type=disc.type,
+        raw_type=PRIMITIVES[underlying].cpp_type,
+        raw_yaml=underlying,
+        offset=offsets[d.discriminator],
+        discriminator_id=ids[(d.header, d.discriminator)],
+        length_id=ids[(d.header, d.length)] if d.length else 0,
+        base=_hex_literal(lo) if lo >= 0 else f"({lo})",
+        table=table,
+    )
+
+
+# ---------------------------------------------------------------------------
+# Instrumentation probes
+# ---------------------------------------------------------------------------
+
+def probe_site(struct: StructDef, op: str, proto: ProtocolDef,
+               field: FieldDef | None = None) -> str:
+    """Static site name a probe reports, e.g. ``ns::Foo::parse/bar``."""
+    site = f"{struct.name}::{op}"
+    if proto.namespace:
+        site = f"{proto.namespace}::{site}"
+    if field is not None:
+        site += f"/{field.name}"
+    return site
+
+
+def probe_field(code: str, struct: StructDef, f: FieldDef, op: str,
+                proto: ProtocolDef, instrument: bool) -> str:
+    """Wrap the parse or serialize code of field *f* in its own probe."""
+    if not instrument or f.kind == TypeKind.PADDING:
+        return code
+    stream = "Reader" if op == "parse" else "Writer"
+    var = "reader" if op == "parse" else "writer"
+    site = probe_site(struct, op, proto, f)
+    return "\n".join([
+        "        {",
+        f'            InstrumentProbe<{stream}> _field_probe({var}, "{site}");',
+        _indent(code.strip("\n"), 1),
+        "            _field_probe.succeed();",
+        "        }",
+    ])
+
+
+def _only_padding(struct: StructDef) -> bool:
+    return all(f.kind == TypeKind.PADDING for f in struct.fields)
+
+
 # ---------------------------------------------------------------------------
 # Main generation entry point
 # ---------------------------------------------------------------------------
@@ -759,6 +3511,34 @@ def _make_guard(proto: ProtocolDef, suffix: str) -> str:
     return guard
 
 
+# Runtime names the protocol header refers to unqualified. In shared-runtime
+# mode they are pulled in from binary-io.hpp instead of a per-protocol copy.
+SHARED_RUNTIME_NAMES = (
+    "Status", "StatusCode",
+    "LittleEndianCodec", "BigEndianCodec",
+    "ByteReaderT", "ChunkedReaderT", "ByteWriterT", "SizeCounterT",
+    "DynamicByteWriterT", "ByteSegment",
+    "LEReader", "BEReader", "LEChunkedReader", "BEChunkedReader",
+    "LEWriter", "BEWriter", "DynamicLEWriter", "DynamicBEWriter",
+    "LESizeCounter", "BESizeCounter",
+    "MsbFirst", "LsbFirst", "BitReaderT", "BitWriterT",
+    "read_delta_array", "write_delta_array",
+    "read_for_array", "write_for_array",
+    "WireType", "Field", "Expected", "Bit", "Bits", "Padding",
+    "decode", "encode", "for_each_field",
+    "NoInstrument", "InstrumentOfT", "InstrumentProbe",
+)
+
+
+def render_shared_runtime() -> str:
+    """Using-declarations that make the ``bio::`` runtime visible unqualified."""
+    lines = [
+        "// I/O primitives come from the shared binary-io runtime.",
+    ]
+    lines.extend(f"using bio::{name};" for name in SHARED_RUNTIME_NAMES)
+    return "\n".join(lines)
+
+
 def generate_io_header(proto: ProtocolDef) -> str:
     """Render the self-contained I/O primitives header for *proto*."""
     io_guard = _make_guard(proto, "IO_HPP")
@@ -773,8 +3553,16 @@ def generate_io_header(proto: ProtocolDef) -> str:
 
 
 def generate_header(proto: ProtocolDef, source_file: str = "<unknown>",
-                    io_filename: str = "") -> str:
-    """Render a complete C++ protocol header for *proto*."""
+                    io_filename: str = "",
+                    shared_runtime: bool = False,
+                    instrument: bool = False) -> str:
+    """Render a complete C++ protocol header for *proto*.
+
+    With *shared_runtime* the header includes ``binary-io/binary-io.hpp``
+    and uses the ``bio::`` types instead of a generated I/O header. With
+    *instrument* every parse() and serialize(), and every field of structs
+    without a fixed layout, reports to an ``InstrumentProbe``.
+    """
     guard_name = _make_guard(proto, "PROTOCOL_HPP")
 
     env = Environment(loader=BaseLoader(), keep_trailing_newline=True)
@@ -784,11 +3572,29 @@ def generate_header(proto: ProtocolDef, source_file: str = "<unknown>",
         source_file=source_file,
         guard=guard_name,
         io_include=io_filename,
+        shared_runtime=shared_runtime,
+        render_shared_runtime=render_shared_runtime,
+        instrument=instrument,
+        probe_site=probe_site,
+        probe_field=probe_field,
         hex_literal=_hex_literal,
         cpp_type=_cpp_type,
         bitfield_member_type=_bitfield_member_type,
         render_parse_field=render_parse_field,
         render_serialize_field=render_serialize_field,
+        render_parse_field_fixed=render_parse_field_fixed,
+        render_serialize_field_fixed=render_serialize_field_fixed,
+        field_offsets=field_offsets,
+        render_view_accessors=render_view_accessors,
+        render_batch_columns=render_batch_columns,
+        batch_can_fail=batch_can_fail,
+        render_batch_loads=render_batch_loads,
+        render_resync=render_resync,
+        render_field_descriptors=render_field_descriptors,
+        render_enum_decoder=render_enum_decoder,
+        render_field_names=render_field_names,
+        dispatch_info=dispatch_info,
+        only_padding=_only_padding,
     )
     template = env.from_string(HEADER_TEMPLATE)
     return template.render()
@@ -805,10 +3611,14 @@ def generate_to_file(
     proto: ProtocolDef,
     output_dir: pathlib.Path,
     source_file: str = "<unknown>",
+    shared_runtime: bool = False,
+    instrument: bool = False,
 ) -> List[pathlib.Path]:
     """Generate io + protocol headers for *proto* into *output_dir*.
 
-    Returns the list of paths written (io header, protocol header).
+    Returns the list of paths written (io header, protocol header). With
+    *shared_runtime* no io header is written and only the protocol header
+    path is returned.
     """
     output_dir.mkdir(parents=True, exist_ok=True)
     base = _to_snake_case(proto.name)
@@ -816,13 +3626,19 @@ def generate_to_file(
     io_filename = base + "_io.hpp"
     proto_filename = base + "_protocol.hpp"
 
-    io_path = output_dir / io_filename
-    io_content = generate_io_header(proto)
-    io_path.write_text(io_content, encoding="utf-8")
+    paths: List[pathlib.Path] = []
+    if not shared_runtime:
+        io_path = output_dir / io_filename
+        io_content = generate_io_header(proto)
+        io_path.write_text(io_content, encoding="utf-8")
+        paths.append(io_path)
 
     proto_path = output_dir / proto_filename
     proto_content = generate_header(proto, source_file=source_file,
-                                    io_filename=io_filename)
+                                    io_filename=io_filename,
+                                    shared_runtime=shared_runtime,
+                                    instrument=instrument)
     proto_path.write_text(proto_content, encoding="utf-8")
+    paths.append(proto_path)
 
-    return [io_path, proto_path]
+    return paths
@@ -10,12 +10,17 @@ import yaml
 
 from .schema import PROTOCOL_SCHEMA
 from .types import (
+    INTEGER_PRIMITIVES,
+    PACKED_BITS,
     BitDef,
+    DispatchDef,
+    DispatchRoute,
     EnumDef,
     EnumValue,
     FieldDef,
     ProtocolDef,
     StructDef,
+    TypeKind,
 )
 
 
@@ -49,6 +54,63 @@ def _build_enum(raw: dict) -> EnumDef:
     )
 
 
+def _build_bits(raw: dict) -> List[BitDef]:
+    """Build the bit slices of a bitfield or packed_bits field.
+
+    Bitfield slices give explicit offsets into their container. packed_bits
+    slices are laid out back to back in declaration order, so they take
+    their offsets from the running total and must fill whole bytes.
+    """
+    packed = raw["type"] == PACKED_BITS
+    name = raw["name"]
+    if "bit_order" in raw and not packed:
+        raise ParseError(f"Field '{name}': bit_order requires type packed_bits")
+    if packed and not raw.get("bits"):
+        raise ParseError(f"Field '{name}': packed_bits requires bits")
+
+    bits: List[BitDef] = []
+    pos = 0
+    for b in raw.get("bits", []):
+        if packed and "offset" in b:
+            raise ParseError(
+                f"Field '{name}': packed_bits slice '{b['name']}' must not "
+                f"have an offset"
+            )
+        if not packed and "offset" not in b:
+            raise ParseError(
+                f"Field '{name}': bit slice '{b['name']}' requires an offset"
+            )
+        bits.append(
+            BitDef(
+                name=b["name"],
+                offset=pos if packed else b["offset"],
+                width=b["width"],
+                description=b.get("description", ""),
+                enum_type=b.get("type"),
+            )
+        )
+        pos += b["width"]
+
+    if packed and pos % 8:
+        raise ParseError(
+            f"Field '{name}': packed_bits widths sum to {pos}, "
+            f"not a whole number of bytes"
+        )
+    return bits
+
+
+def _check_encoding(raw: dict) -> None:
+    """Packed array codings apply only to arrays of integer primitives."""
+    if "encoding" not in raw:
+        return
+    element = raw.get("element_type", "u8")
+    if raw["type"] != "array" or element not in INTEGER_PRIMITIVES:
+        raise ParseError(
+            f"Field '{raw['name']}': encoding '{raw['encoding']}' requires "
+            f"an array of integer primitives"
+        )
+
+
 def _build_field(raw: dict) -> FieldDef:
     length = raw.get("length")
     if isinstance(length, int):
@@ -58,16 +120,8 @@ def _build_field(raw: dict) -> FieldDef:
     if isinstance(expected, str) and expected.startswith("0x"):
         expected = int(expected, 16)
 
-    bits = [
-        BitDef(
-            name=b["name"],
-            offset=b["offset"],
-            width=b["width"],
-            description=b.get("description", ""),
-            enum_type=b.get("type"),
-        )
-        for b in raw.get("bits", [])
-    ]
+    bits = _build_bits(raw)
+    _check_encoding(raw)
 
     return FieldDef(
         name=raw["name"],
@@ -79,6 +133,8 @@ def _build_field(raw: dict) -> FieldDef:
         pad_size=raw.get("pad_size"),
         condition=raw.get("condition"),
         bits=bits,
+        bit_order=raw.get("bit_order", "msb_first"),
+        encoding=raw.get("encoding"),
     )
 
 
@@ -88,6 +144,71 @@ def _build_struct(raw: dict) -> StructDef:
         name=raw["name"],
         fields=fields,
         description=raw.get("description", ""),
+        batch=raw.get("batch", False),
+    )
+
+
+def _check_batch(struct: StructDef, proto: ProtocolDef) -> None:
+    """Batch columns are filled from frames at a constant stride, so only
+    fixed-size structs can have them."""
+    if struct.batch and proto.fixed_wire_size(struct) is None:
+        raise ParseError(f"Struct '{struct.name}': batch requires a fixed-size struct")
+
+
+def _build_dispatch(raw: dict, proto: ProtocolDef) -> DispatchDef:
+    """Build a dispatcher and check it against the resolved protocol.
+
+    The header must be fixed-size so the raw discriminator can be read at a
+    constant offset before the header is decoded.
+    """
+    name = raw["name"]
+    header = proto.struct_map.get(raw["header"])
+    if header is None:
+        raise ParseError(f"Dispatch '{name}': unknown header '{raw['header']}'")
+    if proto.fixed_wire_size(header) is None:
+        raise ParseError(
+            f"Dispatch '{name}': header '{header.name}' must be fixed-size"
+        )
+    fields = {f.name: f for f in header.fields}
+    disc = fields.get(raw["discriminator"])
+    if disc is None or disc.kind != TypeKind.ENUM:
+        raise ParseError(
+            f"Dispatch '{name}': discriminator '{raw['discriminator']}' must "
+            f"be an enum field of '{header.name}'"
+        )
+    length = raw.get("length")
+    if length is not None:
+        f = fields.get(length)
+        if f is None or f.kind != TypeKind.PRIMITIVE or f.type in ("f32", "f64"):
+            raise ParseError(
+                f"Dispatch '{name}': length '{length}' must be an integer "
+                f"field of '{header.name}'"
+            )
+
+    enum_def = proto.enum_map[disc.type]
+    values = {v.name: v for v in enum_def.values}
+    routes: List[DispatchRoute] = []
+    for r in raw["routes"]:
+        value = values.get(r["value"])
+        if value is None:
+            raise ParseError(
+                f"Dispatch '{name}': '{r['value']}' is not a value of "
+                f"'{enum_def.name}'"
+            )
+        if any(existing.value.value == value.value for existing in routes):
+            raise ParseError(f"Dispatch '{name}': duplicate route '{value.name}'")
+        payload = r.get("payload")
+        if payload is not None and payload not in proto.struct_map:
+            raise ParseError(f"Dispatch '{name}': unknown payload '{payload}'")
+        routes.append(DispatchRoute(value=value, payload=payload))
+
+    return DispatchDef(
+        name=name,
+        header=header.name,
+        discriminator=disc.name,
+        length=length,
+        routes=routes,
+        description=raw.get("description", ""),
     )
 
 
@@ -121,6 +242,10 @@ def load_protocol(path: pathlib.Path) -> ProtocolDef:
         proto.structs.append(_build_struct(s))
 
     proto.resolve()
+    for s in proto.structs:
+        _check_batch(s, proto)
+    for d in raw.get("dispatch", []):
+        proto.dispatchers.append(_build_dispatch(d, proto))
     return proto
 
 
@@ -91,6 +91,10 @@ PROTOCOL_SCHEMA = {
                         "pattern": "^[A-Za-z_][A-Za-z0-9_]*$",
                     },
                     "description": {"type": "string"},
+                    "batch": {
+                        "type": "boolean",
+                        "description": "Also generate a column-wise <Name>Batch container (fixed-size structs only).",
+                    },
                     "fields": {
                         "type": "array",
                         "minItems": 1,
@@ -130,13 +134,23 @@ PROTOCOL_SCHEMA = {
                                     "type": "string",
                                     "description": "C++ boolean expression guarding this field.",
                                 },
+                                "encoding": {
+                                    "type": "string",
+                                    "enum": ["delta", "for"],
+                                    "description": "Packed integer array coding: zigzag deltas or offsets from the minimum.",
+                                },
+                                "bit_order": {
+                                    "type": "string",
+                                    "enum": ["msb_first", "lsb_first"],
+                                    "description": "Bit order within each byte (packed_bits only).",
+                                },
                                 "bits": {
                                     "type": "array",
                                     "minItems": 1,
-                                    "description": "Bit-slice definitions (for bitfield_u8/u16/u32).",
+                                    "description": "Bit-slice definitions (for bitfield_u8/u16/u32 and packed_bits).",
                                     "items": {
                                         "type": "object",
-                                        "required": ["name", "offset", "width"],
+                                        "required": ["name", "width"],
                                         "additionalProperties": False,
                                         "properties": {
                                             "name": {
@@ -146,11 +160,12 @@ PROTOCOL_SCHEMA = {
                                             "offset": {
                                                 "type": "integer",
                                                 "minimum": 0,
-                                                "description": "Bit offset from LSB.",
+                                                "description": "Bit offset from LSB (bitfield_u8/u16/u32 only).",
                                             },
                                             "width": {
                                                 "type": "integer",
                                                 "minimum": 1,
+                                                "maximum": 64,
                                                 "description": "Number of bits.",
                                             },
                                             "type": {
@@ -168,5 +183,52 @@ PROTOCOL_SCHEMA = {
                 },
             },
         },
+        "dispatch": {
+            "type": "array",
+            "description": "Demultiplexers choosing a payload struct from a header enum field.",
+            "items": {
+                "type": "object",
+                "required": ["name", "header", "discriminator", "routes"],
+                "additionalProperties": False,
+                "properties": {
+                    "name": {
+                        "type": "string",
+                        "pattern": "^[A-Za-z_][A-Za-z0-9_]*$",
+                    },
+                    "header": {
+                        "type": "string",
+                        "description": "Fixed-size struct read before every payload.",
+                    },
+                    "discriminator": {
+                        "type": "string",
+                        "description": "Enum field of the header that selects the payload.",
+                    },
+                    "length": {
+                        "type": "string",
+                        "description": "Integer header field giving the payload size in bytes; lets unknown types be skipped.",
+                    },
+                    "description": {"type": "string"},
+                    "routes": {
+                        "type": "array",
+                        "minItems": 1,
+                        "items": {
+                            "type": "object",
+                            "required": ["value"],
+                            "additionalProperties": False,
+                            "properties": {
+                                "value": {
+                                    "type": "string",
+                                    "description": "Enum value name of the discriminator.",
+                                },
+                                "payload": {
+                                    "type": "string",
+                                    "description": "Struct parsed after the header; omit for header-only messages.",
+                                },
+                            },
+                        },
+                    },
+                },
+            },
+        },
     },
 }
@@ -11,12 +11,14 @@ class TypeKind(Enum):
     """Classification of protocol field types."""
 
     PRIMITIVE = auto()
+    VARINT = auto()
     ENUM = auto()
     STRUCT = auto()
     BYTES = auto()
     STRING = auto()
     ARRAY = auto()
     BITFIELD = auto()
+    PACKED_BITS = auto()
     PADDING = auto()
 
 
@@ -30,6 +32,16 @@ class PrimitiveType:
     write_method: str
     size: int  # bytes
 
+    @property
+    def read_array_method(self) -> str:
+        """Bulk reader method for a contiguous array of this type."""
+        return self.read_method + "_array"
+
+    @property
+    def write_array_method(self) -> str:
+        """Bulk writer method for a contiguous array of this type."""
+        return self.write_method + "_array"
+
 
 # All primitive types supported by binary-io.hpp
 PRIMITIVES: Dict[str, PrimitiveType] = {
@@ -47,6 +59,18 @@ PRIMITIVES: Dict[str, PrimitiveType] = {
 
 PRIMITIVE_NAMES = set(PRIMITIVES.keys())
 
+# Element types accepted by the delta / frame-of-reference array codings
+INTEGER_PRIMITIVES = PRIMITIVE_NAMES - {"f32", "f64"}
+
+# LEB128 variable-length integers; zigzag-encoded when signed. Their size
+# depends on the value, so structs containing them are never fixed-size.
+VARINT_TYPES: Dict[str, PrimitiveType] = {
+    "varuint": PrimitiveType(
+        "varuint", "uint64_t", "read_varuint", "write_varuint", 0),
+    "varint": PrimitiveType(
+        "varint", "int64_t", "read_varint", "write_varint", 0),
+}
+
 BYTE_ORDERS = {
     "little_endian": ("LittleEndianCodec", "LEReader", "LEWriter"),
     "big_endian": ("BigEndianCodec", "BEReader", "BEWriter"),
@@ -81,7 +105,7 @@ class BitDef:
     """One named bit-slice within a bitfield."""
 
     name: str
-    offset: int  # bit offset from LSB
+    offset: int  # bit offset from LSB (bitfield) or stream start (packed_bits)
     width: int   # number of bits
     description: str = ""
     enum_type: Optional[str] = None  # enum name if this slice maps to an enum
@@ -93,6 +117,13 @@ BITFIELD_TYPES: Dict[str, PrimitiveType] = {
     "bitfield_u32": PRIMITIVES["u32"],
 }
 
+PACKED_BITS = "packed_bits"
+
+BIT_ORDERS = {
+    "msb_first": "MsbFirst",
+    "lsb_first": "LsbFirst",
+}
+
 
 @dataclass
 class FieldDef:
@@ -121,6 +152,17 @@ class FieldDef:
     # For bitfields: list of bit-slice definitions
     bits: List[BitDef] = field(default_factory=list)
 
+    # For packed_bits: order of bits within each byte (key into BIT_ORDERS)
+    bit_order: str = "msb_first"
+
+    # For integer arrays: packed coding ("delta" or "for"), or None for raw
+    encoding: Optional[str] = None
+
+    @property
+    def packed_size(self) -> int:
+        """Encoded size in bytes of a packed_bits field."""
+        return sum(b.width for b in self.bits) // 8
+
 
 @dataclass
 class StructDef:
@@ -129,6 +171,37 @@ class StructDef:
     name: str
     fields: List[FieldDef] = field(default_factory=list)
     description: str = ""
+    batch: bool = False  # also generate a struct-of-arrays <name>Batch
+
+
+@dataclass
+class DispatchRoute:
+    """One discriminator value of a dispatcher and the payload it selects."""
+
+    value: EnumValue
+    payload: Optional[str] = None  # struct name; None for header-only
+
+
+@dataclass
+class DispatchDef:
+    """A demultiplexer that parses a header, then the payload selected by
+    one of its enum fields."""
+
+    name: str
+    header: str
+    discriminator: str
+    length: Optional[str] = None
+    routes: List[DispatchRoute] = field(default_factory=list)
+    description: str = ""
+
+    @property
+    def payloads(self) -> List[str]:
+        """Distinct payload structs in route order."""
+        seen: List[str] = []
+        for r in self.routes:
+            if r.payload and r.payload not in seen:
+                seen.append(r.payload)
+        return seen
 
 
 @dataclass
@@ -142,6 +215,7 @@ class ProtocolDef:
     includes: List[str] = field(default_factory=list)
     enums: List[EnumDef] = field(default_factory=list)
     structs: List[StructDef] = field(default_factory=list)
+    dispatchers: List[DispatchDef] = field(default_factory=list)
 
     # Built during resolution
     enum_map: Dict[str, EnumDef] = field(default_factory=dict, repr=False)
@@ -161,6 +235,8 @@ class ProtocolDef:
             return TypeKind.PADDING
         if f.type in BITFIELD_TYPES:
             return TypeKind.BITFIELD
+        if f.type == PACKED_BITS:
+            return TypeKind.PACKED_BITS
         if f.type == "bytes":
             return TypeKind.BYTES
         if f.type == "string":
@@ -173,6 +249,8 @@ class ProtocolDef:
             return TypeKind.STRUCT
         if f.type in PRIMITIVES:
             return TypeKind.PRIMITIVE
+        if f.type in VARINT_TYPES:
+            return TypeKind.VARINT
         raise ValueError(
             f"Unknown type '{f.type}' in field '{f.name}'"
         )
@@ -188,3 +266,50 @@ class ProtocolDef:
     @property
     def writer_alias(self) -> str:
         return BYTE_ORDERS[self.byte_order][2]
+
+    def fixed_wire_size(self, struct: StructDef) -> Optional[int]:
+        """Return the encoded size of *struct* if it is the same for every
+        message, or ``None`` when any field is conditional or has a length
+        that is not a compile-time integer.
+
+        Fixed-size structs get a single up-front bounds check and read
+        their fields at constant offsets.
+        """
+        total = 0
+        for f in struct.fields:
+            size = self._fixed_field_size(f)
+            if size is None:
+                return None
+            total += size
+        return total
+
+    def _fixed_field_size(self, f: FieldDef) -> Optional[int]:
+        if f.condition or f.encoding:
+            return None
+        if f.kind == TypeKind.PADDING:
+            return f.pad_size or 0
+        if f.kind in (TypeKind.BYTES, TypeKind.STRING, TypeKind.ARRAY):
+            try:
+                count = int(str(f.length), 0)
+            except ValueError:
+                return None
+            if f.kind != TypeKind.ARRAY:
+                return count
+            elem = self._fixed_type_size(f.element_type or "u8")
+            return None if elem is None else count * elem
+        if f.kind == TypeKind.BITFIELD:
+            return BITFIELD_TYPES[f.type].size
+        if f.kind == TypeKind.PACKED_BITS:
+            return f.packed_size
+        if f.kind == TypeKind.VARINT:
+            return None
+        return self._fixed_type_size(f.type)
+
+    def _fixed_type_size(self, type_name: str) -> Optional[int]:
+        if type_name in PRIMITIVES:
+            return PRIMITIVES[type_name].size
+        if type_name in self.enum_map:
+            return PRIMITIVES[self.enum_map[type_name].underlying_type].size
+        if type_name in self.struct_map:
+            return self.fixed_wire_size(self.struct_map[type_name])
+        return None
@@ -163,6 +163,144 @@ class TestParserInvalid:
         with pytest.raises(ValueError, match="Unknown type"):
             load_protocol(path)
 
+    def test_packed_bits_partial_byte(self, tmp_path):
+        path = _write_yaml(tmp_path, """\
+            protocol:
+              name: Bad
+            structs:
+              - name: S
+                fields:
+                  - name: x
+                    type: packed_bits
+                    bits:
+                      - name: a
+                        width: 3
+                      - name: b
+                        width: 4
+        """)
+        with pytest.raises(ParseError, match="whole number of bytes"):
+            load_protocol(path)
+
+    def test_packed_bits_offset(self, tmp_path):
+        path = _write_yaml(tmp_path, """\
+            protocol:
+              name: Bad
+            structs:
+              - name: S
+                fields:
+                  - name: x
+                    type: packed_bits
+                    bits:
+                      - name: a
+                        offset: 0
+                        width: 8
+        """)
+        with pytest.raises(ParseError, match="must not have an offset"):
+            load_protocol(path)
+
+    def test_bitfield_requires_offset(self, tmp_path):
+        path = _write_yaml(tmp_path, """\
+            protocol:
+              name: Bad
+            structs:
+              - name: S
+                fields:
+                  - name: x
+                    type: bitfield_u8
+                    bits:
+                      - name: a
+                        width: 8
+        """)
+        with pytest.raises(ParseError, match="requires an offset"):
+            load_protocol(path)
+
+    def test_encoding_requires_integer_array(self, tmp_path):
+        path = _write_yaml(tmp_path, """\
+            protocol:
+              name: Bad
+            structs:
+              - name: S
+                fields:
+                  - name: xs
+                    type: array
+                    element_type: f32
+                    length: 8
+                    encoding: delta
+        """)
+        with pytest.raises(ParseError, match="array of integer primitives"):
+            load_protocol(path)
+
+    def test_batch_requires_fixed_size(self, tmp_path):
+        path = _write_yaml(tmp_path, """\
+            protocol:
+              name: Bad
+            structs:
+              - name: Msg
+                batch: true
+                fields:
+                  - name: n
+                    type: varuint
+        """)
+        with pytest.raises(ParseError, match="batch requires a fixed-size struct"):
+            load_protocol(path)
+
+    DISPATCH_BASE = """\
+        protocol:
+          name: D
+        enums:
+          - name: Kind
+            type: u8
+            values:
+              - name: A
+                value: 0
+              - name: B
+                value: 1
+        structs:
+          - name: Head
+            fields:
+              - name: kind
+                type: Kind
+              - name: size
+                type: u16
+              - name: extra
+                type: u8
+                condition: size != 0
+          - name: Fixed
+            fields:
+              - name: kind
+                type: Kind
+              - name: ratio
+                type: f32
+        dispatch:
+          - name: Bad
+    """
+
+    def _dispatch_yaml(self, tmp_path, *lines):
+        body = "".join(f"    {line}\n" for line in lines)
+        return _write_yaml(tmp_path, textwrap.dedent(self.DISPATCH_BASE) + body)
+
+    @pytest.mark.parametrize("header, discriminator, length, message", [
+        ("Head", "kind", None, "must be fixed-size"),
+        ("Fixed", "ratio", None, "must be an enum field"),
+        ("Fixed", "kind", "ratio", "must be an integer field"),
+    ])
+    def test_dispatch_invalid_header(self, tmp_path, header, discriminator,
+                                     length, message):
+        lines = [f"header: {header}", f"discriminator: {discriminator}"]
+        if length:
+            lines.append(f"length: {length}")
+        path = self._dispatch_yaml(tmp_path, *lines, "routes:",
+                                   "  - value: A")
+        with pytest.raises(ParseError, match=message):
+            load_protocol(path)
+
+    def test_dispatch_invalid_route(self, tmp_path):
+        path = self._dispatch_yaml(tmp_path, "header: Fixed",
+                                   "discriminator: kind", "routes:",
+                                   "  - value: C")
+        with pytest.raises(ParseError, match="not a value of 'Kind'"):
+            load_protocol(path)
+
 
 # ---------------------------------------------------------------------------
 # Code generation
@@ -224,11 +362,86 @@ class TestCodegen:
         assert "enum class Dir : uint8_t" in code
         assert "Up = 0x0" in code
         assert "Down = 0x1" in code
-        # Parse: switch statement (no UB static_cast)
-        assert "switch (_dir_raw)" in code
-        assert "dir = Dir::Up; break;" in code
-        assert "dir = Dir::Down; break;" in code
-        assert "default: dir = Dir::Up; break;" in code
+        # Parse: raw values go through a decoder; unknown ones map to Up
+        assert "constexpr Dir decode_dir(uint8_t raw) {" in code
+        assert ("return static_cast<uint32_t>(raw) < 0x2u ? "
+                "static_cast<Dir>(raw) : Dir::Up;") in code
+        assert "dir = decode_dir(_dir_raw);" in code
+
+    def test_field_ids(self, tmp_path):
+        code = self._gen(tmp_path, """\
+            protocol:
+              name: FieldIds
+            structs:
+              - name: Inner
+                fields:
+                  - name: tag
+                    type: u8
+                    expected: 7
+              - name: Outer
+                fields:
+                  - name: len
+                    type: u16
+                  - name: inner
+                    type: Inner
+                  - name: tail
+                    type: u8
+                    condition: len != 0
+        """)
+        assert "constexpr const char* field_ids_field_name(uint16_t id) {" in code
+        assert 'case 1: return "Inner.tag";' in code
+        assert 'case 3: return "Outer.inner";' in code
+        assert 'case 4: return "Outer.tail";' in code
+        # Checked path: failures carry the field id; nested ids take priority
+        assert "s = reader.read_u16(len);\n        if (!s) return s.in_field(2);" in code
+        assert "s = inner.parse(reader);\n        if (!s) return s.in_field(3);" in code
+        assert ("return Status::BadMagic(reader.position() + offset)"
+                ".in_field(1);") in code
+
+    def test_enum_decoders(self, tmp_path):
+        code = self._gen(tmp_path, """\
+            protocol:
+              name: Decoders
+            enums:
+              - name: Signed
+                type: i8
+                values:
+                  - name: Minus
+                    value: -1
+                  - name: Zero
+                    value: 0
+                  - name: Plus
+                    value: 1
+              - name: Dense
+                type: u16
+                values:
+                  - name: A
+                    value: 0x10
+                  - name: B
+                    value: 0x12
+                  - name: C
+                    value: 0x4F
+              - name: Sparse
+                type: u32
+                values:
+                  - name: A
+                    value: 7
+                  - name: B
+                    value: 0x10000
+                  - name: C
+                    value: 0xDEADBEEF
+        """)
+        # Contiguous values take one unsigned compare, sign-wrapped
+        assert ("return static_cast<uint32_t>(raw) - 0xFFFFFFFFu < 0x3u ? "
+                "static_cast<Signed>(raw) : Signed::Minus;") in code
+        # Values within 64 codes test a bit mask
+        assert "const uint32_t d = static_cast<uint32_t>(raw) - 0x10u;" in code
+        assert ("return ((0x8000000000000005ull >> (d & 63u)) & (d < 64u)) "
+                "!= 0 ? static_cast<Dense>(raw) : Dense::A;") in code
+        # Anything wider hashes into a table of keys
+        assert "inline constexpr uint32_t kSparseKeys[4] = {" in code
+        assert "return detail::kSparseKeys[(e * 0x" in code
+        assert "switch (raw)" not in code
 
     def test_parse_primitive(self, tmp_path):
         code = self._gen(tmp_path, """\
@@ -240,8 +453,18 @@ class TestCodegen:
                   - name: val
                     type: u32
         """)
-        assert "reader.read_u32(val)" in code
-        assert "writer.write_u32(val)" in code
+        assert "static constexpr size_t kWireSize = 4;" in code
+        assert "Status s = reader.ensure(kWireSize);" in code
+        assert "val = reader.load_u32_at(offset);" in code
+        assert "writer.store_u32_at(offset, val);" in code
+        assert "reader.advance(kWireSize);" in code
+        assert "writer.advance(kWireSize);" in code
+        assert "template <typename Writer>\n    BIO_CONSTEXPR20 Status serialize(Writer& writer) const" in code
+        assert "typename Writer::codec_type, LittleEndianCodec" in code
+        assert "template <typename Reader>\n    BIO_CONSTEXPR20 Status parse(Reader& reader)" in code
+        assert "Status parse_unchecked(const Reader& reader, size_t offset)" in code
+        assert "typename Reader::codec_type, LittleEndianCodec" in code
+        assert "constexpr size_t serialized_size() const { return kWireSize; }" in code
 
     def test_expected_value(self, tmp_path):
         code = self._gen(tmp_path, """\
@@ -255,7 +478,9 @@ class TestCodegen:
                     expected: 0xDEAD
         """)
         assert "0xDEAD" in code
-        assert "OutOfRange" in code
+        # A mismatch reports where the value sits and which field it was
+        assert ("if (magic != 0xDEAD) return Status::BadMagic("
+                "reader.position() + offset).in_field(1);") in code
 
     def test_bytes_field(self, tmp_path):
         code = self._gen(tmp_path, """\
@@ -269,7 +494,8 @@ class TestCodegen:
                     length: 16
         """)
         assert "std::array<uint8_t, 16> data" in code
-        assert "read_bytes" in code
+        assert "reader.load_bytes_at(offset, data.data(), data.size());" in code
+        assert "writer.store_bytes_at(offset, data.data(), data.size());" in code
 
     def test_string_field(self, tmp_path):
         code = self._gen(tmp_path, """\
@@ -297,8 +523,9 @@ class TestCodegen:
                   - name: val
                     type: u8
         """)
-        assert "reader.skip(3)" in code
-        assert "writer.skip(3)" in code
+        assert "static constexpr size_t kWireSize = 4;" in code
+        assert "val = reader.load_u8_at(offset + 3);" in code
+        assert "writer.store_u8_at(offset + 3, val);" in code
 
     def test_nested_struct(self, tmp_path):
         code = self._gen(tmp_path, """\
@@ -315,8 +542,8 @@ class TestCodegen:
                     type: Inner
         """)
         assert "Inner inner{};" in code
-        assert "inner.parse(reader)" in code
-        assert "inner.serialize(writer)" in code
+        assert "inner.parse_unchecked(reader, offset)" in code
+        assert "inner.serialize_unchecked(writer, offset);" in code
 
     def test_array_of_primitives(self, tmp_path):
         code = self._gen(tmp_path, """\
@@ -331,7 +558,12 @@ class TestCodegen:
                     length: 8
         """)
         assert "std::array<uint16_t, 8> values" in code
-        assert "read_u16(elem)" in code
+        assert "static constexpr size_t kWireSize = 16;" in code
+        assert ("reader.load_u16_array_at(offset, values.data(), values.size())"
+                in code)
+        assert ("writer.store_u16_array_at(offset, values.data(), values.size())"
+                in code)
+        assert "for (" not in code
 
     def test_big_endian(self, tmp_path):
         code = self._gen(tmp_path, """\
@@ -361,6 +593,563 @@ class TestCodegen:
                     condition: "flags & 0x01"
         """)
         assert "if (flags & 0x01)" in code
+        # Conditional layouts keep the per-field checked path
+        assert "kWireSize" not in code
+        assert "reader.read_u8(flags)" in code
+        assert "writer.write_u32(extra)" in code
+        assert "SizeCounterT<LittleEndianCodec> counter;" in code
+
+    def test_conditional_struct_checked_fields(self, tmp_path):
+        code = self._gen(tmp_path, """\
+            protocol:
+              name: CondArr
+            structs:
+              - name: Inner
+                fields:
+                  - name: x
+                    type: u8
+              - name: Msg
+                fields:
+                  - name: flags
+                    type: u8
+                  - name: reserved
+                    type: padding
+                    pad_size: 3
+                  - name: inner
+                    type: Inner
+                  - name: values
+                    type: array
+                    element_type: u16
+                    length: 4
+                    condition: "flags & 0x01"
+        """)
+        assert "static constexpr size_t kWireSize = 1;" in code
+        assert "reader.skip(3)" in code
+        assert "writer.skip(3)" in code
+        assert "inner.parse(reader)" in code
+        assert "inner.serialize(writer)" in code
+        assert "reader.read_u16_array(values.data(), values.size())" in code
+        assert "writer.write_u16_array(values.data(), values.size())" in code
+
+    def test_fixed_struct_arrays(self, tmp_path):
+        code = self._gen(tmp_path, """\
+            protocol:
+              name: FixedArr
+            enums:
+              - name: Kind
+                type: u16
+                values:
+                  - name: A
+                    value: 0
+                  - name: B
+                    value: 1
+            structs:
+              - name: Entry
+                fields:
+                  - name: key
+                    type: u8
+                  - name: value
+                    type: u32
+              - name: Table
+                fields:
+                  - name: count
+                    type: u8
+                  - name: kinds
+                    type: array
+                    element_type: Kind
+                    length: 2
+                  - name: entries
+                    type: array
+                    element_type: Entry
+                    length: 3
+        """)
+        assert "static constexpr size_t kWireSize = 5;" in code
+        assert "static constexpr size_t kWireSize = 20;" in code
+        assert "reader.load_u16_at(offset + 1 + i * 2)" in code
+        assert "kinds[i] = decode_kind(_tmp);" in code
+        assert ("entries[i].parse_unchecked(reader, "
+                "offset + 5 + i * Entry::kWireSize)") in code
+        assert ("entries[i].serialize_unchecked(writer, "
+                "offset + 5 + i * Entry::kWireSize)") in code
+
+    def test_views(self, tmp_path):
+        code = self._gen(tmp_path, """\
+            protocol:
+              name: Views
+            enums:
+              - name: Kind
+                type: u8
+                values:
+                  - name: A
+                    value: 0
+                  - name: B
+                    value: 1
+            structs:
+              - name: Entry
+                fields:
+                  - name: key
+                    type: u16
+              - name: Frame
+                fields:
+                  - name: kind
+                    type: Kind
+                  - name: flags
+                    type: packed_bits
+                    bits:
+                      - name: hi
+                        width: 3
+                      - name: lo
+                        width: 13
+                  - name: head
+                    type: Entry
+                  - name: entries
+                    type: array
+                    element_type: Entry
+                    length: 2
+                  - name: name
+                    type: string
+                    length: 4
+              - name: Var
+                fields:
+                  - name: n
+                    type: varuint
+        """)
+        assert "class EntryView {" in code
+        assert "class FrameView {" in code
+        # Only fixed-size structs get a view
+        assert "class VarView" not in code
+        assert "explicit FrameView(const uint8_t* data) : p_(data) {}" in code
+        assert "return reader().load_u16_at(0);" in code
+        assert "return decode_kind(reader().load_u8_at(0));" in code
+        assert "BitReaderT<MsbFirst> bits(p_ + 1, 2);" in code
+        assert "static_cast<void>(bits.take_bits(3));" in code
+        assert "EntryView head() const {" in code
+        assert "return EntryView(p_ + 3);" in code
+        assert "EntryView entries(size_t i) const {" in code
+        assert "return EntryView(p_ + 5 + i * Entry::kWireSize);" in code
+        assert "return reinterpret_cast<const char*>(p_ + 9);" in code
+        assert "static constexpr size_t name_size() { return 4; }" in code
+        # One blank line separates decode() from the first accessor
+        assert ("Status decode(Frame& out) const "
+                "{ return out.parse_unchecked(reader(), 0); }\n\n"
+                "    Kind kind() const {") in code
+
+    def test_batch(self, tmp_path):
+        code = self._gen(tmp_path, """\
+            protocol:
+              name: Batches
+            enums:
+              - name: Kind
+                type: u8
+                values:
+                  - name: A
+                    value: 0
+                  - name: B
+                    value: 1
+            structs:
+              - name: Head
+                fields:
+                  - name: magic
+                    type: u16
+                    expected: 0xBEEF
+                  - name: kind
+                    type: Kind
+              - name: Sample
+                batch: true
+                fields:
+                  - name: head
+                    type: Head
+                  - name: gap
+                    type: padding
+                    pad_size: 1
+                  - name: flags
+                    type: bitfield_u8
+                    bits:
+                      - name: hot
+                        offset: 0
+                        width: 1
+                  - name: temperature
+                    type: f32
+                  - name: history
+                    type: array
+                    element_type: i16
+                    length: 3
+        """)
+        assert "template <size_t Capacity>\nstruct SampleBatch {" in code
+        # Only structs that ask for it get a batch
+        assert "struct HeadBatch" not in code
+        # Nested fields are flattened into their own columns; padding is not
+        assert "std::array<uint16_t, Capacity> head_magic{};" in code
+        assert "std::array<Kind, Capacity> head_kind{};" in code
+        assert "std::array<bool, Capacity> hot{};" in code
+        assert "std::array<float, Capacity> temperature{};" in code
+        assert "std::array<std::array<int16_t, 3>, Capacity> history{};" in code
+        assert "gap" not in code.split("struct SampleBatch")[1]
+        assert "Status parse_batch(Reader& reader, size_t max_frames) {" in code
+        assert "head_magic[j] = frame.load_u16_at(0);" in code
+        assert ("if (head_magic[j] != 0xBEEF) return fail(reader, j, "
+                "Status::BadMagic(frame.position()).in_field(1));") in code
+        assert "head_kind[j] = decode_kind(frame.load_u8_at(2));" in code
+        assert "hot[j] = ((_flags_raw >> 0) & 0x1) != 0;" in code
+        assert "temperature[j] = frame.load_f32_at(5);" in code
+        assert ("frame.load_i16_array_at(9, history[j].data(), "
+                "history[j].size());") in code
+        assert "Status fail(Reader& reader, size_t j, Status s) {" in code
+
+    def test_batch_without_failures_has_no_fail_helper(self, tmp_path):
+        code = self._gen(tmp_path, """\
+            protocol:
+              name: Plain
+            structs:
+              - name: Sample
+                batch: true
+                fields:
+                  - name: id
+                    type: u16
+                  - name: value
+                    type: f32
+        """)
+        batch = code.split("struct SampleBatch")[1]
+        assert "Status parse_batch(Reader& reader, size_t max_frames) {" in batch
+        assert "fail(" not in batch
+        assert "private:" not in batch
+
+    def test_resync(self, tmp_path):
+        code = self._gen(tmp_path, """\
+            protocol:
+              name: Sync
+              byte_order: big_endian
+            enums:
+              - name: Kind
+                type: u8
+                values:
+                  - name: A
+                    value: 1
+                  - name: B
+                    value: 2
+            structs:
+              - name: Head
+                fields:
+                  - name: version
+                    type: u8
+                    expected: 2
+                  - name: magic
+                    type: u32
+                    expected: 0xC0DEF00D
+              - name: Packet
+                fields:
+                  - name: head
+                    type: Head
+                  - name: kind
+                    type: Kind
+                    expected: 1
+                  - name: count
+                    type: varuint
+                  - name: trailer
+                    type: u16
+                    expected: 0xBEEF
+              - name: Plain
+                fields:
+                  - name: value
+                    type: u32
+        """)
+        head = code.split("struct Head {")[1].split("\n};")[0]
+        # The widest expected field is searched for, the others verified
+        assert "template <typename Reader>\n    static Status resync(Reader& reader) {" in head
+        assert "at = reader.find_u32(0xC0DEF00D, at + 1);" in head
+        assert "at -= 1;" in head
+        assert ("if (reader.remaining() - at < 5 ||\n"
+                "                (reader.load_u8_at(at) == 0x2)) {") in head
+        # Nested expected fields count; nothing after the varint does
+        packet = code.split("struct Packet {")[1].split("\n};")[0]
+        assert "at = reader.find_u32(0xC0DEF00D, at + 1);" in packet
+        assert ("(reader.load_u8_at(at) == 0x2 &&\n"
+                "                 reader.load_u8_at(at + 5) == 0x1)) {") in packet
+        assert "0xBEEF) {" not in packet
+        # No expected fields, no resync
+        plain = code.split("struct Plain {")[1].split("\n};")[0]
+        assert "resync" not in plain
+        # The runtime header provides the search
+        io = generate_io_header(load_protocol(tmp_path / "test.yaml"))
+        assert "size_t find_u32(uint32_t value, size_t from = 0) const" in io
+
+    def test_field_descriptors(self, tmp_path):
+        code = self._gen(tmp_path, """\
+            protocol:
+              name: Desc
+              byte_order: big_endian
+            enums:
+              - name: Mode
+                type: u8
+                values:
+                  - name: Idle
+                    value: 0
+                  - name: Active
+                    value: 1
+            structs:
+              - name: Point
+                fields:
+                  - name: x
+                    type: i16
+                  - name: y
+                    type: i16
+              - name: Rec
+                fields:
+                  - name: magic
+                    type: u32
+                    expected: 0xC0DE
+                  - name: mode
+                    type: Mode
+                  - name: flags
+                    type: bitfield_u8
+                    bits:
+                      - name: armed
+                        offset: 0
+                        width: 1
+                      - name: level
+                        offset: 1
+                        width: 2
+                        type: Mode
+                  - name: pad
+                    type: padding
+                    pad_size: 2
+                  - name: samples
+                    type: array
+                    element_type: u16
+                    length: 3
+                  - name: modes
+                    type: array
+                    element_type: Mode
+                    length: 2
+                  - name: label
+                    type: string
+                    length: 4
+                  - name: points
+                    type: array
+                    element_type: Point
+                    length: 2
+              - name: Tail
+                fields:
+                  - name: count
+                    type: varuint
+        """)
+        rec = code.split("struct Rec {")[1].split("\n};")[0]
+        assert "using codec_type = BigEndianCodec;" in rec
+        assert "static constexpr auto kFields = std::make_tuple(" in rec
+        # One descriptor per wire field, at its offset, with its field id
+        assert 'Expected<&Rec::magic, WireType::U32, 0, 0xC0DE>{"magic", 3},' in rec
+        assert ('Field<&Rec::mode, WireType::U8, 4, &decode_mode>'
+                '{"mode", 4},') in rec
+        assert ('Bits<WireType::U8, 5, Bit<&Rec::armed, 0, 1>, '
+                'Bit<&Rec::level, 1, 2, &decode_mode>>{"flags", 5},') in rec
+        assert 'Padding<6, 2>{"pad", 6},' in rec
+        assert 'Field<&Rec::samples, WireType::U16, 8>{"samples", 7},' in rec
+        assert ('Field<&Rec::modes, WireType::U8, 14, &decode_mode>'
+                '{"modes", 8},') in rec
+        assert 'Field<&Rec::label, WireType::Bytes, 16>{"label", 9},' in rec
+        assert ('Field<&Rec::points, WireType::Struct, 20>'
+                '{"points", 10});') in rec
+        point = code.split("struct Point {")[1].split("\n};")[0]
+        assert 'Field<&Point::y, WireType::I16, 2>{"y", 2});' in point
+        # Variable-size structs keep parse()/serialize() only
+        tail = code.split("struct Tail {")[1].split("\n};")[0]
+        assert "kFields" not in tail
+        io = generate_io_header(load_protocol(tmp_path / "test.yaml"))
+        assert "BIO_CONSTEXPR20 Status decode(Reader& reader, T& out) {" in io
+        assert "BIO_CONSTEXPR20 Status encode(Writer& writer, const T& value) {" in io
+
+    def test_instrumentation(self, tmp_path):
+        yaml_text = """\
+            protocol:
+              name: Probed
+              namespace: pr
+            structs:
+              - name: Fixed
+                fields:
+                  - name: a
+                    type: u16
+              - name: Var
+                fields:
+                  - name: pad
+                    type: padding
+                    pad_size: 1
+                  - name: n
+                    type: varuint
+        """
+        plain = self._gen(tmp_path, yaml_text)
+        assert "InstrumentProbe" not in plain
+        proto = load_protocol(tmp_path / "test.yaml")
+        code = generate_header(proto, source_file="test.yaml",
+                               io_filename="test_io.hpp", instrument=True)
+        # Fixed layouts are probed per struct
+        assert ('InstrumentProbe<Reader> _probe(reader, '
+                '"pr::Fixed::parse");') in code
+        assert ('InstrumentProbe<Writer> _probe(writer, '
+                '"pr::Fixed::serialize");') in code
+        assert "_probe.succeed();\n        return Status::Ok();" in code
+        assert '"pr::Fixed::parse/a"' not in code
+        # Sequential layouts are also probed per field, padding excepted
+        assert ('            InstrumentProbe<Reader> _field_probe(reader, '
+                '"pr::Var::parse/n");\n'
+                '            s = reader.read_varuint(n);\n'
+                '            if (!s) return s.in_field(3);\n'
+                '            _field_probe.succeed();\n'
+                '        }') in code
+        assert '"pr::Var::serialize/n"' in code
+        assert '"pr::Var::parse/pad"' not in code
+        io = generate_io_header(proto)
+        assert "struct NoInstrument {" in io
+        assert ("template <typename Codec, typename Instrument = NoInstrument>"
+                "\nclass ByteReaderT {") in io
+        assert ("template <typename Codec, typename Instrument = NoInstrument>"
+                "\nclass ByteWriterT {") in io
+        assert "class InstrumentProbe<Stream, Instrument, true> {" in io
+
+    def test_constexpr_serialization(self, tmp_path):
+        code = self._gen(tmp_path, """\
+            protocol:
+              name: Cx
+            structs:
+              - name: Msg
+                fields:
+                  - name: val
+                    type: f32
+                  - name: tag
+                    type: varuint
+        """)
+        msg = code.split("struct Msg {")[1].split("\n};")[0]
+        assert "BIO_CONSTEXPR20 Status parse(Reader& reader)" in msg
+        assert "BIO_CONSTEXPR20 Status serialize(Writer& writer) const" in msg
+        assert "BIO_CONSTEXPR20 size_t serialized_size() const" in msg
+        io = generate_io_header(load_protocol(tmp_path / "test.yaml"))
+        assert "#define BIO_CONSTEXPR20 constexpr" in io
+        assert "static constexpr uint32_t LoadU32(const uint8_t* p)" in io
+        # Punning goes through bit_cast so it can run at compile time
+        assert "out = detail::BitCast<float>(bits);" in io
+        assert "const auto bits = detail::BitCast<uint32_t>(v);" in io
+        assert "BIO_CONSTEXPR20 ByteWriterT(Byte* data, size_t size)" in io
+        assert "BIO_CONSTEXPR20 Status write_bytes(const Byte* in, size_t len)" in io
+        # packed_bits and encoding: arrays stay constexpr too
+        assert "BIO_CONSTEXPR20 BitReaderT(const Byte* data, size_t size)" in io
+        assert "BIO_CONSTEXPR20 BitWriterT(Byte* data, size_t /*size*/)" in io
+        assert "BIO_CONSTEXPR20 uint64_t take_bits(unsigned width)" in io
+        assert "BIO_CONSTEXPR20 void put_bits(unsigned width, uint64_t value)" in io
+        assert ("BIO_CONSTEXPR20 Status write_delta_array(Writer& writer, "
+                "const T* in, size_t n)") in io
+        assert ("BIO_CONSTEXPR20 Status read_for_array(Reader& reader, "
+                "T* out, size_t n)") in io
+
+    def test_dispatch(self, tmp_path):
+        code = self._gen(tmp_path, """\
+            protocol:
+              name: Demux
+            enums:
+              - name: Kind
+                type: u16
+                values:
+                  - name: Ping
+                    value: 1
+                  - name: Data
+                    value: 2
+                  - name: Log
+                    value: 4
+              - name: Wide
+                type: u32
+                values:
+                  - name: Lo
+                    value: 0
+                  - name: Hi
+                    value: 0x100000
+            structs:
+              - name: Head
+                fields:
+                  - name: magic
+                    type: u8
+                  - name: kind
+                    type: Kind
+                  - name: size
+                    type: u16
+              - name: WideHead
+                fields:
+                  - name: kind
+                    type: Wide
+              - name: DataBody
+                fields:
+                  - name: x
+                    type: u32
+              - name: LogBody
+                fields:
+                  - name: level
+                    type: u8
+            dispatch:
+              - name: Demux
+                header: Head
+                discriminator: kind
+                length: size
+                routes:
+                  - value: Ping
+                  - value: Data
+                    payload: DataBody
+                  - value: Log
+                    payload: LogBody
+              - name: WideDemux
+                header: WideHead
+                discriminator: kind
+                routes:
+                  - value: Lo
+                    payload: DataBody
+                  - value: Hi
+                    payload: DataBody
+        """)
+        assert "#include <variant>" in code
+        assert "struct Demux {" in code
+        assert ("using Payload = std::variant<std::monostate, DataBody, "
+                "LogBody>;") in code
+        assert ("kParsesInPlace = std::is_same_v<P, DataBody> || "
+                "std::is_same_v<P, LogBody>;") in code
+        # The raw discriminator is read before the header is decoded
+        assert "const uint16_t raw = reader.load_u16_at(1);" in code
+        assert "&route<std::monostate, Reader, Body>,  // 0x1 Ping" in code
+        assert "&unknown<Reader, Body>,  // 0x3" in code
+        assert "&route<LogBody, Reader, Body>,  // 0x4 Log" in code
+        assert "const auto index = static_cast<size_t>(raw - 0x1);" in code
+        # Unknown types leave skipping the payload to fit(), so it happens once
+        assert ("static Status unknown(Reader& reader, const Head&, "
+                "Body& body) {") in code
+        assert "reader.skip(header.size)" not in code
+        # Sparse values fall back to a switch; one payload appears once
+        assert "using Payload = std::variant<std::monostate, DataBody>;" in code
+        assert ("case 0x100000: return route<DataBody, Reader, Body>"
+                "(reader, header, body);") in code
+        assert ("static Status unknown(Reader& reader, const WideHead&, "
+                "Body&) {") in code
+        assert ("return Status::BadEnum(reader.position() - "
+                "WideHead::kWireSize + 0)\n            .in_field(4);") in code
+        assert "if (!s) return s.in_field(3);" in code
+        # With a length, routed payloads (header-only ones too) consume
+        # exactly `size` bytes; overruns fail on the length field
+        demux = code.split("struct Demux {")[1].split("struct WideDemux {")[0]
+        assert demux.count("return fit(r, header, start);") == 1
+        assert "const Status s = fit(r, header, start);" in demux
+        assert ("static Status fit(Reader& reader, const Head& header, "
+                "size_t start) {") in demux
+        assert ("if (used > length) return Status::OutOfRange(start + "
+                "length).in_field(3);") in demux
+        assert "const Status s = reader.skip(length - used);" in demux
+        # Without a length there is nothing to check against
+        wide = code.split("struct WideDemux {")[1]
+        assert "fit(" not in wide
+        # peek() reads the discriminator without consuming the message
+        assert "static Status peek(const Reader& reader, Kind& kind) {" in code
+        assert "const Status s = reader.peek_u16(raw, 1);" in code
+        assert "if (!s) return s.in_field(2);" in code
+        assert "kind = static_cast<Kind>(raw);" in code
+        assert "static Status peek(const Reader& reader, Wide& kind) {" in code
+        io = generate_io_header(load_protocol(tmp_path / "test.yaml"))
+        assert "Status peek_u16(uint16_t& out, size_t offset = 0) const {" in io
+        assert "Checkpoint checkpoint() const" in io
+        assert "void rewind(Checkpoint saved)" in io
+        assert "Status seek(size_t pos) {" in io
 
     def test_bitfield_u8(self, tmp_path):
         code = self._gen(tmp_path, """\
@@ -387,12 +1176,12 @@ class TestCodegen:
         assert "uint8_t mode{};" in code
         assert "uint8_t channel{};" in code
         # Parse: reads one u8, extracts bits
-        assert "read_u8(_ctrl_raw)" in code
+        assert "const uint8_t _ctrl_raw = reader.load_u8_at(offset);" in code
         assert ">> 0) & 0x1" in code
         assert ">> 1) & 0x7" in code
         assert ">> 4) & 0xF" in code
         # Serialize: packs bits, writes one u8
-        assert "write_u8(_ctrl_raw)" in code
+        assert "writer.store_u8_at(offset, _ctrl_raw);" in code
         assert "<< 0)" in code
         assert "<< 1)" in code
         assert "<< 4)" in code
@@ -416,8 +1205,8 @@ class TestCodegen:
         """)
         assert "uint8_t low{};" in code
         assert "uint8_t high{};" in code
-        assert "read_u16(_status_raw)" in code
-        assert "write_u16(_status_raw)" in code
+        assert "reader.load_u16_at(offset)" in code
+        assert "writer.store_u16_at(offset, _status_raw);" in code
 
     def test_bitfield_u32(self, tmp_path):
         code = self._gen(tmp_path, """\
@@ -438,8 +1227,8 @@ class TestCodegen:
         """)
         assert "uint16_t addr{};" in code
         assert "uint16_t data{};" in code
-        assert "read_u32(_reg_raw)" in code
-        assert "write_u32(_reg_raw)" in code
+        assert "reader.load_u32_at(offset)" in code
+        assert "writer.store_u32_at(offset, _reg_raw);" in code
 
     def test_bitfield_enum(self, tmp_path):
         """A bit-slice referencing an enum should use the enum type."""
@@ -477,15 +1266,126 @@ class TestCodegen:
         assert "Mode mode{};" in code
         assert "bool enable{};" in code
         assert "uint8_t channel{};" in code
-        # Parse: switch statement for enum (no UB static_cast)
-        assert "switch (" in code
-        assert "mode = Mode::ModeOff; break;" in code
-        assert "mode = Mode::ModeOn; break;" in code
-        assert "mode = Mode::ModeAuto; break;" in code
-        assert "default: mode = Mode::ModeOff; break;" in code
+        # Parse: the slice is narrowed to the enum's type, then decoded
+        assert ("mode = decode_mode(static_cast<uint8_t>"
+                "((_flags_raw >> 1) & 0x3));") in code
         # Serialize: static_cast from enum to raw
         assert "static_cast<uint8_t>(mode)" in code
 
+    def test_packed_bits(self, tmp_path):
+        code = self._gen(tmp_path, """\
+            protocol:
+              name: Packed
+            structs:
+              - name: Hdr
+                fields:
+                  - name: word
+                    type: packed_bits
+                    bits:
+                      - name: version
+                        width: 3
+                      - name: urgent
+                        width: 1
+                      - name: seq
+                        width: 13
+                      - name: stamp
+                        width: 39
+        """)
+        assert "static constexpr size_t kWireSize = 7;" in code
+        assert "bool urgent{};" in code
+        assert "uint16_t seq{};" in code
+        assert "uint64_t stamp{};" in code
+        # Parse: one block load, then shift-and-mask from an accumulator
+        assert "reader.load_bytes_at(offset, _word_buf, sizeof(_word_buf));" in code
+        assert "BitReaderT<MsbFirst> _word_bits(_word_buf, sizeof(_word_buf));" in code
+        assert "version = static_cast<uint8_t>(_word_bits.take_bits(3));" in code
+        assert "urgent = _word_bits.take_bits(1) != 0;" in code
+        # Serialize: pack into a local block, then one store
+        assert "_word_bits.put_bits(39, static_cast<uint64_t>(stamp));" in code
+        assert "_word_bits.flush();" in code
+        assert "writer.store_bytes_at(offset, _word_buf, sizeof(_word_buf));" in code
+
+    def test_varints(self, tmp_path):
+        code = self._gen(tmp_path, """\
+            protocol:
+              name: Var
+            structs:
+              - name: Counter
+                fields:
+                  - name: id
+                    type: u16
+                  - name: count
+                    type: varuint
+                  - name: delta
+                    type: varint
+                  - name: version
+                    type: varuint
+                    expected: 3
+        """)
+        assert "uint64_t count{};" in code
+        assert "int64_t delta{};" in code
+        # Variable-size fields leave the struct on the checked path
+        assert "kWireSize" not in code
+        assert "s = reader.read_varuint(count);" in code
+        assert "s = reader.read_varint(delta);" in code
+        assert ("if (version != 0x3) return Status::BadMagic("
+                "reader.position()).in_field(4);") in code
+        assert "if (!s) return s.in_field(2);" in code
+        assert "s = writer.write_varuint(count);" in code
+        assert "s = writer.write_varint(delta);" in code
+
+    def test_packed_bits_lsb_first(self, tmp_path):
+        code = self._gen(tmp_path, """\
+            protocol:
+              name: PackedLsb
+            structs:
+              - name: Msg
+                fields:
+                  - name: n
+                    type: u8
+                  - name: word
+                    type: packed_bits
+                    bit_order: lsb_first
+                    condition: n != 0
+                    bits:
+                      - name: a
+                        width: 4
+                      - name: b
+                        width: 12
+        """)
+        assert "s = reader.read_bytes(_word_buf, sizeof(_word_buf));" in code
+        assert "BitReaderT<LsbFirst> _word_bits" in code
+        assert "BitWriterT<LsbFirst> _word_bits(_word_buf, sizeof(_word_buf));" in code
+        assert "s = writer.write_bytes(_word_buf, sizeof(_word_buf));" in code
+
+    def test_array_encodings(self, tmp_path):
+        code = self._gen(tmp_path, """\
+            protocol:
+              name: Series
+            structs:
+              - name: Block
+                fields:
+                  - name: stamps
+                    type: array
+                    element_type: u32
+                    length: 64
+                    encoding: delta
+                  - name: temps
+                    type: array
+                    element_type: i16
+                    length: 64
+                    encoding: for
+        """)
+        assert "std::array<uint32_t, 64> stamps{};" in code
+        # Packed sizes depend on the values
+        assert "kWireSize" not in code
+        assert ("s = read_delta_array(reader, stamps.data(), stamps.size());"
+                in code)
+        assert "s = read_for_array(reader, temps.data(), temps.size());" in code
+        assert ("s = write_delta_array(writer, stamps.data(), stamps.size());"
+                in code)
+        assert "s = write_for_array(writer, temps.data(), temps.size());" in code
+
 
 # ---------------------------------------------------------------------------
 # Integration: example protocol files
@@ -529,6 +1429,19 @@ class TestExampleProtocols:
         assert "BEReader" in io_code
         assert "LEWriter" in io_code
         assert "BEWriter" in io_code
+        assert "read_f32_array" in io_code
+        assert "write_f32_array" in io_code
+        assert "Status ensure(size_t len) const" in io_code
+        assert "void advance(size_t len)" in io_code
+        assert "load_f32_at(size_t offset) const" in io_code
+        assert "void store_f64_array_at(" in io_code
+        assert "class DynamicByteWriterT : public ByteWriterT<Codec>" in io_code
+        assert "using DynamicLEWriter" in io_code
+        assert "class SizeCounterT" in io_code
+        assert "using LESizeCounter" in io_code
+        assert "using codec_type = Codec;" in io_code
+        assert "class ChunkedReaderT" in io_code
+        assert "struct ByteSegment" in io_code
         if proto.namespace:
             assert f"namespace {proto.namespace}" in io_code
 
@@ -550,3 +1463,28 @@ class TestExampleProtocols:
         # Protocol header should include the io header
         proto_code = paths[1].read_text(encoding="utf-8")
         assert paths[0].name in proto_code
+
+    @pytest.mark.parametrize("filename", [
+        "sensor_telemetry.yaml",
+        "command_protocol.yaml",
+    ])
+    def test_example_shared_runtime(self, filename, tmp_path):
+        path = self.PROTOCOLS_DIR / filename
+        if not path.exists():
+            pytest.skip(f"{path} not found")
+        proto = load_protocol(path)
+        paths = generate_to_file(proto, tmp_path, source_file=filename,
+                                 shared_runtime=True)
+        assert len(paths) == 1
+        assert paths[0].name.endswith("_protocol.hpp")
+        assert not list(tmp_path.glob("*_io.hpp"))
+        proto_code = paths[0].read_text(encoding="utf-8")
+        assert "#include <binary-io/binary-io.hpp>" in proto_code
+        assert "#include <binary-io/reflect.hpp>" in proto_code
+        assert "_io.hpp" not in proto_code
+        assert "using bio::Status;" in proto_code
+        assert "using bio::LEReader;" in proto_code
+        assert "using bio::decode;" in proto_code
+        # The runtime itself is not duplicated into the protocol namespace
+        assert "class ByteReaderT" not in proto_code
+        assert "struct LittleEndianCodec" not in proto_code
@@ -0,0 +1,335 @@
+// Copyright (c) 2026 Julian Gottwald
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+/// @file array-coding.hpp
+/// @brief Delta and frame-of-reference coding for integer arrays.
+///
+/// Both encodings bit-pack every element of an array at one common width,
+/// chosen as the narrowest that holds the largest packed value:
+/// - @ref write_delta_array() packs the zigzag-encoded differences between
+///   neighbouring elements, which suits counters and slowly changing
+///   samples.
+/// - @ref write_for_array() ("frame of reference") packs each element's
+///   offset from the array minimum, which suits values clustered in a
+///   narrow range.
+///
+/// Wire formats, with the reference value in the writer's byte order:
+/// @code
+///   delta: T first | u8 width | (count - 1) zigzag deltas, width bits each
+///   for:   T min   | u8 width | count offsets from min, width bits each
+/// @endcode
+/// Bits are packed least significant first and the packed run is padded
+/// to a whole byte. An empty array encodes as nothing. A width of 0 (a
+/// constant array, or a constant step for delta) needs no packed bytes.
+///
+/// The functions work with any reader or writer in this library: they only
+/// use the scalar and @c read_bytes / @c write_bytes methods, and in C++20
+/// they are @c constexpr with the byte-buffer readers and writers. Coding runs
+/// in blocks of 64 values through a stack buffer. Each value goes straight
+/// from the packed bits to its output element in one scalar pass. A SIMD
+/// prefix sum over a block array lost to this fused loop, because its
+/// vector loads stall on the scalar stores that fill the block.
+
+#ifndef BINARYIO_ARRAY_CODING_HPP_
+#define BINARYIO_ARRAY_CODING_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "binary-io/binary-io.hpp"
+
+namespace bio {
+
+namespace detail {
+
+/// @brief Values per coding block. A block of 64 values of any width ends on
+///        a byte boundary, so blocks are coded independently.
+inline constexpr size_t kPackBlock = 64;
+
+/// @brief Padding a block buffer needs past its packed bytes, so that
+///        @ref UnpackBlock() can load a whole word at every value.
+inline constexpr size_t kUnpackSlack = 16;
+
+/// @brief Packed size in bytes of @p count values of @p width bits.
+inline constexpr size_t PackedBytes(size_t count, unsigned width) {
+  return (count * width + 7) / 8;
+}
+
+/// @brief Return the number of significant bits of @p v (0 for 0).
+BIO_CONSTEXPR20 inline unsigned SignificantBits(uint64_t v) {
+  return v == 0 ? 0 : HighestBit64(v) + 1;
+}
+
+/// @brief Zigzag-encode a @p U-wide two's-complement difference.
+template <typename U>
+BIO_CONSTEXPR20 inline U ZigZagWord(U d) {
+  constexpr unsigned kTop = 8 * sizeof(U) - 1;
+  return static_cast<U>(static_cast<U>(d << 1) ^
+                        static_cast<U>(0 - (d >> kTop)));
+}
+
+/// @brief Inverse of @ref ZigZagWord().
+template <typename U>
+BIO_CONSTEXPR20 inline U UnZigZagWord(U z) {
+  return static_cast<U>(static_cast<U>(z >> 1) ^ static_cast<U>(0 - (z & 1)));
+}
+
+/// @brief Bit-pack the @p count <= kPackBlock values @p get(0) ...
+///        @p get(count - 1) at @p width bits, least significant bit first,
+///        into PackedBytes(count, width) bytes at @p out.
+/// @pre Every value fits in @p width bits; 0 < @p width <= 64.
+template <typename Get>
+BIO_CONSTEXPR20 void PackBlock(Get get, size_t count, unsigned width,
+                               uint8_t* out) {
+  uint64_t acc = 0;
+  unsigned bits = 0;
+  for (size_t i = 0; i < count; ++i) {
+    const auto v = static_cast<uint64_t>(get(i));
+    acc |= v << bits;
+    bits += width;
+    if (bits >= 64) {
+      LittleEndianCodec::StoreU64(out, acc);
+      out += 8;
+      bits -= 64;
+      // The bits of v that did not fit; none when it ended the word.
+      acc = bits == 0 ? 0 : v >> (width - bits);
+    }
+  }
+  for (; bits > 0; bits = bits > 8 ? bits - 8 : 0) {
+    *out++ = static_cast<uint8_t>(acc);
+    acc >>= 8;
+  }
+}
+
+/// @brief Inverse of @ref PackBlock(): call @p put(i, value) for each of
+///        the @p count values, in order.
+///
+/// Every value is one unaligned 64-bit load, a shift and a mask, with no
+/// dependency between values.
+///
+/// @pre @p in is readable for PackedBytes(count, width) + kUnpackSlack
+///      bytes; 0 < @p width <= 64.
+template <typename Put>
+BIO_CONSTEXPR20 void UnpackBlock(const uint8_t* in, size_t count,
+                                 unsigned width, Put put) {
+  const uint64_t mask = ~uint64_t{0} >> (64 - width);
+  if (width <= 56) {
+    for (size_t i = 0; i < count; ++i) {
+      const size_t bit = i * width;
+      const uint64_t word = LittleEndianCodec::LoadU64(in + bit / 8);
+      put(i, (word >> (bit % 8)) & mask);
+    }
+    return;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    const size_t bit = i * width;
+    const unsigned shift = bit % 8;
+    uint64_t v = LittleEndianCodec::LoadU64(in + bit / 8) >> shift;
+    if (shift != 0) v |= static_cast<uint64_t>(in[bit / 8 + 8]) << (64 - shift);
+    put(i, v & mask);
+  }
+}
+
+/// @brief Write an integer of any width through the matching @c write_uN.
+template <typename Writer, typename U>
+BIO_CONSTEXPR20 Status WriteWord(Writer& writer, U v) {
+  if constexpr (sizeof(U) == 1) {
+    return writer.write_u8(v);
+  } else if constexpr (sizeof(U) == 2) {
+    return writer.write_u16(v);
+  } else if constexpr (sizeof(U) == 4) {
+    return writer.write_u32(v);
+  } else {
+    return writer.write_u64(v);
+  }
+}
+
+/// @brief Read an integer of any width through the matching @c read_uN.
+template <typename Reader, typename U>
+BIO_CONSTEXPR20 Status ReadWord(Reader& reader, U& v) {
+  if constexpr (sizeof(U) == 1) {
+    return reader.read_u8(v);
+  } else if constexpr (sizeof(U) == 2) {
+    return reader.read_u16(v);
+  } else if constexpr (sizeof(U) == 4) {
+    return reader.read_u32(v);
+  } else {
+    return reader.read_u64(v);
+  }
+}
+
+/// @brief Write the packed run: reference value, width byte, then the
+///        @p count values @p get(0) ... @p get(count - 1).
+template <typename Writer, typename U, typename Get>
+BIO_CONSTEXPR20 Status WritePacked(Writer& writer, U reference, unsigned width,
+                                   size_t count, Get get) {
+  Status s = WriteWord(writer, reference);
+  if (!s) return s;
+  s = writer.write_u8(static_cast<uint8_t>(width));
+  if (!s || width == 0) return s;
+  uint8_t packed[kPackBlock * 8];
+  for (size_t i = 0; i < count; i += kPackBlock) {
+    const size_t n = count - i < kPackBlock ? count - i : kPackBlock;
+    PackBlock([&](size_t j) { return get(i + j); }, n, width, packed);
+    s = writer.write_bytes(packed, PackedBytes(n, width));
+    if (!s) return s;
+  }
+  return Status::Ok();
+}
+
+/// @brief Read the header written by @ref WritePacked() and validate the
+///        width.
+template <typename Reader, typename U>
+BIO_CONSTEXPR20 Status ReadPackedHeader(Reader& reader, U& reference,
+                                        unsigned& width) {
+  uint8_t w = 0;
+  Status s = ReadWord(reader, reference);
+  if (!s) return s;
+  s = reader.read_u8(w);
+  if (!s) return s;
+  if (w > 8 * sizeof(U)) return Status::OutOfRange(reader.position() - 1);
+  width = w;
+  return Status::Ok();
+}
+
+/// @brief Read @p count packed values of @p width bits, calling
+///        @p put(i, value) for each, in order.
+template <typename U, typename Reader, typename Put>
+BIO_CONSTEXPR20 Status ReadPacked(Reader& reader, unsigned width, size_t count,
+                                  Put put) {
+  if (width == 0) {
+    for (size_t i = 0; i < count; ++i) put(i, U{0});
+    return Status::Ok();
+  }
+  uint8_t packed[kPackBlock * 8 + kUnpackSlack] = {};
+  for (size_t i = 0; i < count; i += kPackBlock) {
+    const size_t n = count - i < kPackBlock ? count - i : kPackBlock;
+    Status s = reader.read_bytes(packed, PackedBytes(n, width));
+    if (!s) return s;
+    UnpackBlock(packed, n, width, [&](size_t j, uint64_t v) {
+      put(i + j, static_cast<U>(v));
+    });
+  }
+  return Status::Ok();
+}
+
+template <typename T>
+using CodingWord = std::make_unsigned_t<T>;
+
+}  // namespace detail
+
+/// @brief Delta-encode @p count integers; see the file comment for the
+///        format.
+///
+/// Differences wrap modulo the element width, so any sequence round-trips;
+/// zigzag coding keeps small steps in either direction narrow.
+///
+/// @tparam Writer Any writer of this library (including @ref SizeCounterT).
+/// @tparam T Integer element type other than @c bool.
+/// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if the
+///         writer runs out of capacity.
+template <typename Writer, typename T>
+BIO_CONSTEXPR20 Status write_delta_array(Writer& writer, const T* in,
+                                         size_t count) {
+  static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>,
+                "delta coding needs an integer element type");
+  using U = detail::CodingWord<T>;
+  if (count == 0) return Status::Ok();
+  // Delta i is the step from in[i] to in[i + 1].
+  const auto delta = [in](size_t i) {
+    return detail::ZigZagWord(
+        static_cast<U>(static_cast<U>(in[i + 1]) - static_cast<U>(in[i])));
+  };
+  U all = 0;
+  for (size_t i = 0; i + 1 < count; ++i) all |= delta(i);
+  return detail::WritePacked(writer, static_cast<U>(in[0]),
+                             detail::SignificantBits(all), count - 1, delta);
+}
+
+/// @brief Decode @p count integers written by @ref write_delta_array().
+/// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if the
+///         input ends early or its width byte exceeds the element width.
+template <typename Reader, typename T>
+BIO_CONSTEXPR20 Status read_delta_array(Reader& reader, T* out, size_t count) {
+  static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>,
+                "delta coding needs an integer element type");
+  using U = detail::CodingWord<T>;
+  if (count == 0) return Status::Ok();
+  U sum = 0;
+  unsigned width = 0;
+  Status s = detail::ReadPackedHeader(reader, sum, width);
+  if (!s) return s;
+  out[0] = static_cast<T>(sum);
+  return detail::ReadPacked<U>(reader, width, count - 1, [&](size_t i, U z) {
+    sum = static_cast<U>(sum + detail::UnZigZagWord(z));
+    out[i + 1] = static_cast<T>(sum);
+  });
+}
+
+/// @brief Frame-of-reference encode @p count integers; see the file comment
+///        for the format.
+///
+/// @tparam Writer Any writer of this library (including @ref SizeCounterT).
+/// @tparam T Integer element type other than @c bool.
+/// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if the
+///         writer runs out of capacity.
+template <typename Writer, typename T>
+BIO_CONSTEXPR20 Status write_for_array(Writer& writer, const T* in,
+                                       size_t count) {
+  static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>,
+                "frame-of-reference coding needs an integer element type");
+  using U = detail::CodingWord<T>;
+  if (count == 0) return Status::Ok();
+  T lo = in[0];
+  T hi = in[0];
+  for (size_t i = 1; i < count; ++i) {
+    lo = in[i] < lo ? in[i] : lo;
+    hi = in[i] > hi ? in[i] : hi;
+  }
+  const auto base = static_cast<U>(lo);
+  const auto width =
+      detail::SignificantBits(static_cast<U>(static_cast<U>(hi) - base));
+  return detail::WritePacked(writer, base, width, count, [in, base](size_t i) {
+    return static_cast<U>(static_cast<U>(in[i]) - base);
+  });
+}
+
+/// @brief Decode @p count integers written by @ref write_for_array().
+/// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if the
+///         input ends early or its width byte exceeds the element width.
+template <typename Reader, typename T>
+BIO_CONSTEXPR20 Status read_for_array(Reader& reader, T* out, size_t count) {
+  static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>,
+                "frame-of-reference coding needs an integer element type");
+  using U = detail::CodingWord<T>;
+  if (count == 0) return Status::Ok();
+  U base = 0;
+  unsigned width = 0;
+  Status s = detail::ReadPackedHeader(reader, base, width);
+  if (!s) return s;
+  return detail::ReadPacked<U>(reader, width, count, [&](size_t i, U v) {
+    out[i] = static_cast<T>(static_cast<U>(v + base));
+  });
+}
+
+}  // namespace bio
+
+#endif  // !BINARYIO_ARRAY_CODING_HPP_
@@ -24,6 +24,16 @@
 /// Provides byte-order-aware readers and writers for reading and writing
 /// primitive types from/to raw byte buffers. Supports both little-endian
 /// and big-endian byte orders via codec policies.
+///
+/// The codecs detect the host byte order at compile time. When the wire order
+/// matches the host, values are moved with a single unaligned @c memcpy;
+/// otherwise the loaded word is reversed with the compiler's byte-swap
+/// builtin. Hosts of unknown byte order fall back to portable shift code.
+///
+/// In C++20 builds the codecs, @ref ByteReaderT, @ref ByteWriterT,
+/// @ref SizeCounterT, @ref BitReaderT and @ref BitWriterT are @c constexpr,
+/// so tables and frames can be encoded or checked at compile time. Constant evaluation takes the shift code and
+/// @c std::bit_cast; run-time calls keep the @c memcpy and SIMD paths.
 
 #ifndef BINARYIO_BINARYIO_HPP_
 #define BINARYIO_BINARYIO_HPP_
@@ -31,17 +41,112 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+
+#if defined(__has_include)
+#if __has_include(<bit>)
+#include <bit>
+#endif
+#if __has_include(<span>) && __cplusplus >= 202002L
+#include <span>
+#endif
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+
+#include <cstdlib>
+#endif
+
+// C++20 adds std::bit_cast and std::is_constant_evaluated(), which let the
+// readers and writers run in constant expressions. The generated protocol
+// runtime defines the same macro, so either header may come first.
+#ifndef BIO_CONSTEXPR20
+#if defined(__cpp_lib_bit_cast) && defined(__cpp_lib_is_constant_evaluated)
+#define BIO_CONSTEXPR20 constexpr
+#else
+#define BIO_CONSTEXPR20
+#endif
+#endif
+
+// Byte-swap kernels for the bulk array methods. AVX2 implies SSSE3 and SSE2;
+// MSVC does not define __SSE2__, so x64 and /arch:SSE2 builds are detected
+// separately.
+#if defined(__AVX2__)
+#define BIO_SIMD_AVX2 1
+#endif
+#if defined(__SSSE3__) || defined(__AVX2__)
+#define BIO_SIMD_SSSE3 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BIO_SIMD_SSE2 1
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define BIO_SIMD_NEON 1
+#endif
+
+#if defined(BIO_SIMD_AVX2)
+#include <immintrin.h>
+#elif defined(BIO_SIMD_SSSE3)
+#include <tmmintrin.h>
+#elif defined(BIO_SIMD_SSE2)
+#include <emmintrin.h>
+#endif
+#if defined(BIO_SIMD_NEON)
+#include <arm_neon.h>
+#endif
 
 /// @brief Binary I/O library namespace.
 namespace bio {
 
+/// @brief Why an operation failed; see @ref Status::code.
+enum class StatusCode : uint8_t {
+  Ok,                ///< The operation succeeded.
+  OutOfRange,        ///< Too few bytes, or a value outside its valid range.
+  BadMagic,          ///< A field did not hold its expected value.
+  BadEnum,           ///< A discriminator named no known enumerator.
+  ChecksumMismatch,  ///< A stored checksum differs from the computed one.
+};
+
+/// @brief Return the enumerator name of @p code, e.g. @c "OutOfRange".
+constexpr const char* to_string(StatusCode code) {
+  switch (code) {
+    case StatusCode::Ok:
+      return "Ok";
+    case StatusCode::OutOfRange:
+      return "OutOfRange";
+    case StatusCode::BadMagic:
+      return "BadMagic";
+    case StatusCode::BadEnum:
+      return "BadEnum";
+    case StatusCode::ChecksumMismatch:
+      return "ChecksumMismatch";
+  }
+  return "Unknown";
+}
+
 /// @brief Result type indicating success or failure of a read/write operation.
 ///
 /// Convertible to @c bool for convenient error checking. A @c Status that
-/// evaluates to @c true indicates success; @c false indicates an out-of-range
-/// error (not enough bytes remaining in the buffer).
+/// evaluates to @c true indicates success. A failure also records what went
+/// wrong, the byte position where it was detected and, in generated code, the
+/// id of the field being decoded, so a corrupt frame can be reported without
+/// parsing it again.
+///
+/// The whole value is eight bytes and is returned in a register. @ref Ok() is
+/// a constant and the failure details are only computed on the failure
+/// branch, so producing and checking a @c Status costs the same as a @c bool.
 struct [[nodiscard]] Status {
+  /// @brief @ref position value meaning "not recorded" (or beyond 4 GiB).
+  static constexpr uint32_t kNoPosition = UINT32_MAX;
+
   bool ok;  ///< @c true when the operation succeeded.
+  StatusCode code = StatusCode::Ok;  ///< Failure category.
+  uint16_t field = 0;  ///< Id of the failing field, 0 when not recorded.
+  uint32_t position = kNoPosition;  ///< Byte position of the failure.
 
   /// @brief Contextual conversion to @c bool.
   /// @return @c true if the operation succeeded.
@@ -51,24 +156,327 @@ struct [[nodiscard]] Status {
   /// @return A @c Status representing success.
   static constexpr Status Ok() { return {true}; }
 
+  /// @brief Construct a failure status with @p code at @p position.
+  static constexpr Status Failure(StatusCode code,
+                                  size_t position = kNoPosition) {
+    return {false, code, 0,
+            position < kNoPosition ? static_cast<uint32_t>(position)
+                                   : kNoPosition};
+  }
+
   /// @brief Construct a failure status (out of range).
+  /// @param position Reader or writer position where it was detected.
   /// @return A @c Status representing an out-of-range error.
-  static constexpr Status OutOfRange() { return {false}; }
+  static constexpr Status OutOfRange(size_t position = kNoPosition) {
+    return Failure(StatusCode::OutOfRange, position);
+  }
+
+  /// @brief Construct a failure status for an unexpected field value.
+  static constexpr Status BadMagic(size_t position = kNoPosition) {
+    return Failure(StatusCode::BadMagic, position);
+  }
+
+  /// @brief Construct a failure status for an unknown enum value.
+  static constexpr Status BadEnum(size_t position = kNoPosition) {
+    return Failure(StatusCode::BadEnum, position);
+  }
+
+  /// @brief Construct a failure status for a checksum mismatch.
+  static constexpr Status ChecksumMismatch(size_t position = kNoPosition) {
+    return Failure(StatusCode::ChecksumMismatch, position);
+  }
+
+  /// @brief Return a copy attributed to field @p id, unless this is a
+  ///        success or already names a (more deeply nested) field.
+  constexpr Status in_field(uint16_t id) const {
+    Status s = *this;
+    if (!s.ok && s.field == 0) s.field = id;
+    return s;
+  }
 };
 
+static_assert(sizeof(Status) == 8, "Status must stay register-sized");
+
+/// @brief Implementation details; not part of the public API.
+namespace detail {
+
+#if defined(__cpp_lib_endian)
+inline constexpr bool kHostLittleEndian =
+    std::endian::native == std::endian::little;
+inline constexpr bool kHostBigEndian = std::endian::native == std::endian::big;
+#elif defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) && \
+    defined(__ORDER_BIG_ENDIAN__)
+inline constexpr bool kHostLittleEndian =
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+inline constexpr bool kHostBigEndian = __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__;
+#elif defined(_MSC_VER)
+// Every architecture targeted by MSVC is little-endian.
+inline constexpr bool kHostLittleEndian = true;
+inline constexpr bool kHostBigEndian = false;
+#else
+inline constexpr bool kHostLittleEndian = false;
+inline constexpr bool kHostBigEndian = false;
+#endif
+
+/// @brief @c true while the call is being evaluated at compile time; always
+///        @c false before C++20.
+constexpr bool IsConstantEvaluated() {
+#if defined(__cpp_lib_is_constant_evaluated)
+  return std::is_constant_evaluated();
+#else
+  return false;
+#endif
+}
+
+/// @brief Reinterpret the bytes of @p from as a @p To of the same size.
+template <typename To, typename From>
+BIO_CONSTEXPR20 inline To BitCast(const From& from) {
+  static_assert(sizeof(To) == sizeof(From), "BitCast needs equal sizes");
+#if defined(__cpp_lib_bit_cast)
+  return std::bit_cast<To>(from);
+#else
+  To to;
+  std::memcpy(&to, &from, sizeof(To));
+  return to;
+#endif
+}
+
+/// @brief Byte-sized element types that the raw-byte methods accept as typed
+///        pointers, which unlike @c void* work in constant expressions.
+template <typename T>
+inline constexpr bool kIsByte = std::is_same_v<T, uint8_t> ||
+                                std::is_same_v<T, int8_t> ||
+                                std::is_same_v<T, char>;
+
+/// @brief Copy @p len bytes from @p src to @p dst, which must not overlap.
+template <typename To, typename From>
+BIO_CONSTEXPR20 inline void CopyBytes(To* dst, const From* src, size_t len) {
+  if (IsConstantEvaluated()) {
+    for (size_t i = 0; i < len; ++i) dst[i] = static_cast<To>(src[i]);
+  } else if (len != 0) {
+    std::memcpy(dst, src, len);
+  }
+}
+
+/// @brief Reverse the byte order of a 16-bit value.
+inline uint16_t ByteSwap16(uint16_t v) {
+#if defined(__cpp_lib_byteswap)
+  return std::byteswap(v);
+#elif defined(__GNUC__) || defined(__clang__)
+  return __builtin_bswap16(v);
+#elif defined(_MSC_VER)
+  return _byteswap_ushort(v);
+#else
+  return static_cast<uint16_t>((v >> 8) | (v << 8));
+#endif
+}
+
+/// @brief Reverse the byte order of a 32-bit value.
+inline uint32_t ByteSwap32(uint32_t v) {
+#if defined(__cpp_lib_byteswap)
+  return std::byteswap(v);
+#elif defined(__GNUC__) || defined(__clang__)
+  return __builtin_bswap32(v);
+#elif defined(_MSC_VER)
+  return _byteswap_ulong(v);
+#else
+  return ((v & 0x000000FFu) << 24) | ((v & 0x0000FF00u) << 8) |
+         ((v & 0x00FF0000u) >> 8) | ((v & 0xFF000000u) >> 24);
+#endif
+}
+
+/// @brief Reverse the byte order of a 64-bit value.
+inline uint64_t ByteSwap64(uint64_t v) {
+#if defined(__cpp_lib_byteswap)
+  return std::byteswap(v);
+#elif defined(__GNUC__) || defined(__clang__)
+  return __builtin_bswap64(v);
+#elif defined(_MSC_VER)
+  return _byteswap_uint64(v);
+#else
+  return (static_cast<uint64_t>(ByteSwap32(static_cast<uint32_t>(v))) << 32) |
+         ByteSwap32(static_cast<uint32_t>(v >> 32));
+#endif
+}
+
+/// @brief Load a host-order value from possibly unaligned memory.
+template <typename T>
+inline T LoadNative(const uint8_t* p) {
+  T v;
+  std::memcpy(&v, p, sizeof(T));
+  return v;
+}
+
+/// @brief Store a host-order value to possibly unaligned memory.
+template <typename T>
+inline void StoreNative(uint8_t* p, T v) {
+  std::memcpy(p, &v, sizeof(T));
+}
+
+/// @brief Copy @p count 16-bit words from @p src to @p dst, reversing the byte
+///        order of each word. @p dst and @p src may be equal.
+inline void ByteSwapCopy16(void* dst, const void* src, size_t count) {
+  auto* d = static_cast<uint8_t*>(dst);
+  const auto* s = static_cast<const uint8_t*>(src);
+  size_t i = 0;
+#if defined(BIO_SIMD_AVX2)
+  const __m256i mask256 = _mm256_setr_epi8(
+      1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,  //
+      1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+  for (; i + 16 <= count; i += 16) {
+    const __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i * 2));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i * 2),
+                        _mm256_shuffle_epi8(v, mask256));
+  }
+#endif
+#if defined(BIO_SIMD_SSSE3)
+  const __m128i mask =
+      _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+  for (; i + 8 <= count; i += 8) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i * 2));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i * 2),
+                     _mm_shuffle_epi8(v, mask));
+  }
+#elif defined(BIO_SIMD_SSE2)
+  for (; i + 8 <= count; i += 8) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i * 2));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i * 2),
+                     _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+  }
+#elif defined(BIO_SIMD_NEON)
+  for (; i + 8 <= count; i += 8) {
+    vst1q_u8(d + i * 2, vrev16q_u8(vld1q_u8(s + i * 2)));
+  }
+#endif
+  for (; i < count; ++i) {
+    StoreNative(d + i * 2, ByteSwap16(LoadNative<uint16_t>(s + i * 2)));
+  }
+}
+
+/// @brief Copy @p count 32-bit words from @p src to @p dst, reversing the byte
+///        order of each word. @p dst and @p src may be equal.
+inline void ByteSwapCopy32(void* dst, const void* src, size_t count) {
+  auto* d = static_cast<uint8_t*>(dst);
+  const auto* s = static_cast<const uint8_t*>(src);
+  size_t i = 0;
+#if defined(BIO_SIMD_AVX2)
+  const __m256i mask256 = _mm256_setr_epi8(
+      3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,  //
+      3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+  for (; i + 8 <= count; i += 8) {
+    const __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i * 4));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i * 4),
+                        _mm256_shuffle_epi8(v, mask256));
+  }
+#endif
+#if defined(BIO_SIMD_SSSE3)
+  const __m128i mask =
+      _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+  for (; i + 4 <= count; i += 4) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i * 4));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i * 4),
+                     _mm_shuffle_epi8(v, mask));
+  }
+#elif defined(BIO_SIMD_SSE2)
+  // Swap the bytes of each 16-bit half, then swap the halves.
+  for (; i + 4 <= count; i += 4) {
+    __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i * 4));
+    v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+    v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i * 4), v);
+  }
+#elif defined(BIO_SIMD_NEON)
+  for (; i + 4 <= count; i += 4) {
+    vst1q_u8(d + i * 4, vrev32q_u8(vld1q_u8(s + i * 4)));
+  }
+#endif
+  for (; i < count; ++i) {
+    StoreNative(d + i * 4, ByteSwap32(LoadNative<uint32_t>(s + i * 4)));
+  }
+}
+
+/// @brief Copy @p count 64-bit words from @p src to @p dst, reversing the byte
+///        order of each word. @p dst and @p src may be equal.
+inline void ByteSwapCopy64(void* dst, const void* src, size_t count) {
+  auto* d = static_cast<uint8_t*>(dst);
+  const auto* s = static_cast<const uint8_t*>(src);
+  size_t i = 0;
+#if defined(BIO_SIMD_AVX2)
+  const __m256i mask256 = _mm256_setr_epi8(
+      7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,  //
+      7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+  for (; i + 4 <= count; i += 4) {
+    const __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i * 8));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i * 8),
+                        _mm256_shuffle_epi8(v, mask256));
+  }
+#endif
+#if defined(BIO_SIMD_SSSE3)
+  const __m128i mask =
+      _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+  for (; i + 2 <= count; i += 2) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i * 8));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i * 8),
+                     _mm_shuffle_epi8(v, mask));
+  }
+#elif defined(BIO_SIMD_SSE2)
+  // Swap the bytes of each 16-bit quarter, then reverse the quarters.
+  for (; i + 2 <= count; i += 2) {
+    __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i * 8));
+    v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+    v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i * 8), v);
+  }
+#elif defined(BIO_SIMD_NEON)
+  for (; i + 2 <= count; i += 2) {
+    vst1q_u8(d + i * 8, vrev64q_u8(vld1q_u8(s + i * 8)));
+  }
+#endif
+  for (; i < count; ++i) {
+    StoreNative(d + i * 8, ByteSwap64(LoadNative<uint64_t>(s + i * 8)));
+  }
+}
+
+}  // namespace detail
+
 /// @brief Codec that loads and stores integers in little-endian byte order.
 struct LittleEndianCodec {
   /// @brief Load a 16-bit unsigned integer from memory in little-endian order.
   /// @param p Pointer to at least 2 bytes of data.
   /// @return The decoded value.
-  static inline uint16_t LoadU16(const uint8_t* p) {
+  static BIO_CONSTEXPR20 uint16_t LoadU16(const uint8_t* p) {
+    if (!detail::IsConstantEvaluated()) {
+      if constexpr (detail::kHostLittleEndian) {
+        return detail::LoadNative<uint16_t>(p);
+      } else if constexpr (detail::kHostBigEndian) {
+        return detail::ByteSwap16(detail::LoadNative<uint16_t>(p));
+      }
+    }
     return static_cast<uint16_t>(static_cast<uint16_t>(p[0]) |
                                  (static_cast<uint16_t>(p[1]) << 8));
   }
   /// @brief Load a 32-bit unsigned integer from memory in little-endian order.
   /// @param p Pointer to at least 4 bytes of data.
   /// @return The decoded value.
-  static inline uint32_t LoadU32(const uint8_t* p) {
+  static BIO_CONSTEXPR20 uint32_t LoadU32(const uint8_t* p) {
+    if (!detail::IsConstantEvaluated()) {
+      if constexpr (detail::kHostLittleEndian) {
+        return detail::LoadNative<uint32_t>(p);
+      } else if constexpr (detail::kHostBigEndian) {
+        return detail::ByteSwap32(detail::LoadNative<uint32_t>(p));
+      }
+    }
     return (static_cast<uint32_t>(p[0]) << 0) |
            (static_cast<uint32_t>(p[1]) << 8) |
            (static_cast<uint32_t>(p[2]) << 16) |
@@ -78,7 +486,14 @@ struct LittleEndianCodec {
   /// @brief Load a 64-bit unsigned integer from memory in little-endian order.
   /// @param p Pointer to at least 8 bytes of data.
   /// @return The decoded value.
-  static inline uint64_t LoadU64(const uint8_t* p) {
+  static BIO_CONSTEXPR20 uint64_t LoadU64(const uint8_t* p) {
+    if (!detail::IsConstantEvaluated()) {
+      if constexpr (detail::kHostLittleEndian) {
+        return detail::LoadNative<uint64_t>(p);
+      } else if constexpr (detail::kHostBigEndian) {
+        return detail::ByteSwap64(detail::LoadNative<uint64_t>(p));
+      }
+    }
     return (static_cast<uint64_t>(p[0]) << 0) |
            (static_cast<uint64_t>(p[1]) << 8) |
            (static_cast<uint64_t>(p[2]) << 16) |
@@ -92,7 +507,16 @@ struct LittleEndianCodec {
   /// @brief Store a 16-bit unsigned integer to memory in little-endian order.
   /// @param p Pointer to at least 2 bytes of writable memory.
   /// @param v The value to encode.
-  static inline void StoreU16(uint8_t* p, uint16_t v) {
+  static BIO_CONSTEXPR20 void StoreU16(uint8_t* p, uint16_t v) {
+    if (!detail::IsConstantEvaluated()) {
+      if constexpr (detail::kHostLittleEndian) {
+        detail::StoreNative(p, v);
+        return;
+      } else if constexpr (detail::kHostBigEndian) {
+        detail::StoreNative(p, detail::ByteSwap16(v));
+        return;
+      }
+    }
     p[0] = static_cast<uint8_t>((v >> 0) & 0xFFu);
     p[1] = static_cast<uint8_t>((v >> 8) & 0xFFu);
   }
@@ -100,7 +524,16 @@ struct LittleEndianCodec {
   /// @brief Store a 32-bit unsigned integer to memory in little-endian order.
   /// @param p Pointer to at least 4 bytes of writable memory.
   /// @param v The value to encode.
-  static inline void StoreU32(uint8_t* p, uint32_t v) {
+  static BIO_CONSTEXPR20 void StoreU32(uint8_t* p, uint32_t v) {
+    if (!detail::IsConstantEvaluated()) {
+      if constexpr (detail::kHostLittleEndian) {
+        detail::StoreNative(p, v);
+        return;
+      } else if constexpr (detail::kHostBigEndian) {
+        detail::StoreNative(p, detail::ByteSwap32(v));
+        return;
+      }
+    }
     p[0] = static_cast<uint8_t>((v >> 0) & 0xFFu);
     p[1] = static_cast<uint8_t>((v >> 8) & 0xFFu);
     p[2] = static_cast<uint8_t>((v >> 16) & 0xFFu);
@@ -110,7 +543,16 @@ struct LittleEndianCodec {
   /// @brief Store a 64-bit unsigned integer to memory in little-endian order.
   /// @param p Pointer to at least 8 bytes of writable memory.
   /// @param v The value to encode.
-  static inline void StoreU64(uint8_t* p, uint64_t v) {
+  static BIO_CONSTEXPR20 void StoreU64(uint8_t* p, uint64_t v) {
+    if (!detail::IsConstantEvaluated()) {
+      if constexpr (detail::kHostLittleEndian) {
+        detail::StoreNative(p, v);
+        return;
+      } else if constexpr (detail::kHostBigEndian) {
+        detail::StoreNative(p, detail::ByteSwap64(v));
+        return;
+      }
+    }
     p[0] = static_cast<uint8_t>((v >> 0) & 0xFFu);
     p[1] = static_cast<uint8_t>((v >> 8) & 0xFFu);
     p[2] = static_cast<uint8_t>((v >> 16) & 0xFFu);
@@ -120,6 +562,111 @@ struct LittleEndianCodec {
     p[6] = static_cast<uint8_t>((v >> 48) & 0xFFu);
     p[7] = static_cast<uint8_t>((v >> 56) & 0xFFu);
   }
+
+  /// @brief Load @p count consecutive 16-bit words in little-endian order.
+  /// @param[out] out Destination for @p count host-order words; must not
+  ///                 overlap @p p.
+  /// @param p Pointer to at least @p count * 2 bytes of data.
+  /// @param count Number of words to load.
+  static inline void LoadArray16(void* out, const uint8_t* p, size_t count) {
+    if constexpr (detail::kHostLittleEndian) {
+      std::memcpy(out, p, count * 2);
+    } else if constexpr (detail::kHostBigEndian) {
+      detail::ByteSwapCopy16(out, p, count);
+    } else {
+      auto* d = static_cast<uint8_t*>(out);
+      for (size_t i = 0; i < count; ++i) {
+        detail::StoreNative(d + i * 2, LoadU16(p + i * 2));
+      }
+    }
+  }
+
+  /// @brief Load @p count consecutive 32-bit words in little-endian order.
+  /// @param[out] out Destination for @p count host-order words; must not
+  ///                 overlap @p p.
+  /// @param p Pointer to at least @p count * 4 bytes of data.
+  /// @param count Number of words to load.
+  static inline void LoadArray32(void* out, const uint8_t* p, size_t count) {
+    if constexpr (detail::kHostLittleEndian) {
+      std::memcpy(out, p, count * 4);
+    } else if constexpr (detail::kHostBigEndian) {
+      detail::ByteSwapCopy32(out, p, count);
+    } else {
+      auto* d = static_cast<uint8_t*>(out);
+      for (size_t i = 0; i < count; ++i) {
+        detail::StoreNative(d + i * 4, LoadU32(p + i * 4));
+      }
+    }
+  }
+
+  /// @brief Load @p count consecutive 64-bit words in little-endian order.
+  /// @param[out] out Destination for @p count host-order words; must not
+  ///                 overlap @p p.
+  /// @param p Pointer to at least @p count * 8 bytes of data.
+  /// @param count Number of words to load.
+  static inline void LoadArray64(void* out, const uint8_t* p, size_t count) {
+    if constexpr (detail::kHostLittleEndian) {
+      std::memcpy(out, p, count * 8);
+    } else if constexpr (detail::kHostBigEndian) {
+      detail::ByteSwapCopy64(out, p, count);
+    } else {
+      auto* d = static_cast<uint8_t*>(out);
+      for (size_t i = 0; i < count; ++i) {
+        detail::StoreNative(d + i * 8, LoadU64(p + i * 8));
+      }
+    }
+  }
+
+  /// @brief Store @p count consecutive 16-bit words in little-endian order.
+  /// @param p Pointer to at least @p count * 2 bytes of writable memory.
+  /// @param in Source of @p count host-order words; must not overlap @p p.
+  /// @param count Number of words to store.
+  static inline void StoreArray16(uint8_t* p, const void* in, size_t count) {
+    if constexpr (detail::kHostLittleEndian) {
+      std::memcpy(p, in, count * 2);
+    } else if constexpr (detail::kHostBigEndian) {
+      detail::ByteSwapCopy16(p, in, count);
+    } else {
+      const auto* s = static_cast<const uint8_t*>(in);
+      for (size_t i = 0; i < count; ++i) {
+        StoreU16(p + i * 2, detail::LoadNative<uint16_t>(s + i * 2));
+      }
+    }
+  }
+
+  /// @brief Store @p count consecutive 32-bit words in little-endian order.
+  /// @param p Pointer to at least @p count * 4 bytes of writable memory.
+  /// @param in Source of @p count host-order words; must not overlap @p p.
+  /// @param count Number of words to store.
+  static inline void StoreArray32(uint8_t* p, const void* in, size_t count) {
+    if constexpr (detail::kHostLittleEndian) {
+      std::memcpy(p, in, count * 4);
+    } else if constexpr (detail::kHostBigEndian) {
+      detail::ByteSwapCopy32(p, in, count);
+    } else {
+      const auto* s = static_cast<const uint8_t*>(in);
+      for (size_t i = 0; i < count; ++i) {
+        StoreU32(p + i * 4, detail::LoadNative<uint32_t>(s + i * 4));
+      }
+    }
+  }
+
+  /// @brief Store @p count consecutive 64-bit words in little-endian order.
+  /// @param p Pointer to at least @p count * 8 bytes of writable memory.
+  /// @param in Source of @p count host-order words; must not overlap @p p.
+  /// @param count Number of words to store.
+  static inline void StoreArray64(uint8_t* p, const void* in, size_t count) {
+    if constexpr (detail::kHostLittleEndian) {
+      std::memcpy(p, in, count * 8);
+    } else if constexpr (detail::kHostBigEndian) {
+      detail::ByteSwapCopy64(p, in, count);
+    } else {
+      const auto* s = static_cast<const uint8_t*>(in);
+      for (size_t i = 0; i < count; ++i) {
+        StoreU64(p + i * 8, detail::LoadNative<uint64_t>(s + i * 8));
+      }
+    }
+  }
 };
 
 /// @brief Codec that loads and stores integers in big-endian byte order.
@@ -127,14 +674,28 @@ struct BigEndianCodec {
   /// @brief Load a 16-bit unsigned integer from memory in big-endian order.
   /// @param p Pointer to at least 2 bytes of data.
   /// @return The decoded value.
-  static inline uint16_t LoadU16(const uint8_t* p) {
+  static BIO_CONSTEXPR20 uint16_t LoadU16(const uint8_t* p) {
+    if (!detail::IsConstantEvaluated()) {
+      if constexpr (detail::kHostBigEndian) {
+        return detail::LoadNative<uint16_t>(p);
+      } else if constexpr (detail::kHostLittleEndian) {
+        return detail::ByteSwap16(detail::LoadNative<uint16_t>(p));
+      }
+    }
     return static_cast<uint16_t>((static_cast<uint16_t>(p[0]) << 8) |
                                  static_cast<uint16_t>(p[1]));
   }
   /// @brief Load a 32-bit unsigned integer from memory in big-endian order.
   /// @param p Pointer to at least 4 bytes of data.
   /// @return The decoded value.
-  static inline uint32_t LoadU32(const uint8_t* p) {
+  static BIO_CONSTEXPR20 uint32_t LoadU32(const uint8_t* p) {
+    if (!detail::IsConstantEvaluated()) {
+      if constexpr (detail::kHostBigEndian) {
+        return detail::LoadNative<uint32_t>(p);
+      } else if constexpr (detail::kHostLittleEndian) {
+        return detail::ByteSwap32(detail::LoadNative<uint32_t>(p));
+      }
+    }
     return (static_cast<uint32_t>(p[0]) << 24) |
            (static_cast<uint32_t>(p[1]) << 16) |
            (static_cast<uint32_t>(p[2]) << 8) |
@@ -144,7 +705,14 @@ struct BigEndianCodec {
   /// @brief Load a 64-bit unsigned integer from memory in big-endian order.
   /// @param p Pointer to at least 8 bytes of data.
   /// @return The decoded value.
-  static inline uint64_t LoadU64(const uint8_t* p) {
+  static BIO_CONSTEXPR20 uint64_t LoadU64(const uint8_t* p) {
+    if (!detail::IsConstantEvaluated()) {
+      if constexpr (detail::kHostBigEndian) {
+        return detail::LoadNative<uint64_t>(p);
+      } else if constexpr (detail::kHostLittleEndian) {
+        return detail::ByteSwap64(detail::LoadNative<uint64_t>(p));
+      }
+    }
     return (static_cast<uint64_t>(p[0]) << 56) |
            (static_cast<uint64_t>(p[1]) << 48) |
            (static_cast<uint64_t>(p[2]) << 40) |
@@ -158,7 +726,16 @@ struct BigEndianCodec {
   /// @brief Store a 16-bit unsigned integer to memory in big-endian order.
   /// @param p Pointer to at least 2 bytes of writable memory.
   /// @param v The value to encode.
-  static inline void StoreU16(uint8_t* p, uint16_t v) {
+  static BIO_CONSTEXPR20 void StoreU16(uint8_t* p, uint16_t v) {
+    if (!detail::IsConstantEvaluated()) {
+      if constexpr (detail::kHostBigEndian) {
+        detail::StoreNative(p, v);
+        return;
+      } else if constexpr (detail::kHostLittleEndian) {
+        detail::StoreNative(p, detail::ByteSwap16(v));
+        return;
+      }
+    }
     p[0] = static_cast<uint8_t>((v >> 8) & 0xFFu);
     p[1] = static_cast<uint8_t>((v >> 0) & 0xFFu);
   }
@@ -166,7 +743,16 @@ struct BigEndianCodec {
   /// @brief Store a 32-bit unsigned integer to memory in big-endian order.
   /// @param p Pointer to at least 4 bytes of writable memory.
   /// @param v The value to encode.
-  static inline void StoreU32(uint8_t* p, uint32_t v) {
+  static BIO_CONSTEXPR20 void StoreU32(uint8_t* p, uint32_t v) {
+    if (!detail::IsConstantEvaluated()) {
+      if constexpr (detail::kHostBigEndian) {
+        detail::StoreNative(p, v);
+        return;
+      } else if constexpr (detail::kHostLittleEndian) {
+        detail::StoreNative(p, detail::ByteSwap32(v));
+        return;
+      }
+    }
     p[0] = static_cast<uint8_t>((v >> 24) & 0xFFu);
     p[1] = static_cast<uint8_t>((v >> 16) & 0xFFu);
     p[2] = static_cast<uint8_t>((v >> 8) & 0xFFu);
@@ -176,7 +762,16 @@ struct BigEndianCodec {
   /// @brief Store a 64-bit unsigned integer to memory in big-endian order.
   /// @param p Pointer to at least 8 bytes of writable memory.
   /// @param v The value to encode.
-  static inline void StoreU64(uint8_t* p, uint64_t v) {
+  static BIO_CONSTEXPR20 void StoreU64(uint8_t* p, uint64_t v) {
+    if (!detail::IsConstantEvaluated()) {
+      if constexpr (detail::kHostBigEndian) {
+        detail::StoreNative(p, v);
+        return;
+      } else if constexpr (detail::kHostLittleEndian) {
+        detail::StoreNative(p, detail::ByteSwap64(v));
+        return;
+      }
+    }
     p[0] = static_cast<uint8_t>((v >> 56) & 0xFFu);
     p[1] = static_cast<uint8_t>((v >> 48) & 0xFFu);
     p[2] = static_cast<uint8_t>((v >> 40) & 0xFFu);
@@ -186,6 +781,527 @@ struct BigEndianCodec {
     p[6] = static_cast<uint8_t>((v >> 8) & 0xFFu);
     p[7] = static_cast<uint8_t>((v >> 0) & 0xFFu);
   }
+
+  /// @brief Load @p count consecutive 16-bit words in big-endian order.
+  /// @param[out] out Destination for @p count host-order words; must not
+  ///                 overlap @p p.
+  /// @param p Pointer to at least @p count * 2 bytes of data.
+  /// @param count Number of words to load.
+  static inline void LoadArray16(void* out, const uint8_t* p, size_t count) {
+    if constexpr (detail::kHostBigEndian) {
+      std::memcpy(out, p, count * 2);
+    } else if constexpr (detail::kHostLittleEndian) {
+      detail::ByteSwapCopy16(out, p, count);
+    } else {
+      auto* d = static_cast<uint8_t*>(out);
+      for (size_t i = 0; i < count; ++i) {
+        detail::StoreNative(d + i * 2, LoadU16(p + i * 2));
+      }
+    }
+  }
+
+  /// @brief Load @p count consecutive 32-bit words in big-endian order.
+  /// @param[out] out Destination for @p count host-order words; must not
+  ///                 overlap @p p.
+  /// @param p Pointer to at least @p count * 4 bytes of data.
+  /// @param count Number of words to load.
+  static inline void LoadArray32(void* out, const uint8_t* p, size_t count) {
+    if constexpr (detail::kHostBigEndian) {
+      std::memcpy(out, p, count * 4);
+    } else if constexpr (detail::kHostLittleEndian) {
+      detail::ByteSwapCopy32(out, p, count);
+    } else {
+      auto* d = static_cast<uint8_t*>(out);
+      for (size_t i = 0; i < count; ++i) {
+        detail::StoreNative(d + i * 4, LoadU32(p + i * 4));
+      }
+    }
+  }
+
+  /// @brief Load @p count consecutive 64-bit words in big-endian order.
+  /// @param[out] out Destination for @p count host-order words; must not
+  ///                 overlap @p p.
+  /// @param p Pointer to at least @p count * 8 bytes of data.
+  /// @param count Number of words to load.
+  static inline void LoadArray64(void* out, const uint8_t* p, size_t count) {
+    if constexpr (detail::kHostBigEndian) {
+      std::memcpy(out, p, count * 8);
+    } else if constexpr (detail::kHostLittleEndian) {
+      detail::ByteSwapCopy64(out, p, count);
+    } else {
+      auto* d = static_cast<uint8_t*>(out);
+      for (size_t i = 0; i < count; ++i) {
+        detail::StoreNative(d + i * 8, LoadU64(p + i * 8));
+      }
+    }
+  }
+
+  /// @brief Store @p count consecutive 16-bit words in big-endian order.
+  /// @param p Pointer to at least @p count * 2 bytes of writable memory.
+  /// @param in Source of @p count host-order words; must not overlap @p p.
+  /// @param count Number of words to store.
+  static inline void StoreArray16(uint8_t* p, const void* in, size_t count) {
+    if constexpr (detail::kHostBigEndian) {
+      std::memcpy(p, in, count * 2);
+    } else if constexpr (detail::kHostLittleEndian) {
+      detail::ByteSwapCopy16(p, in, count);
+    } else {
+      const auto* s = static_cast<const uint8_t*>(in);
+      for (size_t i = 0; i < count; ++i) {
+        StoreU16(p + i * 2, detail::LoadNative<uint16_t>(s + i * 2));
+      }
+    }
+  }
+
+  /// @brief Store @p count consecutive 32-bit words in big-endian order.
+  /// @param p Pointer to at least @p count * 4 bytes of writable memory.
+  /// @param in Source of @p count host-order words; must not overlap @p p.
+  /// @param count Number of words to store.
+  static inline void StoreArray32(uint8_t* p, const void* in, size_t count) {
+    if constexpr (detail::kHostBigEndian) {
+      std::memcpy(p, in, count * 4);
+    } else if constexpr (detail::kHostLittleEndian) {
+      detail::ByteSwapCopy32(p, in, count);
+    } else {
+      const auto* s = static_cast<const uint8_t*>(in);
+      for (size_t i = 0; i < count; ++i) {
+        StoreU32(p + i * 4, detail::LoadNative<uint32_t>(s + i * 4));
+      }
+    }
+  }
+
+  /// @brief Store @p count consecutive 64-bit words in big-endian order.
+  /// @param p Pointer to at least @p count * 8 bytes of writable memory.
+  /// @param in Source of @p count host-order words; must not overlap @p p.
+  /// @param count Number of words to store.
+  static inline void StoreArray64(uint8_t* p, const void* in, size_t count) {
+    if constexpr (detail::kHostBigEndian) {
+      std::memcpy(p, in, count * 8);
+    } else if constexpr (detail::kHostLittleEndian) {
+      detail::ByteSwapCopy64(p, in, count);
+    } else {
+      const auto* s = static_cast<const uint8_t*>(in);
+      for (size_t i = 0; i < count; ++i) {
+        StoreU64(p + i * 8, detail::LoadNative<uint64_t>(s + i * 8));
+      }
+    }
+  }
+};
+
+namespace detail {
+
+/// @brief Decode a @p T from its @c sizeof(T) bytes at @p p in @p Codec
+///        order.
+template <typename Codec, typename T>
+BIO_CONSTEXPR20 inline T LoadValue(const uint8_t* p) {
+  if constexpr (sizeof(T) == 1) {
+    return BitCast<T>(p[0]);
+  } else if constexpr (sizeof(T) == 2) {
+    return BitCast<T>(Codec::LoadU16(p));
+  } else if constexpr (sizeof(T) == 4) {
+    return BitCast<T>(Codec::LoadU32(p));
+  } else {
+    static_assert(sizeof(T) == 8, "unsupported word width");
+    return BitCast<T>(Codec::LoadU64(p));
+  }
+}
+
+/// @brief Encode @p v into @c sizeof(T) bytes at @p p in @p Codec order.
+template <typename Codec, typename T>
+BIO_CONSTEXPR20 inline void StoreValue(uint8_t* p, T v) {
+  if constexpr (sizeof(T) == 1) {
+    p[0] = BitCast<uint8_t>(v);
+  } else if constexpr (sizeof(T) == 2) {
+    Codec::StoreU16(p, BitCast<uint16_t>(v));
+  } else if constexpr (sizeof(T) == 4) {
+    Codec::StoreU32(p, BitCast<uint32_t>(v));
+  } else {
+    static_assert(sizeof(T) == 8, "unsupported word width");
+    Codec::StoreU64(p, BitCast<uint64_t>(v));
+  }
+}
+
+/// @brief Decode @p count values into @p out with the codec's bulk kernels,
+///        or one value at a time during constant evaluation.
+template <typename Codec, typename T>
+BIO_CONSTEXPR20 inline void LoadValues(T* out, const uint8_t* p, size_t count) {
+  // An empty array may come with null pointers, which memcpy must not see.
+  if (count == 0) return;
+  if (IsConstantEvaluated()) {
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = LoadValue<Codec, T>(p + i * sizeof(T));
+    }
+  } else if constexpr (sizeof(T) == 2) {
+    Codec::LoadArray16(out, p, count);
+  } else if constexpr (sizeof(T) == 4) {
+    Codec::LoadArray32(out, p, count);
+  } else {
+    static_assert(sizeof(T) == 8, "unsupported word width");
+    Codec::LoadArray64(out, p, count);
+  }
+}
+
+/// @brief Encode @p count values from @p in; see @ref LoadValues().
+template <typename Codec, typename T>
+BIO_CONSTEXPR20 inline void StoreValues(uint8_t* p, const T* in,
+                                        size_t count) {
+  if (count == 0) return;
+  if (IsConstantEvaluated()) {
+    for (size_t i = 0; i < count; ++i) {
+      StoreValue<Codec>(p + i * sizeof(T), in[i]);
+    }
+  } else if constexpr (sizeof(T) == 2) {
+    Codec::StoreArray16(p, in, count);
+  } else if constexpr (sizeof(T) == 4) {
+    Codec::StoreArray32(p, in, count);
+  } else {
+    static_assert(sizeof(T) == 8, "unsupported word width");
+    Codec::StoreArray64(p, in, count);
+  }
+}
+
+}  // namespace detail
+
+#if defined(__cpp_lib_span) && __cpp_lib_span >= 202002L
+/// @brief Borrowed, read-only view of a byte range inside a reader's buffer.
+using ByteView = std::span<const uint8_t>;
+#else
+/// @brief Borrowed, read-only view of a byte range inside a reader's buffer.
+///
+/// A minimal stand-in for @c std::span<const uint8_t> on C++17. The view
+/// does not own its bytes; it stays valid only as long as the underlying
+/// buffer does.
+class ByteView {
+ public:
+  using element_type = const uint8_t;
+  using value_type = uint8_t;
+  using size_type = size_t;
+  using iterator = const uint8_t*;
+
+  /// @brief Construct an empty view.
+  constexpr ByteView() = default;
+
+  /// @brief Construct a view over @p size bytes starting at @p data.
+  constexpr ByteView(const uint8_t* data, size_t size)
+      : data_(data), size_(size) {}
+
+  /// @brief Return a pointer to the first byte of the view.
+  constexpr const uint8_t* data() const { return data_; }
+
+  /// @brief Return the number of bytes in the view.
+  constexpr size_t size() const { return size_; }
+
+  /// @brief Return @c true if the view contains no bytes.
+  constexpr bool empty() const { return size_ == 0; }
+
+  /// @brief Return the byte at @p i. @pre @p i < size().
+  constexpr const uint8_t& operator[](size_t i) const { return data_[i]; }
+
+  /// @brief Return an iterator to the first byte.
+  constexpr iterator begin() const { return data_; }
+
+  /// @brief Return an iterator one past the last byte.
+  constexpr iterator end() const { return data_ + size_; }
+
+ private:
+  const uint8_t* data_ = nullptr;
+  size_t size_ = 0;
+};
+#endif
+
+namespace detail {
+
+/// @brief Return the index of the lowest set bit of @p v. @pre @p v != 0.
+BIO_CONSTEXPR20 inline unsigned CountTrailingZeros64(uint64_t v) {
+#if defined(__cpp_lib_bitops)
+  return static_cast<unsigned>(std::countr_zero(v));
+#elif defined(__GNUC__) || defined(__clang__)
+  return static_cast<unsigned>(__builtin_ctzll(v));
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+  unsigned long index;
+  _BitScanForward64(&index, v);
+  return static_cast<unsigned>(index);
+#else
+  unsigned n = 0;
+  for (; (v & 1) == 0; v >>= 1) ++n;
+  return n;
+#endif
+}
+
+/// @brief Return the index of the highest set bit of @p v. @pre @p v != 0.
+BIO_CONSTEXPR20 inline unsigned HighestBit64(uint64_t v) {
+#if defined(__cpp_lib_bitops)
+  return 63 - static_cast<unsigned>(std::countl_zero(v));
+#elif defined(__GNUC__) || defined(__clang__)
+  return 63 - static_cast<unsigned>(__builtin_clzll(v));
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+  unsigned long index;
+  _BitScanReverse64(&index, v);
+  return static_cast<unsigned>(index);
+#else
+  unsigned n = 0;
+  while (v >>= 1) ++n;
+  return n;
+#endif
+}
+
+/// @brief Longest LEB128 encoding of a 64-bit value.
+inline constexpr size_t kMaxVarintBytes = 10;
+
+/// @brief Return the number of bytes LEB128 needs for @p v.
+BIO_CONSTEXPR20 inline size_t VarintSize(uint64_t v) {
+  // Seven value bits per byte: ceil((HighestBit + 1) / 7) without a divide.
+  return (HighestBit64(v | 1) * 9 + 73) / 64;
+}
+
+/// @brief Map a signed value to unsigned so that small magnitudes of either
+///        sign stay small: 0, -1, 1, -2, ... become 0, 1, 2, 3, ...
+BIO_CONSTEXPR20 inline uint64_t ZigZagEncode(int64_t v) {
+  return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+/// @brief Inverse of @ref ZigZagEncode().
+BIO_CONSTEXPR20 inline int64_t ZigZagDecode(uint64_t v) {
+  return static_cast<int64_t>((v >> 1) ^ (~(v & 1) + 1));
+}
+
+/// @brief Decode an unsigned LEB128 value from the @p n bytes at @p p.
+///
+/// One-byte values take a single compare. With 8 bytes readable, the rest
+/// load as one little-endian word: a bit scan over the inverted
+/// continuation bits finds the last byte, and three shift-and-mask steps
+/// squeeze the 7-bit groups together, so the cost does not grow with the
+/// encoded length. Only 9- and 10-byte encodings, and buffers ending in
+/// fewer than 8 bytes, go byte by byte.
+///
+/// @param[out] out Receives the value on success; untouched otherwise.
+/// @return The encoded length, or 0 if the bytes end before the last one or
+///         the value does not fit in 64 bits.
+BIO_CONSTEXPR20 inline size_t DecodeVarint(const uint8_t* p, size_t n,
+                                            uint64_t& out) {
+  if (n != 0 && p[0] < 0x80) {
+    out = p[0];
+    return 1;
+  }
+  if (n >= 8) {
+    const uint64_t word = LittleEndianCodec::LoadU64(p);
+    const uint64_t stops = ~word & 0x8080808080808080u;
+    const unsigned last = stops != 0 ? CountTrailingZeros64(stops) : 63;
+    uint64_t v = word & 0x7F7F7F7F7F7F7F7Fu & (~uint64_t{0} >> (63 - last));
+    v = (v & 0x007F007F007F007Fu) | ((v & 0x7F007F007F007F00u) >> 1);
+    v = (v & 0x00003FFF00003FFFu) | ((v & 0x3FFF00003FFF0000u) >> 2);
+    v = (v & 0x000000000FFFFFFFu) | ((v & 0x0FFFFFFF00000000u) >> 4);
+    if (stops != 0) {
+      out = v;
+      return last / 8 + 1;
+    }
+    if (n < 9) return 0;
+    const uint64_t b8 = p[8];
+    if (b8 < 0x80) {
+      out = v | (b8 << 56);
+      return 9;
+    }
+    if (n < 10 || p[9] > 1) return 0;
+    out = v | ((b8 & 0x7F) << 56) | (uint64_t{p[9]} << 63);
+    return 10;
+  }
+  uint64_t v = 0;
+  for (size_t i = 0; i < n; ++i) {
+    v |= static_cast<uint64_t>(p[i] & 0x7F) << (7 * i);
+    if (p[i] < 0x80) {
+      out = v;
+      return i + 1;
+    }
+  }
+  return 0;
+}
+
+/// @brief Encode @p v as unsigned LEB128 at @p p, which must have room for
+///        @ref VarintSize(v) bytes.
+/// @return The encoded length.
+BIO_CONSTEXPR20 inline size_t EncodeVarint(uint8_t* p, uint64_t v) {
+  size_t len = 0;
+  for (; v >= 0x80; v >>= 7) {
+    p[len++] = static_cast<uint8_t>(v | 0x80);
+  }
+  p[len++] = static_cast<uint8_t>(v);
+  return len;
+}
+
+/// @brief Return the offset of the first copy of the @p len bytes at
+///        @p needle in [@p p, @p p + @p n), or @p n if there is none.
+///
+/// The vector paths compare a block of candidate starts against the first
+/// and the last needle byte at once and only @c memcmp() the candidates that
+/// match both, so a common first byte does not stall the scan. The tail,
+/// and targets without SIMD, use @c memchr() on the first byte followed by a
+/// verify step. One-byte needles always go straight to @c memchr().
+inline size_t FindBytes(const uint8_t* p, size_t n, const uint8_t* needle,
+                        size_t len) {
+  if (len == 0) return 0;
+  if (len > n) return n;
+  // Candidate starts are [0, end); a vector step covers kLanes of them.
+  const size_t end = n - len + 1;
+  size_t i = 0;
+#if defined(BIO_SIMD_AVX2)
+  if (len > 1) {
+    const __m256i first = _mm256_set1_epi8(static_cast<char>(needle[0]));
+    const __m256i last = _mm256_set1_epi8(static_cast<char>(needle[len - 1]));
+    for (; i + 32 <= end; i += 32) {
+      const __m256i a =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+      const __m256i b =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + len - 1));
+      uint64_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+          _mm256_and_si256(_mm256_cmpeq_epi8(a, first),
+                           _mm256_cmpeq_epi8(b, last))));
+      for (; mask != 0; mask &= mask - 1) {
+        const size_t at = i + CountTrailingZeros64(mask);
+        if (std::memcmp(p + at + 1, needle + 1, len - 2) == 0) return at;
+      }
+    }
+  }
+#endif
+#if defined(BIO_SIMD_SSE2)
+  if (len > 1) {
+    const __m128i first = _mm_set1_epi8(static_cast<char>(needle[0]));
+    const __m128i last = _mm_set1_epi8(static_cast<char>(needle[len - 1]));
+    for (; i + 16 <= end; i += 16) {
+      const __m128i a =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+      const __m128i b =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + len - 1));
+      uint64_t mask = static_cast<uint32_t>(_mm_movemask_epi8(
+          _mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last))));
+      for (; mask != 0; mask &= mask - 1) {
+        const size_t at = i + CountTrailingZeros64(mask);
+        if (std::memcmp(p + at + 1, needle + 1, len - 2) == 0) return at;
+      }
+    }
+  }
+#elif defined(BIO_SIMD_NEON)
+  if (len > 1) {
+    const uint8x16_t first = vdupq_n_u8(needle[0]);
+    const uint8x16_t last = vdupq_n_u8(needle[len - 1]);
+    for (; i + 16 <= end; i += 16) {
+      const uint8x16_t eq = vandq_u8(vceqq_u8(vld1q_u8(p + i), first),
+                                     vceqq_u8(vld1q_u8(p + i + len - 1), last));
+      // Narrow each 0x00/0xFF lane to a nibble: bit 4k is set for lane k.
+      uint64_t mask = vget_lane_u64(
+          vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+      mask &= 0x1111111111111111u;
+      for (; mask != 0; mask &= mask - 1) {
+        const size_t at = i + CountTrailingZeros64(mask) / 4;
+        if (std::memcmp(p + at + 1, needle + 1, len - 2) == 0) return at;
+      }
+    }
+  }
+#endif
+  while (i < end) {
+    const void* hit = std::memchr(p + i, needle[0], end - i);
+    if (hit == nullptr) break;
+    i = static_cast<size_t>(static_cast<const uint8_t*>(hit) - p);
+    if (std::memcmp(p + i + 1, needle + 1, len - 1) == 0) return i;
+    ++i;
+  }
+  return n;
+}
+
+}  // namespace detail
+
+/// @brief Default instrumentation policy of the readers and writers: every
+///        hook is a no-op, so instrumented code compiles to nothing.
+///
+/// A policy is a stateless type with the same three static members. bio-gen
+/// emits @ref InstrumentProbe calls when run with @c --instrument; the
+/// policy of the reader or writer passed to @c parse() / @c serialize() then
+/// decides where the counts go. See binary-io/instrumentation.hpp for a
+/// policy that aggregates them per thread.
+struct NoInstrument {
+  /// @brief Whether probes record anything at all.
+  static constexpr bool kEnabled = false;
+
+  /// @brief Read the clock used for the @c cycles argument of @ref Record().
+  static constexpr uint64_t Now() { return 0; }
+
+  /// @brief Called once per probed call site.
+  /// @param site Static string naming the struct, operation and field.
+  /// @param bytes Bytes consumed or produced.
+  /// @param ok Whether the call succeeded.
+  /// @param cycles Difference of two @ref Now() readings around the call.
+  static constexpr void Record(const char* site, size_t bytes, bool ok,
+                               uint64_t cycles) {
+    static_cast<void>(site);
+    static_cast<void>(bytes);
+    static_cast<void>(ok);
+    static_cast<void>(cycles);
+  }
+};
+
+namespace detail {
+
+template <typename Stream, typename = void>
+struct InstrumentOf {
+  using type = NoInstrument;
+};
+
+template <typename Stream>
+struct InstrumentOf<Stream, std::void_t<typename Stream::instrument_type>> {
+  using type = typename Stream::instrument_type;
+};
+
+}  // namespace detail
+
+/// @brief The instrumentation policy of @p Stream, or @ref NoInstrument for
+///        readers and writers without one.
+template <typename Stream>
+using InstrumentOfT = typename detail::InstrumentOf<Stream>::type;
+
+/// @brief Scope guard that reports one call to the instrumentation policy of
+///        @p Stream: the bytes the stream moved, whether @ref succeed() was
+///        reached, and the elapsed clock.
+///
+/// With a disabled policy this is an empty type whose members do nothing.
+template <typename Stream, typename Instrument = InstrumentOfT<Stream>,
+          bool = Instrument::kEnabled>
+class InstrumentProbe {
+ public:
+  /// @brief Start a probe for @p site on @p stream.
+  constexpr InstrumentProbe(const Stream& stream, const char* site) {
+    static_cast<void>(stream);
+    static_cast<void>(site);
+  }
+
+  /// @brief Mark the probed call as successful.
+  constexpr void succeed() {}
+};
+
+/// @brief Enabled @ref InstrumentProbe: records on destruction.
+template <typename Stream, typename Instrument>
+class InstrumentProbe<Stream, Instrument, true> {
+ public:
+  InstrumentProbe(const Stream& stream, const char* site)
+      : stream_(stream),
+        site_(site),
+        start_(stream.position()),
+        begin_(Instrument::Now()) {}
+
+  InstrumentProbe(const InstrumentProbe&) = delete;
+  InstrumentProbe& operator=(const InstrumentProbe&) = delete;
+
+  ~InstrumentProbe() {
+    Instrument::Record(site_, stream_.position() - start_, ok_,
+                       Instrument::Now() - begin_);
+  }
+
+  void succeed() { ok_ = true; }
+
+ private:
+  const Stream& stream_;
+  const char* site_;
+  size_t start_;
+  uint64_t begin_;
+  bool ok_ = false;
 };
 
 /// @brief Byte reader that deserializes primitives from a fixed-size buffer.
@@ -196,29 +1312,41 @@ struct BigEndianCodec {
 ///
 /// @tparam Codec Byte-order codec (e.g. @ref LittleEndianCodec,
 ///               @ref BigEndianCodec).
-template <typename Codec>
+/// @tparam Instrument Instrumentation policy for generated code that reads
+///                    through this reader; see @ref NoInstrument.
+template <typename Codec, typename Instrument = NoInstrument>
 class ByteReaderT {
  public:
+  using codec_type = Codec;  ///< Byte-order codec of this reader.
+  using instrument_type = Instrument;  ///< Instrumentation policy.
+
   /// @brief Construct a reader over an existing buffer.
   /// @param data Pointer to the beginning of the buffer.
   /// @param size Size of the buffer in bytes.
   ByteReaderT(const void* data, size_t size)
       : p_(static_cast<const uint8_t*>(data)), n_(size), size_(size) {}
 
+  /// @brief Construct a reader over a @c uint8_t buffer; unlike the @c void*
+  ///        overload, this one is usable in constant expressions.
+  template <typename Byte,
+            typename = std::enable_if_t<std::is_same_v<Byte, uint8_t>>>
+  BIO_CONSTEXPR20 ByteReaderT(const Byte* data, size_t size)
+      : p_(data), n_(size), size_(size) {}
+
   /// @brief Return the number of bytes remaining to be read.
   /// @return Remaining byte count.
-  size_t remaining() const { return n_; }
+  BIO_CONSTEXPR20 size_t remaining() const { return n_; }
 
   /// @brief Return the current read position (bytes consumed so far).
   /// @return Current byte offset from the start of the buffer.
-  size_t position() const { return size_ - n_; }
+  BIO_CONSTEXPR20 size_t position() const { return size_ - n_; }
 
   /// @brief Read an unsigned 8-bit integer.
   /// @param[out] out Receives the read value on success.
   /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
   ///         than 1 byte remains.
-  Status read_u8(uint8_t& out) {
-    if (1 > n_) return Status::OutOfRange();
+  BIO_CONSTEXPR20 Status read_u8(uint8_t& out) {
+    if (1 > n_) return Status::OutOfRange(position());
     out = *p_++;
     --n_;
     return Status::Ok();
@@ -228,8 +1356,8 @@ class ByteReaderT {
   /// @param[out] out Receives the read value on success.
   /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
   ///         than 2 bytes remain.
-  Status read_u16(uint16_t& out) {
-    if (sizeof(uint16_t) > n_) return Status::OutOfRange();
+  BIO_CONSTEXPR20 Status read_u16(uint16_t& out) {
+    if (sizeof(uint16_t) > n_) return Status::OutOfRange(position());
     out = Codec::LoadU16(p_);
     p_ += sizeof(uint16_t);
     n_ -= sizeof(uint16_t);
@@ -240,8 +1368,8 @@ class ByteReaderT {
   /// @param[out] out Receives the read value on success.
   /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
   ///         than 4 bytes remain.
-  Status read_u32(uint32_t& out) {
-    if (sizeof(uint32_t) > n_) return Status::OutOfRange();
+  BIO_CONSTEXPR20 Status read_u32(uint32_t& out) {
+    if (sizeof(uint32_t) > n_) return Status::OutOfRange(position());
     out = Codec::LoadU32(p_);
     p_ += sizeof(uint32_t);
     n_ -= sizeof(uint32_t);
@@ -252,8 +1380,8 @@ class ByteReaderT {
   /// @param[out] out Receives the read value on success.
   /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
   ///         than 8 bytes remain.
-  Status read_u64(uint64_t& out) {
-    if (sizeof(uint64_t) > n_) return Status::OutOfRange();
+  BIO_CONSTEXPR20 Status read_u64(uint64_t& out) {
+    if (sizeof(uint64_t) > n_) return Status::OutOfRange(position());
     out = Codec::LoadU64(p_);
     p_ += sizeof(uint64_t);
     n_ -= sizeof(uint64_t);
@@ -264,10 +1392,10 @@ class ByteReaderT {
   /// @param[out] out Receives the read value on success.
   /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
   ///         than 1 byte remains.
-  Status read_i8(int8_t& out) {
+  BIO_CONSTEXPR20 Status read_i8(int8_t& out) {
     uint8_t bits = 0;
-    if (!read_u8(bits)) return Status::OutOfRange();
-    std::memcpy(&out, &bits, sizeof(bits));
+    if (!read_u8(bits)) return Status::OutOfRange(position());
+    out = detail::BitCast<int8_t>(bits);
     return Status::Ok();
   }
 
@@ -275,10 +1403,10 @@ class ByteReaderT {
   /// @param[out] out Receives the read value on success.
   /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
   ///         than 2 bytes remain.
-  Status read_i16(int16_t& out) {
+  BIO_CONSTEXPR20 Status read_i16(int16_t& out) {
     uint16_t bits = 0;
-    if (!read_u16(bits)) return Status::OutOfRange();
-    std::memcpy(&out, &bits, sizeof(bits));
+    if (!read_u16(bits)) return Status::OutOfRange(position());
+    out = detail::BitCast<int16_t>(bits);
     return Status::Ok();
   }
 
@@ -286,10 +1414,10 @@ class ByteReaderT {
   /// @param[out] out Receives the read value on success.
   /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
   ///         than 4 bytes remain.
-  Status read_i32(int32_t& out) {
+  BIO_CONSTEXPR20 Status read_i32(int32_t& out) {
     uint32_t bits = 0;
-    if (!read_u32(bits)) return Status::OutOfRange();
-    std::memcpy(&out, &bits, sizeof(bits));
+    if (!read_u32(bits)) return Status::OutOfRange(position());
+    out = detail::BitCast<int32_t>(bits);
     return Status::Ok();
   }
 
@@ -297,10 +1425,10 @@ class ByteReaderT {
   /// @param[out] out Receives the read value on success.
   /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
   ///         than 8 bytes remain.
-  Status read_i64(int64_t& out) {
+  BIO_CONSTEXPR20 Status read_i64(int64_t& out) {
     uint64_t bits = 0;
-    if (!read_u64(bits)) return Status::OutOfRange();
-    std::memcpy(&out, &bits, sizeof(bits));
+    if (!read_u64(bits)) return Status::OutOfRange(position());
+    out = detail::BitCast<int64_t>(bits);
     return Status::Ok();
   }
 
@@ -308,11 +1436,11 @@ class ByteReaderT {
   /// @param[out] out Receives the read value on success.
   /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
   ///         than 4 bytes remain.
-  Status read_f32(float& out) {
+  BIO_CONSTEXPR20 Status read_f32(float& out) {
     static_assert(sizeof(float) == 4, "float must be 32-bit");
     uint32_t bits = 0;
-    if (!read_u32(bits)) return Status::OutOfRange();
-    std::memcpy(&out, &bits, sizeof(bits));
+    if (!read_u32(bits)) return Status::OutOfRange(position());
+    out = detail::BitCast<float>(bits);
     return Status::Ok();
   }
 
@@ -320,212 +1448,2530 @@ class ByteReaderT {
   /// @param[out] out Receives the read value on success.
   /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
   ///         than 8 bytes remain.
-  Status read_f64(double& out) {
+  BIO_CONSTEXPR20 Status read_f64(double& out) {
     static_assert(sizeof(double) == 8, "double must be 64-bit");
     uint64_t bits = 0;
-    if (!read_u64(bits)) return Status::OutOfRange();
-    std::memcpy(&out, &bits, sizeof(bits));
+    if (!read_u64(bits)) return Status::OutOfRange(position());
+    out = detail::BitCast<double>(bits);
     return Status::Ok();
   }
 
-  /// @brief Read a sequence of raw bytes into a caller-provided buffer.
-  /// @param[out] out Destination buffer; must be at least @p len bytes.
-  /// @param len Number of bytes to read.
-  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
-  ///         than @p len bytes remain.
-  Status read_bytes(void* out, size_t len) {
-    if (len > n_) return Status::OutOfRange();
-    std::memcpy(out, p_, len);
+  /// @brief Read an unsigned LEB128 variable-length integer.
+  ///
+  /// Each byte carries seven value bits, least significant group first, and
+  /// sets its high bit if another byte follows; values below 128 take one
+  /// byte and a 64-bit value at most ten. The encoding is the same in either
+  /// byte order. See @ref detail::DecodeVarint() for the word-at-a-time fast
+  /// path.
+  ///
+  /// @param[out] out Receives the decoded value on success.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if the
+  ///         buffer ends before the last byte or the value overflows 64
+  ///         bits. The cursor does not move on failure.
+  BIO_CONSTEXPR20 Status read_varuint(uint64_t& out) {
+    const size_t len = detail::DecodeVarint(p_, n_, out);
+    if (len == 0) return Status::OutOfRange(position());
     p_ += len;
     n_ -= len;
     return Status::Ok();
   }
 
-  /// @brief Advance the read cursor without reading any data.
-  /// @param len Number of bytes to skip.
-  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
-  ///         than @p len bytes remain.
-  Status skip(size_t len) {
-    if (len > n_) return Status::OutOfRange();
-    p_ += len;
-    n_ -= len;
+  /// @brief Read a zigzag-encoded signed LEB128 integer.
+  ///
+  /// Zigzag interleaves signs (0, -1, 1, -2, ... encode as 0, 1, 2, 3, ...),
+  /// so small negative values stay short; see @ref read_varuint().
+  BIO_CONSTEXPR20 Status read_varint(int64_t& out) {
+    uint64_t bits = 0;
+    if (!read_varuint(bits)) return Status::OutOfRange(position());
+    out = detail::ZigZagDecode(bits);
     return Status::Ok();
   }
 
- private:
-  const uint8_t* p_;  ///< Current read position.
-  size_t n_;          ///< Remaining bytes.
-  size_t size_;       ///< Total buffer size.
-};
-
-/// @brief Byte writer that serializes primitives into a fixed-size buffer.
-///
-/// Writes are performed sequentially; the internal cursor advances after each
-/// successful write. Every write method returns a @ref Status indicating
-/// whether enough space was available.
-///
-/// @tparam Codec Byte-order codec (e.g. @ref LittleEndianCodec,
-///               @ref BigEndianCodec).
-template <typename Codec>
-class ByteWriterT {
- public:
-  /// @brief Construct a writer over an existing buffer.
-  /// @param data Pointer to the beginning of the buffer.
-  /// @param size Size of the buffer in bytes.
-  ByteWriterT(void* data, size_t size)
-      : p_(static_cast<uint8_t*>(data)), n_(size), size_(size) {}
-
-  /// @brief Return the number of bytes of remaining capacity.
-  /// @return Remaining byte count.
-  size_t remaining() const { return n_; }
+  /// @brief Read an array of unsigned 8-bit integers.
+  /// @param[out] out Destination array; must hold at least @p count elements.
+  /// @param count Number of elements to read.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
+  ///         than @p count bytes remain.
+  BIO_CONSTEXPR20 Status read_u8_array(uint8_t* out, size_t count) {
+    return read_bytes(out, count);
+  }
 
-  /// @brief Return the current write position (bytes written so far).
-  /// @return Current byte offset from the start of the buffer.
-  size_t position() const { return size_ - n_; }
+  /// @brief Read an array of signed 8-bit integers.
+  /// @param[out] out Destination array; must hold at least @p count elements.
+  /// @param count Number of elements to read.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
+  ///         than @p count bytes remain.
+  BIO_CONSTEXPR20 Status read_i8_array(int8_t* out, size_t count) {
+    return read_bytes(out, count);
+  }
 
-  /// @brief Write an unsigned 8-bit integer.
-  /// @param v The value to write.
+  /// @brief Read an array of unsigned 16-bit integers.
+  ///
+  /// Performs a single bounds check for the whole array, then copies (or
+  /// byte-swaps) all elements at once.
+  ///
+  /// @param[out] out Destination array; must hold at least @p count elements.
+  /// @param count Number of elements to read.
   /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
-  ///         than 1 byte of capacity remains.
-  Status write_u8(uint8_t v) {
-    if (1 > n_) return Status::OutOfRange();
-    *p_++ = v;
-    --n_;
-    return Status::Ok();
+  ///         than @p count * 2 bytes remain.
+  BIO_CONSTEXPR20 Status read_u16_array(uint16_t* out, size_t count) {
+    return read_array(out, count);
   }
 
-  /// @brief Write an unsigned 16-bit integer.
-  /// @param v The value to write.
+  /// @brief Read an array of unsigned 32-bit integers.
+  ///
+  /// Performs a single bounds check for the whole array, then copies (or
+  /// byte-swaps) all elements at once.
+  ///
+  /// @param[out] out Destination array; must hold at least @p count elements.
+  /// @param count Number of elements to read.
   /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
-  ///         than 2 bytes of capacity remain.
-  Status write_u16(uint16_t v) {
-    if (sizeof(uint16_t) > n_) return Status::OutOfRange();
-    Codec::StoreU16(p_, v);
-    p_ += sizeof(uint16_t);
-    n_ -= sizeof(uint16_t);
-    return Status::Ok();
+  ///         than @p count * 4 bytes remain.
+  BIO_CONSTEXPR20 Status read_u32_array(uint32_t* out, size_t count) {
+    return read_array(out, count);
   }
 
-  /// @brief Write an unsigned 32-bit integer.
-  /// @param v The value to write.
+  /// @brief Read an array of unsigned 64-bit integers.
+  ///
+  /// Performs a single bounds check for the whole array, then copies (or
+  /// byte-swaps) all elements at once.
+  ///
+  /// @param[out] out Destination array; must hold at least @p count elements.
+  /// @param count Number of elements to read.
   /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
-  ///         than 4 bytes of capacity remain.
-  Status write_u32(uint32_t v) {
-    if (sizeof(uint32_t) > n_) return Status::OutOfRange();
-    Codec::StoreU32(p_, v);
-    p_ += sizeof(uint32_t);
-    n_ -= sizeof(uint32_t);
-    return Status::Ok();
+  ///         than @p count * 8 bytes remain.
+  BIO_CONSTEXPR20 Status read_u64_array(uint64_t* out, size_t count) {
+    return read_array(out, count);
   }
 
-  /// @brief Write an unsigned 64-bit integer.
-  /// @param v The value to write.
+  /// @brief Read an array of signed 16-bit integers.
+  ///
+  /// Performs a single bounds check for the whole array, then copies (or
+  /// byte-swaps) all elements at once.
+  ///
+  /// @param[out] out Destination array; must hold at least @p count elements.
+  /// @param count Number of elements to read.
   /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
-  ///         than 8 bytes of capacity remain.
-  Status write_u64(uint64_t v) {
-    if (sizeof(uint64_t) > n_) return Status::OutOfRange();
-    Codec::StoreU64(p_, v);
-    p_ += sizeof(uint64_t);
-    n_ -= sizeof(uint64_t);
-    return Status::Ok();
+  ///         than @p count * 2 bytes remain.
+  BIO_CONSTEXPR20 Status read_i16_array(int16_t* out, size_t count) {
+    return read_array(out, count);
   }
 
-  /// @brief Write a signed 8-bit integer.
-  /// @param v The value to write.
+  /// @brief Read an array of signed 32-bit integers.
+  ///
+  /// Performs a single bounds check for the whole array, then copies (or
+  /// byte-swaps) all elements at once.
+  ///
+  /// @param[out] out Destination array; must hold at least @p count elements.
+  /// @param count Number of elements to read.
   /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
-  ///         than 1 byte of capacity remains.
-  Status write_i8(int8_t v) {
-    uint8_t bits = 0;
-    std::memcpy(&bits, &v, sizeof(bits));
-    return write_u8(bits);
+  ///         than @p count * 4 bytes remain.
+  BIO_CONSTEXPR20 Status read_i32_array(int32_t* out, size_t count) {
+    return read_array(out, count);
   }
 
-  /// @brief Write a signed 16-bit integer.
-  /// @param v The value to write.
+  /// @brief Read an array of signed 64-bit integers.
+  ///
+  /// Performs a single bounds check for the whole array, then copies (or
+  /// byte-swaps) all elements at once.
+  ///
+  /// @param[out] out Destination array; must hold at least @p count elements.
+  /// @param count Number of elements to read.
   /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
-  ///         than 2 bytes of capacity remain.
-  Status write_i16(int16_t v) {
-    uint16_t bits = 0;
-    std::memcpy(&bits, &v, sizeof(bits));
-    return write_u16(bits);
+  ///         than @p count * 8 bytes remain.
+  BIO_CONSTEXPR20 Status read_i64_array(int64_t* out, size_t count) {
+    return read_array(out, count);
   }
 
-  /// @brief Write a signed 32-bit integer.
-  /// @param v The value to write.
+  /// @brief Read an array of 32-bit IEEE 754 floating-point values.
+  ///
+  /// Performs a single bounds check for the whole array, then copies (or
+  /// byte-swaps) all elements at once.
+  ///
+  /// @param[out] out Destination array; must hold at least @p count elements.
+  /// @param count Number of elements to read.
   /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
-  ///         than 4 bytes of capacity remain.
-  Status write_i32(int32_t v) {
-    uint32_t bits = 0;
-    std::memcpy(&bits, &v, sizeof(bits));
-    return write_u32(bits);
+  ///         than @p count * 4 bytes remain.
+  BIO_CONSTEXPR20 Status read_f32_array(float* out, size_t count) {
+    return read_array(out, count);
   }
 
-  /// @brief Write a signed 64-bit integer.
-  /// @param v The value to write.
+  /// @brief Read an array of 64-bit IEEE 754 floating-point values.
+  ///
+  /// Performs a single bounds check for the whole array, then copies (or
+  /// byte-swaps) all elements at once.
+  ///
+  /// @param[out] out Destination array; must hold at least @p count elements.
+  /// @param count Number of elements to read.
   /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
-  ///         than 8 bytes of capacity remain.
-  Status write_i64(int64_t v) {
-    uint64_t bits = 0;
-    std::memcpy(&bits, &v, sizeof(bits));
-    return write_u64(bits);
+  ///         than @p count * 8 bytes remain.
+  BIO_CONSTEXPR20 Status read_f64_array(double* out, size_t count) {
+    return read_array(out, count);
   }
 
-  /// @brief Write a 32-bit IEEE 754 floating-point value.
-  /// @param v The value to write.
+  /// @brief Read a sequence of raw bytes into a caller-provided buffer.
+  /// @param[out] out Destination buffer; must be at least @p len bytes.
+  /// @param len Number of bytes to read.
   /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
-  ///         than 4 bytes of capacity remain.
-  Status write_f32(float v) {
-    static_assert(sizeof(float) == 4, "float must be 32-bit");
-    uint32_t bits = 0;
-    std::memcpy(&bits, &v, sizeof(bits));
-    return write_u32(bits);
+  ///         than @p len bytes remain.
+  Status read_bytes(void* out, size_t len) {
+    return read_bytes(static_cast<uint8_t*>(out), len);
   }
 
-  /// @brief Write a 64-bit IEEE 754 floating-point value.
-  /// @param v The value to write.
+  /// @brief Overload of @ref read_bytes() for byte-sized element types,
+  ///        usable in constant expressions.
+  template <typename Byte, typename = std::enable_if_t<detail::kIsByte<Byte>>>
+  BIO_CONSTEXPR20 Status read_bytes(Byte* out, size_t len) {
+    if (len > n_) return Status::OutOfRange(position());
+    detail::CopyBytes(out, p_, len);
+    p_ += len;
+    n_ -= len;
+    return Status::Ok();
+  }
+
+  /// @brief Borrow the next @p len bytes without copying them.
+  ///
+  /// On success @p out points straight into the reader's buffer and the
+  /// cursor advances past the borrowed range. The view is valid only as long
+  /// as that buffer is.
+  ///
+  /// @param[out] out Receives a view of the next @p len bytes on success.
+  /// @param len Number of bytes to borrow.
   /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
-  ///         than 8 bytes of capacity remain.
-  Status write_f64(double v) {
-    static_assert(sizeof(double) == 8, "double must be 64-bit");
-    uint64_t bits = 0;
-    std::memcpy(&bits, &v, sizeof(bits));
-    return write_u64(bits);
+  ///         than @p len bytes remain.
+  Status read_view(ByteView& out, size_t len) {
+    if (len > n_) return Status::OutOfRange(position());
+    out = ByteView(p_, len);
+    p_ += len;
+    n_ -= len;
+    return Status::Ok();
   }
 
-  /// @brief Write a sequence of raw bytes from a caller-provided buffer.
-  /// @param in Source buffer; must contain at least @p len bytes.
-  /// @param len Number of bytes to write.
+  /// @brief Borrow the next @p len bytes as characters without copying them.
+  ///
+  /// Like @ref read_view(), but yields a @c std::string_view. No terminator
+  /// or encoding is checked; embedded NUL bytes are part of the view.
+  ///
+  /// @param[out] out Receives a view of the next @p len bytes on success.
+  /// @param len Number of bytes to borrow.
   /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
-  ///         than @p len bytes of capacity remain.
-  Status write_bytes(const void* in, size_t len) {
-    if (len > n_) return Status::OutOfRange();
-    std::memcpy(p_, in, len);
+  ///         than @p len bytes remain.
+  Status read_string_view(std::string_view& out, size_t len) {
+    if (len > n_) return Status::OutOfRange(position());
+    out = std::string_view(reinterpret_cast<const char*>(p_), len);
     p_ += len;
     n_ -= len;
     return Status::Ok();
   }
 
-  /// @brief Advance the write cursor without writing any data.
+  /// @brief Advance the read cursor without reading any data.
   /// @param len Number of bytes to skip.
   /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
-  ///         than @p len bytes of capacity remain.
-  Status skip(size_t len) {
-    if (len > n_) return Status::OutOfRange();
+  ///         than @p len bytes remain.
+  BIO_CONSTEXPR20 Status skip(size_t len) {
+    if (len > n_) return Status::OutOfRange(position());
+    p_ += len;
+    n_ -= len;
+    return Status::Ok();
+  }
+
+  /// @name Lookahead and repositioning
+  ///
+  /// Peek at a value before deciding how to parse it, or save the cursor with
+  /// @ref checkpoint() and return to it with @ref rewind() after a
+  /// speculative parse, without copying the reader.
+  /// @{
+
+  /// @brief Like @ref read_u8(), at @p offset bytes past the cursor and
+  ///        without consuming anything.
+  BIO_CONSTEXPR20 Status peek_u8(uint8_t& out, size_t offset = 0) const {
+    if (1 > n_ || offset > n_ - 1) return Status::OutOfRange(position());
+    out = load_u8_at(offset);
+    return Status::Ok();
+  }
+
+  /// @brief Like @ref read_u16(), at @p offset bytes past the cursor and
+  ///        without consuming anything.
+  BIO_CONSTEXPR20 Status peek_u16(uint16_t& out, size_t offset = 0) const {
+    if (2 > n_ || offset > n_ - 2) return Status::OutOfRange(position());
+    out = load_u16_at(offset);
+    return Status::Ok();
+  }
+
+  /// @brief Like @ref read_u32(), at @p offset bytes past the cursor and
+  ///        without consuming anything.
+  BIO_CONSTEXPR20 Status peek_u32(uint32_t& out, size_t offset = 0) const {
+    if (4 > n_ || offset > n_ - 4) return Status::OutOfRange(position());
+    out = load_u32_at(offset);
+    return Status::Ok();
+  }
+
+  /// @brief Like @ref read_u64(), at @p offset bytes past the cursor and
+  ///        without consuming anything.
+  BIO_CONSTEXPR20 Status peek_u64(uint64_t& out, size_t offset = 0) const {
+    if (8 > n_ || offset > n_ - 8) return Status::OutOfRange(position());
+    out = load_u64_at(offset);
+    return Status::Ok();
+  }
+
+  /// @brief Like @ref read_i8(), at @p offset bytes past the cursor and
+  ///        without consuming anything.
+  BIO_CONSTEXPR20 Status peek_i8(int8_t& out, size_t offset = 0) const {
+    if (1 > n_ || offset > n_ - 1) return Status::OutOfRange(position());
+    out = load_i8_at(offset);
+    return Status::Ok();
+  }
+
+  /// @brief Like @ref read_i16(), at @p offset bytes past the cursor and
+  ///        without consuming anything.
+  BIO_CONSTEXPR20 Status peek_i16(int16_t& out, size_t offset = 0) const {
+    if (2 > n_ || offset > n_ - 2) return Status::OutOfRange(position());
+    out = load_i16_at(offset);
+    return Status::Ok();
+  }
+
+  /// @brief Like @ref read_i32(), at @p offset bytes past the cursor and
+  ///        without consuming anything.
+  BIO_CONSTEXPR20 Status peek_i32(int32_t& out, size_t offset = 0) const {
+    if (4 > n_ || offset > n_ - 4) return Status::OutOfRange(position());
+    out = load_i32_at(offset);
+    return Status::Ok();
+  }
+
+  /// @brief Like @ref read_i64(), at @p offset bytes past the cursor and
+  ///        without consuming anything.
+  BIO_CONSTEXPR20 Status peek_i64(int64_t& out, size_t offset = 0) const {
+    if (8 > n_ || offset > n_ - 8) return Status::OutOfRange(position());
+    out = load_i64_at(offset);
+    return Status::Ok();
+  }
+
+  /// @brief Saved cursor of a @ref ByteReaderT; see @ref checkpoint().
+  class Checkpoint {
+   private:
+    friend class ByteReaderT;
+    BIO_CONSTEXPR20 Checkpoint(const uint8_t* p, size_t n) : p_(p), n_(n) {}
+    const uint8_t* p_;
+    size_t n_;
+  };
+
+  /// @brief Save the cursor so that @ref rewind() can return to it.
+  BIO_CONSTEXPR20 Checkpoint checkpoint() const { return Checkpoint(p_, n_); }
+
+  /// @brief Move the cursor back (or forward) to @p saved.
+  /// @pre @p saved was taken from this reader.
+  BIO_CONSTEXPR20 void rewind(Checkpoint saved) {
+    p_ = saved.p_;
+    n_ = saved.n_;
+  }
+
+  /// @brief Move the cursor to @p pos bytes from the start of the buffer.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() with the
+  ///         cursor unchanged if @p pos is past the end.
+  BIO_CONSTEXPR20 Status seek(size_t pos) {
+    if (pos > size_) return Status::OutOfRange(position());
+    p_ = p_ - position() + pos;
+    n_ = size_ - pos;
+    return Status::Ok();
+  }
+
+  /// @}
+
+  /// @name Unchecked access at constant offsets
+  ///
+  /// These methods decode relative to the cursor without bounds checks or
+  /// cursor updates, so a fixed-size record can be decoded with a single
+  /// check: call @ref ensure() once for the record size, load every field at
+  /// its offset, then @ref advance() past the record.
+  /// @{
+
+  /// @brief Check that at least @p len bytes remain.
+  /// @param len Number of bytes required.
+  /// @return @ref Status::Ok() if @p len bytes remain,
+  ///         @ref Status::OutOfRange() otherwise.
+  BIO_CONSTEXPR20 Status ensure(size_t len) const {
+    if (len > n_) return Status::OutOfRange(position());
+    return Status::Ok();
+  }
+
+  /// @brief Advance the read cursor without a bounds check.
+  /// @param len Number of bytes to consume.
+  /// @pre @p len <= remaining().
+  BIO_CONSTEXPR20 void advance(size_t len) {
     p_ += len;
     n_ -= len;
+  }
+
+  /// @brief Decode an unsigned 8-bit integer @p offset bytes past the cursor.
+  /// @pre @p offset + 1 <= remaining().
+  BIO_CONSTEXPR20 uint8_t load_u8_at(size_t offset) const {
+    return p_[offset];
+  }
+
+  /// @brief Decode an unsigned 16-bit integer @p offset bytes past the cursor.
+  /// @pre @p offset + 2 <= remaining().
+  BIO_CONSTEXPR20 uint16_t load_u16_at(size_t offset) const {
+    return Codec::LoadU16(p_ + offset);
+  }
+
+  /// @brief Decode an unsigned 32-bit integer @p offset bytes past the cursor.
+  /// @pre @p offset + 4 <= remaining().
+  BIO_CONSTEXPR20 uint32_t load_u32_at(size_t offset) const {
+    return Codec::LoadU32(p_ + offset);
+  }
+
+  /// @brief Decode an unsigned 64-bit integer @p offset bytes past the cursor.
+  /// @pre @p offset + 8 <= remaining().
+  BIO_CONSTEXPR20 uint64_t load_u64_at(size_t offset) const {
+    return Codec::LoadU64(p_ + offset);
+  }
+
+  /// @brief Decode a signed 8-bit integer @p offset bytes past the cursor.
+  /// @pre @p offset + 1 <= remaining().
+  BIO_CONSTEXPR20 int8_t load_i8_at(size_t offset) const {
+    const uint8_t bits = p_[offset];
+    return detail::BitCast<int8_t>(bits);
+  }
+
+  /// @brief Decode a signed 16-bit integer @p offset bytes past the cursor.
+  /// @pre @p offset + 2 <= remaining().
+  BIO_CONSTEXPR20 int16_t load_i16_at(size_t offset) const {
+    const uint16_t bits = Codec::LoadU16(p_ + offset);
+    return detail::BitCast<int16_t>(bits);
+  }
+
+  /// @brief Decode a signed 32-bit integer @p offset bytes past the cursor.
+  /// @pre @p offset + 4 <= remaining().
+  BIO_CONSTEXPR20 int32_t load_i32_at(size_t offset) const {
+    const uint32_t bits = Codec::LoadU32(p_ + offset);
+    return detail::BitCast<int32_t>(bits);
+  }
+
+  /// @brief Decode a signed 64-bit integer @p offset bytes past the cursor.
+  /// @pre @p offset + 8 <= remaining().
+  BIO_CONSTEXPR20 int64_t load_i64_at(size_t offset) const {
+    const uint64_t bits = Codec::LoadU64(p_ + offset);
+    return detail::BitCast<int64_t>(bits);
+  }
+
+  /// @brief Decode a 32-bit IEEE 754 floating-point value @p offset bytes
+  ///        past the cursor.
+  /// @pre @p offset + 4 <= remaining().
+  BIO_CONSTEXPR20 float load_f32_at(size_t offset) const {
+    const uint32_t bits = Codec::LoadU32(p_ + offset);
+    return detail::BitCast<float>(bits);
+  }
+
+  /// @brief Decode a 64-bit IEEE 754 floating-point value @p offset bytes
+  ///        past the cursor.
+  /// @pre @p offset + 8 <= remaining().
+  BIO_CONSTEXPR20 double load_f64_at(size_t offset) const {
+    const uint64_t bits = Codec::LoadU64(p_ + offset);
+    return detail::BitCast<double>(bits);
+  }
+
+  /// @brief Copy @p len raw bytes starting @p offset bytes past the cursor.
+  /// @pre @p offset + @p len <= remaining().
+  void load_bytes_at(size_t offset, void* out, size_t len) const {
+    std::memcpy(out, p_ + offset, len);
+  }
+
+  /// @brief Overload of @ref load_bytes_at() for byte-sized element types,
+  ///        usable in constant expressions.
+  template <typename Byte, typename = std::enable_if_t<detail::kIsByte<Byte>>>
+  BIO_CONSTEXPR20 void load_bytes_at(size_t offset, Byte* out,
+                                     size_t len) const {
+    detail::CopyBytes(out, p_ + offset, len);
+  }
+
+  /// @brief Bulk-decode @p count elements starting @p offset bytes past the
+  ///        cursor.
+  /// @pre @p offset + @p count * 2 <= remaining().
+  BIO_CONSTEXPR20 void load_u16_array_at(size_t offset, uint16_t* out,
+                                         size_t count) const {
+    detail::LoadValues<Codec>(out, p_ + offset, count);
+  }
+
+  /// @brief Bulk-decode @p count elements starting @p offset bytes past the
+  ///        cursor.
+  /// @pre @p offset + @p count * 4 <= remaining().
+  BIO_CONSTEXPR20 void load_u32_array_at(size_t offset, uint32_t* out,
+                                         size_t count) const {
+    detail::LoadValues<Codec>(out, p_ + offset, count);
+  }
+
+  /// @brief Bulk-decode @p count elements starting @p offset bytes past the
+  ///        cursor.
+  /// @pre @p offset + @p count * 8 <= remaining().
+  BIO_CONSTEXPR20 void load_u64_array_at(size_t offset, uint64_t* out,
+                                         size_t count) const {
+    detail::LoadValues<Codec>(out, p_ + offset, count);
+  }
+
+  /// @brief Bulk-decode @p count elements starting @p offset bytes past the
+  ///        cursor.
+  /// @pre @p offset + @p count * 2 <= remaining().
+  BIO_CONSTEXPR20 void load_i16_array_at(size_t offset, int16_t* out,
+                                         size_t count) const {
+    detail::LoadValues<Codec>(out, p_ + offset, count);
+  }
+
+  /// @brief Bulk-decode @p count elements starting @p offset bytes past the
+  ///        cursor.
+  /// @pre @p offset + @p count * 4 <= remaining().
+  BIO_CONSTEXPR20 void load_i32_array_at(size_t offset, int32_t* out,
+                                         size_t count) const {
+    detail::LoadValues<Codec>(out, p_ + offset, count);
+  }
+
+  /// @brief Bulk-decode @p count elements starting @p offset bytes past the
+  ///        cursor.
+  /// @pre @p offset + @p count * 8 <= remaining().
+  BIO_CONSTEXPR20 void load_i64_array_at(size_t offset, int64_t* out,
+                                         size_t count) const {
+    detail::LoadValues<Codec>(out, p_ + offset, count);
+  }
+
+  /// @brief Bulk-decode @p count elements starting @p offset bytes past the
+  ///        cursor.
+  /// @pre @p offset + @p count * 4 <= remaining().
+  BIO_CONSTEXPR20 void load_f32_array_at(size_t offset, float* out,
+                                         size_t count) const {
+    detail::LoadValues<Codec>(out, p_ + offset, count);
+  }
+
+  /// @brief Bulk-decode @p count elements starting @p offset bytes past the
+  ///        cursor.
+  /// @pre @p offset + @p count * 8 <= remaining().
+  BIO_CONSTEXPR20 void load_f64_array_at(size_t offset, double* out,
+                                         size_t count) const {
+    detail::LoadValues<Codec>(out, p_ + offset, count);
+  }
+
+  /// @}
+
+  /// @name Searching
+  ///
+  /// These methods look ahead of the cursor for a byte pattern, such as a
+  /// frame's magic number, to find where decoding can resume after corrupt
+  /// input. They use @ref detail::FindBytes(), which scans with SIMD where
+  /// available. Offsets are relative to the cursor, like the loads above.
+  /// @{
+
+  /// @brief Returned by the find methods when there is no match.
+  static constexpr size_t npos = SIZE_MAX;
+
+  /// @brief Return the offset of the first copy of the @p len bytes at
+  ///        @p pattern that starts at least @p from bytes past the cursor,
+  ///        or @ref npos if none fits in the remaining bytes.
+  /// @pre @p len > 0.
+  size_t find_bytes(const void* pattern, size_t len, size_t from = 0) const {
+    if (from > n_) return npos;
+    const size_t hit = detail::FindBytes(
+        p_ + from, n_ - from, static_cast<const uint8_t*>(pattern), len);
+    return hit == n_ - from ? npos : from + hit;
+  }
+
+  /// @brief Like @ref find_bytes(), for the byte @p value.
+  size_t find_u8(uint8_t value, size_t from = 0) const {
+    return find_bytes(&value, 1, from);
+  }
+
+  /// @brief Like @ref find_bytes(), for @p value encoded in @p Codec order.
+  size_t find_u16(uint16_t value, size_t from = 0) const {
+    uint8_t pattern[2];
+    Codec::StoreU16(pattern, value);
+    return find_bytes(pattern, sizeof(pattern), from);
+  }
+
+  /// @brief Like @ref find_bytes(), for @p value encoded in @p Codec order.
+  size_t find_u32(uint32_t value, size_t from = 0) const {
+    uint8_t pattern[4];
+    Codec::StoreU32(pattern, value);
+    return find_bytes(pattern, sizeof(pattern), from);
+  }
+
+  /// @brief Like @ref find_bytes(), for @p value encoded in @p Codec order.
+  size_t find_u64(uint64_t value, size_t from = 0) const {
+    uint8_t pattern[8];
+    Codec::StoreU64(pattern, value);
+    return find_bytes(pattern, sizeof(pattern), from);
+  }
+
+  /// @brief Move the cursor to the next copy of the @p len bytes at
+  ///        @p pattern, skipping at least one byte so that calling it after a
+  ///        failed decode at the cursor always makes progress.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() with the
+  ///         cursor unchanged if no copy remains.
+  Status resync(const void* pattern, size_t len) {
+    const size_t hit = find_bytes(pattern, len, 1);
+    if (hit == npos) return Status::OutOfRange(position());
+    advance(hit);
     return Status::Ok();
   }
 
+  /// @brief Like @ref resync(), for the magic number @p magic encoded in
+  ///        @p Codec order.
+  Status resync_u32(uint32_t magic) {
+    uint8_t pattern[4];
+    Codec::StoreU32(pattern, magic);
+    return resync(pattern, sizeof(pattern));
+  }
+
+  /// @}
+
  private:
-  uint8_t* p_;   ///< Current write position.
-  size_t n_;     ///< Remaining capacity.
-  size_t size_;  ///< Total buffer size.
+  /// @brief Bulk-load @p count values into @p out.
+  template <typename T>
+  BIO_CONSTEXPR20 Status read_array(T* out, size_t count) {
+    constexpr size_t kWidth = sizeof(T);
+    if (count > n_ / kWidth) return Status::OutOfRange(position());
+    detail::LoadValues<Codec>(out, p_, count);
+    p_ += count * kWidth;
+    n_ -= count * kWidth;
+    return Status::Ok();
+  }
+
+  const uint8_t* p_;  ///< Current read position.
+  size_t n_;          ///< Remaining bytes.
+  size_t size_;       ///< Total buffer size.
+};
+
+/// @brief One contiguous piece of a non-contiguous input.
+struct ByteSegment {
+  const void* data;  ///< First byte of the segment.
+  size_t size;       ///< Number of bytes in the segment.
+};
+
+/// @brief Byte reader over a list of non-contiguous segments.
+///
+/// Offers the @ref ByteReaderT read surface over input that is split across
+/// several buffers, such as the two halves of a wrapped ring buffer or a
+/// chain of DMA descriptors. A read that fits inside the current segment
+/// takes the same single-check fast path as @ref ByteReaderT; only values
+/// that straddle a segment boundary are stitched together through a small
+/// stack buffer. Empty segments are allowed.
+///
+/// The segment list and the bytes it points to must outlive the reader. The
+/// reader itself is a small value type and may be copied freely.
+///
+/// @tparam Codec Byte-order codec (e.g. @ref LittleEndianCodec,
+///               @ref BigEndianCodec).
+template <typename Codec>
+class ChunkedReaderT {
+ public:
+  using codec_type = Codec;  ///< Byte-order codec of this reader.
+
+  /// @brief Construct a reader over @p count segments, read in order.
+  /// @param segments Array of @p count segments.
+  /// @param count Number of segments.
+  ChunkedReaderT(const ByteSegment* segments, size_t count)
+      : segments_(segments), count_(count) {
+    for (size_t i = 0; i < count; ++i) size_ += segments[i].size;
+    if (count != 0) {
+      p_ = static_cast<const uint8_t*>(segments[0].data);
+      n_ = segments[0].size;
+    }
+    rest_ = size_ - n_;
+  }
+
+  /// @brief Return the number of bytes remaining across all segments.
+  size_t remaining() const { return n_ + rest_; }
+
+  /// @brief Return the number of bytes consumed so far.
+  size_t position() const { return size_ - remaining(); }
+
+  /// @brief Read an unsigned 8-bit integer; see @ref ByteReaderT::read_u8().
+  Status read_u8(uint8_t& out) {
+    uint8_t tmp[1];
+    const uint8_t* p = take<1>(tmp);
+    if (p == nullptr) return Status::OutOfRange(position());
+    out = *p;
+    return Status::Ok();
+  }
+
+  /// @brief Read an unsigned 16-bit integer; see @ref ByteReaderT::read_u16().
+  Status read_u16(uint16_t& out) {
+    uint8_t tmp[2];
+    const uint8_t* p = take<2>(tmp);
+    if (p == nullptr) return Status::OutOfRange(position());
+    out = Codec::LoadU16(p);
+    return Status::Ok();
+  }
+
+  /// @brief Read an unsigned 32-bit integer; see @ref ByteReaderT::read_u32().
+  Status read_u32(uint32_t& out) {
+    uint8_t tmp[4];
+    const uint8_t* p = take<4>(tmp);
+    if (p == nullptr) return Status::OutOfRange(position());
+    out = Codec::LoadU32(p);
+    return Status::Ok();
+  }
+
+  /// @brief Read an unsigned 64-bit integer; see @ref ByteReaderT::read_u64().
+  Status read_u64(uint64_t& out) {
+    uint8_t tmp[8];
+    const uint8_t* p = take<8>(tmp);
+    if (p == nullptr) return Status::OutOfRange(position());
+    out = Codec::LoadU64(p);
+    return Status::Ok();
+  }
+
+  /// @brief Read a signed 8-bit integer; see @ref ByteReaderT::read_i8().
+  Status read_i8(int8_t& out) {
+    uint8_t bits = 0;
+    if (!read_u8(bits)) return Status::OutOfRange(position());
+    std::memcpy(&out, &bits, sizeof(bits));
+    return Status::Ok();
+  }
+
+  /// @brief Read a signed 16-bit integer; see @ref ByteReaderT::read_i16().
+  Status read_i16(int16_t& out) {
+    uint16_t bits = 0;
+    if (!read_u16(bits)) return Status::OutOfRange(position());
+    std::memcpy(&out, &bits, sizeof(bits));
+    return Status::Ok();
+  }
+
+  /// @brief Read a signed 32-bit integer; see @ref ByteReaderT::read_i32().
+  Status read_i32(int32_t& out) {
+    uint32_t bits = 0;
+    if (!read_u32(bits)) return Status::OutOfRange(position());
+    std::memcpy(&out, &bits, sizeof(bits));
+    return Status::Ok();
+  }
+
+  /// @brief Read a signed 64-bit integer; see @ref ByteReaderT::read_i64().
+  Status read_i64(int64_t& out) {
+    uint64_t bits = 0;
+    if (!read_u64(bits)) return Status::OutOfRange(position());
+    std::memcpy(&out, &bits, sizeof(bits));
+    return Status::Ok();
+  }
+
+  /// @brief Read a 32-bit IEEE 754 value; see @ref ByteReaderT::read_f32().
+  Status read_f32(float& out) {
+    uint32_t bits = 0;
+    if (!read_u32(bits)) return Status::OutOfRange(position());
+    std::memcpy(&out, &bits, sizeof(bits));
+    return Status::Ok();
+  }
+
+  /// @brief Read a 64-bit IEEE 754 value; see @ref ByteReaderT::read_f64().
+  Status read_f64(double& out) {
+    uint64_t bits = 0;
+    if (!read_u64(bits)) return Status::OutOfRange(position());
+    std::memcpy(&out, &bits, sizeof(bits));
+    return Status::Ok();
+  }
+
+  /// @brief Read an unsigned LEB128 integer; see
+  ///        @ref ByteReaderT::read_varuint().
+  Status read_varuint(uint64_t& out) {
+    size_t len = detail::DecodeVarint(p_, n_, out);
+    if (len == 0 && n_ < detail::kMaxVarintBytes && rest_ != 0) {
+      // The encoding may continue into the next segment.
+      uint8_t tmp[detail::kMaxVarintBytes];
+      const size_t avail =
+          remaining() < sizeof(tmp) ? remaining() : sizeof(tmp);
+      ChunkedReaderT at = *this;
+      at.gather(tmp, avail);
+      len = detail::DecodeVarint(tmp, avail, out);
+    }
+    if (len == 0) return Status::OutOfRange(position());
+    advance(len);
+    return Status::Ok();
+  }
+
+  /// @brief Read a zigzag-encoded signed LEB128 integer; see
+  ///        @ref ByteReaderT::read_varint().
+  Status read_varint(int64_t& out) {
+    uint64_t bits = 0;
+    if (!read_varuint(bits)) return Status::OutOfRange(position());
+    out = detail::ZigZagDecode(bits);
+    return Status::Ok();
+  }
+
+  /// @brief Read an array of unsigned 8-bit integers.
+  Status read_u8_array(uint8_t* out, size_t count) {
+    return read_bytes(out, count);
+  }
+
+  /// @brief Read an array of unsigned 16-bit integers.
+  Status read_u16_array(uint16_t* out, size_t count) {
+    return read_array<2>(out, count);
+  }
+
+  /// @brief Read an array of unsigned 32-bit integers.
+  Status read_u32_array(uint32_t* out, size_t count) {
+    return read_array<4>(out, count);
+  }
+
+  /// @brief Read an array of unsigned 64-bit integers.
+  Status read_u64_array(uint64_t* out, size_t count) {
+    return read_array<8>(out, count);
+  }
+
+  /// @brief Read an array of signed 8-bit integers.
+  Status read_i8_array(int8_t* out, size_t count) {
+    return read_bytes(out, count);
+  }
+
+  /// @brief Read an array of signed 16-bit integers.
+  Status read_i16_array(int16_t* out, size_t count) {
+    return read_array<2>(out, count);
+  }
+
+  /// @brief Read an array of signed 32-bit integers.
+  Status read_i32_array(int32_t* out, size_t count) {
+    return read_array<4>(out, count);
+  }
+
+  /// @brief Read an array of signed 64-bit integers.
+  Status read_i64_array(int64_t* out, size_t count) {
+    return read_array<8>(out, count);
+  }
+
+  /// @brief Read an array of 32-bit IEEE 754 values.
+  Status read_f32_array(float* out, size_t count) {
+    return read_array<4>(out, count);
+  }
+
+  /// @brief Read an array of 64-bit IEEE 754 values.
+  Status read_f64_array(double* out, size_t count) {
+    return read_array<8>(out, count);
+  }
+
+  /// @brief Read @p len raw bytes, gathering across segments as needed.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
+  ///         than @p len bytes remain; nothing is consumed on failure.
+  Status read_bytes(void* out, size_t len) {
+    if (len > remaining()) return Status::OutOfRange(position());
+    gather(static_cast<uint8_t*>(out), len);
+    return Status::Ok();
+  }
+
+  /// @brief Advance the cursor by @p len bytes, crossing segments as needed.
+  Status skip(size_t len) {
+    if (len > remaining()) return Status::OutOfRange(position());
+    advance(len);
+    return Status::Ok();
+  }
+
+  /// @name Lookahead and repositioning
+  ///
+  /// Same contract as the @ref ByteReaderT methods of the same name.
+  /// @{
+
+  /// @brief Like @ref read_u8(), at @p offset bytes past the cursor and
+  ///        without consuming anything.
+  Status peek_u8(uint8_t& out, size_t offset = 0) const {
+    if (1 > remaining() || offset > remaining() - 1)
+      return Status::OutOfRange(position());
+    out = load_u8_at(offset);
+    return Status::Ok();
+  }
+
+  /// @brief Like @ref read_u16(), at @p offset bytes past the cursor and
+  ///        without consuming anything.
+  Status peek_u16(uint16_t& out, size_t offset = 0) const {
+    if (2 > remaining() || offset > remaining() - 2)
+      return Status::OutOfRange(position());
+    out = load_u16_at(offset);
+    return Status::Ok();
+  }
+
+  /// @brief Like @ref read_u32(), at @p offset bytes past the cursor and
+  ///        without consuming anything.
+  Status peek_u32(uint32_t& out, size_t offset = 0) const {
+    if (4 > remaining() || offset > remaining() - 4)
+      return Status::OutOfRange(position());
+    out = load_u32_at(offset);
+    return Status::Ok();
+  }
+
+  /// @brief Like @ref read_u64(), at @p offset bytes past the cursor and
+  ///        without consuming anything.
+  Status peek_u64(uint64_t& out, size_t offset = 0) const {
+    if (8 > remaining() || offset > remaining() - 8)
+      return Status::OutOfRange(position());
+    out = load_u64_at(offset);
+    return Status::Ok();
+  }
+
+  /// @brief Like @ref read_i8(), at @p offset bytes past the cursor and
+  ///        without consuming anything.
+  Status peek_i8(int8_t& out, size_t offset = 0) const {
+    if (1 > remaining() || offset > remaining() - 1)
+      return Status::OutOfRange(position());
+    out = load_i8_at(offset);
+    return Status::Ok();
+  }
+
+  /// @brief Like @ref read_i16(), at @p offset bytes past the cursor and
+  ///        without consuming anything.
+  Status peek_i16(int16_t& out, size_t offset = 0) const {
+    if (2 > remaining() || offset > remaining() - 2)
+      return Status::OutOfRange(position());
+    out = load_i16_at(offset);
+    return Status::Ok();
+  }
+
+  /// @brief Like @ref read_i32(), at @p offset bytes past the cursor and
+  ///        without consuming anything.
+  Status peek_i32(int32_t& out, size_t offset = 0) const {
+    if (4 > remaining() || offset > remaining() - 4)
+      return Status::OutOfRange(position());
+    out = load_i32_at(offset);
+    return Status::Ok();
+  }
+
+  /// @brief Like @ref read_i64(), at @p offset bytes past the cursor and
+  ///        without consuming anything.
+  Status peek_i64(int64_t& out, size_t offset = 0) const {
+    if (8 > remaining() || offset > remaining() - 8)
+      return Status::OutOfRange(position());
+    out = load_i64_at(offset);
+    return Status::Ok();
+  }
+
+  /// @brief Saved cursor of a @ref ChunkedReaderT; see @ref checkpoint().
+  class Checkpoint {
+   private:
+    friend class ChunkedReaderT;
+    Checkpoint(size_t index, const uint8_t* p, size_t n, size_t rest)
+        : index_(index), p_(p), n_(n), rest_(rest) {}
+    size_t index_;
+    const uint8_t* p_;
+    size_t n_;
+    size_t rest_;
+  };
+
+  /// @brief Save the cursor so that @ref rewind() can return to it.
+  Checkpoint checkpoint() const { return Checkpoint(index_, p_, n_, rest_); }
+
+  /// @brief Move the cursor back (or forward) to @p saved.
+  /// @pre @p saved was taken from this reader.
+  void rewind(Checkpoint saved) {
+    index_ = saved.index_;
+    p_ = saved.p_;
+    n_ = saved.n_;
+    rest_ = saved.rest_;
+  }
+
+  /// @brief Move the cursor to @p pos bytes from the start of the input.
+  ///        Walks the segment list from the first segment.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() with the
+  ///         cursor unchanged if @p pos is past the end.
+  Status seek(size_t pos) {
+    if (pos > size_) return Status::OutOfRange(position());
+    index_ = 0;
+    p_ = count_ != 0 ? static_cast<const uint8_t*>(segments_[0].data)
+                     : nullptr;
+    n_ = count_ != 0 ? segments_[0].size : 0;
+    rest_ = size_ - n_;
+    advance(pos);
+    return Status::Ok();
+  }
+
+  /// @}
+
+  /// @name Unchecked access at constant offsets
+  ///
+  /// Same contract as the @ref ByteReaderT methods of the same name. Loads
+  /// that fit inside the current segment read it directly; others walk the
+  /// segment list.
+  /// @{
+
+  /// @brief Check that at least @p len bytes remain across all segments.
+  Status ensure(size_t len) const {
+    if (len > remaining()) return Status::OutOfRange(position());
+    return Status::Ok();
+  }
+
+  /// @brief Advance the cursor without a bounds check.
+  /// @pre @p len <= remaining().
+  void advance(size_t len) {
+    while (len > n_) {
+      len -= n_;
+      next_segment();
+    }
+    p_ += len;
+    n_ -= len;
+  }
+
+  /// @brief Decode an unsigned 8-bit integer @p offset bytes past the cursor.
+  uint8_t load_u8_at(size_t offset) const {
+    uint8_t tmp[1];
+    return *peek<1>(offset, tmp);
+  }
+
+  /// @brief Decode an unsigned 16-bit integer @p offset bytes past the cursor.
+  uint16_t load_u16_at(size_t offset) const {
+    uint8_t tmp[2];
+    return Codec::LoadU16(peek<2>(offset, tmp));
+  }
+
+  /// @brief Decode an unsigned 32-bit integer @p offset bytes past the cursor.
+  uint32_t load_u32_at(size_t offset) const {
+    uint8_t tmp[4];
+    return Codec::LoadU32(peek<4>(offset, tmp));
+  }
+
+  /// @brief Decode an unsigned 64-bit integer @p offset bytes past the cursor.
+  uint64_t load_u64_at(size_t offset) const {
+    uint8_t tmp[8];
+    return Codec::LoadU64(peek<8>(offset, tmp));
+  }
+
+  /// @brief Decode a signed 8-bit integer @p offset bytes past the cursor.
+  int8_t load_i8_at(size_t offset) const {
+    const uint8_t bits = load_u8_at(offset);
+    int8_t out;
+    std::memcpy(&out, &bits, sizeof(bits));
+    return out;
+  }
+
+  /// @brief Decode a signed 16-bit integer @p offset bytes past the cursor.
+  int16_t load_i16_at(size_t offset) const {
+    const uint16_t bits = load_u16_at(offset);
+    int16_t out;
+    std::memcpy(&out, &bits, sizeof(bits));
+    return out;
+  }
+
+  /// @brief Decode a signed 32-bit integer @p offset bytes past the cursor.
+  int32_t load_i32_at(size_t offset) const {
+    const uint32_t bits = load_u32_at(offset);
+    int32_t out;
+    std::memcpy(&out, &bits, sizeof(bits));
+    return out;
+  }
+
+  /// @brief Decode a signed 64-bit integer @p offset bytes past the cursor.
+  int64_t load_i64_at(size_t offset) const {
+    const uint64_t bits = load_u64_at(offset);
+    int64_t out;
+    std::memcpy(&out, &bits, sizeof(bits));
+    return out;
+  }
+
+  /// @brief Decode a 32-bit IEEE 754 value @p offset bytes past the cursor.
+  float load_f32_at(size_t offset) const {
+    const uint32_t bits = load_u32_at(offset);
+    float out;
+    std::memcpy(&out, &bits, sizeof(bits));
+    return out;
+  }
+
+  /// @brief Decode a 64-bit IEEE 754 value @p offset bytes past the cursor.
+  double load_f64_at(size_t offset) const {
+    const uint64_t bits = load_u64_at(offset);
+    double out;
+    std::memcpy(&out, &bits, sizeof(bits));
+    return out;
+  }
+
+  /// @brief Copy @p len raw bytes starting @p offset bytes past the cursor.
+  void load_bytes_at(size_t offset, void* out, size_t len) const {
+    if (offset + len <= n_) {
+      std::memcpy(out, p_ + offset, len);
+      return;
+    }
+    ChunkedReaderT at = *this;
+    at.advance(offset);
+    at.gather(static_cast<uint8_t*>(out), len);
+  }
+
+  /// @brief Decode @p count unsigned 16-bit integers at @p offset.
+  void load_u16_array_at(size_t offset, uint16_t* out, size_t count) const {
+    load_array_at<2>(offset, out, count);
+  }
+
+  /// @brief Decode @p count unsigned 32-bit integers at @p offset.
+  void load_u32_array_at(size_t offset, uint32_t* out, size_t count) const {
+    load_array_at<4>(offset, out, count);
+  }
+
+  /// @brief Decode @p count unsigned 64-bit integers at @p offset.
+  void load_u64_array_at(size_t offset, uint64_t* out, size_t count) const {
+    load_array_at<8>(offset, out, count);
+  }
+
+  /// @brief Decode @p count signed 16-bit integers at @p offset.
+  void load_i16_array_at(size_t offset, int16_t* out, size_t count) const {
+    load_array_at<2>(offset, out, count);
+  }
+
+  /// @brief Decode @p count signed 32-bit integers at @p offset.
+  void load_i32_array_at(size_t offset, int32_t* out, size_t count) const {
+    load_array_at<4>(offset, out, count);
+  }
+
+  /// @brief Decode @p count signed 64-bit integers at @p offset.
+  void load_i64_array_at(size_t offset, int64_t* out, size_t count) const {
+    load_array_at<8>(offset, out, count);
+  }
+
+  /// @brief Decode @p count 32-bit IEEE 754 values at @p offset.
+  void load_f32_array_at(size_t offset, float* out, size_t count) const {
+    load_array_at<4>(offset, out, count);
+  }
+
+  /// @brief Decode @p count 64-bit IEEE 754 values at @p offset.
+  void load_f64_array_at(size_t offset, double* out, size_t count) const {
+    load_array_at<8>(offset, out, count);
+  }
+
+  /// @}
+
+ private:
+  /// @brief Return @p N contiguous bytes, consuming them; stitches into
+  ///        @p tmp when they straddle segments. Null if too few remain.
+  template <size_t N>
+  const uint8_t* take(uint8_t (&tmp)[N]) {
+    if (N <= n_) {
+      const uint8_t* p = p_;
+      p_ += N;
+      n_ -= N;
+      return p;
+    }
+    if (N > remaining()) return nullptr;
+    gather(tmp, N);
+    return tmp;
+  }
+
+  /// @brief Return @p N contiguous bytes @p offset bytes past the cursor.
+  /// @pre @p offset + @p N <= remaining().
+  template <size_t N>
+  const uint8_t* peek(size_t offset, uint8_t (&tmp)[N]) const {
+    if (offset + N <= n_) return p_ + offset;
+    ChunkedReaderT at = *this;
+    at.advance(offset);
+    at.gather(tmp, N);
+    return tmp;
+  }
+
+  /// @brief Copy @p len bytes out and consume them.
+  /// @pre @p len <= remaining().
+  void gather(uint8_t* out, size_t len) {
+    while (len > n_) {
+      if (n_ != 0) std::memcpy(out, p_, n_);
+      out += n_;
+      len -= n_;
+      next_segment();
+    }
+    if (len != 0) std::memcpy(out, p_, len);
+    p_ += len;
+    n_ -= len;
+  }
+
+  /// @brief Make the following segment current.
+  void next_segment() {
+    ++index_;
+    p_ = static_cast<const uint8_t*>(segments_[index_].data);
+    n_ = segments_[index_].size;
+    rest_ -= n_;
+  }
+
+  /// @brief Decode @p count words of @p kWidth bytes into @p out.
+  template <size_t kWidth>
+  static void load_words(void* out, const uint8_t* p, size_t count) {
+    if constexpr (kWidth == 2) {
+      Codec::LoadArray16(out, p, count);
+    } else if constexpr (kWidth == 4) {
+      Codec::LoadArray32(out, p, count);
+    } else {
+      static_assert(kWidth == 8, "unsupported word width");
+      Codec::LoadArray64(out, p, count);
+    }
+  }
+
+  /// @brief Bulk-load @p count words, one run per segment; only words that
+  ///        straddle a boundary are stitched individually.
+  template <size_t kWidth>
+  Status read_array(void* out, size_t count) {
+    if (count > remaining() / kWidth) return Status::OutOfRange(position());
+    auto* dst = static_cast<uint8_t*>(out);
+    while (count != 0) {
+      const size_t run = n_ / kWidth < count ? n_ / kWidth : count;
+      if (run != 0) {
+        load_words<kWidth>(dst, p_, run);
+        p_ += run * kWidth;
+        n_ -= run * kWidth;
+        dst += run * kWidth;
+        count -= run;
+      } else {
+        uint8_t tmp[kWidth];
+        gather(tmp, kWidth);
+        load_words<kWidth>(dst, tmp, 1);
+        dst += kWidth;
+        --count;
+      }
+    }
+    return Status::Ok();
+  }
+
+  /// @brief Unchecked counterpart of @ref read_array() at an offset.
+  template <size_t kWidth>
+  void load_array_at(size_t offset, void* out, size_t count) const {
+    if (offset + count * kWidth <= n_) {
+      load_words<kWidth>(out, p_ + offset, count);
+      return;
+    }
+    ChunkedReaderT at = *this;
+    at.advance(offset);
+    static_cast<void>(at.read_array<kWidth>(out, count));
+  }
+
+  const ByteSegment* segments_;  ///< Segment list.
+  size_t count_;                 ///< Number of segments.
+  size_t index_ = 0;             ///< Index of the current segment.
+  const uint8_t* p_ = nullptr;   ///< Read position in the current segment.
+  size_t n_ = 0;                 ///< Bytes left in the current segment.
+  size_t rest_ = 0;              ///< Bytes in the segments after it.
+  size_t size_ = 0;              ///< Total bytes over all segments.
+};
+
+/// @brief Byte writer that serializes primitives into a fixed-size buffer.
+///
+/// Writes are performed sequentially; the internal cursor advances after each
+/// successful write. Every write method returns a @ref Status indicating
+/// whether enough space was available.
+///
+/// @tparam Codec Byte-order codec (e.g. @ref LittleEndianCodec,
+///               @ref BigEndianCodec).
+/// @tparam Instrument Instrumentation policy for generated code that writes
+///                    through this writer; see @ref NoInstrument.
+template <typename Codec, typename Instrument = NoInstrument>
+class ByteWriterT {
+ public:
+  using codec_type = Codec;  ///< Byte-order codec of this writer.
+  using instrument_type = Instrument;  ///< Instrumentation policy.
+
+  /// @brief Construct a writer over an existing buffer.
+  /// @param data Pointer to the beginning of the buffer.
+  /// @param size Size of the buffer in bytes.
+  ByteWriterT(void* data, size_t size)
+      : p_(static_cast<uint8_t*>(data)), n_(size), size_(size) {}
+
+  /// @brief Construct a writer over a @c uint8_t buffer; unlike the @c void*
+  ///        overload, this one is usable in constant expressions.
+  template <typename Byte,
+            typename = std::enable_if_t<std::is_same_v<Byte, uint8_t>>>
+  BIO_CONSTEXPR20 ByteWriterT(Byte* data, size_t size)
+      : p_(data), n_(size), size_(size) {}
+
+  /// @brief Copy the cursor. The copy writes into the same buffer but never
+  ///        grows it; only the writer that owns a growable buffer can.
+  BIO_CONSTEXPR20 ByteWriterT(const ByteWriterT& other)
+      : p_(other.p_), n_(other.n_), size_(other.size_) {}
+
+  /// @brief Copy the cursor; see the copy constructor.
+  BIO_CONSTEXPR20 ByteWriterT& operator=(const ByteWriterT& other) {
+    p_ = other.p_;
+    n_ = other.n_;
+    size_ = other.size_;
+    grow_ = nullptr;
+    return *this;
+  }
+
+  /// @brief Return the number of bytes of remaining capacity.
+  /// @return Remaining byte count.
+  BIO_CONSTEXPR20 size_t remaining() const { return n_; }
+
+  /// @brief Return the current write position (bytes written so far).
+  /// @return Current byte offset from the start of the buffer.
+  BIO_CONSTEXPR20 size_t position() const { return size_ - n_; }
+
+  /// @brief Write an unsigned 8-bit integer.
+  /// @param v The value to write.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
+  ///         than 1 byte of capacity remains.
+  BIO_CONSTEXPR20 Status write_u8(uint8_t v) {
+    if (1 > n_ && !grow(1)) return Status::OutOfRange(position());
+    *p_++ = v;
+    --n_;
+    return Status::Ok();
+  }
+
+  /// @brief Write an unsigned 16-bit integer.
+  /// @param v The value to write.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
+  ///         than 2 bytes of capacity remain.
+  BIO_CONSTEXPR20 Status write_u16(uint16_t v) {
+    if (sizeof(uint16_t) > n_ && !grow(sizeof(uint16_t))) {
+      return Status::OutOfRange(position());
+    }
+    Codec::StoreU16(p_, v);
+    p_ += sizeof(uint16_t);
+    n_ -= sizeof(uint16_t);
+    return Status::Ok();
+  }
+
+  /// @brief Write an unsigned 32-bit integer.
+  /// @param v The value to write.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
+  ///         than 4 bytes of capacity remain.
+  BIO_CONSTEXPR20 Status write_u32(uint32_t v) {
+    if (sizeof(uint32_t) > n_ && !grow(sizeof(uint32_t))) {
+      return Status::OutOfRange(position());
+    }
+    Codec::StoreU32(p_, v);
+    p_ += sizeof(uint32_t);
+    n_ -= sizeof(uint32_t);
+    return Status::Ok();
+  }
+
+  /// @brief Write an unsigned 64-bit integer.
+  /// @param v The value to write.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
+  ///         than 8 bytes of capacity remain.
+  BIO_CONSTEXPR20 Status write_u64(uint64_t v) {
+    if (sizeof(uint64_t) > n_ && !grow(sizeof(uint64_t))) {
+      return Status::OutOfRange(position());
+    }
+    Codec::StoreU64(p_, v);
+    p_ += sizeof(uint64_t);
+    n_ -= sizeof(uint64_t);
+    return Status::Ok();
+  }
+
+  /// @brief Write a signed 8-bit integer.
+  /// @param v The value to write.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
+  ///         than 1 byte of capacity remains.
+  BIO_CONSTEXPR20 Status write_i8(int8_t v) {
+    const auto bits = detail::BitCast<uint8_t>(v);
+    return write_u8(bits);
+  }
+
+  /// @brief Write a signed 16-bit integer.
+  /// @param v The value to write.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
+  ///         than 2 bytes of capacity remain.
+  BIO_CONSTEXPR20 Status write_i16(int16_t v) {
+    const auto bits = detail::BitCast<uint16_t>(v);
+    return write_u16(bits);
+  }
+
+  /// @brief Write a signed 32-bit integer.
+  /// @param v The value to write.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
+  ///         than 4 bytes of capacity remain.
+  BIO_CONSTEXPR20 Status write_i32(int32_t v) {
+    const auto bits = detail::BitCast<uint32_t>(v);
+    return write_u32(bits);
+  }
+
+  /// @brief Write a signed 64-bit integer.
+  /// @param v The value to write.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
+  ///         than 8 bytes of capacity remain.
+  BIO_CONSTEXPR20 Status write_i64(int64_t v) {
+    const auto bits = detail::BitCast<uint64_t>(v);
+    return write_u64(bits);
+  }
+
+  /// @brief Write a 32-bit IEEE 754 floating-point value.
+  /// @param v The value to write.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
+  ///         than 4 bytes of capacity remain.
+  BIO_CONSTEXPR20 Status write_f32(float v) {
+    static_assert(sizeof(float) == 4, "float must be 32-bit");
+    const auto bits = detail::BitCast<uint32_t>(v);
+    return write_u32(bits);
+  }
+
+  /// @brief Write a 64-bit IEEE 754 floating-point value.
+  /// @param v The value to write.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
+  ///         than 8 bytes of capacity remain.
+  BIO_CONSTEXPR20 Status write_f64(double v) {
+    static_assert(sizeof(double) == 8, "double must be 64-bit");
+    const auto bits = detail::BitCast<uint64_t>(v);
+    return write_u64(bits);
+  }
+
+  /// @brief Write an unsigned LEB128 variable-length integer.
+  ///
+  /// Takes one byte per seven significant bits of @p v (one to ten bytes);
+  /// see @ref ByteReaderT::read_varuint().
+  ///
+  /// @param v The value to write.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if the
+  ///         encoding does not fit in the remaining capacity.
+  BIO_CONSTEXPR20 Status write_varuint(uint64_t v) {
+    // Only measure the encoding when the buffer is nearly full.
+    if (n_ < detail::kMaxVarintBytes) {
+      const size_t len = detail::VarintSize(v);
+      if (len > n_ && !grow(len)) return Status::OutOfRange(position());
+    }
+    const size_t len = detail::EncodeVarint(p_, v);
+    p_ += len;
+    n_ -= len;
+    return Status::Ok();
+  }
+
+  /// @brief Write a zigzag-encoded signed LEB128 integer; see
+  ///        @ref ByteReaderT::read_varint().
+  BIO_CONSTEXPR20 Status write_varint(int64_t v) {
+    return write_varuint(detail::ZigZagEncode(v));
+  }
+
+  /// @brief Write an array of unsigned 8-bit integers.
+  /// @param in Source array; must contain at least @p count elements.
+  /// @param count Number of elements to write.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
+  ///         than @p count bytes of capacity remain.
+  BIO_CONSTEXPR20 Status write_u8_array(const uint8_t* in, size_t count) {
+    return write_bytes(in, count);
+  }
+
+  /// @brief Write an array of signed 8-bit integers.
+  /// @param in Source array; must contain at least @p count elements.
+  /// @param count Number of elements to write.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
+  ///         than @p count bytes of capacity remain.
+  BIO_CONSTEXPR20 Status write_i8_array(const int8_t* in, size_t count) {
+    return write_bytes(in, count);
+  }
+
+  /// @brief Write an array of unsigned 16-bit integers.
+  ///
+  /// Performs a single bounds check for the whole array, then copies (or
+  /// byte-swaps) all elements at once.
+  ///
+  /// @param in Source array; must contain at least @p count elements.
+  /// @param count Number of elements to write.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
+  ///         than @p count * 2 bytes of capacity remain.
+  BIO_CONSTEXPR20 Status write_u16_array(const uint16_t* in, size_t count) {
+    return write_array(in, count);
+  }
+
+  /// @brief Write an array of unsigned 32-bit integers.
+  ///
+  /// Performs a single bounds check for the whole array, then copies (or
+  /// byte-swaps) all elements at once.
+  ///
+  /// @param in Source array; must contain at least @p count elements.
+  /// @param count Number of elements to write.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
+  ///         than @p count * 4 bytes of capacity remain.
+  BIO_CONSTEXPR20 Status write_u32_array(const uint32_t* in, size_t count) {
+    return write_array(in, count);
+  }
+
+  /// @brief Write an array of unsigned 64-bit integers.
+  ///
+  /// Performs a single bounds check for the whole array, then copies (or
+  /// byte-swaps) all elements at once.
+  ///
+  /// @param in Source array; must contain at least @p count elements.
+  /// @param count Number of elements to write.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
+  ///         than @p count * 8 bytes of capacity remain.
+  BIO_CONSTEXPR20 Status write_u64_array(const uint64_t* in, size_t count) {
+    return write_array(in, count);
+  }
+
+  /// @brief Write an array of signed 16-bit integers.
+  ///
+  /// Performs a single bounds check for the whole array, then copies (or
+  /// byte-swaps) all elements at once.
+  ///
+  /// @param in Source array; must contain at least @p count elements.
+  /// @param count Number of elements to write.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
+  ///         than @p count * 2 bytes of capacity remain.
+  BIO_CONSTEXPR20 Status write_i16_array(const int16_t* in, size_t count) {
+    return write_array(in, count);
+  }
+
+  /// @brief Write an array of signed 32-bit integers.
+  ///
+  /// Performs a single bounds check for the whole array, then copies (or
+  /// byte-swaps) all elements at once.
+  ///
+  /// @param in Source array; must contain at least @p count elements.
+  /// @param count Number of elements to write.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
+  ///         than @p count * 4 bytes of capacity remain.
+  BIO_CONSTEXPR20 Status write_i32_array(const int32_t* in, size_t count) {
+    return write_array(in, count);
+  }
+
+  /// @brief Write an array of signed 64-bit integers.
+  ///
+  /// Performs a single bounds check for the whole array, then copies (or
+  /// byte-swaps) all elements at once.
+  ///
+  /// @param in Source array; must contain at least @p count elements.
+  /// @param count Number of elements to write.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
+  ///         than @p count * 8 bytes of capacity remain.
+  BIO_CONSTEXPR20 Status write_i64_array(const int64_t* in, size_t count) {
+    return write_array(in, count);
+  }
+
+  /// @brief Write an array of 32-bit IEEE 754 floating-point values.
+  ///
+  /// Performs a single bounds check for the whole array, then copies (or
+  /// byte-swaps) all elements at once.
+  ///
+  /// @param in Source array; must contain at least @p count elements.
+  /// @param count Number of elements to write.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
+  ///         than @p count * 4 bytes of capacity remain.
+  BIO_CONSTEXPR20 Status write_f32_array(const float* in, size_t count) {
+    return write_array(in, count);
+  }
+
+  /// @brief Write an array of 64-bit IEEE 754 floating-point values.
+  ///
+  /// Performs a single bounds check for the whole array, then copies (or
+  /// byte-swaps) all elements at once.
+  ///
+  /// @param in Source array; must contain at least @p count elements.
+  /// @param count Number of elements to write.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
+  ///         than @p count * 8 bytes of capacity remain.
+  BIO_CONSTEXPR20 Status write_f64_array(const double* in, size_t count) {
+    return write_array(in, count);
+  }
+
+  /// @brief Write a sequence of raw bytes from a caller-provided buffer.
+  /// @param in Source buffer; must contain at least @p len bytes.
+  /// @param len Number of bytes to write.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
+  ///         than @p len bytes of capacity remain.
+  Status write_bytes(const void* in, size_t len) {
+    return write_bytes(static_cast<const uint8_t*>(in), len);
+  }
+
+  /// @brief Overload of @ref write_bytes() for byte-sized element types,
+  ///        usable in constant expressions.
+  template <typename Byte, typename = std::enable_if_t<detail::kIsByte<Byte>>>
+  BIO_CONSTEXPR20 Status write_bytes(const Byte* in, size_t len) {
+    if (len > n_ && !grow(len)) return Status::OutOfRange(position());
+    detail::CopyBytes(p_, in, len);
+    p_ += len;
+    n_ -= len;
+    return Status::Ok();
+  }
+
+  /// @brief Advance the write cursor without writing any data.
+  /// @param len Number of bytes to skip.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
+  ///         than @p len bytes of capacity remain.
+  BIO_CONSTEXPR20 Status skip(size_t len) {
+    if (len > n_ && !grow(len)) return Status::OutOfRange(position());
+    p_ += len;
+    n_ -= len;
+    return Status::Ok();
+  }
+
+  /// @name Reserve and backpatch
+  ///
+  /// For fields that are only known after later bytes are written, such as
+  /// a payload length in a header or a checksum over a frame: reserve the
+  /// field with @ref reserve_bytes(), write the rest, then fill it in with a
+  /// @c patch_* method. Patches address absolute positions, must lie inside
+  /// the bytes written so far and leave the cursor where it is.
+  /// @{
+
+  /// @brief Zero-fill @p len bytes and advance past them.
+  /// @param len Number of bytes to reserve.
+  /// @param[out] pos Position of the first reserved byte, for the
+  ///             later @c patch_* call.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if fewer
+  ///         than @p len bytes of capacity remain.
+  BIO_CONSTEXPR20 Status reserve_bytes(size_t len, size_t& pos) {
+    if (len > n_ && !grow(len)) return Status::OutOfRange(position());
+    pos = position();
+    for (size_t i = 0; i < len; ++i) p_[i] = 0;
+    p_ += len;
+    n_ -= len;
+    return Status::Ok();
+  }
+
+  /// @brief Encode an unsigned 8-bit integer at @p pos.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if the
+  ///         byte has not been written yet.
+  BIO_CONSTEXPR20 Status patch_u8(size_t pos, uint8_t v) {
+    if (!written(pos, 1)) return Status::OutOfRange(pos);
+    buffer()[pos] = v;
+    return Status::Ok();
+  }
+
+  /// @brief Encode an unsigned 16-bit integer at @p pos.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if the
+  ///         2 bytes have not all been written yet.
+  BIO_CONSTEXPR20 Status patch_u16(size_t pos, uint16_t v) {
+    if (!written(pos, 2)) return Status::OutOfRange(pos);
+    Codec::StoreU16(buffer() + pos, v);
+    return Status::Ok();
+  }
+
+  /// @brief Encode an unsigned 32-bit integer at @p pos.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if the
+  ///         4 bytes have not all been written yet.
+  BIO_CONSTEXPR20 Status patch_u32(size_t pos, uint32_t v) {
+    if (!written(pos, 4)) return Status::OutOfRange(pos);
+    Codec::StoreU32(buffer() + pos, v);
+    return Status::Ok();
+  }
+
+  /// @brief Encode an unsigned 64-bit integer at @p pos.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if the
+  ///         8 bytes have not all been written yet.
+  BIO_CONSTEXPR20 Status patch_u64(size_t pos, uint64_t v) {
+    if (!written(pos, 8)) return Status::OutOfRange(pos);
+    Codec::StoreU64(buffer() + pos, v);
+    return Status::Ok();
+  }
+
+  /// @brief Copy @p len raw bytes to @p pos.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if the
+  ///         @p len bytes have not all been written yet.
+  Status patch_bytes(size_t pos, const void* in, size_t len) {
+    if (!written(pos, len)) return Status::OutOfRange(pos);
+    detail::CopyBytes(buffer() + pos, static_cast<const uint8_t*>(in),
+                      len);
+    return Status::Ok();
+  }
+
+  /// @}
+
+  /// @name Unchecked access at constant offsets
+  ///
+  /// These methods encode relative to the cursor without bounds checks or
+  /// cursor updates, so a fixed-size record can be encoded with a single
+  /// check: call @ref ensure() once for the record size, store every field at
+  /// its offset, then @ref advance() past the record.
+  /// @{
+
+  /// @brief Check that at least @p len bytes of capacity remain.
+  ///
+  /// A growable writer (see @ref DynamicByteWriterT) enlarges its buffer
+  /// here if needed; offsets stay relative to the cursor.
+  ///
+  /// @param len Number of bytes required.
+  /// @return @ref Status::Ok() if @p len bytes of capacity remain,
+  ///         @ref Status::OutOfRange() otherwise.
+  BIO_CONSTEXPR20 Status ensure(size_t len) {
+    if (len > n_ && !grow(len)) return Status::OutOfRange(position());
+    return Status::Ok();
+  }
+
+  /// @brief Advance the write cursor without a bounds check.
+  /// @param len Number of bytes to commit.
+  /// @pre @p len <= remaining().
+  BIO_CONSTEXPR20 void advance(size_t len) {
+    p_ += len;
+    n_ -= len;
+  }
+
+  /// @brief Encode an unsigned 8-bit integer @p offset bytes past the cursor.
+  /// @pre @p offset + 1 <= remaining().
+  BIO_CONSTEXPR20 void store_u8_at(size_t offset, uint8_t v) {
+    p_[offset] = v;
+  }
+
+  /// @brief Encode an unsigned 16-bit integer @p offset bytes past the cursor.
+  /// @pre @p offset + 2 <= remaining().
+  BIO_CONSTEXPR20 void store_u16_at(size_t offset, uint16_t v) {
+    Codec::StoreU16(p_ + offset, v);
+  }
+
+  /// @brief Encode an unsigned 32-bit integer @p offset bytes past the cursor.
+  /// @pre @p offset + 4 <= remaining().
+  BIO_CONSTEXPR20 void store_u32_at(size_t offset, uint32_t v) {
+    Codec::StoreU32(p_ + offset, v);
+  }
+
+  /// @brief Encode an unsigned 64-bit integer @p offset bytes past the cursor.
+  /// @pre @p offset + 8 <= remaining().
+  BIO_CONSTEXPR20 void store_u64_at(size_t offset, uint64_t v) {
+    Codec::StoreU64(p_ + offset, v);
+  }
+
+  /// @brief Encode a signed 8-bit integer @p offset bytes past the cursor.
+  /// @pre @p offset + 1 <= remaining().
+  BIO_CONSTEXPR20 void store_i8_at(size_t offset, int8_t v) {
+    const auto bits = detail::BitCast<uint8_t>(v);
+    p_[offset] = bits;
+  }
+
+  /// @brief Encode a signed 16-bit integer @p offset bytes past the cursor.
+  /// @pre @p offset + 2 <= remaining().
+  BIO_CONSTEXPR20 void store_i16_at(size_t offset, int16_t v) {
+    const auto bits = detail::BitCast<uint16_t>(v);
+    Codec::StoreU16(p_ + offset, bits);
+  }
+
+  /// @brief Encode a signed 32-bit integer @p offset bytes past the cursor.
+  /// @pre @p offset + 4 <= remaining().
+  BIO_CONSTEXPR20 void store_i32_at(size_t offset, int32_t v) {
+    const auto bits = detail::BitCast<uint32_t>(v);
+    Codec::StoreU32(p_ + offset, bits);
+  }
+
+  /// @brief Encode a signed 64-bit integer @p offset bytes past the cursor.
+  /// @pre @p offset + 8 <= remaining().
+  BIO_CONSTEXPR20 void store_i64_at(size_t offset, int64_t v) {
+    const auto bits = detail::BitCast<uint64_t>(v);
+    Codec::StoreU64(p_ + offset, bits);
+  }
+
+  /// @brief Encode a 32-bit IEEE 754 floating-point value @p offset bytes
+  ///        past the cursor.
+  /// @pre @p offset + 4 <= remaining().
+  BIO_CONSTEXPR20 void store_f32_at(size_t offset, float v) {
+    const auto bits = detail::BitCast<uint32_t>(v);
+    Codec::StoreU32(p_ + offset, bits);
+  }
+
+  /// @brief Encode a 64-bit IEEE 754 floating-point value @p offset bytes
+  ///        past the cursor.
+  /// @pre @p offset + 8 <= remaining().
+  BIO_CONSTEXPR20 void store_f64_at(size_t offset, double v) {
+    const auto bits = detail::BitCast<uint64_t>(v);
+    Codec::StoreU64(p_ + offset, bits);
+  }
+
+  /// @brief Copy @p len raw bytes to @p offset bytes past the cursor.
+  /// @pre @p offset + @p len <= remaining().
+  void store_bytes_at(size_t offset, const void* in, size_t len) {
+    std::memcpy(p_ + offset, in, len);
+  }
+
+  /// @brief Overload of @ref store_bytes_at() for byte-sized element types,
+  ///        usable in constant expressions.
+  template <typename Byte, typename = std::enable_if_t<detail::kIsByte<Byte>>>
+  BIO_CONSTEXPR20 void store_bytes_at(size_t offset, const Byte* in,
+                                      size_t len) {
+    detail::CopyBytes(p_ + offset, in, len);
+  }
+
+  /// @brief Bulk-encode @p count elements to @p offset bytes past the cursor.
+  /// @pre @p offset + @p count * 2 <= remaining().
+  BIO_CONSTEXPR20 void store_u16_array_at(size_t offset, const uint16_t* in,
+                                          size_t count) {
+    detail::StoreValues<Codec>(p_ + offset, in, count);
+  }
+
+  /// @brief Bulk-encode @p count elements to @p offset bytes past the cursor.
+  /// @pre @p offset + @p count * 4 <= remaining().
+  BIO_CONSTEXPR20 void store_u32_array_at(size_t offset, const uint32_t* in,
+                                          size_t count) {
+    detail::StoreValues<Codec>(p_ + offset, in, count);
+  }
+
+  /// @brief Bulk-encode @p count elements to @p offset bytes past the cursor.
+  /// @pre @p offset + @p count * 8 <= remaining().
+  BIO_CONSTEXPR20 void store_u64_array_at(size_t offset, const uint64_t* in,
+                                          size_t count) {
+    detail::StoreValues<Codec>(p_ + offset, in, count);
+  }
+
+  /// @brief Bulk-encode @p count elements to @p offset bytes past the cursor.
+  /// @pre @p offset + @p count * 2 <= remaining().
+  BIO_CONSTEXPR20 void store_i16_array_at(size_t offset, const int16_t* in,
+                                          size_t count) {
+    detail::StoreValues<Codec>(p_ + offset, in, count);
+  }
+
+  /// @brief Bulk-encode @p count elements to @p offset bytes past the cursor.
+  /// @pre @p offset + @p count * 4 <= remaining().
+  BIO_CONSTEXPR20 void store_i32_array_at(size_t offset, const int32_t* in,
+                                          size_t count) {
+    detail::StoreValues<Codec>(p_ + offset, in, count);
+  }
+
+  /// @brief Bulk-encode @p count elements to @p offset bytes past the cursor.
+  /// @pre @p offset + @p count * 8 <= remaining().
+  BIO_CONSTEXPR20 void store_i64_array_at(size_t offset, const int64_t* in,
+                                          size_t count) {
+    detail::StoreValues<Codec>(p_ + offset, in, count);
+  }
+
+  /// @brief Bulk-encode @p count elements to @p offset bytes past the cursor.
+  /// @pre @p offset + @p count * 4 <= remaining().
+  BIO_CONSTEXPR20 void store_f32_array_at(size_t offset, const float* in,
+                                          size_t count) {
+    detail::StoreValues<Codec>(p_ + offset, in, count);
+  }
+
+  /// @brief Bulk-encode @p count elements to @p offset bytes past the cursor.
+  /// @pre @p offset + @p count * 8 <= remaining().
+  BIO_CONSTEXPR20 void store_f64_array_at(size_t offset, const double* in,
+                                          size_t count) {
+    detail::StoreValues<Codec>(p_ + offset, in, count);
+  }
+
+  /// @}
+
+ protected:
+  /// @brief Growth hook invoked when a write needs @p len more bytes than
+  ///        remain; returns @c true after calling @ref rebind() with a buffer
+  ///        that has room for them.
+  using GrowFn = bool (*)(ByteWriterT& writer, size_t len);
+
+  /// @brief Construct a writer whose buffer can be replaced by @p grow_fn.
+  ByteWriterT(void* data, size_t size, GrowFn grow_fn)
+      : p_(static_cast<uint8_t*>(data)),
+        n_(size),
+        size_(size),
+        grow_(grow_fn) {}
+
+  /// @brief Return the start of the current buffer.
+  BIO_CONSTEXPR20 uint8_t* buffer() const { return p_ - (size_ - n_); }
+
+  /// @brief Move to a new buffer of @p size bytes, keeping the position.
+  /// @pre @p size >= position().
+  BIO_CONSTEXPR20 void rebind(uint8_t* data, size_t size) {
+    const size_t pos = position();
+    p_ = data + pos;
+    n_ = size - pos;
+    size_ = size;
+  }
+
+  /// @brief Rewind the cursor to the start of the current buffer.
+  BIO_CONSTEXPR20 void rewind() {
+    p_ = buffer();
+    n_ = size_;
+  }
+
+ private:
+  /// @brief Bulk-store @p count values from @p in.
+  template <typename T>
+  BIO_CONSTEXPR20 Status write_array(const T* in, size_t count) {
+    constexpr size_t kWidth = sizeof(T);
+    if (count > n_ / kWidth &&
+        (count > SIZE_MAX / kWidth || !grow(count * kWidth))) {
+      return Status::OutOfRange(position());
+    }
+    detail::StoreValues<Codec>(p_, in, count);
+    p_ += count * kWidth;
+    n_ -= count * kWidth;
+    return Status::Ok();
+  }
+
+  /// @brief Ask the growth hook for at least @p len more bytes.
+  BIO_CONSTEXPR20 bool grow(size_t len) {
+    return grow_ != nullptr && grow_(*this, len);
+  }
+
+  /// @brief Whether [@p pos, @p pos + @p len) has been written.
+  BIO_CONSTEXPR20 bool written(size_t pos, size_t len) const {
+    return pos <= position() && len <= position() - pos;
+  }
+
+  uint8_t* p_;              ///< Current write position.
+  size_t n_;                ///< Remaining capacity.
+  size_t size_;             ///< Total buffer size.
+  GrowFn grow_ = nullptr;  ///< Growth hook; null for fixed buffers.
+};
+
+/// @brief Measure-only writer that counts the bytes a serialization needs.
+///
+/// Has the same @c write_* / @c skip / @c ensure surface as @ref ByteWriterT
+/// but stores nothing: every call succeeds and only adds to @ref size(). Run
+/// a serializer against a counter first to size the real buffer exactly,
+/// then run it again against a @ref ByteWriterT over that buffer.
+///
+/// Generated @c serialize() methods are templated on the writer type and
+/// accept a counter of the matching codec.
+///
+/// @tparam Codec Byte-order codec of the writer being measured for. It does
+///               not affect the count but keeps the interface type-checked.
+template <typename Codec>
+class SizeCounterT {
+ public:
+  using codec_type = Codec;
+
+  /// @brief Return the number of bytes counted so far.
+  BIO_CONSTEXPR20 size_t size() const { return n_; }
+
+  /// @brief Return the number of bytes counted so far; same as size().
+  BIO_CONSTEXPR20 size_t position() const { return n_; }
+
+  /// @brief Return the remaining capacity, which is unbounded.
+  BIO_CONSTEXPR20 size_t remaining() const { return SIZE_MAX - n_; }
+
+  /// @brief Reset the count to zero.
+  BIO_CONSTEXPR20 void clear() { n_ = 0; }
+
+  /// @brief Count a 1-byte value.
+  BIO_CONSTEXPR20 Status write_u8(uint8_t /*v*/) { return add(1); }
+
+  /// @brief Count a 2-byte value.
+  BIO_CONSTEXPR20 Status write_u16(uint16_t /*v*/) { return add(2); }
+
+  /// @brief Count a 4-byte value.
+  BIO_CONSTEXPR20 Status write_u32(uint32_t /*v*/) { return add(4); }
+
+  /// @brief Count a 8-byte value.
+  BIO_CONSTEXPR20 Status write_u64(uint64_t /*v*/) { return add(8); }
+
+  /// @brief Count a 1-byte value.
+  BIO_CONSTEXPR20 Status write_i8(int8_t /*v*/) { return add(1); }
+
+  /// @brief Count a 2-byte value.
+  BIO_CONSTEXPR20 Status write_i16(int16_t /*v*/) { return add(2); }
+
+  /// @brief Count a 4-byte value.
+  BIO_CONSTEXPR20 Status write_i32(int32_t /*v*/) { return add(4); }
+
+  /// @brief Count a 8-byte value.
+  BIO_CONSTEXPR20 Status write_i64(int64_t /*v*/) { return add(8); }
+
+  /// @brief Count a 4-byte value.
+  BIO_CONSTEXPR20 Status write_f32(float /*v*/) { return add(4); }
+
+  /// @brief Count a 8-byte value.
+  BIO_CONSTEXPR20 Status write_f64(double /*v*/) { return add(8); }
+
+  /// @brief Count an unsigned LEB128 value.
+  BIO_CONSTEXPR20 Status write_varuint(uint64_t v) {
+    return add(detail::VarintSize(v));
+  }
+
+  /// @brief Count a zigzag-encoded signed LEB128 value.
+  BIO_CONSTEXPR20 Status write_varint(int64_t v) {
+    return add(detail::VarintSize(detail::ZigZagEncode(v)));
+  }
+
+  /// @brief Count @p count 1-byte values.
+  BIO_CONSTEXPR20 Status write_u8_array(const uint8_t* /*in*/, size_t count) {
+    return add(count * 1);
+  }
+
+  /// @brief Count @p count 2-byte values.
+  BIO_CONSTEXPR20 Status write_u16_array(const uint16_t* /*in*/, size_t count) {
+    return add(count * 2);
+  }
+
+  /// @brief Count @p count 4-byte values.
+  BIO_CONSTEXPR20 Status write_u32_array(const uint32_t* /*in*/, size_t count) {
+    return add(count * 4);
+  }
+
+  /// @brief Count @p count 8-byte values.
+  BIO_CONSTEXPR20 Status write_u64_array(const uint64_t* /*in*/, size_t count) {
+    return add(count * 8);
+  }
+
+  /// @brief Count @p count 1-byte values.
+  BIO_CONSTEXPR20 Status write_i8_array(const int8_t* /*in*/, size_t count) {
+    return add(count * 1);
+  }
+
+  /// @brief Count @p count 2-byte values.
+  BIO_CONSTEXPR20 Status write_i16_array(const int16_t* /*in*/, size_t count) {
+    return add(count * 2);
+  }
+
+  /// @brief Count @p count 4-byte values.
+  BIO_CONSTEXPR20 Status write_i32_array(const int32_t* /*in*/, size_t count) {
+    return add(count * 4);
+  }
+
+  /// @brief Count @p count 8-byte values.
+  BIO_CONSTEXPR20 Status write_i64_array(const int64_t* /*in*/, size_t count) {
+    return add(count * 8);
+  }
+
+  /// @brief Count @p count 4-byte values.
+  BIO_CONSTEXPR20 Status write_f32_array(const float* /*in*/, size_t count) {
+    return add(count * 4);
+  }
+
+  /// @brief Count @p count 8-byte values.
+  BIO_CONSTEXPR20 Status write_f64_array(const double* /*in*/, size_t count) {
+    return add(count * 8);
+  }
+
+  /// @brief Count @p len raw bytes.
+  BIO_CONSTEXPR20 Status write_bytes(const void* /*in*/, size_t len) {
+    return add(len);
+  }
+
+  /// @brief Count @p len skipped bytes.
+  BIO_CONSTEXPR20 Status skip(size_t len) { return add(len); }
+
+  /// @brief Count @p len reserved bytes and report where they start.
+  BIO_CONSTEXPR20 Status reserve_bytes(size_t len, size_t& pos) {
+    pos = n_;
+    return add(len);
+  }
+
+  /// @brief No-op; patched bytes were counted when they were reserved.
+  BIO_CONSTEXPR20 Status patch_u8(size_t /*pos*/, uint8_t /*v*/) {
+    return Status::Ok();
+  }
+
+  /// @brief No-op; patched bytes were counted when they were reserved.
+  BIO_CONSTEXPR20 Status patch_u16(size_t /*pos*/, uint16_t /*v*/) {
+    return Status::Ok();
+  }
+
+  /// @brief No-op; patched bytes were counted when they were reserved.
+  BIO_CONSTEXPR20 Status patch_u32(size_t /*pos*/, uint32_t /*v*/) {
+    return Status::Ok();
+  }
+
+  /// @brief No-op; patched bytes were counted when they were reserved.
+  BIO_CONSTEXPR20 Status patch_u64(size_t /*pos*/, uint64_t /*v*/) {
+    return Status::Ok();
+  }
+
+  /// @brief No-op; patched bytes were counted when they were reserved.
+  BIO_CONSTEXPR20 Status patch_bytes(size_t /*pos*/, const void* /*in*/,
+                                     size_t /*len*/) {
+    return Status::Ok();
+  }
+
+  /// @brief Always succeeds; there is no capacity to check.
+  BIO_CONSTEXPR20 Status ensure(size_t /*len*/) { return Status::Ok(); }
+
+  /// @brief Count @p len bytes stored through the @c store_*_at methods.
+  BIO_CONSTEXPR20 void advance(size_t len) { n_ += len; }
+
+  /// @brief No-op; the value is counted by @ref advance().
+  BIO_CONSTEXPR20 void store_u8_at(size_t /*offset*/, uint8_t /*v*/) {}
+
+  /// @brief No-op; the value is counted by @ref advance().
+  BIO_CONSTEXPR20 void store_u16_at(size_t /*offset*/, uint16_t /*v*/) {}
+
+  /// @brief No-op; the value is counted by @ref advance().
+  BIO_CONSTEXPR20 void store_u32_at(size_t /*offset*/, uint32_t /*v*/) {}
+
+  /// @brief No-op; the value is counted by @ref advance().
+  BIO_CONSTEXPR20 void store_u64_at(size_t /*offset*/, uint64_t /*v*/) {}
+
+  /// @brief No-op; the value is counted by @ref advance().
+  BIO_CONSTEXPR20 void store_i8_at(size_t /*offset*/, int8_t /*v*/) {}
+
+  /// @brief No-op; the value is counted by @ref advance().
+  BIO_CONSTEXPR20 void store_i16_at(size_t /*offset*/, int16_t /*v*/) {}
+
+  /// @brief No-op; the value is counted by @ref advance().
+  BIO_CONSTEXPR20 void store_i32_at(size_t /*offset*/, int32_t /*v*/) {}
+
+  /// @brief No-op; the value is counted by @ref advance().
+  BIO_CONSTEXPR20 void store_i64_at(size_t /*offset*/, int64_t /*v*/) {}
+
+  /// @brief No-op; the value is counted by @ref advance().
+  BIO_CONSTEXPR20 void store_f32_at(size_t /*offset*/, float /*v*/) {}
+
+  /// @brief No-op; the value is counted by @ref advance().
+  BIO_CONSTEXPR20 void store_f64_at(size_t /*offset*/, double /*v*/) {}
+
+  /// @brief No-op; the bytes are counted by @ref advance().
+  BIO_CONSTEXPR20 void store_bytes_at(size_t /*offset*/, const void* /*in*/,
+                                      size_t /*len*/) {}
+
+  /// @brief No-op; the values are counted by @ref advance().
+  BIO_CONSTEXPR20 void store_u16_array_at(size_t /*offset*/,
+                                          const uint16_t* /*in*/,
+                                          size_t /*count*/) {}
+
+  /// @brief No-op; the values are counted by @ref advance().
+  BIO_CONSTEXPR20 void store_u32_array_at(size_t /*offset*/,
+                                          const uint32_t* /*in*/,
+                                          size_t /*count*/) {}
+
+  /// @brief No-op; the values are counted by @ref advance().
+  BIO_CONSTEXPR20 void store_u64_array_at(size_t /*offset*/,
+                                          const uint64_t* /*in*/,
+                                          size_t /*count*/) {}
+
+  /// @brief No-op; the values are counted by @ref advance().
+  BIO_CONSTEXPR20 void store_i16_array_at(size_t /*offset*/,
+                                          const int16_t* /*in*/,
+                                          size_t /*count*/) {}
+
+  /// @brief No-op; the values are counted by @ref advance().
+  BIO_CONSTEXPR20 void store_i32_array_at(size_t /*offset*/,
+                                          const int32_t* /*in*/,
+                                          size_t /*count*/) {}
+
+  /// @brief No-op; the values are counted by @ref advance().
+  BIO_CONSTEXPR20 void store_i64_array_at(size_t /*offset*/,
+                                          const int64_t* /*in*/,
+                                          size_t /*count*/) {}
+
+  /// @brief No-op; the values are counted by @ref advance().
+  BIO_CONSTEXPR20 void store_f32_array_at(size_t /*offset*/,
+                                          const float* /*in*/,
+                                          size_t /*count*/) {}
+
+  /// @brief No-op; the values are counted by @ref advance().
+  BIO_CONSTEXPR20 void store_f64_array_at(size_t /*offset*/,
+                                          const double* /*in*/,
+                                          size_t /*count*/) {}
+
+ private:
+  BIO_CONSTEXPR20 Status add(size_t len) {
+    n_ += len;
+    return Status::Ok();
+  }
+
+  size_t n_ = 0;  ///< Bytes counted.
+};
+
+/// @brief Byte writer that owns a buffer and grows it geometrically.
+///
+/// Exposes the full @ref ByteWriterT write surface (it @e is a
+/// @ref ByteWriterT), so functions and generated @c serialize() methods that
+/// take an @ref LEWriter / @ref BEWriter reference work unchanged. Whenever a
+/// write does not fit, the buffer is reallocated to at least twice its size
+/// and the written bytes are copied over. Bytes that are skipped rather than
+/// written are zero on first use.
+///
+/// Memory comes from @p Allocator. To encode batches without per-message
+/// heap traffic, pass an arena, e.g. a
+/// @c std::pmr::polymorphic_allocator<uint8_t> over a
+/// @c std::pmr::monotonic_buffer_resource, and call @ref clear() between
+/// messages to reuse the capacity.
+///
+/// Writers are neither copyable nor movable: the buffer they own is bound
+/// into the @ref ByteWriterT base.
+///
+/// @tparam Codec Byte-order codec (e.g. @ref LittleEndianCodec,
+///               @ref BigEndianCodec).
+/// @tparam Allocator Allocator of @c uint8_t.
+template <typename Codec, typename Allocator = std::allocator<uint8_t>>
+class DynamicByteWriterT : public ByteWriterT<Codec> {
+  using Base = ByteWriterT<Codec>;
+  using Traits = std::allocator_traits<Allocator>;
+
+ public:
+  using allocator_type = Allocator;
+
+  /// @brief Construct an empty writer.
+  /// @param initial_capacity Bytes to allocate up front.
+  /// @param alloc Allocator used for every buffer.
+  explicit DynamicByteWriterT(size_t initial_capacity = 0,
+                              const Allocator& alloc = Allocator())
+      : Base(nullptr, 0, &DynamicByteWriterT::grow_hook), alloc_(alloc) {
+    reserve(initial_capacity);
+  }
+
+  DynamicByteWriterT(const DynamicByteWriterT&) = delete;
+  DynamicByteWriterT& operator=(const DynamicByteWriterT&) = delete;
+
+  ~DynamicByteWriterT() {
+    if (capacity_ != 0) Traits::deallocate(alloc_, data_, capacity_);
+  }
+
+  /// @brief Return the start of the written bytes.
+  const uint8_t* data() const { return data_; }
+
+  /// @brief Return the number of bytes written; same as position().
+  size_t size() const { return this->position(); }
+
+  /// @brief Return the allocated buffer size in bytes.
+  size_t capacity() const { return capacity_; }
+
+  /// @brief Return a view of the written bytes.
+  ByteView view() const { return ByteView(data_, size()); }
+
+  /// @brief Return a copy of the allocator.
+  allocator_type get_allocator() const { return alloc_; }
+
+  /// @brief Discard the written bytes but keep the capacity.
+  void clear() { this->rewind(); }
+
+  /// @brief Ensure the buffer holds at least @p capacity bytes in total.
+  void reserve(size_t capacity) {
+    if (capacity <= capacity_) return;
+    uint8_t* data = Traits::allocate(alloc_, capacity);
+    const size_t used = size();
+    if (used != 0) std::memcpy(data, data_, used);
+    std::memset(data + used, 0, capacity - used);
+    if (capacity_ != 0) Traits::deallocate(alloc_, data_, capacity_);
+    data_ = data;
+    capacity_ = capacity;
+    this->rebind(data_, capacity_);
+  }
+
+ private:
+  static constexpr size_t kMinCapacity = 64;
+
+  static bool grow_hook(Base& base, size_t len) {
+    auto& self = static_cast<DynamicByteWriterT&>(base);
+    const size_t used = self.size();
+    if (len > SIZE_MAX - used) return false;
+    size_t capacity = self.capacity_ < kMinCapacity ? kMinCapacity
+                                                    : self.capacity_;
+    while (capacity < used + len) {
+      if (capacity > SIZE_MAX / 2) {
+        capacity = used + len;
+        break;
+      }
+      capacity *= 2;
+    }
+    self.reserve(capacity);
+    return true;
+  }
+
+  Allocator alloc_;
+  uint8_t* data_ = nullptr;
+  size_t capacity_ = 0;
+};
+
+/// @brief Bit-order policy: the first bit of the stream is the most
+///        significant bit of the first byte.
+///
+/// Used by most network, video and sensor formats (e.g. H.264, MPEG-TS).
+struct MsbFirst {};
+
+/// @brief Bit-order policy: the first bit of the stream is the least
+///        significant bit of the first byte.
+///
+/// Used by DEFLATE and many packed microcontroller formats.
+struct LsbFirst {};
+
+/// @brief Reader for densely packed bit fields.
+///
+/// Keeps up to 64 bits in an accumulator and refills it a word at a time:
+/// while at least 8 bytes remain, one unaligned 64-bit load tops the
+/// accumulator up to at least 56 bits, so a run of sub-byte fields costs a
+/// shift and a mask each rather than a load, mask and shift round trip per
+/// field. Near the end of the buffer it refills byte by byte.
+///
+/// Fields are unsigned or signed integers, @c bool or enums of 1 to 64 bits;
+/// signed destinations are sign-extended from the field width.
+///
+/// @tparam Order Bit-order policy, @ref MsbFirst or @ref LsbFirst.
+template <typename Order>
+class BitReaderT {
+  static_assert(std::is_same_v<Order, MsbFirst> ||
+                    std::is_same_v<Order, LsbFirst>,
+                "Order must be MsbFirst or LsbFirst");
+
+ public:
+  /// @brief Construct a reader over an existing buffer.
+  /// @param data Pointer to the beginning of the buffer.
+  /// @param size Size of the buffer in bytes.
+  BitReaderT(const void* data, size_t size)
+      : begin_(static_cast<const uint8_t*>(data)),
+        p_(begin_),
+        end_(begin_ + size) {}
+
+  /// @brief Construct a reader over a @c uint8_t buffer; unlike the @c void*
+  ///        overload, this one is usable in constant expressions.
+  template <typename Byte,
+            typename = std::enable_if_t<std::is_same_v<Byte, uint8_t>>>
+  BIO_CONSTEXPR20 BitReaderT(const Byte* data, size_t size)
+      : begin_(data), p_(data), end_(data + size) {}
+
+  /// @brief Return the number of bits remaining to be read.
+  BIO_CONSTEXPR20 size_t remaining_bits() const {
+    return bits_ + 8 * static_cast<size_t>(end_ - p_);
+  }
+
+  /// @brief Return the number of bits consumed so far.
+  BIO_CONSTEXPR20 size_t position_bits() const {
+    return 8 * static_cast<size_t>(p_ - begin_) - bits_;
+  }
+
+  /// @brief Return the number of bytes touched so far, counting a partially
+  ///        consumed byte as whole.
+  BIO_CONSTEXPR20 size_t position_bytes() const {
+    return (position_bits() + 7) / 8;
+  }
+
+  /// @brief Read a field of @p width bits.
+  /// @param width Field width, 1 to 64 and at most the width of @p T.
+  /// @param[out] out Receives the field on success.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if
+  ///         fewer than @p width bits remain.
+  template <typename T>
+  BIO_CONSTEXPR20 Status read_bits(unsigned width, T& out) {
+    if (width > bits_) {
+      refill();
+      if (width > remaining_bits())
+        return Status::OutOfRange(position_bits() / 8);
+    }
+    out = Cast<T>(take_bits(width), width);
+    return Status::Ok();
+  }
+
+  /// @brief Skip @p count bits.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if
+  ///         fewer than @p count bits remain.
+  BIO_CONSTEXPR20 Status skip_bits(size_t count) {
+    if (count > remaining_bits())
+      return Status::OutOfRange(position_bits() / 8);
+    if (count <= bits_) {
+      drop(static_cast<unsigned>(count));
+      return Status::Ok();
+    }
+    count -= bits_;
+    acc_ = 0;
+    bits_ = 0;
+    p_ += count / 8;
+    drop_after_refill(static_cast<unsigned>(count % 8));
+    return Status::Ok();
+  }
+
+  /// @brief Skip to the next byte boundary.
+  BIO_CONSTEXPR20 void align() { drop(bits_ % 8); }
+
+  /// @name Unchecked access
+  ///
+  /// For a run of fields whose total width is known up front: call
+  /// @ref ensure_bits() once, then @ref take_bits() for every field.
+  /// @{
+
+  /// @brief Check that at least @p count bits remain.
+  BIO_CONSTEXPR20 Status ensure_bits(size_t count) const {
+    if (count > remaining_bits())
+      return Status::OutOfRange(position_bits() / 8);
+    return Status::Ok();
+  }
+
+  /// @brief Extract the next @p width bits without a bounds check.
+  /// @param width Field width, 1 to 64.
+  /// @return The field, zero-extended.
+  /// @pre @p width <= remaining_bits().
+  BIO_CONSTEXPR20 uint64_t take_bits(unsigned width) {
+    if (width > kMaxTake) {
+      if constexpr (std::is_same_v<Order, MsbFirst>) {
+        const uint64_t hi = take_bits(width - 32);
+        return (hi << 32) | take_bits(32);
+      } else {
+        const uint64_t lo = take_bits(32);
+        return lo | (take_bits(width - 32) << 32);
+      }
+    }
+    if (width > bits_) refill();
+    uint64_t v;
+    if constexpr (std::is_same_v<Order, MsbFirst>) {
+      v = acc_ >> (64 - width);
+      acc_ <<= width;
+    } else {
+      v = acc_ & (~uint64_t{0} >> (64 - width));
+      acc_ >>= width;
+    }
+    bits_ -= width;
+    return v;
+  }
+
+  /// @}
+
+ private:
+  /// Widest field a single refill guarantees.
+  static constexpr unsigned kMaxTake = 56;
+
+  /// @brief Top the accumulator up to at least 56 bits if data remains.
+  ///
+  /// The fast path ORs in a whole 64-bit word and advances by the number of
+  /// whole bytes that fit. Bits past @c bits_ may then hold the start of the
+  /// next byte; the next refill ORs the same value into the same place.
+  BIO_CONSTEXPR20 void refill() {
+    if (end_ - p_ >= 8) {
+      if constexpr (std::is_same_v<Order, MsbFirst>) {
+        acc_ |= BigEndianCodec::LoadU64(p_) >> bits_;
+      } else {
+        acc_ |= LittleEndianCodec::LoadU64(p_) << bits_;
+      }
+      p_ += (63 - bits_) >> 3;
+      bits_ |= 56;
+      return;
+    }
+    while (bits_ <= 56 && p_ != end_) {
+      if constexpr (std::is_same_v<Order, MsbFirst>) {
+        acc_ |= static_cast<uint64_t>(*p_++) << (56 - bits_);
+      } else {
+        acc_ |= static_cast<uint64_t>(*p_++) << bits_;
+      }
+      bits_ += 8;
+    }
+  }
+
+  /// @brief Discard @p count buffered bits.
+  /// @pre @p count <= bits_ and @p count < 64.
+  BIO_CONSTEXPR20 void drop(unsigned count) {
+    if constexpr (std::is_same_v<Order, MsbFirst>) {
+      acc_ <<= count;
+    } else {
+      acc_ >>= count;
+    }
+    bits_ -= count;
+  }
+
+  BIO_CONSTEXPR20 void drop_after_refill(unsigned count) {
+    if (count == 0) return;
+    refill();
+    drop(count);
+  }
+
+  template <typename T>
+  static BIO_CONSTEXPR20 T Cast(uint64_t v, unsigned width) {
+    if constexpr (std::is_same_v<T, bool>) {
+      return v != 0;
+    } else if constexpr (std::is_enum_v<T>) {
+      return static_cast<T>(v);
+    } else {
+      static_assert(std::is_integral_v<T>, "field type must be integral");
+      if constexpr (std::is_signed_v<T>) {
+        const uint64_t sign = uint64_t{1} << (width - 1);
+        v = (v ^ sign) - sign;
+      }
+      return static_cast<T>(v);
+    }
+  }
+
+  const uint8_t* begin_;  ///< Start of the buffer.
+  const uint8_t* p_;      ///< Next byte to load into the accumulator.
+  const uint8_t* end_;    ///< End of the buffer.
+  uint64_t acc_ = 0;      ///< Buffered bits, next bit first.
+  unsigned bits_ = 0;     ///< Number of valid bits in @c acc_.
+};
+
+/// @brief Writer for densely packed bit fields.
+///
+/// Collects fields in a 64-bit accumulator and stores whole bytes once it
+/// fills. Call @ref flush() after the last field to zero-pad and store the
+/// final partial byte; the buffer only holds the complete stream after
+/// that.
+///
+/// @tparam Order Bit-order policy, @ref MsbFirst or @ref LsbFirst.
+template <typename Order>
+class BitWriterT {
+  static_assert(std::is_same_v<Order, MsbFirst> ||
+                    std::is_same_v<Order, LsbFirst>,
+                "Order must be MsbFirst or LsbFirst");
+
+ public:
+  /// @brief Construct a writer over an existing buffer.
+  /// @param data Pointer to the beginning of the buffer.
+  /// @param size Size of the buffer in bytes.
+  BitWriterT(void* data, size_t size)
+      : begin_(static_cast<uint8_t*>(data)), p_(begin_), n_(size) {}
+
+  /// @brief Construct a writer over a @c uint8_t buffer; unlike the @c void*
+  ///        overload, this one is usable in constant expressions.
+  template <typename Byte,
+            typename = std::enable_if_t<std::is_same_v<Byte, uint8_t>>>
+  BIO_CONSTEXPR20 BitWriterT(Byte* data, size_t size)
+      : begin_(data), p_(data), n_(size) {}
+
+  /// @brief Return the number of bits of capacity remaining.
+  BIO_CONSTEXPR20 size_t remaining_bits() const {
+    return 8 * n_ - bits_;
+  }
+
+  /// @brief Return the number of bits written so far.
+  BIO_CONSTEXPR20 size_t position_bits() const {
+    return 8 * static_cast<size_t>(p_ - begin_) + bits_;
+  }
+
+  /// @brief Return the number of bytes the stream occupies, counting a
+  ///        partial final byte as whole.
+  BIO_CONSTEXPR20 size_t position_bytes() const {
+    return (position_bits() + 7) / 8;
+  }
+
+  /// @brief Write the low @p width bits of @p value.
+  /// @param width Field width, 1 to 64; higher bits of @p value are ignored.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if
+  ///         fewer than @p width bits of capacity remain.
+  template <typename T>
+  BIO_CONSTEXPR20 Status write_bits(unsigned width, T value) {
+    if (width > remaining_bits())
+      return Status::OutOfRange(position_bits() / 8);
+    put_bits(width, static_cast<uint64_t>(value));
+    return Status::Ok();
+  }
+
+  /// @brief Zero-pad to the next byte boundary and store every pending
+  ///        byte. Further writes start at that boundary.
+  BIO_CONSTEXPR20 void flush() {
+    bits_ = (bits_ + 7) & ~7u;
+    drain();
+  }
+
+  /// @name Unchecked access
+  /// @{
+
+  /// @brief Check that at least @p count bits of capacity remain.
+  BIO_CONSTEXPR20 Status ensure_bits(size_t count) const {
+    if (count > remaining_bits())
+      return Status::OutOfRange(position_bits() / 8);
+    return Status::Ok();
+  }
+
+  /// @brief Append the low @p width bits of @p value without a bounds
+  ///        check.
+  /// @pre @p width <= remaining_bits().
+  BIO_CONSTEXPR20 void put_bits(unsigned width, uint64_t value) {
+    if (width > kMaxPut) {
+      if constexpr (std::is_same_v<Order, MsbFirst>) {
+        put_bits(width - 32, value >> 32);
+        put_bits(32, value);
+      } else {
+        put_bits(32, value);
+        put_bits(width - 32, value >> 32);
+      }
+      return;
+    }
+    value &= ~uint64_t{0} >> (64 - width);
+    if (bits_ + width > 64) drain();
+    if constexpr (std::is_same_v<Order, MsbFirst>) {
+      acc_ |= value << (64 - bits_ - width);
+    } else {
+      acc_ |= value << bits_;
+    }
+    bits_ += width;
+  }
+
+  /// @}
+
+ private:
+  /// Widest field appended without a split.
+  static constexpr unsigned kMaxPut = 56;
+
+  /// @brief Store all whole bytes of the accumulator.
+  BIO_CONSTEXPR20 void drain() {
+    for (; bits_ >= 8; bits_ -= 8, --n_) {
+      if constexpr (std::is_same_v<Order, MsbFirst>) {
+        *p_++ = static_cast<uint8_t>(acc_ >> 56);
+        acc_ <<= 8;
+      } else {
+        *p_++ = static_cast<uint8_t>(acc_);
+        acc_ >>= 8;
+      }
+    }
+  }
+
+  uint8_t* begin_;     ///< Start of the buffer.
+  uint8_t* p_;         ///< Next byte to store.
+  size_t n_;           ///< Bytes not yet stored.
+  uint64_t acc_ = 0;   ///< Pending bits, first bit first.
+  unsigned bits_ = 0;  ///< Number of pending bits in @c acc_.
 };
 
 using LEReader = ByteReaderT<LittleEndianCodec>;
 using BEReader = ByteReaderT<BigEndianCodec>;
+using LEChunkedReader = ChunkedReaderT<LittleEndianCodec>;
+using BEChunkedReader = ChunkedReaderT<BigEndianCodec>;
 using LEWriter = ByteWriterT<LittleEndianCodec>;
 using BEWriter = ByteWriterT<BigEndianCodec>;
+using DynamicLEWriter = DynamicByteWriterT<LittleEndianCodec>;
+using DynamicBEWriter = DynamicByteWriterT<BigEndianCodec>;
+using LESizeCounter = SizeCounterT<LittleEndianCodec>;
+using BESizeCounter = SizeCounterT<BigEndianCodec>;
+using MsbBitReader = BitReaderT<MsbFirst>;
+using LsbBitReader = BitReaderT<LsbFirst>;
+using MsbBitWriter = BitWriterT<MsbFirst>;
+using LsbBitWriter = BitWriterT<LsbFirst>;
 
 }  // namespace bio
 
@@ -0,0 +1,706 @@
+// Copyright (c) 2026 Julian Gottwald
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+/// @file checksum.hpp
+/// @brief CRC-32 checksums and checksumming reader/writer adapters.
+///
+/// Two CRC-32 variants are provided, both reflected with an all-ones initial
+/// value and final XOR:
+/// - @ref crc32(): polynomial 0x04C11DB7 (ISO-HDLC), as used by ZIP, gzip,
+///   PNG and Ethernet.
+/// - @ref crc32c(): Castagnoli polynomial 0x1EDC6F41, as used by iSCSI,
+///   SCTP, ext4 and many storage formats.
+///
+/// The portable implementation is slicing-by-8. Hardware paths are selected
+/// at compile time, like the byte-swap kernels in binary-io.hpp:
+/// - SSE4.2 @c crc32 instruction for CRC-32C (@c -msse4.2).
+/// - PCLMULQDQ carry-less folding for CRC-32 (@c -mpclmul @c -msse4.1).
+/// - ARMv8 CRC instructions for both (@c -march=armv8-a+crc).
+///
+/// @ref ChecksumReaderT and @ref ChecksumWriterT fold the bytes they pass
+/// into a running checksum, so the wire data is checksummed while it is
+/// still in cache instead of in a second pass.
+
+#ifndef BINARYIO_CHECKSUM_HPP_
+#define BINARYIO_CHECKSUM_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "binary-io/binary-io.hpp"
+
+#if defined(__SSE4_2__)
+#define BIO_CRC_SSE42 1
+#endif
+#if defined(__PCLMUL__) && defined(__SSE4_1__)
+#define BIO_CRC_PCLMUL 1
+#endif
+#if defined(__ARM_FEATURE_CRC32)
+#define BIO_CRC_ARMV8 1
+#endif
+
+#if defined(BIO_CRC_SSE42)
+#include <nmmintrin.h>
+#endif
+#if defined(BIO_CRC_PCLMUL)
+#include <smmintrin.h>
+#include <wmmintrin.h>
+#endif
+#if defined(BIO_CRC_ARMV8)
+#include <arm_acle.h>
+#endif
+
+namespace bio {
+
+namespace detail {
+
+/// @brief Slicing-by-8 tables for a reflected CRC-32 polynomial.
+///
+/// Row 0 is the classic byte-at-a-time table; row @c k advances a byte
+/// through @c k further zero bytes, so eight rows consume eight input bytes
+/// per step.
+template <uint32_t kPoly>
+struct Crc32Tables {
+  static constexpr std::array<std::array<uint32_t, 256>, 8> Make() {
+    std::array<std::array<uint32_t, 256>, 8> t{};
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t crc = i;
+      for (int bit = 0; bit < 8; ++bit) {
+        crc = (crc >> 1) ^ ((crc & 1u) != 0 ? kPoly : 0u);
+      }
+      t[0][i] = crc;
+    }
+    for (size_t k = 1; k < 8; ++k) {
+      for (size_t i = 0; i < 256; ++i) {
+        t[k][i] = (t[k - 1][i] >> 8) ^ t[0][t[k - 1][i] & 0xFFu];
+      }
+    }
+    return t;
+  }
+
+  static constexpr std::array<std::array<uint32_t, 256>, 8> kTable = Make();
+};
+
+/// @brief Reflected CRC-32 polynomials.
+inline constexpr uint32_t kCrc32Poly = 0xEDB88320u;
+inline constexpr uint32_t kCrc32cPoly = 0x82F63B78u;
+
+/// @brief Advance the raw (pre-inverted) CRC @p crc over @p n bytes.
+template <uint32_t kPoly>
+inline uint32_t Crc32Slice8(uint32_t crc, const uint8_t* p, size_t n) {
+  const auto& t = Crc32Tables<kPoly>::kTable;
+  for (; n >= 8; p += 8, n -= 8) {
+    const uint32_t lo = LittleEndianCodec::LoadU32(p) ^ crc;
+    const uint32_t hi = LittleEndianCodec::LoadU32(p + 4);
+    crc = t[7][lo & 0xFFu] ^ t[6][(lo >> 8) & 0xFFu] ^
+          t[5][(lo >> 16) & 0xFFu] ^ t[4][lo >> 24] ^ t[3][hi & 0xFFu] ^
+          t[2][(hi >> 8) & 0xFFu] ^ t[1][(hi >> 16) & 0xFFu] ^ t[0][hi >> 24];
+  }
+  for (; n != 0; ++p, --n) {
+    crc = t[0][(crc ^ *p) & 0xFFu] ^ (crc >> 8);
+  }
+  return crc;
+}
+
+#if defined(BIO_CRC_PCLMUL)
+/// @brief Fold @p n bytes into the raw CRC-32 @p crc with PCLMULQDQ.
+///
+/// Four 128-bit lanes are folded 64 bytes at a time, reduced to one lane,
+/// then to 32 bits with a Barrett reduction. The constants are
+/// x^(k) mod P(x) for the reflected ISO-HDLC polynomial, following Intel's
+/// "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ".
+///
+/// @pre @p n >= 64 and @p n is a multiple of 16.
+inline uint32_t Crc32Pclmul(uint32_t crc, const uint8_t* p, size_t n) {
+  const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+  const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+  const __m128i k5k0 = _mm_set_epi64x(0, 0x0163cd6124);
+  const __m128i poly = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+  const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+
+  const auto load = [](const uint8_t* q) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(q));
+  };
+  const auto fold = [](__m128i x, __m128i k, __m128i next) {
+    const __m128i lo = _mm_clmulepi64_si128(x, k, 0x00);
+    const __m128i hi = _mm_clmulepi64_si128(x, k, 0x11);
+    return _mm_xor_si128(_mm_xor_si128(hi, lo), next);
+  };
+
+  __m128i x1 = _mm_xor_si128(load(p), _mm_cvtsi32_si128(static_cast<int>(crc)));
+  __m128i x2 = load(p + 16);
+  __m128i x3 = load(p + 32);
+  __m128i x4 = load(p + 48);
+  p += 64;
+  n -= 64;
+  for (; n >= 64; p += 64, n -= 64) {
+    x1 = fold(x1, k1k2, load(p));
+    x2 = fold(x2, k1k2, load(p + 16));
+    x3 = fold(x3, k1k2, load(p + 32));
+    x4 = fold(x4, k1k2, load(p + 48));
+  }
+  x1 = fold(x1, k3k4, x2);
+  x1 = fold(x1, k3k4, x3);
+  x1 = fold(x1, k3k4, x4);
+  for (; n >= 16; p += 16, n -= 16) {
+    x1 = fold(x1, k3k4, load(p));
+  }
+
+  // 128 -> 64 bits.
+  __m128i x = _mm_xor_si128(_mm_srli_si128(x1, 8),
+                            _mm_clmulepi64_si128(x1, k3k4, 0x10));
+  // 64 -> 32 bits.
+  x = _mm_xor_si128(
+      _mm_srli_si128(x, 4),
+      _mm_clmulepi64_si128(_mm_and_si128(x, mask32), k5k0, 0x00));
+  // Barrett reduction.
+  __m128i t = _mm_clmulepi64_si128(_mm_and_si128(x, mask32), poly, 0x10);
+  t = _mm_clmulepi64_si128(_mm_and_si128(t, mask32), poly, 0x00);
+  return static_cast<uint32_t>(_mm_extract_epi32(_mm_xor_si128(x, t), 1));
+}
+#endif
+
+/// @brief Advance the raw CRC-32 @p crc over @p n bytes.
+inline uint32_t Crc32Update(uint32_t crc, const uint8_t* p, size_t n) {
+#if defined(BIO_CRC_ARMV8)
+  for (; n >= 8; p += 8, n -= 8) {
+    crc = __crc32d(crc, LittleEndianCodec::LoadU64(p));
+  }
+  for (; n != 0; ++p, --n) crc = __crc32b(crc, *p);
+  return crc;
+#else
+#if defined(BIO_CRC_PCLMUL)
+  if (n >= 64) {
+    const size_t bulk = n & ~size_t{15};
+    crc = Crc32Pclmul(crc, p, bulk);
+    p += bulk;
+    n -= bulk;
+  }
+#endif
+  return Crc32Slice8<kCrc32Poly>(crc, p, n);
+#endif
+}
+
+/// @brief Advance the raw CRC-32C @p crc over @p n bytes.
+inline uint32_t Crc32cUpdate(uint32_t crc, const uint8_t* p, size_t n) {
+#if defined(BIO_CRC_ARMV8)
+  for (; n >= 8; p += 8, n -= 8) {
+    crc = __crc32cd(crc, LittleEndianCodec::LoadU64(p));
+  }
+  for (; n != 0; ++p, --n) crc = __crc32cb(crc, *p);
+  return crc;
+#elif defined(BIO_CRC_SSE42) && (defined(__x86_64__) || defined(_M_X64))
+  uint64_t wide = crc;
+  for (; n >= 8; p += 8, n -= 8) {
+    wide = _mm_crc32_u64(wide, LittleEndianCodec::LoadU64(p));
+  }
+  crc = static_cast<uint32_t>(wide);
+  for (; n != 0; ++p, --n) crc = _mm_crc32_u8(crc, *p);
+  return crc;
+#elif defined(BIO_CRC_SSE42)
+  for (; n >= 4; p += 4, n -= 4) {
+    crc = _mm_crc32_u32(crc, LittleEndianCodec::LoadU32(p));
+  }
+  for (; n != 0; ++p, --n) crc = _mm_crc32_u8(crc, *p);
+  return crc;
+#else
+  return Crc32Slice8<kCrc32cPoly>(crc, p, n);
+#endif
+}
+
+}  // namespace detail
+
+/// @brief Compute or continue a CRC-32 (ISO-HDLC) over @p size bytes.
+/// @param data Bytes to checksum; may be null if @p size is 0.
+/// @param size Number of bytes.
+/// @param crc Result of a previous call to continue a checksum in pieces;
+///            0 to start a new one.
+/// @return Updated checksum.
+inline uint32_t crc32(const void* data, size_t size, uint32_t crc = 0) {
+  return ~detail::Crc32Update(~crc, static_cast<const uint8_t*>(data), size);
+}
+
+/// @brief Compute or continue a CRC-32C (Castagnoli) over @p size bytes.
+/// @param data Bytes to checksum; may be null if @p size is 0.
+/// @param size Number of bytes.
+/// @param crc Result of a previous call to continue a checksum in pieces;
+///            0 to start a new one.
+/// @return Updated checksum.
+inline uint32_t crc32c(const void* data, size_t size, uint32_t crc = 0) {
+  return ~detail::Crc32cUpdate(~crc, static_cast<const uint8_t*>(data), size);
+}
+
+/// @brief Running CRC-32 (ISO-HDLC) state for @ref ChecksumReaderT and
+///        @ref ChecksumWriterT.
+///
+/// A checksum policy provides @c value_type, @c update(data, size),
+/// @c value() and @c reset().
+class Crc32 {
+ public:
+  using value_type = uint32_t;  ///< Checksum type.
+
+  /// @brief Fold @p size bytes into the checksum.
+  void update(const void* data, size_t size) {
+    crc_ = detail::Crc32Update(crc_, static_cast<const uint8_t*>(data), size);
+  }
+
+  /// @brief Return the checksum of all bytes folded so far.
+  uint32_t value() const { return ~crc_; }
+
+  /// @brief Start over with an empty checksum.
+  void reset() { crc_ = ~uint32_t{0}; }
+
+ private:
+  uint32_t crc_ = ~uint32_t{0};  ///< Raw, pre-inverted register.
+};
+
+/// @brief Running CRC-32C (Castagnoli) state; see @ref Crc32.
+class Crc32c {
+ public:
+  using value_type = uint32_t;  ///< Checksum type.
+
+  /// @brief Fold @p size bytes into the checksum.
+  void update(const void* data, size_t size) {
+    crc_ = detail::Crc32cUpdate(crc_, static_cast<const uint8_t*>(data), size);
+  }
+
+  /// @brief Return the checksum of all bytes folded so far.
+  uint32_t value() const { return ~crc_; }
+
+  /// @brief Start over with an empty checksum.
+  void reset() { crc_ = ~uint32_t{0}; }
+
+ private:
+  uint32_t crc_ = ~uint32_t{0};  ///< Raw, pre-inverted register.
+};
+
+/// @brief @ref ByteReaderT that checksums every byte it consumes.
+///
+/// Reads behave exactly like @ref ByteReaderT. Consumed bytes, including
+/// skipped ones, are folded into the checksum in batches of at least
+/// @ref kFoldBytes, so scalar reads only pay for a comparison and bulk reads
+/// are checksummed right after they were copied, while still in cache.
+/// @ref checksum() folds whatever is pending.
+///
+/// @code
+///   bio::ChecksumReaderT<bio::LittleEndianCodec> reader(data, size);
+///   // ... parse the payload ...
+///   if (!reader.verify_checksum()) { ... }  // stored u32 follows payload
+/// @endcode
+///
+/// @tparam Codec Byte-order codec (e.g. @ref LittleEndianCodec,
+///               @ref BigEndianCodec).
+/// @tparam Checksum Checksum policy, e.g. @ref Crc32 or @ref Crc32c.
+template <typename Codec, typename Checksum = Crc32>
+class ChecksumReaderT {
+ public:
+  using codec_type = Codec;  ///< Byte-order codec of this reader.
+
+  /// @brief Pending bytes that trigger a fold.
+  static constexpr size_t kFoldBytes = 64;
+
+  /// @brief Construct a reader over an existing buffer.
+  /// @param data Pointer to the beginning of the buffer.
+  /// @param size Size of the buffer in bytes.
+  /// @param checksum Initial checksum state, e.g. to continue a checksum
+  ///                 that started in an earlier buffer.
+  ChecksumReaderT(const void* data, size_t size, Checksum checksum = {})
+      : reader_(data, size),
+        data_(static_cast<const uint8_t*>(data)),
+        checksum_(checksum) {}
+
+  /// @brief Return the checksum of all bytes consumed so far.
+  typename Checksum::value_type checksum() {
+    fold();
+    return checksum_.value();
+  }
+
+  /// @brief Restart the checksum at the current position.
+  void reset_checksum() {
+    checksum_.reset();
+    folded_ = reader_.position();
+  }
+
+  /// @brief Read a stored checksum and compare it with @ref checksum() of
+  ///        the bytes before it.
+  /// @return @ref Status::Ok() on a match, @ref Status::ChecksumMismatch() at
+  ///         the stored value's position otherwise, or @ref
+  ///         Status::OutOfRange() if it is truncated.
+  Status verify_checksum() {
+    static_assert(sizeof(typename Checksum::value_type) == 4,
+                  "verify_checksum() reads a 32-bit checksum");
+    const size_t at = position();
+    const uint32_t computed = checksum();
+    uint32_t stored = 0;
+    const Status s = read_u32(stored);
+    if (!s) return s;
+    if (stored != computed) return Status::ChecksumMismatch(at);
+    return Status::Ok();
+  }
+
+  /// @brief Return the number of bytes remaining to be read.
+  size_t remaining() const { return reader_.remaining(); }
+
+  /// @brief Return the current read position (bytes consumed so far).
+  size_t position() const { return reader_.position(); }
+
+  /// @name Reads
+  /// Same contract as the @ref ByteReaderT methods of the same name.
+  /// @{
+  Status read_u8(uint8_t& out) { return track(reader_.read_u8(out)); }
+  Status read_u16(uint16_t& out) { return track(reader_.read_u16(out)); }
+  Status read_u32(uint32_t& out) { return track(reader_.read_u32(out)); }
+  Status read_u64(uint64_t& out) { return track(reader_.read_u64(out)); }
+  Status read_i8(int8_t& out) { return track(reader_.read_i8(out)); }
+  Status read_i16(int16_t& out) { return track(reader_.read_i16(out)); }
+  Status read_i32(int32_t& out) { return track(reader_.read_i32(out)); }
+  Status read_i64(int64_t& out) { return track(reader_.read_i64(out)); }
+  Status read_f32(float& out) { return track(reader_.read_f32(out)); }
+  Status read_f64(double& out) { return track(reader_.read_f64(out)); }
+  Status read_varuint(uint64_t& out) {
+    return track(reader_.read_varuint(out));
+  }
+  Status read_varint(int64_t& out) { return track(reader_.read_varint(out)); }
+
+  Status read_u8_array(uint8_t* out, size_t count) {
+    return track(reader_.read_u8_array(out, count));
+  }
+  Status read_i8_array(int8_t* out, size_t count) {
+    return track(reader_.read_i8_array(out, count));
+  }
+  Status read_u16_array(uint16_t* out, size_t count) {
+    return track(reader_.read_u16_array(out, count));
+  }
+  Status read_u32_array(uint32_t* out, size_t count) {
+    return track(reader_.read_u32_array(out, count));
+  }
+  Status read_u64_array(uint64_t* out, size_t count) {
+    return track(reader_.read_u64_array(out, count));
+  }
+  Status read_i16_array(int16_t* out, size_t count) {
+    return track(reader_.read_i16_array(out, count));
+  }
+  Status read_i32_array(int32_t* out, size_t count) {
+    return track(reader_.read_i32_array(out, count));
+  }
+  Status read_i64_array(int64_t* out, size_t count) {
+    return track(reader_.read_i64_array(out, count));
+  }
+  Status read_f32_array(float* out, size_t count) {
+    return track(reader_.read_f32_array(out, count));
+  }
+  Status read_f64_array(double* out, size_t count) {
+    return track(reader_.read_f64_array(out, count));
+  }
+
+  Status read_bytes(void* out, size_t len) {
+    return track(reader_.read_bytes(out, len));
+  }
+  Status read_view(ByteView& out, size_t len) {
+    return track(reader_.read_view(out, len));
+  }
+  Status read_string_view(std::string_view& out, size_t len) {
+    return track(reader_.read_string_view(out, len));
+  }
+  Status skip(size_t len) { return track(reader_.skip(len)); }
+  /// @}
+
+  /// @name Unchecked access at constant offsets
+  /// Same contract as the @ref ByteReaderT methods of the same name; bytes
+  /// are checksummed once @ref advance() moves past them.
+  /// @{
+  Status ensure(size_t len) const { return reader_.ensure(len); }
+  void advance(size_t len) {
+    reader_.advance(len);
+    (void)track(Status::Ok());
+  }
+
+  uint8_t load_u8_at(size_t offset) const { return reader_.load_u8_at(offset); }
+  uint16_t load_u16_at(size_t offset) const {
+    return reader_.load_u16_at(offset);
+  }
+  uint32_t load_u32_at(size_t offset) const {
+    return reader_.load_u32_at(offset);
+  }
+  uint64_t load_u64_at(size_t offset) const {
+    return reader_.load_u64_at(offset);
+  }
+  int8_t load_i8_at(size_t offset) const { return reader_.load_i8_at(offset); }
+  int16_t load_i16_at(size_t offset) const {
+    return reader_.load_i16_at(offset);
+  }
+  int32_t load_i32_at(size_t offset) const {
+    return reader_.load_i32_at(offset);
+  }
+  int64_t load_i64_at(size_t offset) const {
+    return reader_.load_i64_at(offset);
+  }
+  float load_f32_at(size_t offset) const {
+    return reader_.load_f32_at(offset);
+  }
+  double load_f64_at(size_t offset) const {
+    return reader_.load_f64_at(offset);
+  }
+  void load_bytes_at(size_t offset, void* out, size_t len) const {
+    reader_.load_bytes_at(offset, out, len);
+  }
+  void load_u16_array_at(size_t offset, uint16_t* out, size_t count) const {
+    reader_.load_u16_array_at(offset, out, count);
+  }
+  void load_u32_array_at(size_t offset, uint32_t* out, size_t count) const {
+    reader_.load_u32_array_at(offset, out, count);
+  }
+  void load_u64_array_at(size_t offset, uint64_t* out, size_t count) const {
+    reader_.load_u64_array_at(offset, out, count);
+  }
+  void load_i16_array_at(size_t offset, int16_t* out, size_t count) const {
+    reader_.load_i16_array_at(offset, out, count);
+  }
+  void load_i32_array_at(size_t offset, int32_t* out, size_t count) const {
+    reader_.load_i32_array_at(offset, out, count);
+  }
+  void load_i64_array_at(size_t offset, int64_t* out, size_t count) const {
+    reader_.load_i64_array_at(offset, out, count);
+  }
+  void load_f32_array_at(size_t offset, float* out, size_t count) const {
+    reader_.load_f32_array_at(offset, out, count);
+  }
+  void load_f64_array_at(size_t offset, double* out, size_t count) const {
+    reader_.load_f64_array_at(offset, out, count);
+  }
+  /// @}
+
+ private:
+  /// @brief Fold pending bytes once enough have accumulated.
+  Status track(Status s) {
+    if (reader_.position() - folded_ >= kFoldBytes) fold();
+    return s;
+  }
+
+  /// @brief Fold every consumed byte not yet in the checksum.
+  void fold() {
+    const size_t pos = reader_.position();
+    checksum_.update(data_ + folded_, pos - folded_);
+    folded_ = pos;
+  }
+
+  ByteReaderT<Codec> reader_;  ///< Underlying reader.
+  const uint8_t* data_;        ///< Start of the buffer.
+  size_t folded_ = 0;          ///< Bytes already in the checksum.
+  Checksum checksum_;          ///< Running checksum.
+};
+
+/// @brief @ref ByteWriterT that checksums every byte it commits.
+///
+/// Writes behave exactly like @ref ByteWriterT. Committed bytes are folded
+/// into the checksum in batches of at least @ref kFoldBytes; bytes passed
+/// with @ref skip() are checksummed with whatever the buffer holds. Bytes
+/// behind the cursor must therefore not be changed afterwards.
+///
+/// @tparam Codec Byte-order codec (e.g. @ref LittleEndianCodec,
+///               @ref BigEndianCodec).
+/// @tparam Checksum Checksum policy, e.g. @ref Crc32 or @ref Crc32c.
+template <typename Codec, typename Checksum = Crc32>
+class ChecksumWriterT {
+ public:
+  using codec_type = Codec;  ///< Byte-order codec of this writer.
+
+  /// @brief Pending bytes that trigger a fold.
+  static constexpr size_t kFoldBytes = 64;
+
+  /// @brief Construct a writer over an existing buffer.
+  /// @param data Pointer to the beginning of the buffer.
+  /// @param size Size of the buffer in bytes.
+  /// @param checksum Initial checksum state.
+  ChecksumWriterT(void* data, size_t size, Checksum checksum = {})
+      : writer_(data, size),
+        data_(static_cast<const uint8_t*>(data)),
+        checksum_(checksum) {}
+
+  /// @brief Return the checksum of all bytes written so far.
+  typename Checksum::value_type checksum() {
+    fold();
+    return checksum_.value();
+  }
+
+  /// @brief Restart the checksum at the current position.
+  void reset_checksum() {
+    checksum_.reset();
+    folded_ = writer_.position();
+  }
+
+  /// @brief Return the number of bytes of capacity remaining.
+  size_t remaining() const { return writer_.remaining(); }
+
+  /// @brief Return the current write position (bytes written so far).
+  size_t position() const { return writer_.position(); }
+
+  /// @name Writes
+  /// Same contract as the @ref ByteWriterT methods of the same name.
+  /// @{
+  Status write_u8(uint8_t v) { return track(writer_.write_u8(v)); }
+  Status write_u16(uint16_t v) { return track(writer_.write_u16(v)); }
+  Status write_u32(uint32_t v) { return track(writer_.write_u32(v)); }
+  Status write_u64(uint64_t v) { return track(writer_.write_u64(v)); }
+  Status write_i8(int8_t v) { return track(writer_.write_i8(v)); }
+  Status write_i16(int16_t v) { return track(writer_.write_i16(v)); }
+  Status write_i32(int32_t v) { return track(writer_.write_i32(v)); }
+  Status write_i64(int64_t v) { return track(writer_.write_i64(v)); }
+  Status write_f32(float v) { return track(writer_.write_f32(v)); }
+  Status write_f64(double v) { return track(writer_.write_f64(v)); }
+  Status write_varuint(uint64_t v) {
+    return track(writer_.write_varuint(v));
+  }
+  Status write_varint(int64_t v) { return track(writer_.write_varint(v)); }
+
+  Status write_u8_array(const uint8_t* in, size_t count) {
+    return track(writer_.write_u8_array(in, count));
+  }
+  Status write_i8_array(const int8_t* in, size_t count) {
+    return track(writer_.write_i8_array(in, count));
+  }
+  Status write_u16_array(const uint16_t* in, size_t count) {
+    return track(writer_.write_u16_array(in, count));
+  }
+  Status write_u32_array(const uint32_t* in, size_t count) {
+    return track(writer_.write_u32_array(in, count));
+  }
+  Status write_u64_array(const uint64_t* in, size_t count) {
+    return track(writer_.write_u64_array(in, count));
+  }
+  Status write_i16_array(const int16_t* in, size_t count) {
+    return track(writer_.write_i16_array(in, count));
+  }
+  Status write_i32_array(const int32_t* in, size_t count) {
+    return track(writer_.write_i32_array(in, count));
+  }
+  Status write_i64_array(const int64_t* in, size_t count) {
+    return track(writer_.write_i64_array(in, count));
+  }
+  Status write_f32_array(const float* in, size_t count) {
+    return track(writer_.write_f32_array(in, count));
+  }
+  Status write_f64_array(const double* in, size_t count) {
+    return track(writer_.write_f64_array(in, count));
+  }
+
+  Status write_bytes(const void* in, size_t len) {
+    return track(writer_.write_bytes(in, len));
+  }
+  Status skip(size_t len) { return track(writer_.skip(len)); }
+  /// @}
+
+  /// @name Unchecked access at constant offsets
+  /// Same contract as the @ref ByteWriterT methods of the same name; bytes
+  /// are checksummed once @ref advance() moves past them.
+  /// @{
+  Status ensure(size_t len) { return writer_.ensure(len); }
+  void advance(size_t len) {
+    writer_.advance(len);
+    (void)track(Status::Ok());
+  }
+
+  void store_u8_at(size_t offset, uint8_t v) { writer_.store_u8_at(offset, v); }
+  void store_u16_at(size_t offset, uint16_t v) {
+    writer_.store_u16_at(offset, v);
+  }
+  void store_u32_at(size_t offset, uint32_t v) {
+    writer_.store_u32_at(offset, v);
+  }
+  void store_u64_at(size_t offset, uint64_t v) {
+    writer_.store_u64_at(offset, v);
+  }
+  void store_i8_at(size_t offset, int8_t v) { writer_.store_i8_at(offset, v); }
+  void store_i16_at(size_t offset, int16_t v) {
+    writer_.store_i16_at(offset, v);
+  }
+  void store_i32_at(size_t offset, int32_t v) {
+    writer_.store_i32_at(offset, v);
+  }
+  void store_i64_at(size_t offset, int64_t v) {
+    writer_.store_i64_at(offset, v);
+  }
+  void store_f32_at(size_t offset, float v) { writer_.store_f32_at(offset, v); }
+  void store_f64_at(size_t offset, double v) {
+    writer_.store_f64_at(offset, v);
+  }
+  void store_bytes_at(size_t offset, const void* in, size_t len) {
+    writer_.store_bytes_at(offset, in, len);
+  }
+  void store_u16_array_at(size_t offset, const uint16_t* in, size_t count) {
+    writer_.store_u16_array_at(offset, in, count);
+  }
+  void store_u32_array_at(size_t offset, const uint32_t* in, size_t count) {
+    writer_.store_u32_array_at(offset, in, count);
+  }
+  void store_u64_array_at(size_t offset, const uint64_t* in, size_t count) {
+    writer_.store_u64_array_at(offset, in, count);
+  }
+  void store_i16_array_at(size_t offset, const int16_t* in, size_t count) {
+    writer_.store_i16_array_at(offset, in, count);
+  }
+  void store_i32_array_at(size_t offset, const int32_t* in, size_t count) {
+    writer_.store_i32_array_at(offset, in, count);
+  }
+  void store_i64_array_at(size_t offset, const int64_t* in, size_t count) {
+    writer_.store_i64_array_at(offset, in, count);
+  }
+  void store_f32_array_at(size_t offset, const float* in, size_t count) {
+    writer_.store_f32_array_at(offset, in, count);
+  }
+  void store_f64_array_at(size_t offset, const double* in, size_t count) {
+    writer_.store_f64_array_at(offset, in, count);
+  }
+  /// @}
+
+ private:
+  /// @brief Fold pending bytes once enough have accumulated.
+  Status track(Status s) {
+    if (writer_.position() - folded_ >= kFoldBytes) fold();
+    return s;
+  }
+
+  /// @brief Fold every committed byte not yet in the checksum.
+  void fold() {
+    const size_t pos = writer_.position();
+    checksum_.update(data_ + folded_, pos - folded_);
+    folded_ = pos;
+  }
+
+  ByteWriterT<Codec> writer_;  ///< Underlying writer.
+  const uint8_t* data_;        ///< Start of the buffer.
+  size_t folded_ = 0;          ///< Bytes already in the checksum.
+  Checksum checksum_;          ///< Running checksum.
+};
+
+/// @brief Little-endian @ref ChecksumReaderT computing CRC-32.
+using LECrc32Reader = ChecksumReaderT<LittleEndianCodec, Crc32>;
+/// @brief Big-endian @ref ChecksumReaderT computing CRC-32.
+using BECrc32Reader = ChecksumReaderT<BigEndianCodec, Crc32>;
+/// @brief Little-endian @ref ChecksumWriterT computing CRC-32.
+using LECrc32Writer = ChecksumWriterT<LittleEndianCodec, Crc32>;
+/// @brief Big-endian @ref ChecksumWriterT computing CRC-32.
+using BECrc32Writer = ChecksumWriterT<BigEndianCodec, Crc32>;
+
+}  // namespace bio
+
+#endif  // !BINARYIO_CHECKSUM_HPP_
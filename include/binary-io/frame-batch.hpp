@@ -0,0 +1,289 @@
+// Copyright (c) 2026 Julian Gottwald
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+/// @file frame-batch.hpp
+/// @brief Serialize many length-prefixed frames into one buffer and send
+///        them with a single system call.
+///
+/// This is the writing counterpart of @ref split_frames(), and it takes the
+/// same @ref FrameFormat. Each frame is written in three steps:
+/// - @ref FrameBatchWriterT::begin_frame() reserves the header.
+/// - The payload is serialized through @ref FrameBatchWriterT::writer().
+/// - @ref FrameBatchWriterT::end_frame() fills in the header and backpatches
+///   the payload length. With a checksum policy it also appends a CRC
+///   trailer over the frame.
+///
+/// @ref FrameBatchWriterT::append() does all three steps for a header and
+/// payload struct. Structs from bio-gen need @c --shared-runtime so that they
+/// serialize into a @ref ByteWriterT. Finished frames sit back to back in the
+/// batch buffer. Hand them to the OS in one call:
+/// - On a stream socket or file, write @ref FrameBatchWriterT::view() with
+///   @c write() or @c send().
+/// - On a datagram socket, @ref FrameBatchWriterT::fill_iovecs() yields one
+///   @c iovec per frame for the @c msghdr entries of @c sendmmsg().
+///
+/// @code
+///   // cmd::CommandHeader: sync u16, command u16, payload_size u16.
+///   constexpr bio::FrameFormat kFormat{0, 0, 6, 4, 2};
+///   bio::FrameBatchWriterT<bio::BigEndianCodec> batch(kFormat, 64 * 1024);
+///   for (const cmd::SetSpeedPayload& p : pending) {
+///     const cmd::CommandHeader h{0xAA55, cmd::CommandId::SetSpeed, 0};
+///     if (!batch.append(h, p)) {  // full: send what we have, then retry
+///       send(fd, batch.view().data(), batch.view().size(), 0);
+///       batch.clear();
+///       if (!batch.append(h, p)) { ... }  // larger than the whole buffer
+///     }
+///   }
+/// @endcode
+
+#ifndef BINARYIO_FRAME_BATCH_HPP_
+#define BINARYIO_FRAME_BATCH_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "binary-io/binary-io.hpp"
+#include "binary-io/frame-pipeline.hpp"
+
+#if !defined(_WIN32)
+#include <sys/uio.h>
+#endif
+
+namespace bio {
+
+/// @brief Builds a batch of frames in one owned buffer.
+///
+/// The buffer is allocated once, at construction, and never grows. Frame
+/// pointers therefore stay valid until @ref clear(). A frame that does not
+/// fit fails with @ref Status::OutOfRange() and is discarded, leaving
+/// the finished frames intact. Send them, call @ref clear(), and
+/// serialize the frame again.
+///
+/// The length field counts the payload only, as @ref split_frames()
+/// expects. With a @p Checksum policy, a u32 checksum over the header and
+/// payload follows the payload. A @ref ChecksumReaderT over the frame
+/// checks it with @c verify_checksum() after parsing the payload.
+///
+/// Move-only.
+///
+/// @tparam Codec Byte order of the header fields and the checksum.
+/// @tparam Checksum @c void for no trailer, or a checksum policy such as
+///                  @ref Crc32 or @ref Crc32c from checksum.hpp.
+template <typename Codec, typename Checksum = void>
+class FrameBatchWriterT {
+ public:
+  using codec_type = Codec;                ///< Byte order of the frames.
+  using writer_type = ByteWriterT<Codec>;  ///< Type of @ref writer().
+
+  /// @brief Allocate a batch buffer of @p capacity bytes.
+  /// @param format Header layout. The length field must fit inside the
+  ///               header, and so must the magic if @ref end_frame() is
+  ///               called without a header.
+  FrameBatchWriterT(const FrameFormat& format, size_t capacity)
+      : format_(format),
+        buffer_(capacity),
+        writer_(buffer_.data(), buffer_.size()) {}
+
+  FrameBatchWriterT(const FrameBatchWriterT&) = delete;
+  FrameBatchWriterT& operator=(const FrameBatchWriterT&) = delete;
+  FrameBatchWriterT(FrameBatchWriterT&&) = default;
+  FrameBatchWriterT& operator=(FrameBatchWriterT&&) = default;
+
+  /// @brief Open a frame. The header bytes are reserved, and @ref writer()
+  ///        then appends the payload. A frame that is still open is
+  ///        discarded first.
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if the
+  ///         header does not fit.
+  Status begin_frame() {
+    abort_frame();
+    const Status s = writer_.reserve_bytes(format_.header_size, start_);
+    if (!s) return s;
+    open_ = true;
+    return Status::Ok();
+  }
+
+  /// @brief Return the writer for the payload of the open frame. Its
+  ///        positions are offsets into the batch buffer.
+  writer_type& writer() { return writer_; }
+
+  /// @brief Close the open frame with @p header serialized into its
+  ///        reserved header bytes. The length field is then overwritten
+  ///        with the payload size.
+  /// @tparam Header A type with a @c serialize(Writer&) method, such as a
+  ///                generated struct. It may write fewer bytes than
+  ///                @c header_size; the rest stay zero.
+  /// @return @ref Status::Ok() on success. Otherwise the frame is discarded,
+  ///         and the status is the header's error or
+  ///         @ref Status::OutOfRange() if the payload is too long for the
+  ///         length field or the trailer does not fit.
+  /// @pre A frame is open.
+  template <typename Header>
+  Status end_frame(const Header& header) {
+    writer_type hole(buffer_.data() + start_, format_.header_size);
+    const Status s = header.serialize(hole);
+    if (!s) {
+      abort_frame();
+      return s;
+    }
+    return finish();
+  }
+
+  /// @brief Close the open frame, writing only the magic and the length
+  ///        into its header; other header bytes may be patched through
+  ///        @ref writer() beforehand.
+  /// @return See the overload above.
+  /// @pre A frame is open.
+  Status end_frame() {
+    const Status s =
+        writer_.patch_u32(start_ + format_.magic_offset, format_.magic);
+    if (!s) {
+      abort_frame();
+      return s;
+    }
+    return finish();
+  }
+
+  /// @brief Discard the open frame, if any.
+  void abort_frame() {
+    if (!open_) return;
+    rewind(start_);
+    open_ = false;
+  }
+
+  /// @brief Append one frame: @p payload serialized behind @p header.
+  /// @return @ref Status::Ok() on success; otherwise the frame is discarded.
+  template <typename Header, typename Payload>
+  Status append(const Header& header, const Payload& payload) {
+    Status s = begin_frame();
+    if (!s) return s;
+    s = payload.serialize(writer_);
+    if (!s) {
+      abort_frame();
+      return s;
+    }
+    return end_frame(header);
+  }
+
+  /// @brief Discard every frame, e.g. after the batch was sent.
+  void clear() {
+    rewind(0);
+    frames_.clear();
+    committed_ = 0;
+    open_ = false;
+  }
+
+  /// @brief Return the number of finished frames.
+  size_t frame_count() const { return frames_.size(); }
+
+  /// @brief Return the number of bytes in finished frames.
+  size_t size() const { return committed_; }
+
+  /// @brief Return the size of the batch buffer.
+  size_t capacity() const { return buffer_.size(); }
+
+  /// @brief Whether no frame has been finished.
+  bool empty() const { return frames_.empty(); }
+
+  /// @brief Return the finished frames as one contiguous view, for a single
+  ///        @c write() or @c send().
+  ByteView view() const { return ByteView(buffer_.data(), committed_); }
+
+  /// @brief Return one segment per finished frame, in order.
+  const std::vector<ByteSegment>& frames() const { return frames_; }
+
+#if !defined(_WIN32)
+  /// @brief Point @p out at up to @p max finished frames, starting at frame
+  ///        @p first, one @c iovec per frame.
+  /// @return Number of entries filled.
+  size_t fill_iovecs(iovec* out, size_t max, size_t first = 0) const {
+    size_t n = 0;
+    for (size_t i = first; i < frames_.size() && n < max; ++i, ++n) {
+      out[n].iov_base = const_cast<void*>(frames_[i].data);
+      out[n].iov_len = frames_[i].size;
+    }
+    return n;
+  }
+#endif
+
+ private:
+  /// @brief Backpatch the length, append the trailer and commit the frame.
+  Status finish() {
+    const size_t payload_at = start_ + format_.header_size;
+    const size_t payload = writer_.position() - payload_at;
+    const size_t length_at = start_ + format_.length_offset;
+    Status s = Status::OutOfRange(payload_at);
+    if (payload <= format_.max_payload) {
+      switch (format_.length_size) {
+        case 1:
+          if (payload <= UINT8_MAX) {
+            s = writer_.patch_u8(length_at, static_cast<uint8_t>(payload));
+          }
+          break;
+        case 2:
+          if (payload <= UINT16_MAX) {
+            s = writer_.patch_u16(length_at, static_cast<uint16_t>(payload));
+          }
+          break;
+        default:
+          if (payload <= UINT32_MAX) {
+            s = writer_.patch_u32(length_at, static_cast<uint32_t>(payload));
+          }
+          break;
+      }
+    }
+    if constexpr (!std::is_void_v<Checksum>) {
+      static_assert(sizeof(typename Checksum::value_type) == 4,
+                    "the frame trailer is a 32-bit checksum");
+      if (s) {
+        Checksum checksum;
+        checksum.update(buffer_.data() + start_, writer_.position() - start_);
+        s = writer_.write_u32(checksum.value());
+      }
+    }
+    if (!s) {
+      abort_frame();
+      return s;
+    }
+    frames_.push_back({buffer_.data() + start_, writer_.position() - start_});
+    committed_ = writer_.position();
+    open_ = false;
+    return Status::Ok();
+  }
+
+  /// @brief Move the cursor back to @p pos, which lies in the buffer.
+  void rewind(size_t pos) {
+    writer_ = writer_type(buffer_.data(), buffer_.size());
+    writer_.advance(pos);
+  }
+
+  FrameFormat format_;               ///< Header layout.
+  std::vector<uint8_t> buffer_;      ///< Batch buffer; never reallocated.
+  writer_type writer_;               ///< Cursor into @ref buffer_.
+  std::vector<ByteSegment> frames_;  ///< Finished frames.
+  size_t committed_ = 0;             ///< End of the last finished frame.
+  size_t start_ = 0;                 ///< Start of the open frame.
+  bool open_ = false;                ///< Whether a frame is open.
+};
+
+}  // namespace bio
+
+#endif  // BINARYIO_FRAME_BATCH_HPP_
@@ -0,0 +1,407 @@
+// Copyright (c) 2026 Julian Gottwald
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+/// @file frame-pipeline.hpp
+/// @brief Split a capture buffer into length-prefixed frames and decode them
+///        on several threads.
+///
+/// Capture files are often a run of records, each a fixed-size header with a
+/// magic number and a payload length, followed by the payload. Decoding them
+/// is done in two stages:
+/// - @ref split_frames() walks the headers only, recording where every frame
+///   starts. A header with the wrong magic or an impossible length is treated
+///   as corruption, and the scan resynchronizes on the next occurrence of the
+///   magic.
+/// - @ref decode_frames() hands chunks of those frames to worker threads.
+///   Each frame is decoded through its own reader, and its result is stored
+///   under its frame index, so results come back in capture order.
+///
+/// The split reads a few bytes per frame, so the parallel decode stage carries
+/// almost all of the cost and scales with the number of cores.
+///
+/// @code
+///   // sensor::FrameHeader: magic u32 at 0, payload_length u16 at 11.
+///   constexpr bio::FrameFormat kFormat{0xFEEDFACE, 0, 13, 11, 2};
+///   auto split = bio::split_frames<bio::LittleEndianCodec>(data, kFormat);
+///   std::vector<Record> records;
+///   auto s = bio::decode_frames<sensor::LEReader>(
+///       data, split.frames, records,
+///       [](sensor::LEReader& r, Record& out) { return out.parse(r); });
+/// @endcode
+
+#ifndef BINARYIO_FRAME_PIPELINE_HPP_
+#define BINARYIO_FRAME_PIPELINE_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "binary-io/binary-io.hpp"
+
+namespace bio {
+
+/// @brief Layout of a length-prefixed frame header.
+struct FrameFormat {
+  uint32_t magic = 0;          ///< Value of the u32 at @ref magic_offset.
+  size_t magic_offset = 0;     ///< Offset of the magic within the header.
+  size_t header_size = 0;      ///< Bytes before the payload.
+  size_t length_offset = 0;    ///< Offset of the payload length field.
+  uint8_t length_size = 2;     ///< Width of the length field: 1, 2 or 4.
+  size_t max_payload = SIZE_MAX;  ///< Longer payloads count as corruption.
+};
+
+/// @brief One frame inside a capture buffer, header included.
+struct FrameSpan {
+  size_t offset = 0;
+  size_t size = 0;
+};
+
+/// @brief Result of @ref split_frames().
+struct FrameSplit {
+  std::vector<FrameSpan> frames;
+  size_t skipped = 0;   ///< Bytes before or between frames, in no frame.
+  size_t resyncs = 0;   ///< Number of such corrupt stretches.
+  size_t trailing = 0;  ///< Bytes after the last frame, e.g. a cut-off one.
+};
+
+namespace detail {
+
+/// Run @p fn(worker) for every worker in [0, @p threads), the first one on
+/// the calling thread, and wait for all of them.
+template <typename Fn>
+void RunWorkers(size_t threads, Fn&& fn) {
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  for (size_t t = 1; t < threads; ++t) workers.emplace_back(fn, t);
+  fn(size_t{0});
+  for (auto& worker : workers) worker.join();
+}
+
+inline size_t ResolveThreads(size_t threads) {
+  if (threads != 0) return threads;
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/// The frame walk of @ref split_frames(). The format is copied into members
+/// so the walk keeps it in registers while it appends frames.
+template <typename Codec>
+class FrameWalker {
+ public:
+  FrameWalker(ByteView data, const FrameFormat& format)
+      : base_(data.data()),
+        n_(data.size()),
+        magic_(format.magic),
+        magic_offset_(format.magic_offset),
+        header_size_(format.header_size),
+        length_offset_(format.length_offset),
+        max_payload_(format.max_payload),
+        length_size_(format.length_size) {
+    Codec::StoreU32(pattern_, magic_);
+  }
+
+  /// Take one step from @p pos. If a frame starts there, set @p frame_size
+  /// and move @p pos past it; otherwise set @p frame_size to 0 and move
+  /// @p pos to the next copy of the magic.
+  /// @return @c false when no frame can follow @p pos.
+  bool step(size_t& pos, size_t& frame_size) const {
+    if (n_ - pos < header_size_) return false;
+    const uint8_t* header = base_ + pos;
+    if (Codec::LoadU32(header + magic_offset_) == magic_) {
+      const size_t payload = load_length(header + length_offset_);
+      if (payload <= max_payload_ && payload <= n_ - pos - header_size_) {
+        frame_size = header_size_ + payload;
+        pos += frame_size;
+        return true;
+      }
+    }
+    const size_t from = pos + 1 + magic_offset_;
+    if (from >= n_) return false;
+    const size_t hit = FindBytes(base_ + from, n_ - from, pattern_, 4);
+    if (hit == n_ - from) return false;
+    frame_size = 0;
+    pos += hit + 1;
+    return true;
+  }
+
+  /// Walk from @p pos, appending frames to @p frames, until the walk ends
+  /// or reaches @p limit. @return where it stopped.
+  size_t walk(size_t pos, size_t limit, std::vector<FrameSpan>& frames,
+              bool& ended) const {
+    size_t size = 0;
+    ended = false;
+    while (pos < limit) {
+      if (!step(pos, size)) {
+        ended = true;
+        break;
+      }
+      if (size != 0) frames.push_back({pos - size, size});
+    }
+    return pos;
+  }
+
+ private:
+  size_t load_length(const uint8_t* p) const {
+    switch (length_size_) {
+      case 1:
+        return p[0];
+      case 2:
+        return Codec::LoadU16(p);
+      default:
+        return Codec::LoadU32(p);
+    }
+  }
+
+  const uint8_t* base_;
+  size_t n_;
+  uint32_t magic_;
+  size_t magic_offset_;
+  size_t header_size_;
+  size_t length_offset_;
+  size_t max_payload_;
+  uint8_t length_size_;
+  uint8_t pattern_[4];
+};
+
+/// Fill in the gap statistics of @p split from its frames.
+inline void CountGaps(FrameSplit& split, size_t size) {
+  size_t end = 0;
+  split.skipped = 0;
+  split.resyncs = 0;
+  for (const FrameSpan& f : split.frames) {
+    if (f.offset != end) {
+      split.skipped += f.offset - end;
+      ++split.resyncs;
+    }
+    end = f.offset + f.size;
+  }
+  split.trailing = size - end;
+}
+
+/// Frames handed to a worker at a time: enough to amortize the shared
+/// counter, few enough to balance frames of very different sizes.
+inline constexpr size_t kFramesPerChunk = 256;
+
+/// Smallest slice of the buffer that split_frames() gives its own thread.
+inline constexpr size_t kSplitBytesPerThread = size_t{1} << 20;
+
+}  // namespace detail
+
+/// @brief Find the frames in @p data, replacing the contents of @p split.
+///
+/// A frame is accepted when its magic matches and its payload is at most
+/// @c max_payload bytes and fits in the buffer. Otherwise the scan moves to
+/// the next copy of the magic. It ends when fewer than @c header_size bytes
+/// remain or no later magic exists.
+///
+/// With several @p threads, each one walks its own slice of the buffer,
+/// starting from the first frame it can find there. The slices are then
+/// joined where the walk from the previous slice lands on a frame the next
+/// slice found, so the result is the same as for one thread. A magic that
+/// also appears inside payloads only costs a short serial rewalk at a seam.
+/// Reusing one @p split across buffers keeps its frame storage.
+///
+/// @tparam Codec Byte order of the header fields, e.g. @ref LittleEndianCodec.
+/// @param threads Threads including the caller; 0 picks
+///        @c std::thread::hardware_concurrency(). Each gets at least 1 MiB.
+/// @pre @p format places the magic and the length field inside the header.
+template <typename Codec>
+void split_frames(ByteView data, const FrameFormat& format, FrameSplit& split,
+                  size_t threads = 1) {
+  const detail::FrameWalker<Codec> walker(data, format);
+  const size_t n = data.size();
+  threads = std::max<size_t>(
+      1, std::min(detail::ResolveThreads(threads),
+                  n / detail::kSplitBytesPerThread));
+  if (threads == 1) {
+    std::vector<FrameSpan> frames = std::move(split.frames);
+    frames.clear();
+    bool ended = false;
+    walker.walk(0, n, frames, ended);
+    split.frames = std::move(frames);
+    detail::CountGaps(split, n);
+    return;
+  }
+
+  // Speculative walks, one per slice.
+  struct alignas(64) Slice {
+    std::vector<FrameSpan> frames;
+    size_t end = 0;   // where the walk stopped, at or past the slice
+    bool ended = false;
+  };
+  std::vector<Slice> slices(threads);
+  detail::RunWorkers(threads, [&](size_t t) {
+    Slice& slice = slices[t];
+    slice.end = walker.walk(n * t / threads, n * (t + 1) / threads,
+                            slice.frames, slice.ended);
+  });
+
+  // Continue the true walk into each slice until it meets a frame the slice
+  // found; from there on the slice's frames are the true ones.
+  struct Piece {
+    const FrameSpan* frames;
+    size_t count;
+  };
+  std::vector<Piece> pieces{{slices[0].frames.data(), slices[0].frames.size()}};
+  std::vector<std::vector<FrameSpan>> rewalks(threads);
+  size_t pos = slices[0].end;
+  bool ended = slices[0].ended;
+  for (size_t t = 1; t < threads && !ended; ++t) {
+    const Slice& slice = slices[t];
+    const size_t limit = n * (t + 1) / threads;
+    std::vector<FrameSpan>& rewalk = rewalks[t];
+    size_t i = 0;
+    for (;;) {
+      while (i < slice.frames.size() && slice.frames[i].offset < pos) ++i;
+      if (i < slice.frames.size() && slice.frames[i].offset == pos) {
+        pieces.push_back({rewalk.data(), rewalk.size()});
+        pieces.push_back({slice.frames.data() + i, slice.frames.size() - i});
+        pos = slice.end;
+        ended = slice.ended;
+        break;
+      }
+      if (pos >= limit) {
+        pieces.push_back({rewalk.data(), rewalk.size()});
+        break;
+      }
+      size_t size = 0;
+      if (!walker.step(pos, size)) {
+        pieces.push_back({rewalk.data(), rewalk.size()});
+        ended = true;
+        break;
+      }
+      if (size != 0) rewalk.push_back({pos - size, size});
+    }
+  }
+
+  size_t total = 0;
+  for (const Piece& piece : pieces) total += piece.count;
+  split.frames.resize(total);
+  FrameSpan* out = split.frames.data();
+  std::vector<FrameSpan*> targets;
+  targets.reserve(pieces.size());
+  for (const Piece& piece : pieces) {
+    targets.push_back(out);
+    out += piece.count;
+  }
+  detail::RunWorkers(threads, [&](size_t t) {
+    for (size_t p = t; p < pieces.size(); p += threads) {
+      if (pieces[p].count == 0) continue;
+      std::memcpy(targets[p], pieces[p].frames,
+                  pieces[p].count * sizeof(FrameSpan));
+    }
+  });
+  detail::CountGaps(split, n);
+}
+
+/// @brief Find the frames in @p data; see the overload above.
+template <typename Codec>
+FrameSplit split_frames(ByteView data, const FrameFormat& format,
+                        size_t threads = 1) {
+  FrameSplit split;
+  split_frames<Codec>(data, format, split, threads);
+  return split;
+}
+
+/// @brief Decode every frame of @p frames in parallel, into @p out.
+///
+/// @p out is resized to one element per frame, and element @c i receives
+/// frame @c i. Each call of @p decode gets a fresh @p Reader over exactly one
+/// frame, header included, so the calls share nothing but the input buffer.
+/// Once a frame fails, no chunk of frames after it is started.
+///
+/// @tparam Reader A reader constructible from @c (pointer, size), such as
+///         @ref LEReader or a bio-gen protocol's reader.
+/// @param decode Called as @c decode(reader, out[i]), concurrently from
+///        several threads; returns a Status.
+/// @param threads Worker count including the caller; 0 picks
+///        @c std::thread::hardware_concurrency().
+/// @return Ok, or the failure of the first failing frame in capture order,
+///         with its position translated to an offset into @p data.
+template <typename Reader, typename T, typename Decode>
+auto decode_frames(ByteView data, const std::vector<FrameSpan>& frames,
+                   std::vector<T>& out, Decode&& decode, size_t threads = 0)
+    -> decltype(decode(std::declval<Reader&>(), std::declval<T&>())) {
+  using Result = decltype(decode(std::declval<Reader&>(), std::declval<T&>()));
+  out.resize(frames.size());
+  const size_t chunks =
+      (frames.size() + detail::kFramesPerChunk - 1) / detail::kFramesPerChunk;
+  threads =
+      std::max<size_t>(1, std::min(detail::ResolveThreads(threads), chunks));
+
+  // One cache line per worker so the failure records do not false-share.
+  struct alignas(64) Failure {
+    size_t index = SIZE_MAX;
+    Result status = Result::Ok();
+  };
+  std::vector<Failure> failures(threads);
+  std::atomic<size_t> next_chunk{0};
+  std::atomic<size_t> first_failure{SIZE_MAX};
+
+  // Chunks are claimed in increasing order, so every frame before the first
+  // failure is still decoded and the earliest failure is always found.
+  auto work = [&](Failure& failure) {
+    for (;;) {
+      const size_t begin = next_chunk.fetch_add(1, std::memory_order_relaxed) *
+                           detail::kFramesPerChunk;
+      if (begin >= frames.size() ||
+          begin > first_failure.load(std::memory_order_relaxed)) {
+        return;
+      }
+      const size_t end =
+          std::min(begin + detail::kFramesPerChunk, frames.size());
+      for (size_t i = begin; i < end; ++i) {
+        Reader reader(data.data() + frames[i].offset, frames[i].size);
+        const Result s = decode(reader, out[i]);
+        if (s) continue;
+        if (i < failure.index) {
+          failure.index = i;
+          failure.status = s;
+        }
+        size_t seen = first_failure.load(std::memory_order_relaxed);
+        while (i < seen && !first_failure.compare_exchange_weak(
+                               seen, i, std::memory_order_relaxed)) {
+        }
+        return;
+      }
+    }
+  };
+
+  detail::RunWorkers(threads, [&](size_t t) { work(failures[t]); });
+
+  const Failure* first = &failures[0];
+  for (const Failure& f : failures) {
+    if (f.index < first->index) first = &f;
+  }
+  if (first->index == SIZE_MAX) return Result::Ok();
+  const Result& s = first->status;
+  const size_t position = s.position == Result::kNoPosition
+                              ? Result::kNoPosition
+                              : frames[first->index].offset + s.position;
+  return Result::Failure(s.code, position).in_field(s.field);
+}
+
+}  // namespace bio
+
+#endif  // BINARYIO_FRAME_PIPELINE_HPP_
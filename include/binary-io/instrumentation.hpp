@@ -0,0 +1,292 @@
+// Copyright (c) 2026 Julian Gottwald
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+/// @file instrumentation.hpp
+/// @brief Per-thread decode/encode statistics for instrumented code.
+///
+/// bio-gen run with @c --instrument wraps every @c parse() and
+/// @c serialize(), and every field of structs without a fixed layout, in an
+/// @ref InstrumentProbe. The probe reports to the instrumentation policy of
+/// the reader or writer it is given, which is @ref NoInstrument by default.
+/// Switching a hot path to @ref StatsInstrument turns the probes on:
+/// @code
+///   using ProfiledReader =
+///       bio::ByteReaderT<bio::LittleEndianCodec,
+///                        bio::StatsInstrument<bio::CycleClock>>;
+///   ProfiledReader reader(buf, len);
+///   frame.parse(reader);
+///   ...
+///   for (const bio::SiteStats& s : bio::collect_stats()) {
+///     std::printf("%s %llu calls %llu cycles\n", s.site, ...);
+///   }
+/// @endcode
+///
+/// Each thread writes to its own table of counters. No locks or atomic
+/// read-modify-write operations are involved, so recording costs a few
+/// plain loads and stores. @ref visit_stats() and @ref collect_stats() read
+/// every table while the owning threads keep running. A table outlives its
+/// thread and is reused by the next thread that starts recording, so the
+/// counts are running totals over the process lifetime; scrape twice and
+/// subtract to get a rate.
+
+#ifndef BINARYIO_INSTRUMENTATION_HPP_
+#define BINARYIO_INSTRUMENTATION_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "binary-io/binary-io.hpp"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || \
+    defined(_M_IX86)
+#define BIO_CYCLES_TSC 1
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+#define BIO_CYCLES_CNTVCT 1
+#elif defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || \
+    defined(__ARM_ARCH_8M_MAIN__)
+#define BIO_CYCLES_DWT 1
+#endif
+
+#if defined(BIO_CYCLES_TSC)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#elif !defined(BIO_CYCLES_CNTVCT) && !defined(BIO_CYCLES_DWT)
+#include <chrono>
+#endif
+
+namespace bio {
+
+/// @brief Clock for @ref StatsInstrument that never ticks: calls, bytes and
+///        failures are counted, cycles stay zero.
+struct NullClock {
+  /// @brief Bits of @ref Now() that are significant.
+  static constexpr uint64_t kMask = 0;
+
+  static constexpr uint64_t Now() { return 0; }
+};
+
+/// @brief The cheapest running cycle counter of the target.
+///
+/// - x86: the time-stamp counter (@c rdtsc).
+/// - AArch64: the virtual counter @c cntvct_el0.
+/// - Cortex-M3/M4/M7/M33: @c DWT_CYCCNT. The application must enable it
+///   (@c CoreDebug->DEMCR @c TRCENA and @c DWT->CTRL @c CYCCNTENA). The
+///   counter is 32 bits, so longer intervals wrap.
+/// - Elsewhere: @c std::chrono::steady_clock in nanoseconds.
+struct CycleClock {
+#if defined(BIO_CYCLES_DWT)
+  static constexpr uint64_t kMask = 0xFFFFFFFFu;
+#else
+  static constexpr uint64_t kMask = ~uint64_t{0};
+#endif
+
+  static uint64_t Now() {
+#if defined(BIO_CYCLES_TSC)
+    return __rdtsc();
+#elif defined(BIO_CYCLES_CNTVCT)
+    uint64_t v;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+#elif defined(BIO_CYCLES_DWT)
+    return *reinterpret_cast<const volatile uint32_t*>(0xE0001004u);
+#else
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+#endif
+  }
+};
+
+/// @brief Totals for one probe site.
+struct SiteStats {
+  const char* site;   ///< Site name, e.g. "sensor::FrameHeader::parse".
+  uint64_t calls;     ///< Number of probed calls.
+  uint64_t failures;  ///< Calls that returned a failed @ref Status.
+  uint64_t bytes;     ///< Bytes consumed or produced.
+  uint64_t cycles;    ///< Clock ticks spent, in the policy's clock.
+};
+
+namespace detail {
+
+/// @brief Counters of one site in one thread's table.
+struct StatsSlot {
+  std::atomic<const char*> site{nullptr};
+  std::atomic<uint64_t> calls{0};
+  std::atomic<uint64_t> failures{0};
+  std::atomic<uint64_t> bytes{0};
+  std::atomic<uint64_t> cycles{0};
+};
+
+/// @brief One thread's open-addressed table of sites, keyed by the address
+///        of the site string.
+struct StatsTable {
+  static constexpr size_t kSlots = 256;
+
+  StatsSlot slots[kSlots];
+  std::atomic<uint64_t> dropped{0};  ///< Records that found no free slot.
+  std::atomic<bool> in_use{true};    ///< Owned by a running thread.
+  StatsTable* next = nullptr;        ///< Fixed once the table is published.
+};
+
+/// @brief Every table ever created; tables are never freed.
+inline std::atomic<StatsTable*> g_stats_tables{nullptr};
+
+/// @brief Claim a table released by a finished thread, or publish a new one.
+inline StatsTable* AcquireStatsTable() {
+  for (StatsTable* t = g_stats_tables.load(std::memory_order_acquire); t;
+       t = t->next) {
+    bool idle = false;
+    if (t->in_use.compare_exchange_strong(idle, true,
+                                          std::memory_order_acq_rel)) {
+      return t;
+    }
+  }
+  auto* t = new StatsTable;
+  t->next = g_stats_tables.load(std::memory_order_relaxed);
+  while (!g_stats_tables.compare_exchange_weak(
+      t->next, t, std::memory_order_release, std::memory_order_relaxed)) {
+  }
+  return t;
+}
+
+/// @brief Releases the calling thread's table when the thread exits.
+struct StatsTableOwner {
+  StatsTable* table = AcquireStatsTable();
+  ~StatsTableOwner() { table->in_use.store(false, std::memory_order_release); }
+};
+
+inline StatsTable& LocalStatsTable() {
+  thread_local StatsTableOwner owner;
+  return *owner.table;
+}
+
+/// @brief Add to a counter only the owning thread writes.
+inline void BumpCounter(std::atomic<uint64_t>& counter, uint64_t v) {
+  counter.store(counter.load(std::memory_order_relaxed) + v,
+                std::memory_order_relaxed);
+}
+
+inline void RecordStats(const char* site, size_t bytes, bool ok,
+                        uint64_t cycles) {
+  StatsTable& table = LocalStatsTable();
+  const auto key = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(site));
+  size_t i = static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 56);
+  for (size_t n = 0; n < StatsTable::kSlots; ++n) {
+    StatsSlot& slot = table.slots[i];
+    const char* held = slot.site.load(std::memory_order_relaxed);
+    if (held == nullptr) {
+      slot.site.store(site, std::memory_order_release);
+      held = site;
+    }
+    if (held == site) {
+      BumpCounter(slot.calls, 1);
+      if (!ok) BumpCounter(slot.failures, 1);
+      BumpCounter(slot.bytes, bytes);
+      BumpCounter(slot.cycles, cycles);
+      return;
+    }
+    i = (i + 1) % StatsTable::kSlots;
+  }
+  BumpCounter(table.dropped, 1);
+}
+
+}  // namespace detail
+
+/// @brief Instrumentation policy that aggregates probes into per-thread
+///        tables; read them with @ref visit_stats() or @ref collect_stats().
+/// @tparam Clock @ref NullClock to count only, or @ref CycleClock to also
+///               time every probed call.
+template <typename Clock = NullClock>
+struct StatsInstrument {
+  static constexpr bool kEnabled = true;
+
+  static uint64_t Now() { return Clock::Now(); }
+
+  static void Record(const char* site, size_t bytes, bool ok,
+                     uint64_t cycles) {
+    detail::RecordStats(site, bytes, ok, cycles & Clock::kMask);
+  }
+};
+
+/// @brief Call @p fn with the @ref SiteStats of every site in every
+///        thread's table, unmerged. Safe while other threads record; each
+///        counter is read once, so a snapshot may straddle a record.
+template <typename Fn>
+void visit_stats(Fn&& fn) {
+  for (detail::StatsTable* t =
+           detail::g_stats_tables.load(std::memory_order_acquire);
+       t; t = t->next) {
+    for (const detail::StatsSlot& slot : t->slots) {
+      const char* site = slot.site.load(std::memory_order_acquire);
+      if (site == nullptr) continue;
+      fn(SiteStats{site, slot.calls.load(std::memory_order_relaxed),
+                   slot.failures.load(std::memory_order_relaxed),
+                   slot.bytes.load(std::memory_order_relaxed),
+                   slot.cycles.load(std::memory_order_relaxed)});
+    }
+  }
+}
+
+/// @brief Return the totals of every site over all threads, merged by site
+///        name and sorted by cycles, then calls, in descending order.
+inline std::vector<SiteStats> collect_stats() {
+  std::vector<SiteStats> out;
+  visit_stats([&](const SiteStats& s) {
+    for (SiteStats& o : out) {
+      if (std::string_view(o.site) == s.site) {
+        o.calls += s.calls;
+        o.failures += s.failures;
+        o.bytes += s.bytes;
+        o.cycles += s.cycles;
+        return;
+      }
+    }
+    out.push_back(s);
+  });
+  std::sort(out.begin(), out.end(), [](const SiteStats& a, const SiteStats& b) {
+    if (a.cycles != b.cycles) return a.cycles > b.cycles;
+    return a.calls > b.calls;
+  });
+  return out;
+}
+
+/// @brief Return the number of records lost because a thread's table had
+///        no free slot for a new site.
+inline uint64_t dropped_stats() {
+  uint64_t dropped = 0;
+  for (detail::StatsTable* t =
+           detail::g_stats_tables.load(std::memory_order_acquire);
+       t; t = t->next) {
+    dropped += t->dropped.load(std::memory_order_relaxed);
+  }
+  return dropped;
+}
+
+}  // namespace bio
+
+#endif  // BINARYIO_INSTRUMENTATION_HPP_
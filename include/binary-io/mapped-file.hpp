@@ -0,0 +1,250 @@
+// Copyright (c) 2026 Julian Gottwald
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+/// @file mapped-file.hpp
+/// @brief Read-only memory-mapped files.
+///
+/// @ref MappedFile maps a whole file into the address space (@c mmap on
+/// POSIX, @c CreateFileMapping on Windows) and hands out @ref LEReader /
+/// @ref BEReader instances over it. The pages are backed by the OS page
+/// cache, so any number of readers, in this or other processes, share one
+/// copy of the data. Access-pattern hints and position-driven prefetching
+/// let the kernel read ahead of a sequential parser.
+
+#ifndef BINARYIO_MAPPED_FILE_HPP_
+#define BINARYIO_MAPPED_FILE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "binary-io/binary-io.hpp"
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace bio {
+
+/// @brief Read-only memory mapping of an entire file.
+///
+/// Move-only; the mapping is released by @ref close() or the destructor.
+/// Readers obtained from it point into the mapping and must not outlive it.
+///
+/// @code
+///   bio::MappedFile file;
+///   if (file.open("capture.bin")) {
+///     file.advise(bio::MappedFile::Access::Sequential);
+///     auto reader = file.le_reader();
+///     while (reader.remaining() != 0) {
+///       file.prefetch(reader, 1 << 20);
+///       ...
+///     }
+///   }
+/// @endcode
+class MappedFile {
+ public:
+  /// @brief Expected access pattern, see @ref advise().
+  enum class Access {
+    Normal,      ///< No particular pattern (the default).
+    Sequential,  ///< Front to back; aggressive read-ahead.
+    Random,      ///< Scattered; read-ahead disabled.
+  };
+
+  /// @brief Construct an empty mapping; see @ref open().
+  MappedFile() = default;
+
+  ~MappedFile() { close(); }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  MappedFile(MappedFile&& other) noexcept { take(other); }
+
+  MappedFile& operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+      close();
+      take(other);
+    }
+    return *this;
+  }
+
+  /// @brief Map the file at @p path, replacing any current mapping.
+  ///
+  /// An empty file opens successfully with a null @ref data() and zero
+  /// @ref size().
+  ///
+  /// @return @c true on success. On failure the object is left closed and
+  ///         @c errno (or @c GetLastError() on Windows) describes the cause.
+  bool open(const char* path) {
+    close();
+#if defined(_WIN32)
+    HANDLE file = ::CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    bool ok = ::GetFileSizeEx(file, &size) != 0 &&
+              static_cast<uint64_t>(size.QuadPart) <= SIZE_MAX;
+    if (ok && size.QuadPart != 0) {
+      HANDLE mapping =
+          ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      ok = mapping != nullptr;
+      if (ok) {
+        void* view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        ::CloseHandle(mapping);
+        ok = view != nullptr;
+        data_ = static_cast<const uint8_t*>(view);
+      }
+    }
+    ::CloseHandle(file);
+    if (ok) size_ = static_cast<size_t>(size.QuadPart);
+    return ok;
+#else
+    const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    struct stat st;
+    bool ok = ::fstat(fd, &st) == 0 &&
+              static_cast<uint64_t>(st.st_size) <= SIZE_MAX;
+    if (ok && st.st_size != 0) {
+      void* view = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ,
+                          MAP_SHARED, fd, 0);
+      ok = view != MAP_FAILED;
+      if (ok) data_ = static_cast<const uint8_t*>(view);
+    }
+    ::close(fd);
+    if (ok) size_ = static_cast<size_t>(st.st_size);
+    return ok;
+#endif
+  }
+
+  /// @brief Release the mapping; a no-op when nothing is mapped.
+  void close() {
+    if (data_ != nullptr) {
+#if defined(_WIN32)
+      ::UnmapViewOfFile(data_);
+#else
+      ::munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+    }
+    data_ = nullptr;
+    size_ = 0;
+    prefetched_ = 0;
+  }
+
+  /// @brief Return a pointer to the first mapped byte.
+  const uint8_t* data() const { return data_; }
+
+  /// @brief Return the size of the mapping in bytes.
+  size_t size() const { return size_; }
+
+  /// @brief Return the mapped bytes as a @ref ByteView.
+  ByteView view() const { return ByteView(data_, size_); }
+
+  /// @brief Return a little-endian reader over the whole file.
+  LEReader le_reader() const { return LEReader(data_, size_); }
+
+  /// @brief Return a big-endian reader over the whole file.
+  BEReader be_reader() const { return BEReader(data_, size_); }
+
+  /// @brief Tell the kernel how the mapping will be accessed.
+  ///
+  /// Maps to @c madvise(MADV_NORMAL/SEQUENTIAL/RANDOM). Windows has no
+  /// equivalent for an existing view, so the hint is ignored there.
+  void advise(Access access) const {
+#if !defined(_WIN32)
+    if (data_ == nullptr) return;
+    int advice = MADV_NORMAL;
+    if (access == Access::Sequential) advice = MADV_SEQUENTIAL;
+    if (access == Access::Random) advice = MADV_RANDOM;
+    ::madvise(const_cast<uint8_t*>(data_), size_, advice);
+#else
+    (void)access;
+#endif
+  }
+
+  /// @brief Ask the kernel to start reading @p len bytes at @p offset.
+  ///
+  /// The range is clamped to the mapping. Uses @c madvise(MADV_WILLNEED) on
+  /// POSIX and @c PrefetchVirtualMemory() on Windows 8 and later.
+  void will_need(size_t offset, size_t len) const {
+    if (offset >= size_) return;
+    if (len > size_ - offset) len = size_ - offset;
+    if (len == 0) return;
+#if defined(_WIN32)
+#if defined(_WIN32_WINNT) && _WIN32_WINNT >= 0x0602
+    WIN32_MEMORY_RANGE_ENTRY range;
+    range.VirtualAddress = const_cast<uint8_t*>(data_ + offset);
+    range.NumberOfBytes = len;
+    ::PrefetchVirtualMemory(::GetCurrentProcess(), 1, &range, 0);
+#endif
+#else
+    // madvise() needs a page-aligned start; the mapping itself is aligned.
+    const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    const size_t start = offset - offset % page;
+    ::madvise(const_cast<uint8_t*>(data_ + start), len + (offset - start),
+              MADV_WILLNEED);
+#endif
+  }
+
+  /// @brief Keep @p ahead bytes past @p reader's cursor prefetched.
+  ///
+  /// Intended to be called from a parse loop: a hint is only issued once
+  /// less than half of @p ahead remains hinted, so the per-call cost is a
+  /// comparison. @p reader must have been obtained from @ref le_reader() or
+  /// @ref be_reader(), so that its position is an offset into the file.
+  template <typename Reader>
+  void prefetch(const Reader& reader, size_t ahead) {
+    const size_t pos = reader.position();
+    if (pos >= size_) return;
+    const size_t lead = size_ - pos < ahead ? size_ - pos : ahead;
+    if (prefetched_ >= pos + (lead + 1) / 2) return;
+    const size_t start = prefetched_ > pos ? prefetched_ : pos;
+    will_need(start, pos + lead - start);
+    prefetched_ = pos + lead;
+  }
+
+ private:
+  void take(MappedFile& other) {
+    data_ = other.data_;
+    size_ = other.size_;
+    prefetched_ = other.prefetched_;
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.prefetched_ = 0;
+  }
+
+  const uint8_t* data_ = nullptr;  ///< Start of the mapping.
+  size_t size_ = 0;                ///< Mapping size in bytes.
+  size_t prefetched_ = 0;          ///< End of the last prefetch() hint.
+};
+
+}  // namespace bio
+
+#endif  // !BINARYIO_MAPPED_FILE_HPP_
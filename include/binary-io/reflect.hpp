@@ -0,0 +1,567 @@
+// Copyright (c) 2026 Julian Gottwald
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+/// @file reflect.hpp
+/// @brief Compile-time field descriptors and generic encode / decode.
+///
+/// A struct with a fixed wire layout can describe itself with a
+/// @c static @c constexpr tuple named @c kFields, holding one descriptor per
+/// wire field in wire order, and a @c kWireSize constant:
+/// @code
+///   struct Sample {
+///     uint32_t magic{};
+///     Kind kind{};
+///     std::array<int16_t, 4> values{};
+///
+///     static constexpr size_t kWireSize = 13;
+///     static constexpr auto kFields = std::make_tuple(
+///         bio::Expected<&Sample::magic, bio::WireType::U32, 0, 0xC0DE>{
+///             "magic"},
+///         bio::Field<&Sample::kind, bio::WireType::U8, 4>{"kind"},
+///         bio::Field<&Sample::values, bio::WireType::I16, 5>{"values"});
+///   };
+/// @endcode
+/// Each descriptor names the member, its wire type and its byte offset at
+/// compile time. @ref decode() and @ref encode() fold over the tuple: one
+/// bounds check for the whole struct, then every field is loaded or stored
+/// at its constant offset, so the compiler sees the whole layout and can
+/// merge neighbouring accesses. @ref for_each_field() hands every descriptor
+/// to a callback, for dumps and other generic tooling.
+///
+/// bio-gen emits @c kFields for every fixed-size struct. Types without
+/// @c kFields are passed to their own @c parse() / @c serialize().
+
+#ifndef BINARYIO_REFLECT_HPP_
+#define BINARYIO_REFLECT_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+
+#include "binary-io/binary-io.hpp"
+
+namespace bio {
+
+/// @brief How one element of a described field is stored on the wire.
+enum class WireType : uint8_t {
+  U8,
+  U16,
+  U32,
+  U64,
+  I8,
+  I16,
+  I32,
+  I64,
+  F32,
+  F64,
+  Bytes,    ///< Raw bytes of a @c std::array of @c uint8_t or @c char.
+  Struct,   ///< A nested struct with its own @c kFields.
+  Bits,     ///< Bit slices of an unsigned integer; see @ref Bits.
+  Padding,  ///< Bytes that are skipped on read and not written.
+};
+
+/// @brief @c true if @p T describes its layout with @c kFields.
+template <typename T, typename = void>
+inline constexpr bool kHasFields = false;
+template <typename T>
+inline constexpr bool kHasFields<T, std::void_t<decltype(T::kFields)>> = true;
+
+namespace detail {
+
+template <typename M>
+struct MemberPointer;
+template <typename Owner, typename Value>
+struct MemberPointer<Value Owner::*> {
+  using owner = Owner;
+  using value = Value;
+};
+
+template <typename T>
+struct ArrayTraits {
+  using element_type = T;
+  static constexpr bool kIsArray = false;
+  static constexpr size_t kCount = 1;
+};
+template <typename T, size_t N>
+struct ArrayTraits<std::array<T, N>> {
+  using element_type = T;
+  static constexpr bool kIsArray = true;
+  static constexpr size_t kCount = N;
+};
+
+/// @brief Host type of one element of a scalar wire type.
+template <WireType W>
+struct WireValue {};
+template <>
+struct WireValue<WireType::U8> { using type = uint8_t; };
+template <>
+struct WireValue<WireType::U16> { using type = uint16_t; };
+template <>
+struct WireValue<WireType::U32> { using type = uint32_t; };
+template <>
+struct WireValue<WireType::U64> { using type = uint64_t; };
+template <>
+struct WireValue<WireType::I8> { using type = int8_t; };
+template <>
+struct WireValue<WireType::I16> { using type = int16_t; };
+template <>
+struct WireValue<WireType::I32> { using type = int32_t; };
+template <>
+struct WireValue<WireType::I64> { using type = int64_t; };
+template <>
+struct WireValue<WireType::F32> { using type = float; };
+template <>
+struct WireValue<WireType::F64> { using type = double; };
+template <>
+struct WireValue<WireType::Bytes> { using type = uint8_t; };
+
+template <WireType W>
+using WireValueT = typename WireValue<W>::type;
+
+template <WireType W, typename Reader>
+BIO_CONSTEXPR20 WireValueT<W> LoadWireAt(const Reader& reader, size_t at) {
+  if constexpr (W == WireType::U8) {
+    return reader.load_u8_at(at);
+  } else if constexpr (W == WireType::U16) {
+    return reader.load_u16_at(at);
+  } else if constexpr (W == WireType::U32) {
+    return reader.load_u32_at(at);
+  } else if constexpr (W == WireType::U64) {
+    return reader.load_u64_at(at);
+  } else if constexpr (W == WireType::I8) {
+    return reader.load_i8_at(at);
+  } else if constexpr (W == WireType::I16) {
+    return reader.load_i16_at(at);
+  } else if constexpr (W == WireType::I32) {
+    return reader.load_i32_at(at);
+  } else if constexpr (W == WireType::I64) {
+    return reader.load_i64_at(at);
+  } else if constexpr (W == WireType::F32) {
+    return reader.load_f32_at(at);
+  } else {
+    return reader.load_f64_at(at);
+  }
+}
+
+template <WireType W, typename Writer>
+BIO_CONSTEXPR20 void StoreWireAt(Writer& writer, size_t at, WireValueT<W> v) {
+  if constexpr (W == WireType::U8) {
+    writer.store_u8_at(at, v);
+  } else if constexpr (W == WireType::U16) {
+    writer.store_u16_at(at, v);
+  } else if constexpr (W == WireType::U32) {
+    writer.store_u32_at(at, v);
+  } else if constexpr (W == WireType::U64) {
+    writer.store_u64_at(at, v);
+  } else if constexpr (W == WireType::I8) {
+    writer.store_i8_at(at, v);
+  } else if constexpr (W == WireType::I16) {
+    writer.store_i16_at(at, v);
+  } else if constexpr (W == WireType::I32) {
+    writer.store_i32_at(at, v);
+  } else if constexpr (W == WireType::I64) {
+    writer.store_i64_at(at, v);
+  } else if constexpr (W == WireType::F32) {
+    writer.store_f32_at(at, v);
+  } else {
+    writer.store_f64_at(at, v);
+  }
+}
+
+/// @brief Load @p count elements wider than a byte into @p out.
+template <WireType W, typename Reader, typename T>
+BIO_CONSTEXPR20 void LoadWireArrayAt(const Reader& reader, size_t at, T* out,
+                                     size_t count) {
+  if constexpr (W == WireType::U16) {
+    reader.load_u16_array_at(at, out, count);
+  } else if constexpr (W == WireType::U32) {
+    reader.load_u32_array_at(at, out, count);
+  } else if constexpr (W == WireType::U64) {
+    reader.load_u64_array_at(at, out, count);
+  } else if constexpr (W == WireType::I16) {
+    reader.load_i16_array_at(at, out, count);
+  } else if constexpr (W == WireType::I32) {
+    reader.load_i32_array_at(at, out, count);
+  } else if constexpr (W == WireType::I64) {
+    reader.load_i64_array_at(at, out, count);
+  } else if constexpr (W == WireType::F32) {
+    reader.load_f32_array_at(at, out, count);
+  } else {
+    reader.load_f64_array_at(at, out, count);
+  }
+}
+
+/// @brief Store @p count elements wider than a byte from @p in.
+template <WireType W, typename Writer, typename T>
+BIO_CONSTEXPR20 void StoreWireArrayAt(Writer& writer, size_t at, const T* in,
+                                      size_t count) {
+  if constexpr (W == WireType::U16) {
+    writer.store_u16_array_at(at, in, count);
+  } else if constexpr (W == WireType::U32) {
+    writer.store_u32_array_at(at, in, count);
+  } else if constexpr (W == WireType::U64) {
+    writer.store_u64_array_at(at, in, count);
+  } else if constexpr (W == WireType::I16) {
+    writer.store_i16_array_at(at, in, count);
+  } else if constexpr (W == WireType::I32) {
+    writer.store_i32_array_at(at, in, count);
+  } else if constexpr (W == WireType::I64) {
+    writer.store_i64_array_at(at, in, count);
+  } else if constexpr (W == WireType::F32) {
+    writer.store_f32_array_at(at, in, count);
+  } else {
+    writer.store_f64_array_at(at, in, count);
+  }
+}
+
+/// @brief Convert a raw wire value to the member type @p V, through
+///        @p Decode (an enum's raw-to-enumerator mapping) if one is given.
+template <typename V, auto Decode, typename Raw>
+constexpr V FromWire(Raw raw) {
+  if constexpr (!std::is_null_pointer_v<decltype(Decode)>) {
+    return Decode(raw);
+  } else {
+    return static_cast<V>(raw);
+  }
+}
+
+template <typename T, typename Reader>
+BIO_CONSTEXPR20 Status LoadFields(const Reader& reader, size_t base, T& obj);
+template <typename T, typename Writer>
+BIO_CONSTEXPR20 void StoreFields(Writer& writer, size_t base, const T& obj);
+
+}  // namespace detail
+
+/// @brief A member stored at byte @p Offset of its struct.
+///
+/// Scalars, enums and @c std::array members of them are described by the
+/// wire type of one element; @c std::array<uint8_t|char, N> members may also
+/// use @c WireType::Bytes. Nested structs and arrays of them use
+/// @c WireType::Struct.
+/// @tparam Member Pointer to the data member.
+/// @tparam Wire Wire type of one element.
+/// @tparam Offset Byte offset within the encoded struct.
+/// @tparam Decode Optional @c constexpr function mapping a raw value to an
+///         enum member (for example one generated by bio-gen). Without it
+///         the raw value is @c static_cast.
+template <auto Member, WireType Wire, size_t Offset, auto Decode = nullptr>
+struct Field {
+  using owner_type = typename detail::MemberPointer<decltype(Member)>::owner;
+  using value_type = typename detail::MemberPointer<decltype(Member)>::value;
+  using element_type = typename detail::ArrayTraits<value_type>::element_type;
+
+  static constexpr auto member = Member;
+  static constexpr WireType wire = Wire;
+  static constexpr size_t offset = Offset;
+  /// @brief Elements of an array member, 1 otherwise.
+  static constexpr size_t count = detail::ArrayTraits<value_type>::kCount;
+  /// @brief Encoded size in bytes.
+  static constexpr size_t size = [] {
+    if constexpr (Wire == WireType::Struct) {
+      return count * element_type::kWireSize;
+    } else {
+      return count * sizeof(detail::WireValueT<Wire>);
+    }
+  }();
+
+  const char* name;  ///< Member name.
+  uint16_t id = 0;   ///< @ref Status::field id reported for this field.
+
+  /// @brief Decode this field of @p obj from @p base bytes past the reader's
+  ///        cursor. Bounds are the caller's responsibility.
+  template <typename Reader>
+  BIO_CONSTEXPR20 Status load(const Reader& reader, size_t base,
+                              owner_type& obj) const {
+    auto& dst = obj.*Member;
+    const size_t at = base + Offset;
+    if constexpr (Wire == WireType::Struct) {
+      if constexpr (detail::ArrayTraits<value_type>::kIsArray) {
+        for (size_t i = 0; i < count; ++i) {
+          Status s = detail::LoadFields(
+              reader, at + i * element_type::kWireSize, dst[i]);
+          if (!s) return s;
+        }
+        return Status::Ok();
+      } else {
+        return detail::LoadFields(reader, at, dst);
+      }
+    } else if constexpr (!detail::ArrayTraits<value_type>::kIsArray) {
+      dst = detail::FromWire<value_type, Decode>(
+          detail::LoadWireAt<Wire>(reader, at));
+    } else if constexpr (std::is_enum_v<element_type>) {
+      constexpr size_t step = sizeof(detail::WireValueT<Wire>);
+      for (size_t i = 0; i < count; ++i) {
+        dst[i] = detail::FromWire<element_type, Decode>(
+            detail::LoadWireAt<Wire>(reader, at + i * step));
+      }
+    } else if constexpr (sizeof(element_type) == 1) {
+      reader.load_bytes_at(at, dst.data(), dst.size());
+    } else {
+      detail::LoadWireArrayAt<Wire>(reader, at, dst.data(), dst.size());
+    }
+    return Status::Ok();
+  }
+
+  /// @brief Encode this field of @p obj at @p base bytes past the writer's
+  ///        cursor. Bounds are the caller's responsibility.
+  template <typename Writer>
+  BIO_CONSTEXPR20 void store(Writer& writer, size_t base,
+                             const owner_type& obj) const {
+    const auto& src = obj.*Member;
+    const size_t at = base + Offset;
+    using Raw = detail::WireValueT<Wire == WireType::Struct ? WireType::U8
+                                                            : Wire>;
+    if constexpr (Wire == WireType::Struct) {
+      if constexpr (detail::ArrayTraits<value_type>::kIsArray) {
+        for (size_t i = 0; i < count; ++i) {
+          detail::StoreFields(writer, at + i * element_type::kWireSize,
+                              src[i]);
+        }
+      } else {
+        detail::StoreFields(writer, at, src);
+      }
+    } else if constexpr (!detail::ArrayTraits<value_type>::kIsArray) {
+      detail::StoreWireAt<Wire>(writer, at, static_cast<Raw>(src));
+    } else if constexpr (std::is_enum_v<element_type>) {
+      for (size_t i = 0; i < count; ++i) {
+        detail::StoreWireAt<Wire>(writer, at + i * sizeof(Raw),
+                                  static_cast<Raw>(src[i]));
+      }
+    } else if constexpr (sizeof(element_type) == 1) {
+      writer.store_bytes_at(at, src.data(), src.size());
+    } else {
+      detail::StoreWireArrayAt<Wire>(writer, at, src.data(), src.size());
+    }
+  }
+};
+
+/// @brief A scalar or enum member whose raw wire value must equal @p Value
+///        (a magic number or version guard). Decoding still stores the
+///        value, then fails with @ref StatusCode::BadMagic on a mismatch.
+template <auto Member, WireType Wire, size_t Offset, auto Value,
+          auto Decode = nullptr>
+struct Expected {
+  using owner_type = typename detail::MemberPointer<decltype(Member)>::owner;
+  using value_type = typename detail::MemberPointer<decltype(Member)>::value;
+  using element_type = value_type;
+  using raw_type = detail::WireValueT<Wire>;
+
+  static constexpr auto member = Member;
+  static constexpr WireType wire = Wire;
+  static constexpr size_t offset = Offset;
+  static constexpr size_t count = 1;
+  static constexpr size_t size = sizeof(raw_type);
+  static constexpr raw_type expected = static_cast<raw_type>(Value);
+
+  const char* name;
+  uint16_t id = 0;
+
+  template <typename Reader>
+  BIO_CONSTEXPR20 Status load(const Reader& reader, size_t base,
+                              owner_type& obj) const {
+    const raw_type raw = detail::LoadWireAt<Wire>(reader, base + Offset);
+    obj.*Member = detail::FromWire<value_type, Decode>(raw);
+    if (raw != expected) {
+      return Status::BadMagic(reader.position() + base + Offset);
+    }
+    return Status::Ok();
+  }
+
+  template <typename Writer>
+  BIO_CONSTEXPR20 void store(Writer& writer, size_t base,
+                             const owner_type& obj) const {
+    detail::StoreWireAt<Wire>(writer, base + Offset,
+                              static_cast<raw_type>(obj.*Member));
+  }
+};
+
+/// @brief One slice of a @ref Bits field: @p Width bits from bit @p Shift
+///        (counted from the least significant bit) stored in @p Member.
+///
+/// @c bool members are set from a non-zero slice; enum members go through
+/// @p Decode when given.
+template <auto Member, unsigned Shift, unsigned Width, auto Decode = nullptr>
+struct Bit {
+  using value_type = typename detail::MemberPointer<decltype(Member)>::value;
+
+  static constexpr auto member = Member;
+  static constexpr unsigned shift = Shift;
+  static constexpr unsigned width = Width;
+  static constexpr uint64_t mask = (uint64_t{1} << Width) - 1;
+
+  template <typename Raw>
+  static constexpr value_type Extract(Raw raw) {
+    const auto bits = static_cast<Raw>((raw >> Shift) & mask);
+    if constexpr (std::is_same_v<value_type, bool>) {
+      return bits != 0;
+    } else {
+      return detail::FromWire<value_type, Decode>(bits);
+    }
+  }
+};
+
+/// @brief An unsigned @p Wire integer at @p Offset split into @ref Bit
+///        slices, each stored in its own member.
+template <WireType Wire, size_t Offset, typename... Slices>
+struct Bits {
+  using raw_type = detail::WireValueT<Wire>;
+  static_assert(std::is_unsigned_v<raw_type>, "Bits need an unsigned type");
+
+  static constexpr WireType wire = WireType::Bits;
+  static constexpr size_t offset = Offset;
+  static constexpr size_t count = 1;
+  static constexpr size_t size = sizeof(raw_type);
+
+  const char* name;
+  uint16_t id = 0;
+
+  template <typename Reader, typename T>
+  BIO_CONSTEXPR20 Status load(const Reader& reader, size_t base, T& obj) const {
+    const raw_type raw = detail::LoadWireAt<Wire>(reader, base + Offset);
+    static_cast<void>(raw);
+    ((obj.*Slices::member = Slices::Extract(raw)), ...);
+    return Status::Ok();
+  }
+
+  template <typename Writer, typename T>
+  BIO_CONSTEXPR20 void store(Writer& writer, size_t base, const T& obj) const {
+    raw_type raw = 0;
+    ((raw |= static_cast<raw_type>(
+          (static_cast<raw_type>(obj.*Slices::member) & Slices::mask)
+          << Slices::shift)),
+     ...);
+    detail::StoreWireAt<Wire>(writer, base + Offset, raw);
+  }
+};
+
+/// @brief @p Size reserved bytes at @p Offset: skipped on decode and left
+///        untouched on encode.
+template <size_t Offset, size_t Size>
+struct Padding {
+  static constexpr WireType wire = WireType::Padding;
+  static constexpr size_t offset = Offset;
+  static constexpr size_t count = Size;
+  static constexpr size_t size = Size;
+
+  const char* name;
+  uint16_t id = 0;
+
+  template <typename Reader, typename T>
+  constexpr Status load(const Reader&, size_t, T&) const {
+    return Status::Ok();
+  }
+  template <typename Writer, typename T>
+  constexpr void store(Writer&, size_t, const T&) const {}
+};
+
+namespace detail {
+
+template <typename T, typename Reader>
+BIO_CONSTEXPR20 Status LoadFields(const Reader& reader, size_t base, T& obj) {
+  return std::apply(
+      [&](const auto&... field) {
+        Status s = Status::Ok();
+        static_cast<void>(
+            ((s = field.load(reader, base, obj).in_field(field.id)).ok &&
+             ...));
+        return s;
+      },
+      T::kFields);
+}
+
+template <typename T, typename Writer>
+BIO_CONSTEXPR20 void StoreFields(Writer& writer, size_t base, const T& obj) {
+  std::apply(
+      [&](const auto&... field) { (field.store(writer, base, obj), ...); },
+      T::kFields);
+}
+
+/// @brief The struct's @c codec_type, or @c void if it declares none.
+template <typename T, typename = void>
+struct CodecOf {
+  using type = void;
+};
+template <typename T>
+struct CodecOf<T, std::void_t<typename T::codec_type>> {
+  using type = typename T::codec_type;
+};
+
+template <typename T, typename Stream>
+constexpr void CheckCodec() {
+  using Codec = typename CodecOf<T>::type;
+  static_assert(std::is_void_v<Codec> ||
+                    std::is_same_v<Codec, typename Stream::codec_type>,
+                "stream byte order does not match the struct");
+}
+
+}  // namespace detail
+
+/// @brief Decode @p out from @p reader and advance past it.
+///
+/// With @c kFields, the whole struct is bounds-checked once and every
+/// descriptor loads its field at a constant offset; on failure the reader
+/// is not advanced. Other types are decoded by @c out.parse(reader).
+/// @return @ref Status::Ok(), or the first failure, attributed to the
+///         failing field's id.
+template <typename T, typename Reader>
+BIO_CONSTEXPR20 Status decode(Reader& reader, T& out) {
+  if constexpr (kHasFields<T>) {
+    detail::CheckCodec<T, Reader>();
+    Status s = reader.ensure(T::kWireSize);
+    if (!s) return s;
+    s = detail::LoadFields(reader, 0, out);
+    if (!s) return s;
+    reader.advance(T::kWireSize);
+    return Status::Ok();
+  } else {
+    return out.parse(reader);
+  }
+}
+
+/// @brief Encode @p value into @p writer and advance past it.
+///
+/// With @c kFields, the writer is bounds-checked (or grown) once and every
+/// descriptor stores its field at a constant offset. Other types are
+/// encoded by @c value.serialize(writer).
+template <typename T, typename Writer>
+BIO_CONSTEXPR20 Status encode(Writer& writer, const T& value) {
+  if constexpr (kHasFields<T>) {
+    detail::CheckCodec<T, Writer>();
+    Status s = writer.ensure(T::kWireSize);
+    if (!s) return s;
+    detail::StoreFields(writer, 0, value);
+    writer.advance(T::kWireSize);
+    return Status::Ok();
+  } else {
+    return value.serialize(writer);
+  }
+}
+
+/// @brief Call @p fn with every descriptor in @c T::kFields, in wire order.
+template <typename T, typename Fn>
+constexpr void for_each_field(Fn&& fn) {
+  std::apply([&](const auto&... field) { (fn(field), ...); }, T::kFields);
+}
+
+}  // namespace bio
+
+#endif  // BINARYIO_REFLECT_HPP_
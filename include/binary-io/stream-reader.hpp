@@ -0,0 +1,604 @@
+// Copyright (c) 2026 Julian Gottwald
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+/// @file stream-reader.hpp
+/// @brief Buffered reader over sequential byte sources such as files.
+///
+/// @ref StreamReaderT decodes from a fixed, caller-supplied window that is
+/// refilled from a @e source whenever it runs dry, so memory use stays
+/// constant regardless of the input size. Large skips become seeks when the
+/// source supports them.
+///
+/// A source is any type with
+/// @code
+///   size_t read(void* out, size_t len);  // bytes read; 0 at end or error
+///   bool seek(uint64_t offset);          // from where the source started;
+///                                        // false if unsupported or past
+///                                        // the end
+/// @endcode
+/// Offsets count from the source's starting point, like
+/// @ref StreamReaderT::position(), so a source may start mid-file.
+/// @ref IStreamSource adapts a @c std::istream; @ref FdSource reads a POSIX
+/// file descriptor with @c pread().
+
+#ifndef BINARYIO_STREAM_READER_HPP_
+#define BINARYIO_STREAM_READER_HPP_
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+
+#include "binary-io/binary-io.hpp"
+
+#if defined(__has_include)
+#if __has_include(<unistd.h>) && __has_include(<sys/stat.h>)
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#define BIO_HAS_FD_SOURCE 1
+#endif
+#endif
+
+namespace bio {
+
+/// @brief Stream source reading from a @c std::istream.
+///
+/// Seeking is supported when the stream is seekable; its size is measured
+/// once at construction so seeks past the end are rejected. Offsets count
+/// from the stream position at construction.
+class IStreamSource {
+ public:
+  /// @brief Wrap @p in, which must outlive the source.
+  explicit IStreamSource(std::istream& in) : in_(in) {
+    const auto start = in_.tellg();
+    if (start != std::streampos(-1) && in_.seekg(0, std::ios::end)) {
+      const auto end = in_.tellg();
+      in_.seekg(start);
+      if (end != std::streampos(-1)) {
+        base_ = static_cast<uint64_t>(start);
+        size_ = static_cast<uint64_t>(end) - base_;
+        seekable_ = true;
+      }
+    }
+    in_.clear();
+  }
+
+  /// @brief Read up to @p len bytes into @p out.
+  /// @return Number of bytes read; 0 at end of stream or on error.
+  size_t read(void* out, size_t len) {
+    in_.read(static_cast<char*>(out), static_cast<std::streamsize>(len));
+    return static_cast<size_t>(in_.gcount());
+  }
+
+  /// @brief Move to @p offset bytes past the position at construction.
+  /// @return @c false if the stream is not seekable or @p offset is past the
+  ///         end.
+  bool seek(uint64_t offset) {
+    if (!seekable_ || offset > size_) return false;
+    in_.clear();
+    return static_cast<bool>(in_.seekg(
+        static_cast<std::streamoff>(base_ + offset), std::ios::beg));
+  }
+
+ private:
+  std::istream& in_;
+  uint64_t base_ = 0;  ///< Stream position at construction.
+  uint64_t size_ = 0;  ///< Bytes from there to the end.
+  bool seekable_ = false;
+};
+
+#if defined(BIO_HAS_FD_SOURCE)
+/// @brief Stream source reading from a POSIX file descriptor.
+///
+/// Uses @c pread() with its own offset, so the descriptor's file position is
+/// left untouched. Regular files are seekable; pipes and sockets fall back
+/// to plain @c read() and cannot seek.
+class FdSource {
+ public:
+  /// @brief Wrap @p fd, which stays owned by the caller.
+  /// @param fd Open, readable file descriptor.
+  /// @param offset Absolute file offset to start reading at; seek() offsets
+  ///               count from here.
+  explicit FdSource(int fd, uint64_t offset = 0)
+      : fd_(fd), base_(offset), offset_(offset) {
+    struct stat st;
+    if (::fstat(fd_, &st) == 0 && S_ISREG(st.st_mode)) {
+      size_ = static_cast<uint64_t>(st.st_size);
+      seekable_ = true;
+    }
+  }
+
+  /// @brief Read up to @p len bytes into @p out.
+  /// @return Number of bytes read; 0 at end of file or on error.
+  size_t read(void* out, size_t len) {
+    for (;;) {
+      const ssize_t got =
+          seekable_ ? ::pread(fd_, out, len, static_cast<off_t>(offset_))
+                    : ::read(fd_, out, len);
+      if (got >= 0) {
+        offset_ += static_cast<uint64_t>(got);
+        return static_cast<size_t>(got);
+      }
+      if (errno != EINTR) return 0;
+    }
+  }
+
+  /// @brief Move to @p offset bytes past the starting offset.
+  /// @return @c false for non-regular files or if @p offset is past the end.
+  bool seek(uint64_t offset) {
+    if (!seekable_ || base_ > size_ || offset > size_ - base_) return false;
+    offset_ = base_ + offset;
+    return true;
+  }
+
+ private:
+  int fd_;
+  uint64_t base_;    ///< Starting offset.
+  uint64_t offset_;  ///< Offset of the next pread().
+  uint64_t size_ = 0;
+  bool seekable_ = false;
+};
+#endif
+
+/// @brief Byte reader that refills a fixed window from a stream source.
+///
+/// Offers the @ref ByteReaderT read surface. Reads that fit in the buffered
+/// window take a single-check fast path; otherwise the unread tail is moved
+/// to the front of the window and the rest is refilled from the source.
+/// @ref read_bytes() larger than the window reads straight into the
+/// destination, and @ref skip() seeks once the jump leaves the window.
+///
+/// Unlike @ref ByteReaderT, a read that runs into the end of the source
+/// after consuming part of its input (an array or byte run longer than the
+/// window) leaves that part consumed. Scalar reads and reads that fit in the
+/// window still consume nothing on failure.
+///
+/// The fixed-layout accessors (@ref ensure(), @ref load_u8_at() and
+/// friends) operate on the window, so @ref ensure() must not ask for more
+/// than @ref window_size() bytes.
+///
+/// @tparam Codec Byte-order codec (e.g. @ref LittleEndianCodec,
+///               @ref BigEndianCodec).
+/// @tparam Source Stream source, e.g. @ref IStreamSource or @ref FdSource.
+template <typename Codec, typename Source>
+class StreamReaderT {
+ public:
+  using codec_type = Codec;  ///< Byte-order codec of this reader.
+
+  /// @brief Construct a reader that buffers @p source through @p window.
+  /// @param source Byte source; must outlive the reader.
+  /// @param window Caller-owned buffer of @p window_size bytes.
+  /// @param window_size Size of @p window; at least 8 bytes.
+  StreamReaderT(Source& source, void* window, size_t window_size)
+      : source_(source),
+        window_(static_cast<uint8_t*>(window)),
+        capacity_(window_size),
+        p_(static_cast<const uint8_t*>(window)) {}
+
+  /// @brief Return the number of bytes consumed from the source so far.
+  uint64_t position() const { return position_; }
+
+  /// @brief Return the number of bytes buffered and not yet consumed.
+  size_t buffered() const { return n_; }
+
+  /// @brief Return the size of the window.
+  size_t window_size() const { return capacity_; }
+
+  /// @brief Read an unsigned 8-bit integer.
+  Status read_u8(uint8_t& out) {
+    if (1 > n_ && !fill(1)) return Status::OutOfRange(position());
+    out = *p_;
+    consume(1);
+    return Status::Ok();
+  }
+
+  /// @brief Read an unsigned 16-bit integer.
+  Status read_u16(uint16_t& out) {
+    if (2 > n_ && !fill(2)) return Status::OutOfRange(position());
+    out = Codec::LoadU16(p_);
+    consume(2);
+    return Status::Ok();
+  }
+
+  /// @brief Read an unsigned 32-bit integer.
+  Status read_u32(uint32_t& out) {
+    if (4 > n_ && !fill(4)) return Status::OutOfRange(position());
+    out = Codec::LoadU32(p_);
+    consume(4);
+    return Status::Ok();
+  }
+
+  /// @brief Read an unsigned 64-bit integer.
+  Status read_u64(uint64_t& out) {
+    if (8 > n_ && !fill(8)) return Status::OutOfRange(position());
+    out = Codec::LoadU64(p_);
+    consume(8);
+    return Status::Ok();
+  }
+
+  /// @brief Read a signed 8-bit integer.
+  Status read_i8(int8_t& out) { return read_as<uint8_t>(out); }
+
+  /// @brief Read a signed 16-bit integer.
+  Status read_i16(int16_t& out) { return read_as<uint16_t>(out); }
+
+  /// @brief Read a signed 32-bit integer.
+  Status read_i32(int32_t& out) { return read_as<uint32_t>(out); }
+
+  /// @brief Read a signed 64-bit integer.
+  Status read_i64(int64_t& out) { return read_as<uint64_t>(out); }
+
+  /// @brief Read a 32-bit IEEE 754 floating-point value.
+  Status read_f32(float& out) { return read_as<uint32_t>(out); }
+
+  /// @brief Read a 64-bit IEEE 754 floating-point value.
+  Status read_f64(double& out) { return read_as<uint64_t>(out); }
+
+  /// @brief Read an unsigned LEB128 integer; see
+  ///        @ref ByteReaderT::read_varuint().
+  Status read_varuint(uint64_t& out) {
+    // Top the window up to the longest encoding; near the end of the source
+    // a shorter fill is fine, as the decoder reports a truncated value.
+    if (n_ < detail::kMaxVarintBytes) {
+      static_cast<void>(fill(capacity_ < detail::kMaxVarintBytes
+                                 ? capacity_
+                                 : detail::kMaxVarintBytes));
+    }
+    const size_t len = detail::DecodeVarint(p_, n_, out);
+    if (len == 0) return Status::OutOfRange(position());
+    consume(len);
+    return Status::Ok();
+  }
+
+  /// @brief Read a zigzag-encoded signed LEB128 integer; see
+  ///        @ref ByteReaderT::read_varint().
+  Status read_varint(int64_t& out) {
+    uint64_t bits = 0;
+    if (!read_varuint(bits)) return Status::OutOfRange(position());
+    out = detail::ZigZagDecode(bits);
+    return Status::Ok();
+  }
+
+  /// @brief Read an array of unsigned 8-bit integers.
+  Status read_u8_array(uint8_t* out, size_t count) {
+    return read_bytes(out, count);
+  }
+
+  /// @brief Read an array of unsigned 16-bit integers.
+  Status read_u16_array(uint16_t* out, size_t count) {
+    return read_array<2>(out, count);
+  }
+
+  /// @brief Read an array of unsigned 32-bit integers.
+  Status read_u32_array(uint32_t* out, size_t count) {
+    return read_array<4>(out, count);
+  }
+
+  /// @brief Read an array of unsigned 64-bit integers.
+  Status read_u64_array(uint64_t* out, size_t count) {
+    return read_array<8>(out, count);
+  }
+
+  /// @brief Read an array of signed 8-bit integers.
+  Status read_i8_array(int8_t* out, size_t count) {
+    return read_bytes(out, count);
+  }
+
+  /// @brief Read an array of signed 16-bit integers.
+  Status read_i16_array(int16_t* out, size_t count) {
+    return read_array<2>(out, count);
+  }
+
+  /// @brief Read an array of signed 32-bit integers.
+  Status read_i32_array(int32_t* out, size_t count) {
+    return read_array<4>(out, count);
+  }
+
+  /// @brief Read an array of signed 64-bit integers.
+  Status read_i64_array(int64_t* out, size_t count) {
+    return read_array<8>(out, count);
+  }
+
+  /// @brief Read an array of 32-bit IEEE 754 floating-point values.
+  Status read_f32_array(float* out, size_t count) {
+    return read_array<4>(out, count);
+  }
+
+  /// @brief Read an array of 64-bit IEEE 754 floating-point values.
+  Status read_f64_array(double* out, size_t count) {
+    return read_array<8>(out, count);
+  }
+
+  /// @brief Read @p len raw bytes.
+  ///
+  /// Bytes already in the window are copied first; a remainder of at least
+  /// one window is read directly into @p out without buffering.
+  ///
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if the
+  ///         source ends early.
+  Status read_bytes(void* out, size_t len) {
+    if (len <= n_ || (len <= capacity_ && fill(len))) {
+      std::memcpy(out, p_, len);
+      consume(len);
+      return Status::Ok();
+    }
+    // A read that fits in the window consumes nothing when it fails.
+    if (len <= capacity_) return Status::OutOfRange(position());
+    auto* dst = static_cast<uint8_t*>(out);
+    if (n_ != 0) std::memcpy(dst, p_, n_);
+    dst += n_;
+    len -= n_;
+    consume(n_);
+    while (len >= capacity_) {
+      const size_t got = source_.read(dst, len);
+      if (got == 0) return Status::OutOfRange(position());
+      dst += got;
+      len -= got;
+      position_ += got;
+    }
+    if (len != 0) {
+      if (!fill(len)) return Status::OutOfRange(position());
+      std::memcpy(dst, p_, len);
+      consume(len);
+    }
+    return Status::Ok();
+  }
+
+  /// @brief Advance the cursor by @p len bytes.
+  ///
+  /// Jumps inside the window just move the cursor. Longer jumps drop the
+  /// window and seek the source, falling back to reading and discarding when
+  /// the source cannot seek; a failed skip therefore leaves the reader at the
+  /// end of the source.
+  ///
+  /// @return @ref Status::Ok() on success, @ref Status::OutOfRange() if the
+  ///         source ends first.
+  Status skip(uint64_t len) {
+    if (len <= n_) {
+      consume(static_cast<size_t>(len));
+      return Status::Ok();
+    }
+    const uint64_t target = position_ + len;
+    if (source_.seek(target)) {
+      p_ = window_;
+      n_ = 0;
+      position_ = target;
+      return Status::Ok();
+    }
+    while (len > n_) {
+      len -= n_;
+      consume(n_);
+      if (!fill(1)) return Status::OutOfRange(position());
+    }
+    consume(static_cast<size_t>(len));
+    return Status::Ok();
+  }
+
+  /// @name Unchecked access at constant offsets
+  ///
+  /// Same contract as the @ref ByteReaderT methods of the same name, applied
+  /// to the buffered window.
+  /// @{
+
+  /// @brief Buffer at least @p len bytes so they can be loaded at offsets.
+  /// @return @ref Status::OutOfRange() if the source ends first or @p len
+  ///         exceeds window_size().
+  Status ensure(size_t len) {
+    if (len > n_ && !fill(len)) return Status::OutOfRange(position());
+    return Status::Ok();
+  }
+
+  /// @brief Consume @p len buffered bytes.
+  /// @pre @p len <= buffered().
+  void advance(size_t len) { consume(len); }
+
+  /// @brief Decode an unsigned 8-bit integer @p offset bytes past the cursor.
+  uint8_t load_u8_at(size_t offset) const {
+    return window().load_u8_at(offset);
+  }
+
+  /// @brief Decode an unsigned 16-bit integer @p offset bytes past the cursor.
+  uint16_t load_u16_at(size_t offset) const {
+    return window().load_u16_at(offset);
+  }
+
+  /// @brief Decode an unsigned 32-bit integer @p offset bytes past the cursor.
+  uint32_t load_u32_at(size_t offset) const {
+    return window().load_u32_at(offset);
+  }
+
+  /// @brief Decode an unsigned 64-bit integer @p offset bytes past the cursor.
+  uint64_t load_u64_at(size_t offset) const {
+    return window().load_u64_at(offset);
+  }
+
+  /// @brief Decode a signed 8-bit integer @p offset bytes past the cursor.
+  int8_t load_i8_at(size_t offset) const { return window().load_i8_at(offset); }
+
+  /// @brief Decode a signed 16-bit integer @p offset bytes past the cursor.
+  int16_t load_i16_at(size_t offset) const {
+    return window().load_i16_at(offset);
+  }
+
+  /// @brief Decode a signed 32-bit integer @p offset bytes past the cursor.
+  int32_t load_i32_at(size_t offset) const {
+    return window().load_i32_at(offset);
+  }
+
+  /// @brief Decode a signed 64-bit integer @p offset bytes past the cursor.
+  int64_t load_i64_at(size_t offset) const {
+    return window().load_i64_at(offset);
+  }
+
+  /// @brief Decode a 32-bit IEEE 754 value @p offset bytes past the cursor.
+  float load_f32_at(size_t offset) const {
+    return window().load_f32_at(offset);
+  }
+
+  /// @brief Decode a 64-bit IEEE 754 value @p offset bytes past the cursor.
+  double load_f64_at(size_t offset) const {
+    return window().load_f64_at(offset);
+  }
+
+  /// @brief Copy @p len raw bytes starting @p offset bytes past the cursor.
+  void load_bytes_at(size_t offset, void* out, size_t len) const {
+    window().load_bytes_at(offset, out, len);
+  }
+
+  /// @brief Decode @p count unsigned 16-bit integers at @p offset.
+  void load_u16_array_at(size_t offset, uint16_t* out, size_t count) const {
+    window().load_u16_array_at(offset, out, count);
+  }
+
+  /// @brief Decode @p count unsigned 32-bit integers at @p offset.
+  void load_u32_array_at(size_t offset, uint32_t* out, size_t count) const {
+    window().load_u32_array_at(offset, out, count);
+  }
+
+  /// @brief Decode @p count unsigned 64-bit integers at @p offset.
+  void load_u64_array_at(size_t offset, uint64_t* out, size_t count) const {
+    window().load_u64_array_at(offset, out, count);
+  }
+
+  /// @brief Decode @p count signed 16-bit integers at @p offset.
+  void load_i16_array_at(size_t offset, int16_t* out, size_t count) const {
+    window().load_i16_array_at(offset, out, count);
+  }
+
+  /// @brief Decode @p count signed 32-bit integers at @p offset.
+  void load_i32_array_at(size_t offset, int32_t* out, size_t count) const {
+    window().load_i32_array_at(offset, out, count);
+  }
+
+  /// @brief Decode @p count signed 64-bit integers at @p offset.
+  void load_i64_array_at(size_t offset, int64_t* out, size_t count) const {
+    window().load_i64_array_at(offset, out, count);
+  }
+
+  /// @brief Decode @p count 32-bit IEEE 754 values at @p offset.
+  void load_f32_array_at(size_t offset, float* out, size_t count) const {
+    window().load_f32_array_at(offset, out, count);
+  }
+
+  /// @brief Decode @p count 64-bit IEEE 754 values at @p offset.
+  void load_f64_array_at(size_t offset, double* out, size_t count) const {
+    window().load_f64_array_at(offset, out, count);
+  }
+
+  /// @}
+
+ private:
+  /// @brief Return a reader over the buffered bytes.
+  ByteReaderT<Codec> window() const { return ByteReaderT<Codec>(p_, n_); }
+
+  /// @brief Consume @p len buffered bytes.
+  void consume(size_t len) {
+    p_ += len;
+    n_ -= len;
+    position_ += len;
+  }
+
+  /// @brief Refill until at least @p len bytes are buffered.
+  /// @return @c false if the source ends first or @p len exceeds the window;
+  ///         the buffered bytes are kept either way.
+  bool fill(size_t len) {
+    if (len > capacity_) return false;
+    if (p_ != window_) {
+      if (n_ != 0) std::memmove(window_, p_, n_);
+      p_ = window_;
+    }
+    while (n_ < len) {
+      const size_t got = source_.read(window_ + n_, capacity_ - n_);
+      if (got == 0) return false;
+      n_ += got;
+    }
+    return true;
+  }
+
+  /// @brief Read an unsigned word of the same width and copy its bits.
+  template <typename Bits, typename T>
+  Status read_as(T& out) {
+    static_assert(sizeof(Bits) == sizeof(T), "width mismatch");
+    Bits bits = 0;
+    Status s = Status::Ok();
+    if constexpr (sizeof(T) == 1) {
+      s = read_u8(bits);
+    } else if constexpr (sizeof(T) == 2) {
+      s = read_u16(bits);
+    } else if constexpr (sizeof(T) == 4) {
+      s = read_u32(bits);
+    } else {
+      s = read_u64(bits);
+    }
+    if (!s) return s;
+    std::memcpy(&out, &bits, sizeof(bits));
+    return Status::Ok();
+  }
+
+  /// @brief Bulk-load @p count words of @p kWidth bytes, one window at a
+  ///        time.
+  template <size_t kWidth>
+  Status read_array(void* out, size_t count) {
+    // Buffer an array that fits in the window up front, so that a failed
+    // read consumes nothing.
+    if (count <= capacity_ / kWidth && count * kWidth > n_ &&
+        !fill(count * kWidth)) {
+      return Status::OutOfRange(position());
+    }
+    auto* dst = static_cast<uint8_t*>(out);
+    while (count != 0) {
+      if (kWidth > n_ && !fill(kWidth)) return Status::OutOfRange(position());
+      const size_t run = n_ / kWidth < count ? n_ / kWidth : count;
+      if constexpr (kWidth == 2) {
+        Codec::LoadArray16(dst, p_, run);
+      } else if constexpr (kWidth == 4) {
+        Codec::LoadArray32(dst, p_, run);
+      } else {
+        static_assert(kWidth == 8, "unsupported word width");
+        Codec::LoadArray64(dst, p_, run);
+      }
+      consume(run * kWidth);
+      dst += run * kWidth;
+      count -= run;
+    }
+    return Status::Ok();
+  }
+
+  Source& source_;         ///< Byte source.
+  uint8_t* window_;        ///< Start of the window.
+  size_t capacity_;        ///< Window size.
+  const uint8_t* p_;       ///< Read position in the window.
+  size_t n_ = 0;           ///< Buffered, unconsumed bytes.
+  uint64_t position_ = 0;  ///< Bytes consumed from the source.
+};
+
+/// @brief Little-endian @ref StreamReaderT.
+template <typename Source>
+using LEStreamReader = StreamReaderT<LittleEndianCodec, Source>;
+
+/// @brief Big-endian @ref StreamReaderT.
+template <typename Source>
+using BEStreamReader = StreamReaderT<BigEndianCodec, Source>;
+
+}  // namespace bio
+
+#endif  // !BINARYIO_STREAM_READER_HPP_
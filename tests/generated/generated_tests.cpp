@@ -0,0 +1,563 @@
+// Round trips through the headers bio-gen writes for the example protocols
+// and packed_fields.yaml.
+// meson.build compiles this file once per generator mode (own runtime,
+// --shared-runtime, --instrument) and C++ standard, with -Werror.
+
+#include "command_protocol_protocol.hpp"
+#include "doctest.h"
+#include "packed_fields_protocol.hpp"
+#include "sensor_telemetry_protocol.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace {
+
+sensor::FrameHeader make_header(uint16_t sequence) {
+    sensor::FrameHeader h;
+    h.magic = 0xFEEDFACE;
+    h.version = 1;
+    h.msg_type = sensor::MessageType::Accelerometer;
+    h.status = sensor::StatusFlags::LowBattery;
+    h.sample_rate = 5;
+    h.filter_enable = true;
+    h.channel = 9;
+    h.sequence = sequence;
+    h.payload_length = 13;
+    return h;
+}
+
+void check_same(const sensor::FrameHeader& a, const sensor::FrameHeader& b) {
+    CHECK(a.magic == b.magic);
+    CHECK(a.version == b.version);
+    CHECK(a.msg_type == b.msg_type);
+    CHECK(a.status == b.status);
+    CHECK(a.sample_rate == b.sample_rate);
+    CHECK(a.filter_enable == b.filter_enable);
+    CHECK(a.channel == b.channel);
+    CHECK(a.sequence == b.sequence);
+    CHECK(a.payload_length == b.payload_length);
+}
+
+cmd::SetSpeedPayload make_speed(uint8_t motor, int32_t rpm) {
+    cmd::SetSpeedPayload p;
+    p.motor_id = motor;
+    p.target_rpm = rpm;
+    p.ramp_time_ms = 750;
+    p.direction = true;
+    p.brake_mode = cmd::BrakeMode::HoldPosition;
+    p.acceleration_profile = 17;
+    return p;
+}
+
+}  // namespace
+
+// ============================================================================
+// Structs and views
+// ============================================================================
+
+TEST_CASE("FrameHeader serializes to its wire layout and parses back") {
+    const sensor::FrameHeader h = make_header(0x1234);
+    std::array<uint8_t, sensor::FrameHeader::kWireSize> wire{};
+    sensor::LEWriter w(wire.data(), wire.size());
+    REQUIRE(h.serialize(w));
+    CHECK(w.position() == 13);
+    CHECK(h.serialized_size() == 13);
+    const std::array<uint8_t, 13> expected = {0xCE, 0xFA, 0xED, 0xFE, 1, 3, 1,
+                                              0x9D, 0, 0x34, 0x12, 13, 0};
+    CHECK(wire == expected);
+
+    sensor::FrameHeader back;
+    sensor::LEReader r(wire.data(), wire.size());
+    REQUIRE(back.parse(r));
+    CHECK(r.remaining() == 0);
+    check_same(back, h);
+
+    wire[0] ^= 0xFF;
+    sensor::LEReader bad(wire.data(), wire.size());
+    const sensor::Status s = back.parse(bad);
+    CHECK_FALSE(s);
+    CHECK(s.code == sensor::StatusCode::BadMagic);
+    CHECK(s.field == 1);
+    CHECK(bad.position() == 0);
+}
+
+TEST_CASE("Views decode fields in place") {
+    sensor::SensorFrame frame;
+    frame.header = make_header(7);
+    for (size_t i = 0; i < frame.data.size(); ++i) {
+        frame.data[i] = static_cast<uint8_t>(i * 3);
+    }
+    std::vector<uint8_t> wire(sensor::SensorFrame::kWireSize);
+    sensor::LEWriter w(wire.data(), wire.size());
+    REQUIRE(frame.serialize(w));
+
+    const sensor::SensorFrameView view(wire.data());
+    const sensor::FrameHeaderView header = view.header();
+    CHECK(header.wire() == wire.data());
+    CHECK(header.magic() == 0xFEEDFACE);
+    CHECK(header.msg_type() == sensor::MessageType::Accelerometer);
+    CHECK(header.status() == sensor::StatusFlags::LowBattery);
+    CHECK(header.sample_rate() == 5);
+    CHECK(header.filter_enable());
+    CHECK(header.channel() == 9);
+    CHECK(header.sequence() == 7);
+    CHECK(view.data() == wire.data() + 13);
+    CHECK(sensor::SensorFrameView::data_size() == 256);
+    CHECK(view.data()[100] == 44);
+
+    sensor::SensorFrame decoded;
+    REQUIRE(view.decode(decoded));
+    check_same(decoded.header, frame.header);
+    CHECK(decoded.data == frame.data);
+
+    // Big-endian bitfields and nested arrays.
+    cmd::SetConfigPayload config;
+    config.entry_count = 2;
+    config.entries[1].key = 0xBEEF;
+    config.entries[1].value = 0x01020304;
+    const cmd::SetSpeedPayload speed = make_speed(4, -1200);
+    std::array<uint8_t, cmd::SetSpeedPayload::kWireSize +
+                            cmd::SetConfigPayload::kWireSize> bytes{};
+    cmd::BEWriter bw(bytes.data(), bytes.size());
+    REQUIRE(speed.serialize(bw));
+    REQUIRE(config.serialize(bw));
+    CHECK(bw.remaining() == 0);
+
+    const cmd::SetSpeedPayloadView sv(bytes.data());
+    CHECK(sv.motor_id() == 4);
+    CHECK(sv.target_rpm() == -1200);
+    CHECK(sv.ramp_time_ms() == 750);
+    CHECK(sv.direction());
+    CHECK(sv.brake_mode() == cmd::BrakeMode::HoldPosition);
+    CHECK(sv.acceleration_profile() == 17);
+    const cmd::SetConfigPayloadView cv(bytes.data() +
+                                       cmd::SetSpeedPayload::kWireSize);
+    CHECK(cv.entry_count() == 2);
+    CHECK(cv.entries(1).key() == 0xBEEF);
+    CHECK(cv.entries(1).value() == 0x01020304);
+    CHECK(cv.entries(0).value() == 0);
+    // Big-endian on the wire: the key's high byte comes first.
+    CHECK(cv.entries(1).wire()[0] == 0xBE);
+}
+
+TEST_CASE("StatusResponse round-trips arrays and floats") {
+    cmd::StatusResponse status;
+    status.error = cmd::ErrorCode::Timeout;
+    status.motor_count = 3;
+    status.rpms = {100, -200, 300, 0};
+    status.voltage = 24.5f;
+    status.current = -1.25f;
+    cmd::DynamicBEWriter w;
+    REQUIRE(status.serialize(w));
+    CHECK(w.size() == cmd::StatusResponse::kWireSize);
+
+    cmd::BEReader r(w.data(), w.size());
+    cmd::StatusResponse back;
+    REQUIRE(back.parse(r));
+    CHECK(back.error == cmd::ErrorCode::Timeout);
+    CHECK(back.motor_count == 3);
+    CHECK(back.rpms == status.rpms);
+    CHECK(back.voltage == 24.5f);
+    CHECK(back.current == -1.25f);
+
+    const cmd::StatusResponseView view(w.data());
+    CHECK(view.rpms(1) == -200);
+    CHECK(view.voltage() == 24.5f);
+}
+
+TEST_CASE("SampleBlock bit-packs its delta and frame-of-reference arrays") {
+    sensor::SampleBlock block;
+    block.sensor_id = 9;
+    for (size_t i = 0; i < 64; ++i) {
+        block.timestamps[i] = static_cast<uint32_t>(100000 + i * 20 + i % 3);
+        block.centi_celsius[i] = static_cast<int16_t>(-150 + (i * 7) % 40);
+    }
+    sensor::DynamicLEWriter w;
+    REQUIRE(block.serialize(w));
+    CHECK(w.size() == block.serialized_size());
+    // Far below the 1 + 64 * 4 + 64 * 2 bytes of the unpacked arrays.
+    CHECK(w.size() < 120);
+
+    sensor::LEReader r(w.data(), w.size());
+    sensor::SampleBlock back;
+    REQUIRE(back.parse(r));
+    CHECK(r.remaining() == 0);
+    CHECK(back.sensor_id == 9);
+    CHECK(back.timestamps == block.timestamps);
+    CHECK(back.centi_celsius == block.centi_celsius);
+
+    // A truncated packed run fails on its field.
+    sensor::LEReader short_reader(w.data(), w.size() - 1);
+    const sensor::Status s = back.parse(short_reader);
+    CHECK_FALSE(s);
+    CHECK(s.code == sensor::StatusCode::OutOfRange);
+    CHECK(s.field == 21);
+}
+
+// ============================================================================
+// Dispatch
+// ============================================================================
+
+namespace {
+
+// Append a CommandHeader declaring @p size payload bytes.
+void put_header(cmd::DynamicBEWriter& w, cmd::CommandId id, uint16_t size) {
+    cmd::CommandHeader h;
+    h.sync = 0xAA55;
+    h.command = id;
+    h.payload_size = size;
+    REQUIRE(h.serialize(w));
+}
+
+template <typename Payload>
+void put_message(cmd::DynamicBEWriter& w, cmd::CommandId id,
+                 const Payload& payload, uint16_t extra = 0) {
+    put_header(w, id, static_cast<uint16_t>(Payload::kWireSize + extra));
+    REQUIRE(payload.serialize(w));
+    for (uint16_t i = 0; i < extra; ++i) REQUIRE(w.write_u8(0xEE));
+}
+
+}  // namespace
+
+TEST_CASE("CommandDispatch routes each message to its payload type") {
+    cmd::DynamicBEWriter w;
+    put_header(w, cmd::CommandId::Ping, 0);
+    put_message(w, cmd::CommandId::SetSpeed, make_speed(1, 500));
+    cmd::StatusResponse status;
+    status.motor_count = 2;
+    put_message(w, cmd::CommandId::GetStatus, status);
+    cmd::SetConfigPayload config;
+    config.entry_count = 1;
+    config.entries[0].value = 99;
+    put_message(w, cmd::CommandId::SetConfig, config);
+    put_message(w, cmd::CommandId::SetSpeed, make_speed(2, -7));
+
+    cmd::BEReader r(w.data(), w.size());
+    cmd::CommandHeader header;
+    cmd::CommandDispatch::Payload payload;
+    std::vector<size_t> kinds;
+    while (r.remaining() != 0) {
+        cmd::CommandId next{};
+        REQUIRE(cmd::CommandDispatch::peek(r, next));
+        const size_t before = r.position();
+        REQUIRE(cmd::CommandDispatch::parse(r, header, payload));
+        CHECK(header.command == next);
+        CHECK(r.position() - before ==
+              cmd::CommandHeader::kWireSize + header.payload_size);
+        kinds.push_back(payload.index());
+    }
+    CHECK(kinds == std::vector<size_t>{0, 1, 2, 3, 1});
+    CHECK(std::get<cmd::SetSpeedPayload>(payload).target_rpm == -7);
+
+    // visit() hands each decoded payload to the matching overload.
+    cmd::BEReader vr(w.data(), w.size());
+    int pings = 0;
+    int32_t rpm_sum = 0;
+    uint32_t config_value = 0;
+    uint8_t motors = 0;
+    while (vr.remaining() != 0) {
+        REQUIRE(cmd::CommandDispatch::visit(vr, [&](const cmd::CommandHeader&,
+                                                    const auto& p) {
+            using P = std::decay_t<decltype(p)>;
+            if constexpr (std::is_same_v<P, std::monostate>) {
+                ++pings;
+            } else if constexpr (std::is_same_v<P, cmd::SetSpeedPayload>) {
+                rpm_sum += p.target_rpm;
+            } else if constexpr (std::is_same_v<P, cmd::StatusResponse>) {
+                motors = p.motor_count;
+            } else {
+                config_value = p.entries[0].value;
+            }
+        }));
+    }
+    CHECK(pings == 1);
+    CHECK(rpm_sum == 493);
+    CHECK(motors == 2);
+    CHECK(config_value == 99);
+}
+
+TEST_CASE("CommandDispatch keeps every message within payload_size") {
+    cmd::DynamicBEWriter w;
+    put_header(w, cmd::CommandId::Ping, 3);  // header-only with a payload
+    for (int i = 0; i < 3; ++i) REQUIRE(w.write_u8(0xEE));
+    put_header(w, static_cast<cmd::CommandId>(0x7), 2);  // unknown type
+    REQUIRE(w.write_u16(0xEEEE));
+    put_message(w, cmd::CommandId::SetSpeed, make_speed(3, 42), 4);
+    put_message(w, cmd::CommandId::SetSpeed, make_speed(4, 43));
+    const size_t short_at = w.size();
+    put_header(w, cmd::CommandId::SetSpeed, 5);  // shorter than the payload
+    REQUIRE(make_speed(5, 44).serialize(w));
+
+    cmd::BEReader r(w.data(), w.size());
+    cmd::CommandHeader header;
+    cmd::CommandDispatch::Payload payload;
+    REQUIRE(cmd::CommandDispatch::parse(r, header, payload));
+    CHECK(payload.index() == 0);
+    CHECK(r.position() == 9);
+    REQUIRE(cmd::CommandDispatch::parse(r, header, payload));
+    CHECK(payload.index() == 0);
+    CHECK(r.position() == 17);
+    REQUIRE(cmd::CommandDispatch::parse(r, header, payload));
+    CHECK(std::get<cmd::SetSpeedPayload>(payload).motor_id == 3);
+    CHECK(r.position() == 17 + 6 + 9 + 4);
+    REQUIRE(cmd::CommandDispatch::parse(r, header, payload));
+    CHECK(std::get<cmd::SetSpeedPayload>(payload).motor_id == 4);
+    CHECK(r.position() == short_at);
+
+    const cmd::Status s = cmd::CommandDispatch::parse(r, header, payload);
+    CHECK_FALSE(s);
+    CHECK(s.code == cmd::StatusCode::OutOfRange);
+    CHECK(s.field == 3);  // CommandHeader.payload_size
+    CHECK(s.position == short_at + 6 + 5);
+
+    // visit() rejects the overrun before calling the visitor.
+    cmd::BEReader vr(w.data() + short_at, w.size() - short_at);
+    bool called = false;
+    CHECK_FALSE(cmd::CommandDispatch::visit(
+        vr, [&](const cmd::CommandHeader&, const auto&) { called = true; }));
+    CHECK_FALSE(called);
+}
+
+// ============================================================================
+// Batch decode
+// ============================================================================
+
+TEST_CASE("TemperaturePayloadBatch decodes N frames into columns") {
+    sensor::DynamicLEWriter w;
+    for (uint8_t i = 0; i < 10; ++i) {
+        sensor::TemperaturePayload t;
+        t.sensor_id = static_cast<uint8_t>(i + 1);
+        t.temperature = -20.0f + i * 2.5f;
+        REQUIRE(t.serialize(w));
+    }
+    REQUIRE(w.write_u8(0x42));  // partial eleventh frame
+
+    sensor::LEReader r(w.data(), w.size());
+    sensor::TemperaturePayloadBatch<8> batch;
+    REQUIRE(batch.parse_batch(r, 3));
+    CHECK(batch.size == 3);
+    CHECK(r.position() == 3 * sensor::TemperaturePayload::kWireSize);
+
+    // The batch fills to capacity and leaves the rest in the reader.
+    REQUIRE(batch.parse_batch(r, 100));
+    CHECK(batch.size == 8);
+    CHECK(r.position() == 8 * sensor::TemperaturePayload::kWireSize);
+    for (size_t j = 0; j < batch.size; ++j) {
+        CHECK(batch.sensor_id[j] == j + 1);
+        CHECK(batch.temperature[j] == -20.0f + j * 2.5f);
+    }
+
+    // Rows match the per-frame parser.
+    sensor::LEReader one(w.data() + 5 * sensor::TemperaturePayload::kWireSize,
+                         sensor::TemperaturePayload::kWireSize);
+    sensor::TemperaturePayload row;
+    REQUIRE(row.parse(one));
+    CHECK(row.sensor_id == batch.sensor_id[5]);
+    CHECK(row.temperature == batch.temperature[5]);
+
+    // After clear() the two whole frames left decode; the partial one stays.
+    batch.clear();
+    REQUIRE(batch.parse_batch(r, 100));
+    CHECK(batch.size == 2);
+    CHECK(batch.sensor_id[1] == 10);
+    CHECK(r.remaining() == 1);
+    REQUIRE(batch.parse_batch(r, 100));
+    CHECK(batch.size == 2);
+    CHECK(r.remaining() == 1);
+}
+
+// ============================================================================
+// Field descriptors
+// ============================================================================
+
+TEST_CASE("encode and decode through kFields match serialize and parse") {
+    const sensor::FrameHeader h = make_header(0xBEEF);
+    std::array<uint8_t, sensor::FrameHeader::kWireSize> by_serialize{};
+    std::array<uint8_t, sensor::FrameHeader::kWireSize> by_encode{};
+    sensor::LEWriter sw(by_serialize.data(), by_serialize.size());
+    sensor::LEWriter ew(by_encode.data(), by_encode.size());
+    REQUIRE(h.serialize(sw));
+    REQUIRE(sensor::encode(ew, h));
+    CHECK(ew.position() == sensor::FrameHeader::kWireSize);
+    CHECK(by_encode == by_serialize);
+
+    sensor::LEReader r(by_encode.data(), by_encode.size());
+    sensor::FrameHeader back;
+    REQUIRE(sensor::decode(r, back));
+    CHECK(r.remaining() == 0);
+    check_same(back, h);
+
+    // The Expected descriptor reports the magic's field and leaves the
+    // reader where it was.
+    by_encode[3] = 0;
+    sensor::LEReader bad(by_encode.data(), by_encode.size());
+    const sensor::Status s = sensor::decode(bad, back);
+    CHECK_FALSE(s);
+    CHECK(s.code == sensor::StatusCode::BadMagic);
+    CHECK(s.field == 1);
+    CHECK(bad.position() == 0);
+
+    // Too short for the struct: one bounds check, nothing consumed.
+    sensor::LEReader tiny(by_serialize.data(), 4);
+    CHECK(sensor::decode(tiny, back).code == sensor::StatusCode::OutOfRange);
+    CHECK(tiny.position() == 0);
+
+    // Nested struct arrays, big-endian.
+    cmd::SetConfigPayload config;
+    config.entry_count = 3;
+    for (uint16_t i = 0; i < 3; ++i) {
+        config.entries[i].key = static_cast<uint16_t>(0x100 + i);
+        config.entries[i].value = 1000u * i;
+    }
+    std::vector<uint8_t> a(cmd::SetConfigPayload::kWireSize);
+    std::vector<uint8_t> b(cmd::SetConfigPayload::kWireSize);
+    cmd::BEWriter aw(a.data(), a.size());
+    cmd::BEWriter bw(b.data(), b.size());
+    REQUIRE(config.serialize(aw));
+    REQUIRE(cmd::encode(bw, config));
+    CHECK(a == b);
+    cmd::BEReader cr(b.data(), b.size());
+    cmd::SetConfigPayload config_back;
+    REQUIRE(cmd::decode(cr, config_back));
+    CHECK(config_back.entry_count == 3);
+    CHECK(config_back.entries[2].key == 0x102);
+    CHECK(config_back.entries[2].value == 2000);
+}
+
+TEST_CASE("for_each_field walks descriptors in wire order") {
+    std::vector<std::string> names;
+    std::vector<size_t> offsets;
+    size_t covered = 0;
+    sensor::for_each_field<sensor::FrameHeader>([&](const auto& field) {
+        names.emplace_back(field.name);
+        offsets.push_back(field.offset);
+        covered += field.size;
+    });
+    CHECK(names == std::vector<std::string>{"magic", "version", "msg_type",
+                                            "status", "config", "reserved",
+                                            "sequence", "payload_length"});
+    CHECK(offsets == std::vector<size_t>{0, 4, 5, 6, 7, 8, 9, 11});
+    CHECK(covered == sensor::FrameHeader::kWireSize);
+}
+
+// ============================================================================
+// Packed bit fields
+// ============================================================================
+
+namespace {
+
+constexpr packed::PackedHeader make_packed() {
+    packed::PackedHeader h;
+    h.kind = 0x5A;
+    h.version = 5;
+    h.urgent = true;
+    h.seq = 0x1ABC;
+    h.stamp = 0x7F12345678ull;
+    h.lane = 0xC;
+    h.credit = 0x321;
+    return h;
+}
+
+constexpr packed::Counters make_counters() {
+    packed::Counters c;
+    c.id = 0x0102;
+    for (size_t i = 0; i < c.ticks.size(); ++i) {
+        c.ticks[i] = static_cast<uint32_t>(4000000000u + i * 1000 + i % 2);
+    }
+    return c;
+}
+
+}  // namespace
+
+TEST_CASE("PackedHeader packs fields in either bit order") {
+    const packed::PackedHeader h = make_packed();
+    std::array<uint8_t, packed::PackedHeader::kWireSize> wire{};
+    packed::BEWriter w(wire.data(), wire.size());
+    REQUIRE(h.serialize(w));
+    // 101 1 1101010111100 then the 39-bit stamp, most significant bit first.
+    CHECK(wire[0] == 0x5A);
+    CHECK(wire[1] == 0xBD);
+    CHECK(wire[2] == 0x5E);
+    CHECK(wire[3] == 0x7F);
+    // lane in the low nibble of the first byte, then credit.
+    CHECK(wire[8] == 0x1C);
+    CHECK(wire[9] == 0x32);
+
+    packed::BEReader r(wire.data(), wire.size());
+    packed::PackedHeader back;
+    REQUIRE(back.parse(r));
+    CHECK(back.version == 5);
+    CHECK(back.urgent);
+    CHECK(back.seq == 0x1ABC);
+    CHECK(back.stamp == 0x7F12345678ull);
+    CHECK(back.lane == 0xC);
+    CHECK(back.credit == 0x321);
+
+    const packed::PackedHeaderView view(wire.data());
+    CHECK(view.seq() == 0x1ABC);
+    CHECK(view.stamp() == 0x7F12345678ull);
+    CHECK(view.credit() == 0x321);
+}
+
+// ============================================================================
+// Compile-time round trips (C++20)
+// ============================================================================
+
+#if defined(__cpp_lib_bit_cast) && defined(__cpp_lib_is_constant_evaluated)
+
+namespace {
+
+constexpr bool packed_header_roundtrips() {
+    const packed::PackedHeader h = make_packed();
+    std::array<uint8_t, packed::PackedHeader::kWireSize> wire{};
+    packed::BEWriter w(wire.data(), wire.size());
+    if (!h.serialize(w) || h.serialized_size() != wire.size()) return false;
+    packed::BEReader r(wire.data(), wire.size());
+    packed::PackedHeader back;
+    return back.parse(r) && back.kind == h.kind && back.version == h.version &&
+           back.urgent == h.urgent && back.seq == h.seq &&
+           back.stamp == h.stamp && back.lane == h.lane &&
+           back.credit == h.credit && wire[1] == 0xBD;
+}
+
+constexpr bool counters_roundtrip() {
+    const packed::Counters c = make_counters();
+    std::array<uint8_t, 64> wire{};
+    packed::BEWriter w(wire.data(), wire.size());
+    if (!c.serialize(w) || c.serialized_size() != w.position()) return false;
+    packed::BEReader r(wire.data(), w.position());
+    packed::Counters back;
+    return back.parse(r) && r.remaining() == 0 && back.id == c.id &&
+           back.ticks == c.ticks;
+}
+
+constexpr bool sample_block_roundtrips() {
+    sensor::SampleBlock block;
+    block.sensor_id = 3;
+    for (size_t i = 0; i < 64; ++i) {
+        block.timestamps[i] = static_cast<uint32_t>(5000 + i * 10);
+        block.centi_celsius[i] = static_cast<int16_t>(i % 5) - 2;
+    }
+    std::array<uint8_t, 512> wire{};
+    sensor::LEWriter w(wire.data(), wire.size());
+    if (!block.serialize(w)) return false;
+    sensor::LEReader r(wire.data(), w.position());
+    sensor::SampleBlock back;
+    return back.parse(r) && r.remaining() == 0 &&
+           back.timestamps == block.timestamps &&
+           back.centi_celsius == block.centi_celsius;
+}
+
+}  // namespace
+
+static_assert(packed_header_roundtrips());
+static_assert(counters_roundtrip());
+static_assert(sample_block_roundtrips());
+
+#endif
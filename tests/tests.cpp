@@ -1,9 +1,32 @@
+#include "binary-io/array-coding.hpp"
 #include "binary-io/binary-io.hpp"
+#include "binary-io/checksum.hpp"
+#include "binary-io/frame-batch.hpp"
+#include "binary-io/frame-pipeline.hpp"
+#include "binary-io/instrumentation.hpp"
+#include "binary-io/mapped-file.hpp"
+#include "binary-io/reflect.hpp"
+#include "binary-io/stream-reader.hpp"
 #include "doctest.h"
+#include "thread_pool.hpp"
+#include "zip_index.hpp"
+#include "zip_validate.hpp"
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <limits>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
 
 using namespace bio;
 
@@ -25,6 +48,57 @@ TEST_CASE("Status::OutOfRange is falsy") {
     CHECK_FALSE(s);
 }
 
+TEST_CASE("Status records code, position and field of a failure") {
+    static_assert(sizeof(Status) == 8);
+    const Status ok = Status::Ok();
+    CHECK(ok.code == StatusCode::Ok);
+    CHECK(ok.field == 0);
+    CHECK(ok.position == Status::kNoPosition);
+    CHECK(ok.in_field(3).field == 0);
+
+    const Status s = Status::BadMagic(12);
+    CHECK_FALSE(s);
+    CHECK(s.code == StatusCode::BadMagic);
+    CHECK(s.position == 12);
+    CHECK(Status::OutOfRange().position == Status::kNoPosition);
+    // The innermost field wins.
+    CHECK(s.in_field(4).in_field(9).field == 4);
+
+    constexpr Status enum_fail = Status::BadEnum(size_t{1} << 40);
+    static_assert(enum_fail.position == Status::kNoPosition);
+    CHECK(std::string(to_string(enum_fail.code)) == "BadEnum");
+    CHECK(std::string(to_string(
+              Status::ChecksumMismatch().code)) == "ChecksumMismatch");
+}
+
+TEST_CASE("Failed reads and writes report their position") {
+    const uint8_t data[6] = {};
+    LEReader r(data, sizeof(data));
+    uint32_t v = 0;
+    REQUIRE(r.read_u32(v));
+    Status s = r.read_u32(v);
+    CHECK(s.code == StatusCode::OutOfRange);
+    CHECK(s.position == 4);
+
+    const ByteSegment segs[] = {{data, 3}, {data + 3, 3}};
+    LEChunkedReader c(segs, 2);
+    REQUIRE(c.skip(5));
+    uint16_t h = 0;
+    CHECK(c.read_u16(h).position == 5);
+
+    uint8_t out[3];
+    LEWriter w(out, sizeof(out));
+    REQUIRE(w.write_u16(1));
+    CHECK(w.write_u16(2).position == 2);
+
+    MsbBitReader bits(data, sizeof(data));
+    REQUIRE(bits.skip_bits(44));
+    uint8_t b = 0;
+    s = bits.read_bits(5, b);
+    CHECK(s.code == StatusCode::OutOfRange);
+    CHECK(s.position == 5);
+}
+
 // ============================================================================
 // LittleEndianCodec – Load
 // ============================================================================
@@ -919,6 +993,101 @@ TEST_CASE("BE write then read all types round-trip") {
     CHECK(r.remaining() == 0);
 }
 
+// ============================================================================
+// Compile-time serialization (C++20)
+// ============================================================================
+
+#if defined(__cpp_lib_bit_cast) && defined(__cpp_lib_is_constant_evaluated)
+
+namespace {
+
+/// A command frame encoded at compile time, as it would sit in flash.
+struct ConstFrame {
+    std::array<uint8_t, 40> bytes{};
+    size_t size = 0;
+};
+
+template <typename Writer>
+constexpr Status write_const_frame(Writer& w) {
+    const uint8_t tag[] = {'C', 'M', 'D'};
+    const uint16_t words[] = {0x1234, 0xABCD};
+    if (Status s = w.write_u32(0xC0FFEE11u); !s) return s;
+    if (Status s = w.write_i16(-2); !s) return s;
+    if (Status s = w.write_f32(1.5f); !s) return s;
+    if (Status s = w.write_f64(-0.25); !s) return s;
+    if (Status s = w.write_varuint(300); !s) return s;
+    if (Status s = w.write_varint(-3); !s) return s;
+    if (Status s = w.write_bytes(tag, sizeof(tag)); !s) return s;
+    if (Status s = w.write_u16_array(words, 2); !s) return s;
+    if (Status s = w.ensure(2); !s) return s;
+    w.store_u16_at(0, 0xFEED);
+    w.advance(2);
+    return Status::Ok();
+}
+
+template <typename Codec>
+constexpr ConstFrame make_const_frame() {
+    ConstFrame f;
+    ByteWriterT<Codec> w(f.bytes.data(), f.bytes.size());
+    if (write_const_frame(w)) f.size = w.position();
+    return f;
+}
+
+template <typename Codec>
+constexpr bool check_const_frame(const ConstFrame& f) {
+    ByteReaderT<Codec> r(f.bytes.data(), f.size);
+    uint32_t magic = 0;
+    int16_t i16 = 0;
+    float f32 = 0;
+    double f64 = 0;
+    uint64_t count = 0;
+    int64_t delta = 0;
+    uint8_t tag[3] = {};
+    uint16_t words[2] = {};
+    uint16_t trailer = 0;
+    return r.read_u32(magic) && magic == 0xC0FFEE11u && r.read_i16(i16) &&
+           i16 == -2 && r.read_f32(f32) && f32 == 1.5f && r.read_f64(f64) &&
+           f64 == -0.25 && r.read_varuint(count) && count == 300 &&
+           r.read_varint(delta) && delta == -3 && r.read_bytes(tag, 3) &&
+           tag[2] == 'D' && r.read_u16_array(words, 2) &&
+           words[1] == 0xABCD && r.load_u16_at(0) == 0xFEED &&
+           r.read_u16(trailer) && r.remaining() == 0 && !r.read_u8(tag[0]);
+}
+
+constexpr ConstFrame kLEFrame = make_const_frame<LittleEndianCodec>();
+constexpr ConstFrame kBEFrame = make_const_frame<BigEndianCodec>();
+
+constexpr size_t const_frame_size() {
+    LESizeCounter counter;
+    return write_const_frame(counter) ? counter.size() : 0;
+}
+
+}  // namespace
+
+static_assert(kLEFrame.size == 30 && const_frame_size() == 30);
+static_assert(kLEFrame.bytes[0] == 0x11 && kBEFrame.bytes[0] == 0xC0);
+static_assert(check_const_frame<LittleEndianCodec>(kLEFrame));
+static_assert(check_const_frame<BigEndianCodec>(kBEFrame));
+
+TEST_CASE("Frames built at compile time match the run-time encoding") {
+    for (const ConstFrame* f : {&kLEFrame, &kBEFrame}) {
+        std::array<uint8_t, 40> buf{};
+        bool ok = false;
+        if (f == &kLEFrame) {
+            LEWriter w(buf.data(), buf.size());
+            ok = static_cast<bool>(write_const_frame(w));
+        } else {
+            BEWriter w(buf.data(), buf.size());
+            ok = static_cast<bool>(write_const_frame(w));
+        }
+        CHECK(ok);
+        CHECK(buf == f->bytes);
+    }
+    CHECK(check_const_frame<LittleEndianCodec>(kLEFrame));
+}
+
+#endif
+
 // ============================================================================
 // Boundary: exactly-sized buffer succeeds, one-less fails
 // ============================================================================
@@ -1362,6 +1531,74 @@ TEST_CASE("Writer skip + Reader skip round-trip") {
     CHECK(r.remaining() == 4);
 }
 
+// ============================================================================
+// ByteWriterT – reserve and backpatch
+// ============================================================================
+
+TEST_CASE("BE writer reserve_bytes zero-fills and patches in place") {
+    uint8_t buf[12];
+    std::memset(buf, 0xEE, sizeof(buf));
+    BEWriter w(buf, sizeof(buf));
+    REQUIRE(w.write_u8(0x7E));
+    size_t length_at = 0;
+    REQUIRE(w.reserve_bytes(2, length_at));
+    CHECK(length_at == 1);
+    CHECK(buf[1] == 0x00);
+    CHECK(buf[2] == 0x00);
+    REQUIRE(w.write_u32(0x01020304u));
+    REQUIRE(w.patch_u16(length_at, 4));
+    CHECK(w.position() == 7);  // patching does not move the cursor
+    CHECK(buf[1] == 0x00);
+    CHECK(buf[2] == 0x04);
+
+    CHECK(w.patch_u8(0, 0x7F));
+    CHECK(w.patch_u32(3, 0xA1A2A3A4u));
+    const uint8_t tag[] = {0x55, 0x66};
+    CHECK(w.patch_bytes(5, tag, 2));
+    const uint8_t expected[] = {0x7F, 0x00, 0x04, 0xA1,
+                                0xA2, 0x55, 0x66, 0xEE};
+    CHECK(std::memcmp(buf, expected, sizeof(expected)) == 0);
+}
+
+TEST_CASE("Writer patches must lie inside the written bytes") {
+    uint8_t buf[16] = {};
+    LEWriter w(buf, sizeof(buf));
+    REQUIRE(w.write_u32(0));
+    CHECK(w.patch_u32(0, 1));
+    const Status s = w.patch_u16(3, 1);  // would cover byte 4
+    CHECK_FALSE(s);
+    CHECK(s.code == StatusCode::OutOfRange);
+    CHECK(s.position == 3);
+    CHECK_FALSE(w.patch_u8(4, 1));
+    CHECK_FALSE(w.patch_u64(0, 1));
+    CHECK_FALSE(w.patch_bytes(SIZE_MAX, buf, 2));
+    CHECK(w.position() == 4);
+
+    size_t at = 0;
+    CHECK_FALSE(w.reserve_bytes(13, at));
+    CHECK(w.position() == 4);  // unchanged
+}
+
+TEST_CASE("Growable writer patches survive reallocation") {
+    DynamicBEWriter w(4);
+    size_t at = 0;
+    REQUIRE(w.reserve_bytes(4, at));
+    for (uint32_t i = 0; i < 64; ++i) REQUIRE(w.write_u32(i));
+    REQUIRE(w.patch_u32(at, 0xCAFEF00Du));
+    CHECK(BigEndianCodec::LoadU32(w.data()) == 0xCAFEF00Du);
+    CHECK(w.size() == 260);
+}
+
+TEST_CASE("SizeCounterT counts reserved bytes and ignores patches") {
+    LESizeCounter counter;
+    REQUIRE(counter.write_u8(1));
+    size_t at = 0;
+    REQUIRE(counter.reserve_bytes(4, at));
+    CHECK(at == 1);
+    CHECK(counter.patch_u32(at, 5));
+    CHECK(counter.size() == 5);
+}
+
 // ============================================================================
 // ByteReaderT – read_i8
 // ============================================================================
@@ -1932,4 +2169,3156 @@ TEST_CASE("LE write then read all types including signed and f64") {
     CHECK(r.read_f64(vf64));
     CHECK(vf64 == doctest::Approx(2.718281828459045));
     CHECK(r.remaining() == 0);
-}
\ No newline at end of file
+}
+
+// ============================================================================
+// detail::ByteSwap
+// ============================================================================
+
+TEST_CASE("ByteSwap16 reverses bytes") {
+    CHECK(detail::ByteSwap16(0x1234) == 0x3412);
+    CHECK(detail::ByteSwap16(0x00FF) == 0xFF00);
+}
+
+TEST_CASE("ByteSwap32 reverses bytes") {
+    CHECK(detail::ByteSwap32(0x12345678u) == 0x78563412u);
+    CHECK(detail::ByteSwap32(0x000000FFu) == 0xFF000000u);
+}
+
+TEST_CASE("ByteSwap64 reverses bytes") {
+    CHECK(detail::ByteSwap64(0x0123456789ABCDEFull) == 0xEFCDAB8967452301ull);
+    CHECK(detail::ByteSwap64(0x00000000000000FFull) == 0xFF00000000000000ull);
+}
+
+TEST_CASE("Host byte order is detected") {
+    CHECK_FALSE((detail::kHostLittleEndian && detail::kHostBigEndian));
+    const uint16_t probe = 0x0102;
+    uint8_t bytes[2] = {};
+    std::memcpy(bytes, &probe, sizeof(probe));
+    if (detail::kHostLittleEndian) CHECK(bytes[0] == 0x02);
+    if (detail::kHostBigEndian) CHECK(bytes[0] == 0x01);
+}
+
+// ============================================================================
+// Codecs – unaligned access
+// ============================================================================
+
+TEST_CASE("LE codec loads from unaligned addresses") {
+    const uint8_t d[] = {0x00, 0xEF, 0xCD, 0xAB, 0x89, 0x67, 0x45, 0x23, 0x01};
+    CHECK(LittleEndianCodec::LoadU16(d + 1) == 0xCDEF);
+    CHECK(LittleEndianCodec::LoadU32(d + 1) == 0x89ABCDEFu);
+    CHECK(LittleEndianCodec::LoadU64(d + 1) == 0x0123456789ABCDEFull);
+}
+
+TEST_CASE("BE codec loads from unaligned addresses") {
+    const uint8_t d[] = {0x00, 0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF};
+    CHECK(BigEndianCodec::LoadU16(d + 1) == 0x0123);
+    CHECK(BigEndianCodec::LoadU32(d + 1) == 0x01234567u);
+    CHECK(BigEndianCodec::LoadU64(d + 1) == 0x0123456789ABCDEFull);
+}
+
+TEST_CASE("LE codec stores to unaligned addresses") {
+    uint8_t d[9] = {};
+    LittleEndianCodec::StoreU64(d + 1, 0x0123456789ABCDEFull);
+    CHECK(d[0] == 0x00);
+    CHECK(d[1] == 0xEF);
+    CHECK(d[8] == 0x01);
+    LittleEndianCodec::StoreU32(d + 1, 0x01020304u);
+    CHECK(d[1] == 0x04);
+    CHECK(d[4] == 0x01);
+    LittleEndianCodec::StoreU16(d + 1, 0xA1B2);
+    CHECK(d[1] == 0xB2);
+    CHECK(d[2] == 0xA1);
+}
+
+TEST_CASE("BE codec stores to unaligned addresses") {
+    uint8_t d[9] = {};
+    BigEndianCodec::StoreU64(d + 1, 0x0123456789ABCDEFull);
+    CHECK(d[0] == 0x00);
+    CHECK(d[1] == 0x01);
+    CHECK(d[8] == 0xEF);
+    BigEndianCodec::StoreU32(d + 1, 0x01020304u);
+    CHECK(d[1] == 0x01);
+    CHECK(d[4] == 0x04);
+    BigEndianCodec::StoreU16(d + 1, 0xA1B2);
+    CHECK(d[1] == 0xA1);
+    CHECK(d[2] == 0xB2);
+}
+
+// ============================================================================
+// detail::ByteSwapCopy kernels
+// ============================================================================
+
+TEST_CASE("ByteSwapCopy16 matches scalar swap across SIMD and tail") {
+    uint16_t src[37], dst[37] = {};
+    for (uint16_t i = 0; i < 37; ++i) src[i] = static_cast<uint16_t>(0x0100 * i + i + 1);
+    detail::ByteSwapCopy16(dst, src, 37);
+    bool all = true;
+    for (size_t i = 0; i < 37; ++i) all = all && dst[i] == detail::ByteSwap16(src[i]);
+    CHECK(all);
+}
+
+TEST_CASE("ByteSwapCopy32 matches scalar swap across SIMD and tail") {
+    uint32_t src[19], dst[19] = {};
+    for (uint32_t i = 0; i < 19; ++i) src[i] = 0x01020304u * (i + 1);
+    detail::ByteSwapCopy32(dst, src, 19);
+    bool all = true;
+    for (size_t i = 0; i < 19; ++i) all = all && dst[i] == detail::ByteSwap32(src[i]);
+    CHECK(all);
+}
+
+TEST_CASE("ByteSwapCopy64 matches scalar swap across SIMD and tail") {
+    uint64_t src[11], dst[11] = {};
+    for (uint64_t i = 0; i < 11; ++i) src[i] = 0x0102030405060708ull * (i + 1);
+    detail::ByteSwapCopy64(dst, src, 11);
+    bool all = true;
+    for (size_t i = 0; i < 11; ++i) all = all && dst[i] == detail::ByteSwap64(src[i]);
+    CHECK(all);
+}
+
+TEST_CASE("ByteSwapCopy32 works in place") {
+    uint32_t v[5] = {0x01020304u, 0x05060708u, 0x090A0B0Cu, 0x0D0E0F10u, 0x11121314u};
+    detail::ByteSwapCopy32(v, v, 5);
+    CHECK(v[0] == 0x04030201u);
+    CHECK(v[4] == 0x14131211u);
+}
+
+// ============================================================================
+// ByteReaderT – bulk array reads
+// ============================================================================
+
+TEST_CASE("LE read_u16_array decodes every element") {
+    uint8_t buf[2 * 21];
+    for (size_t i = 0; i < 21; ++i) LittleEndianCodec::StoreU16(buf + 2 * i, static_cast<uint16_t>(0x1111 * i + 3));
+    LEReader r(buf, sizeof(buf));
+    uint16_t out[21] = {};
+    CHECK(r.read_u16_array(out, 21));
+    CHECK(r.remaining() == 0);
+    bool all = true;
+    for (size_t i = 0; i < 21; ++i) all = all && out[i] == static_cast<uint16_t>(0x1111 * i + 3);
+    CHECK(all);
+}
+
+TEST_CASE("BE read_u32_array decodes every element") {
+    uint8_t buf[4 * 13];
+    for (size_t i = 0; i < 13; ++i) BigEndianCodec::StoreU32(buf + 4 * i, 0xA0B0C0D0u + static_cast<uint32_t>(i));
+    BEReader r(buf, sizeof(buf));
+    uint32_t out[13] = {};
+    CHECK(r.read_u32_array(out, 13));
+    bool all = true;
+    for (size_t i = 0; i < 13; ++i) all = all && out[i] == 0xA0B0C0D0u + i;
+    CHECK(all);
+}
+
+TEST_CASE("BE read_u64_array decodes every element") {
+    uint8_t buf[8 * 5];
+    for (size_t i = 0; i < 5; ++i) BigEndianCodec::StoreU64(buf + 8 * i, 0x0102030405060708ull << i);
+    BEReader r(buf, sizeof(buf));
+    uint64_t out[5] = {};
+    CHECK(r.read_u64_array(out, 5));
+    CHECK(out[0] == 0x0102030405060708ull);
+    CHECK(out[4] == 0x0102030405060708ull << 4);
+}
+
+TEST_CASE("BE read_i16_array keeps sign") {
+    const uint8_t buf[] = {0xFF, 0xFE, 0x00, 0x05, 0x80, 0x00};
+    BEReader r(buf, sizeof(buf));
+    int16_t out[3] = {};
+    CHECK(r.read_i16_array(out, 3));
+    CHECK(out[0] == -2);
+    CHECK(out[1] == 5);
+    CHECK(out[2] == std::numeric_limits<int16_t>::min());
+}
+
+TEST_CASE("LE and BE read_f32_array round-trip through write_f32") {
+    float values[9];
+    for (int i = 0; i < 9; ++i) values[i] = 0.25f * static_cast<float>(i) - 1.0f;
+    uint8_t le[36], be[36];
+    LEWriter lw(le, sizeof(le));
+    BEWriter bw(be, sizeof(be));
+    for (float v : values) {
+        CHECK(lw.write_f32(v));
+        CHECK(bw.write_f32(v));
+    }
+    float lout[9] = {}, bout[9] = {};
+    LEReader lr(le, sizeof(le));
+    BEReader br(be, sizeof(be));
+    CHECK(lr.read_f32_array(lout, 9));
+    CHECK(br.read_f32_array(bout, 9));
+    CHECK(std::memcmp(lout, values, sizeof(values)) == 0);
+    CHECK(std::memcmp(bout, values, sizeof(values)) == 0);
+}
+
+TEST_CASE("read_f64_array and read_u8_array") {
+    uint8_t buf[8 * 2 + 3];
+    BEWriter w(buf, sizeof(buf));
+    CHECK(w.write_f64(1.5));
+    CHECK(w.write_f64(-2.0));
+    CHECK(w.write_u8(7));
+    CHECK(w.write_u8(8));
+    CHECK(w.write_u8(9));
+    BEReader r(buf, sizeof(buf));
+    double d[2] = {};
+    uint8_t b[3] = {};
+    CHECK(r.read_f64_array(d, 2));
+    CHECK(r.read_u8_array(b, 3));
+    CHECK(d[0] == 1.5);
+    CHECK(d[1] == -2.0);
+    CHECK(b[2] == 9);
+}
+
+TEST_CASE("read_u32_array out of range does not consume") {
+    uint8_t buf[7] = {};
+    LEReader r(buf, sizeof(buf));
+    uint32_t out[2] = {};
+    CHECK_FALSE(r.read_u32_array(out, 2));
+    CHECK(r.position() == 0);
+    CHECK(r.read_u32_array(out, 1));
+    CHECK(r.position() == 4);
+}
+
+TEST_CASE("read_u64_array rejects counts whose byte size overflows") {
+    uint8_t buf[8] = {};
+    LEReader r(buf, sizeof(buf));
+    uint64_t out[1] = {};
+    CHECK_FALSE(r.read_u64_array(out, std::numeric_limits<size_t>::max() / 4));
+    CHECK(r.remaining() == 8);
+}
+
+TEST_CASE("read_u16_array with zero count succeeds on empty buffer") {
+    LEReader r(nullptr, 0);
+    CHECK(r.read_u16_array(nullptr, 0));
+}
+
+// ============================================================================
+// ByteWriterT – bulk array writes
+// ============================================================================
+
+TEST_CASE("BE write_u16_array matches per-element writes") {
+    uint16_t values[23];
+    for (size_t i = 0; i < 23; ++i) values[i] = static_cast<uint16_t>(0x0F0F * i + 1);
+    uint8_t bulk[46] = {}, single[46] = {};
+    BEWriter bw(bulk, sizeof(bulk));
+    BEWriter sw(single, sizeof(single));
+    CHECK(bw.write_u16_array(values, 23));
+    for (auto v : values) CHECK(sw.write_u16(v));
+    CHECK(std::memcmp(bulk, single, sizeof(bulk)) == 0);
+    CHECK(bw.remaining() == 0);
+}
+
+TEST_CASE("LE write_i64_array matches per-element writes") {
+    const int64_t values[] = {-1, 2, -3000000000LL, 4};
+    uint8_t bulk[32] = {}, single[32] = {};
+    LEWriter bw(bulk, sizeof(bulk));
+    LEWriter sw(single, sizeof(single));
+    CHECK(bw.write_i64_array(values, 4));
+    for (auto v : values) CHECK(sw.write_i64(v));
+    CHECK(std::memcmp(bulk, single, sizeof(bulk)) == 0);
+}
+
+TEST_CASE("BE write_f32_array / read_f32_array round-trip") {
+    const float values[] = {1.0f, -0.5f, 3.25f, 1e10f, -1e-10f};
+    uint8_t buf[20] = {};
+    BEWriter w(buf, sizeof(buf));
+    CHECK(w.write_f32_array(values, 5));
+    CHECK(BigEndianCodec::LoadU32(buf) == 0x3F800000u);
+    BEReader r(buf, sizeof(buf));
+    float out[5] = {};
+    CHECK(r.read_f32_array(out, 5));
+    CHECK(std::memcmp(out, values, sizeof(values)) == 0);
+}
+
+TEST_CASE("write_u32_array out of range does not consume space") {
+    const uint32_t values[] = {1, 2};
+    uint8_t buf[7] = {};
+    LEWriter w(buf, sizeof(buf));
+    CHECK_FALSE(w.write_u32_array(values, 2));
+    CHECK(w.position() == 0);
+    CHECK(w.write_u32_array(values, 1));
+    CHECK(w.position() == 4);
+}
+
+TEST_CASE("write_u8_array and write_i8_array copy raw bytes") {
+    const uint8_t u[] = {1, 2};
+    const int8_t i[] = {-1, -2};
+    uint8_t buf[4] = {};
+    LEWriter w(buf, sizeof(buf));
+    CHECK(w.write_u8_array(u, 2));
+    CHECK(w.write_i8_array(i, 2));
+    CHECK(buf[1] == 2);
+    CHECK(buf[2] == 0xFF);
+    CHECK(buf[3] == 0xFE);
+}
+
+
+// ============================================================================
+// Unchecked access at constant offsets
+// ============================================================================
+
+TEST_CASE("Reader ensure checks remaining bytes without consuming") {
+    const uint8_t buf[8] = {};
+    LEReader r(buf, sizeof(buf));
+    CHECK(r.ensure(8));
+    CHECK_FALSE(r.ensure(9));
+    CHECK(r.position() == 0);
+    r.advance(6);
+    CHECK(r.position() == 6);
+    CHECK(r.remaining() == 2);
+    CHECK(r.ensure(2));
+    CHECK_FALSE(r.ensure(3));
+}
+
+TEST_CASE("LE load_*_at decodes relative to the cursor") {
+    const uint8_t buf[] = {0xAA, 0x01, 0x02, 0x03, 0x04, 0xFF, 0xFE,
+                           0x00, 0x00, 0x80, 0x3F};
+    LEReader r(buf, sizeof(buf));
+    r.advance(1);
+    CHECK(r.load_u8_at(0) == 0x01);
+    CHECK(r.load_u16_at(0) == 0x0201);
+    CHECK(r.load_u32_at(0) == 0x04030201u);
+    CHECK(r.load_i8_at(4) == -1);
+    CHECK(r.load_i16_at(4) == static_cast<int16_t>(0xFEFF));
+    CHECK(r.load_f32_at(6) == 1.0f);
+    CHECK(r.position() == 1);
+}
+
+TEST_CASE("BE load_*_at decodes relative to the cursor") {
+    const uint8_t buf[] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+                           0x08, 0xFF, 0xFF, 0xFF, 0xFE};
+    BEReader r(buf, sizeof(buf));
+    CHECK(r.load_u64_at(1) == 0x0102030405060708ull);
+    CHECK(r.load_i32_at(9) == -2);
+    CHECK(r.load_i64_at(1) == 0x0102030405060708ll);
+    CHECK(r.position() == 0);
+}
+
+TEST_CASE("store_*_at round-trips through load_*_at") {
+    uint8_t buf[32] = {};
+    BEWriter w(buf, sizeof(buf));
+    REQUIRE(w.ensure(sizeof(buf)));
+    CHECK_FALSE(w.ensure(sizeof(buf) + 1));
+    w.store_u8_at(0, 0x12);
+    w.store_u16_at(1, 0x3456);
+    w.store_u32_at(3, 0x789ABCDEu);
+    w.store_i64_at(7, -42);
+    w.store_f64_at(15, 2.5);
+    w.store_i16_at(23, -3);
+    w.store_f32_at(25, -0.25f);
+    w.store_i8_at(29, -7);
+    CHECK(w.position() == 0);
+    w.advance(30);
+    CHECK(w.position() == 30);
+    CHECK(buf[1] == 0x34);
+    CHECK(buf[2] == 0x56);
+
+    BEReader r(buf, sizeof(buf));
+    CHECK(r.load_u8_at(0) == 0x12);
+    CHECK(r.load_u16_at(1) == 0x3456);
+    CHECK(r.load_u32_at(3) == 0x789ABCDEu);
+    CHECK(r.load_i64_at(7) == -42);
+    CHECK(r.load_f64_at(15) == 2.5);
+    CHECK(r.load_i16_at(23) == -3);
+    CHECK(r.load_f32_at(25) == -0.25f);
+    CHECK(r.load_i8_at(29) == -7);
+}
+
+TEST_CASE("load_bytes_at / store_bytes_at copy raw bytes") {
+    uint8_t buf[8] = {};
+    LEWriter w(buf, sizeof(buf));
+    const char text[] = "abc";
+    w.store_bytes_at(2, text, 3);
+    CHECK(buf[2] == 'a');
+    CHECK(buf[4] == 'c');
+
+    LEReader r(buf, sizeof(buf));
+    r.advance(1);
+    char out[4] = {};
+    r.load_bytes_at(1, out, 3);
+    CHECK(std::memcmp(out, "abc", 3) == 0);
+}
+
+TEST_CASE("*_array_at matches the bulk array methods") {
+    const uint32_t values[] = {0x01020304u, 0xA0B0C0D0u, 7};
+    uint8_t bulk[13] = {};
+    uint8_t at[13] = {};
+    BEWriter bw(bulk, sizeof(bulk));
+    BEWriter aw(at, sizeof(at));
+    CHECK(bw.write_u8(0x55));
+    CHECK(bw.write_u32_array(values, 3));
+    aw.store_u8_at(0, 0x55);
+    aw.store_u32_array_at(1, values, 3);
+    CHECK(std::memcmp(bulk, at, sizeof(bulk)) == 0);
+
+    BEReader r(at, sizeof(at));
+    uint32_t out[3] = {};
+    r.load_u32_array_at(1, out, 3);
+    CHECK(std::memcmp(out, values, sizeof(values)) == 0);
+
+    const double dv[] = {1.5, -2.25};
+    uint8_t dbuf[16] = {};
+    LEWriter dw(dbuf, sizeof(dbuf));
+    dw.store_f64_array_at(0, dv, 2);
+    LEReader dr(dbuf, sizeof(dbuf));
+    double dout[2] = {};
+    dr.load_f64_array_at(0, dout, 2);
+    CHECK(dout[0] == 1.5);
+    CHECK(dout[1] == -2.25);
+}
+
+
+// ============================================================================
+// ByteReaderT – zero-copy views
+// ============================================================================
+
+TEST_CASE("read_view borrows bytes from the source buffer") {
+    const uint8_t buf[] = {1, 2, 3, 4, 5};
+    LEReader r(buf, sizeof(buf));
+    uint8_t first = 0;
+    CHECK(r.read_u8(first));
+    ByteView view;
+    CHECK(r.read_view(view, 3));
+    CHECK(view.data() == buf + 1);
+    CHECK(view.size() == 3);
+    CHECK(view[0] == 2);
+    CHECK(view[2] == 4);
+    CHECK(r.position() == 4);
+
+    size_t sum = 0;
+    for (uint8_t b : view) sum += b;
+    CHECK(sum == 9);
+}
+
+TEST_CASE("read_view out of range leaves the reader untouched") {
+    const uint8_t buf[] = {1, 2, 3};
+    LEReader r(buf, sizeof(buf));
+    ByteView view;
+    CHECK_FALSE(r.read_view(view, 4));
+    CHECK(view.empty());
+    CHECK(r.position() == 0);
+    CHECK(r.read_view(view, 3));
+    CHECK(r.remaining() == 0);
+    CHECK(r.read_view(view, 0));
+    CHECK(view.empty());
+}
+
+TEST_CASE("read_string_view borrows characters from the source buffer") {
+    const char text[] = "name.txt\0rest";
+    BEReader r(text, sizeof(text) - 1);
+    std::string_view name;
+    CHECK(r.read_string_view(name, 8));
+    CHECK(name == "name.txt");
+    CHECK(name.data() == text);
+
+    std::string_view rest;
+    CHECK(r.read_string_view(rest, 5));
+    CHECK(rest.size() == 5);
+    CHECK(rest[0] == '\0');
+    CHECK(rest.substr(1) == "rest");
+    CHECK_FALSE(r.read_string_view(rest, 1));
+}
+
+
+// ============================================================================
+// ByteReaderT – searching
+// ============================================================================
+
+TEST_CASE("FindBytes matches a naive search") {
+    // A four-symbol alphabet makes partial matches common, and the lengths
+    // put matches in the vector blocks as well as in the scalar tail.
+    std::vector<uint8_t> buf(300);
+    uint32_t x = 0x9E3779B9u;
+    for (auto& b : buf) {
+        x = x * 1664525u + 1013904223u;
+        b = static_cast<uint8_t>(0xF0 + (x >> 30));
+    }
+    for (size_t len = 1; len <= 9; ++len) {
+        for (size_t start = 0; start + len <= buf.size(); start += 7) {
+            const uint8_t* needle = buf.data() + start;
+            for (size_t n : {buf.size(), size_t{40}, size_t{17}, len}) {
+                size_t expected = n;
+                for (size_t i = 0; i + len <= n; ++i) {
+                    if (std::memcmp(buf.data() + i, needle, len) == 0) {
+                        expected = i;
+                        break;
+                    }
+                }
+                CHECK(detail::FindBytes(buf.data(), n, needle, len) ==
+                      expected);
+            }
+        }
+    }
+    const uint8_t absent[] = {0x00, 0x01};
+    CHECK(detail::FindBytes(buf.data(), buf.size(), absent, 2) == buf.size());
+}
+
+TEST_CASE("find_* search past the cursor in the reader's byte order") {
+    const uint8_t buf[] = {0xAA, 0xCE, 0xFA, 0xED, 0xFE, 0x00,
+                           0xFE, 0xED, 0xFA, 0xCE, 0xCE, 0xFA};
+    LEReader le(buf, sizeof(buf));
+    CHECK(le.find_u32(0xFEEDFACEu) == 1);
+    CHECK(le.find_u32(0xFEEDFACEu, 2) == LEReader::npos);
+    CHECK(le.find_u16(0xFACEu, 2) == 10);
+    CHECK(le.find_u8(0xFE, 5) == 6);
+    CHECK(le.find_u8(0xFE, sizeof(buf) + 1) == LEReader::npos);
+
+    BEReader be(buf, sizeof(buf));
+    CHECK(be.find_u32(0xFEEDFACEu) == 6);
+    CHECK(be.skip(3));
+    CHECK(be.find_u32(0xFEEDFACEu) == 3);
+    CHECK(be.find_u64(0xFEEDFACECEFA0000u) == BEReader::npos);
+    CHECK(be.find_bytes("\xCE\xCE", 2) == 6);
+    CHECK(be.position() == 3);
+}
+
+TEST_CASE("resync moves to the next magic and always makes progress") {
+    const uint8_t buf[] = {0x11, 0x22, 0x33, 0x44, 0x00, 0x11,
+                           0x22, 0x33, 0x44, 0x11, 0x22, 0x33};
+    BEReader r(buf, sizeof(buf));
+    CHECK(r.resync_u32(0x11223344u));
+    CHECK(r.position() == 5);
+    CHECK(r.resync_u32(0x11223344u).code == StatusCode::OutOfRange);
+    CHECK(r.position() == 5);
+
+    const uint8_t marker[] = {0x22, 0x33};
+    CHECK(r.resync(marker, sizeof(marker)));
+    CHECK(r.position() == 6);
+    CHECK(r.resync(marker, sizeof(marker)));
+    CHECK(r.position() == 10);
+    CHECK_FALSE(r.resync(marker, sizeof(marker)));
+    CHECK(r.position() == 10);
+}
+
+
+// ============================================================================
+// ByteReaderT – lookahead and checkpoints
+// ============================================================================
+
+TEST_CASE("peek_* read past the cursor without consuming") {
+    const uint8_t buf[] = {0x01, 0x02, 0x03, 0x04, 0x05,
+                           0x06, 0x07, 0x08, 0xFF};
+    BEReader r(buf, sizeof(buf));
+    uint8_t u8 = 0;
+    uint16_t u16 = 0;
+    uint32_t u32 = 0;
+    uint64_t u64 = 0;
+    int8_t i8 = 0;
+    int16_t i16 = 0;
+    CHECK(r.peek_u8(u8));
+    CHECK(u8 == 0x01);
+    CHECK(r.peek_u16(u16, 1));
+    CHECK(u16 == 0x0203);
+    CHECK(r.peek_u32(u32, 5));
+    CHECK(u32 == 0x060708FFu);
+    CHECK(r.peek_u64(u64, 1));
+    CHECK(u64 == 0x02030405060708FFull);
+    CHECK(r.peek_i8(i8, 8));
+    CHECK(i8 == -1);
+    CHECK(r.peek_i16(i16, 7));
+    CHECK(i16 == 0x08FF);
+    CHECK(r.position() == 0);
+
+    // Out-of-range peeks fail without touching the output or the cursor.
+    u32 = 0xAAAAAAAAu;
+    CHECK(r.peek_u32(u32, 6).code == StatusCode::OutOfRange);
+    CHECK(u32 == 0xAAAAAAAAu);
+    CHECK_FALSE(r.peek_u8(u8, sizeof(buf)));
+    CHECK_FALSE(r.peek_u16(u16, SIZE_MAX));
+    CHECK(r.skip(8));
+    CHECK_FALSE(r.peek_u16(u16));
+    CHECK(r.peek_u8(u8));
+    CHECK(u8 == 0xFF);
+    CHECK(r.remaining() == 1);
+}
+
+TEST_CASE("rewind() returns to a checkpoint after a speculative parse") {
+    const uint8_t buf[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06};
+    LEReader r(buf, sizeof(buf));
+    CHECK(r.skip(1));
+    const LEReader::Checkpoint saved = r.checkpoint();
+
+    uint32_t u32 = 0;
+    uint16_t u16 = 0;
+    CHECK(r.read_u32(u32));
+    CHECK_FALSE(r.read_u16(u16));
+    r.rewind(saved);
+    CHECK(r.position() == 1);
+    CHECK(r.remaining() == 5);
+    CHECK(r.read_u16(u16));
+    CHECK(u16 == 0x0302);
+}
+
+TEST_CASE("seek() moves to an absolute position within the buffer") {
+    const uint8_t buf[] = {0x10, 0x20, 0x30, 0x40};
+    LEReader r(buf, sizeof(buf));
+    uint8_t u8 = 0;
+    CHECK(r.seek(3));
+    CHECK(r.read_u8(u8));
+    CHECK(u8 == 0x40);
+    CHECK(r.seek(1));
+    CHECK(r.position() == 1);
+    CHECK(r.read_u8(u8));
+    CHECK(u8 == 0x20);
+    CHECK(r.seek(sizeof(buf)));
+    CHECK(r.remaining() == 0);
+    CHECK(r.seek(sizeof(buf) + 1).code == StatusCode::OutOfRange);
+    CHECK(r.position() == sizeof(buf));
+    CHECK(r.seek(0));
+    CHECK(r.remaining() == sizeof(buf));
+}
+
+#if defined(__cpp_lib_bit_cast) && defined(__cpp_lib_is_constant_evaluated)
+static constexpr uint32_t peek_then_rewind() {
+    constexpr uint8_t kBuf[] = {0xAB, 0x01, 0x02, 0x03, 0x04};
+    BEReader r(kBuf, sizeof(kBuf));
+    uint8_t tag = 0;
+    uint32_t body = 0;
+    if (!r.peek_u8(tag) || tag != 0xAB) return 0;
+    const auto saved = r.checkpoint();
+    if (!r.seek(1) || !r.read_u32(body)) return 0;
+    r.rewind(saved);
+    return r.position() == 0 ? body : 0;
+}
+static_assert(peek_then_rewind() == 0x01020304u);
+#endif
+
+
+// ============================================================================
+// DynamicByteWriterT
+// ============================================================================
+
+TEST_CASE("DynamicByteWriterT grows past its initial capacity") {
+    DynamicLEWriter w(4);
+    CHECK(w.capacity() == 4);
+    CHECK(w.write_u32(0x04030201u));
+    CHECK(w.remaining() == 0);
+    CHECK(w.write_u64(0x0807060504030201ull));
+    CHECK(w.write_u8(0xAA));
+    CHECK(w.size() == 13);
+    CHECK(w.position() == 13);
+    CHECK(w.capacity() >= 13);
+    CHECK(w.data()[0] == 0x01);
+    CHECK(w.data()[4] == 0x01);
+    CHECK(w.data()[11] == 0x08);
+    CHECK(w.data()[12] == 0xAA);
+}
+
+TEST_CASE("DynamicByteWriterT output matches a fixed writer") {
+    uint8_t fixed[64] = {};
+    BEWriter fw(fixed, sizeof(fixed));
+    DynamicBEWriter dw;
+    CHECK(dw.capacity() == 0);
+
+    const float samples[] = {1.0f, -2.0f, 3.5f};
+    for (ByteWriterT<BigEndianCodec>* w :
+         {static_cast<ByteWriterT<BigEndianCodec>*>(&fw),
+          static_cast<ByteWriterT<BigEndianCodec>*>(&dw)}) {
+        CHECK(w->write_u16(0xCAFE));
+        CHECK(w->write_i32(-5));
+        CHECK(w->skip(3));
+        CHECK(w->write_f32_array(samples, 3));
+        CHECK(w->write_bytes("xyz", 3));
+        CHECK(w->write_f64(0.125));
+    }
+    REQUIRE(dw.size() == fw.position());
+    CHECK(std::memcmp(dw.data(), fixed, dw.size()) == 0);
+    CHECK(dw.view().size() == dw.size());
+}
+
+TEST_CASE("DynamicByteWriterT grows for ensure, skip and bulk writes") {
+    DynamicLEWriter w;
+    CHECK(w.ensure(10));
+    CHECK(w.remaining() >= 10);
+    w.store_u16_at(0, 0x1234);
+    w.advance(2);
+    CHECK(w.skip(200));
+    CHECK(w.data()[100] == 0);
+
+    std::vector<uint32_t> values(1000);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<uint32_t>(i);
+    }
+    CHECK(w.write_u32_array(values.data(), values.size()));
+    CHECK(w.size() == 202 + 4000);
+    LEReader r(w.data(), w.size());
+    uint16_t head = 0;
+    CHECK(r.read_u16(head));
+    CHECK(head == 0x1234);
+    CHECK(r.skip(200));
+    std::vector<uint32_t> back(values.size());
+    CHECK(r.read_u32_array(back.data(), back.size()));
+    CHECK(back == values);
+}
+
+TEST_CASE("DynamicByteWriterT clear keeps capacity") {
+    DynamicLEWriter w;
+    CHECK(w.write_u64(1));
+    const size_t capacity = w.capacity();
+    w.clear();
+    CHECK(w.size() == 0);
+    CHECK(w.capacity() == capacity);
+    CHECK(w.write_u8(7));
+    CHECK(w.data()[0] == 7);
+}
+
+TEST_CASE("Copies of a dynamic writer do not grow") {
+    DynamicLEWriter w(8);
+    LEWriter copy = w;
+    CHECK(copy.write_u64(1));
+    CHECK_FALSE(copy.write_u8(1));
+    CHECK(w.write_u64(2));
+    CHECK(w.write_u8(3));
+}
+
+TEST_CASE("DynamicByteWriterT with an arena allocator") {
+    alignas(std::max_align_t) uint8_t arena[4096];
+    std::pmr::monotonic_buffer_resource resource(
+        arena, sizeof(arena), std::pmr::null_memory_resource());
+    using ArenaWriter =
+        DynamicByteWriterT<LittleEndianCodec,
+                           std::pmr::polymorphic_allocator<uint8_t>>;
+    ArenaWriter w(0, &resource);
+    for (uint32_t i = 0; i < 100; ++i) CHECK(w.write_u32(i));
+    CHECK(w.size() == 400);
+    CHECK(w.data() >= arena);
+    CHECK(w.data() < arena + sizeof(arena));
+    LEReader r(w.data(), w.size());
+    uint32_t v = 0;
+    CHECK(r.skip(99 * 4));
+    CHECK(r.read_u32(v));
+    CHECK(v == 99);
+}
+
+
+// ============================================================================
+// SizeCounterT
+// ============================================================================
+
+template <typename Writer>
+Status write_sample_record(Writer& w) {
+    const uint16_t words[] = {1, 2, 3};
+    Status s = w.write_u8(1);
+    if (!s) return s;
+    s = w.write_i16(-2);
+    if (!s) return s;
+    s = w.write_f64(3.0);
+    if (!s) return s;
+    s = w.write_u16_array(words, 3);
+    if (!s) return s;
+    s = w.skip(5);
+    if (!s) return s;
+    s = w.write_bytes("abcd", 4);
+    if (!s) return s;
+    s = w.ensure(6);
+    if (!s) return s;
+    w.store_u32_at(0, 0xDEADBEEFu);
+    w.store_u16_at(4, 0xBEEF);
+    w.advance(6);
+    return Status::Ok();
+}
+
+TEST_CASE("SizeCounterT counts exactly what a writer writes") {
+    LESizeCounter counter;
+    CHECK(write_sample_record(counter));
+    CHECK(counter.size() == 1 + 2 + 8 + 6 + 5 + 4 + 6);
+
+    std::vector<uint8_t> buf(counter.size());
+    LEWriter exact(buf.data(), buf.size());
+    CHECK(write_sample_record(exact));
+    CHECK(exact.remaining() == 0);
+
+    std::vector<uint8_t> small(counter.size() - 1);
+    LEWriter short_writer(small.data(), small.size());
+    CHECK_FALSE(write_sample_record(short_writer));
+}
+
+TEST_CASE("SizeCounterT never fails and can be cleared") {
+    BESizeCounter counter;
+    CHECK(counter.write_u64_array(nullptr, 1000));
+    CHECK(counter.ensure(SIZE_MAX));
+    CHECK(counter.position() == 8000);
+    CHECK(counter.remaining() == SIZE_MAX - 8000);
+    counter.clear();
+    CHECK(counter.size() == 0);
+}
+
+
+// ============================================================================
+// ChunkedReaderT
+// ============================================================================
+
+TEST_CASE("ChunkedReaderT reads values that straddle segments") {
+    // 0x0102 | 0x03040506 | 0x0708090A0B0C0D0E split at awkward places.
+    const uint8_t a[] = {0x01, 0x02, 0x03};
+    const uint8_t b[] = {0x04};
+    const uint8_t c[] = {0x05, 0x06, 0x07, 0x08, 0x09};
+    const uint8_t d[] = {0x0A, 0x0B, 0x0C, 0x0D, 0x0E};
+    const ByteSegment segments[] = {
+        {a, sizeof(a)}, {b, sizeof(b)}, {nullptr, 0}, {c, sizeof(c)},
+        {d, sizeof(d)}};
+    BEChunkedReader r(segments, 5);
+    CHECK(r.remaining() == 14);
+
+    uint16_t u16 = 0;
+    uint32_t u32 = 0;
+    uint64_t u64 = 0;
+    CHECK(r.read_u16(u16));
+    CHECK(u16 == 0x0102);
+    CHECK(r.read_u32(u32));
+    CHECK(u32 == 0x03040506u);
+    CHECK(r.position() == 6);
+    CHECK(r.read_u64(u64));
+    CHECK(u64 == 0x0708090A0B0C0D0Eull);
+    CHECK(r.remaining() == 0);
+    uint8_t u8 = 0;
+    CHECK_FALSE(r.read_u8(u8));
+}
+
+TEST_CASE("ChunkedReaderT matches ByteReaderT on every split") {
+    uint8_t buf[40];
+    for (size_t i = 0; i < sizeof(buf); ++i) {
+        buf[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+    LEReader ref(buf, sizeof(buf));
+    uint64_t e64 = 0;
+    int32_t ei32 = 0;
+    double ef64 = 0;
+    uint16_t earr[5] = {};
+    uint8_t ebytes[7] = {};
+    CHECK(ref.read_u64(e64));
+    CHECK(ref.read_i32(ei32));
+    CHECK(ref.read_f64(ef64));
+    CHECK(ref.read_u16_array(earr, 5));
+    CHECK(ref.read_bytes(ebytes, 7));
+
+    for (size_t cut1 = 0; cut1 <= sizeof(buf); ++cut1) {
+        for (size_t cut2 = cut1; cut2 <= sizeof(buf); cut2 += 3) {
+            const ByteSegment segments[] = {
+                {buf, cut1},
+                {buf + cut1, cut2 - cut1},
+                {buf + cut2, sizeof(buf) - cut2}};
+            LEChunkedReader r(segments, 3);
+            uint64_t v64 = 0;
+            int32_t vi32 = 0;
+            double vf64 = 0;
+            uint16_t arr[5] = {};
+            uint8_t bytes[7] = {};
+            REQUIRE(r.read_u64(v64));
+            REQUIRE(r.read_i32(vi32));
+            REQUIRE(r.read_f64(vf64));
+            REQUIRE(r.read_u16_array(arr, 5));
+            REQUIRE(r.read_bytes(bytes, 7));
+            CHECK(v64 == e64);
+            CHECK(vi32 == ei32);
+            CHECK(std::memcmp(&vf64, &ef64, sizeof(ef64)) == 0);
+            CHECK(std::memcmp(arr, earr, sizeof(arr)) == 0);
+            CHECK(std::memcmp(bytes, ebytes, sizeof(bytes)) == 0);
+            CHECK(r.position() == ref.position());
+        }
+    }
+}
+
+TEST_CASE("ChunkedReaderT failed reads consume nothing") {
+    const uint8_t a[] = {1, 2};
+    const uint8_t b[] = {3};
+    const ByteSegment segments[] = {{a, 2}, {b, 1}};
+    LEChunkedReader r(segments, 2);
+    uint32_t v = 0;
+    CHECK_FALSE(r.read_u32(v));
+    uint16_t arr[2] = {};
+    CHECK_FALSE(r.read_u16_array(arr, 2));
+    CHECK_FALSE(r.skip(4));
+    CHECK(r.position() == 0);
+    uint8_t out[3] = {};
+    CHECK(r.read_bytes(out, 3));
+    CHECK(out[2] == 3);
+}
+
+TEST_CASE("ChunkedReaderT load_*_at across segments") {
+    const uint8_t a[] = {0xFF, 0x01, 0x02};
+    const uint8_t b[] = {0x03, 0x04, 0x00, 0x00};
+    const uint8_t c[] = {0x80, 0x3F, 0x10, 0x20};
+    const ByteSegment segments[] = {{a, 3}, {b, 4}, {c, 4}};
+    LEChunkedReader r(segments, 3);
+    r.advance(1);
+    REQUIRE(r.ensure(10));
+    CHECK_FALSE(r.ensure(11));
+    CHECK(r.load_u8_at(0) == 0x01);
+    CHECK(r.load_u32_at(0) == 0x04030201u);
+    CHECK(r.load_f32_at(4) == 1.0f);
+    CHECK(r.load_i8_at(2) == 3);
+    uint16_t words[2] = {};
+    r.load_u16_array_at(6, words, 2);
+    CHECK(words[0] == 0x3F80);
+    CHECK(words[1] == 0x2010);
+    uint8_t bytes[4] = {};
+    r.load_bytes_at(1, bytes, 4);
+    CHECK(bytes[0] == 0x02);
+    CHECK(bytes[3] == 0x00);
+    CHECK(r.position() == 1);
+    r.advance(10);
+    CHECK(r.remaining() == 0);
+}
+
+TEST_CASE("ChunkedReaderT over no segments") {
+    LEChunkedReader r(nullptr, 0);
+    CHECK(r.remaining() == 0);
+    CHECK(r.skip(0));
+    uint8_t v = 0;
+    CHECK_FALSE(r.read_u8(v));
+}
+
+TEST_CASE("ChunkedReaderT peeks, seeks and rewinds across segments") {
+    const uint8_t a[] = {0x01, 0x02, 0x03};
+    const uint8_t b[] = {0x04};
+    const uint8_t c[] = {0x05, 0x06, 0x07};
+    const ByteSegment segments[] = {
+        {a, sizeof(a)}, {nullptr, 0}, {b, sizeof(b)}, {c, sizeof(c)}};
+    BEChunkedReader r(segments, 4);
+
+    uint32_t u32 = 0;
+    uint16_t u16 = 0;
+    CHECK(r.peek_u32(u32, 1));
+    CHECK(u32 == 0x02030405u);
+    CHECK(r.position() == 0);
+    CHECK_FALSE(r.peek_u32(u32, 4));
+
+    CHECK(r.seek(2));
+    const BEChunkedReader::Checkpoint saved = r.checkpoint();
+    CHECK(r.read_u32(u32));
+    CHECK(u32 == 0x03040506u);
+    r.rewind(saved);
+    CHECK(r.position() == 2);
+    CHECK(r.remaining() == 5);
+    CHECK(r.read_u16(u16));
+    CHECK(u16 == 0x0304);
+
+    CHECK(r.seek(0));
+    CHECK(r.read_u16(u16));
+    CHECK(u16 == 0x0102);
+    CHECK(r.seek(7));
+    CHECK(r.remaining() == 0);
+    CHECK_FALSE(r.seek(8));
+    CHECK(r.position() == 7);
+}
+
+
+// ============================================================================
+// StreamReaderT
+// ============================================================================
+
+namespace {
+
+/// In-memory source that serves at most max_read bytes per call and counts
+/// the calls, so tests can observe refills and seeks.
+struct MemorySource {
+    const uint8_t* data;
+    size_t size;
+    size_t max_read = SIZE_MAX;
+    bool seekable = true;
+    uint64_t offset = 0;
+    size_t reads = 0;
+    size_t seeks = 0;
+
+    size_t read(void* out, size_t len) {
+        ++reads;
+        size_t n = size - static_cast<size_t>(offset);
+        if (n > len) n = len;
+        if (n > max_read) n = max_read;
+        if (n != 0) std::memcpy(out, data + offset, n);
+        offset += n;
+        return n;
+    }
+
+    bool seek(uint64_t target) {
+        if (!seekable || target > size) return false;
+        ++seeks;
+        offset = target;
+        return true;
+    }
+};
+
+std::vector<uint8_t> iota_bytes(size_t n) {
+    std::vector<uint8_t> v(n);
+    for (size_t i = 0; i < n; ++i) v[i] = static_cast<uint8_t>(i);
+    return v;
+}
+
+}  // namespace
+
+TEST_CASE("StreamReaderT scalar reads refill the window") {
+    const auto data = iota_bytes(64);
+    MemorySource src{data.data(), data.size()};
+    uint8_t window[8];
+    LEStreamReader<MemorySource> r(src, window, sizeof(window));
+
+    uint8_t u8 = 0;
+    REQUIRE(r.read_u8(u8));
+    CHECK(u8 == 0x00);
+    uint64_t u64 = 0;
+    REQUIRE(r.read_u64(u64));  // straddles the first refill
+    CHECK(u64 == 0x0807060504030201ull);
+    uint32_t u32 = 0;
+    REQUIRE(r.read_u32(u32));
+    CHECK(u32 == 0x0C0B0A09u);
+    int16_t i16 = 0;
+    REQUIRE(r.read_i16(i16));
+    CHECK(i16 == 0x0E0D);
+    CHECK(r.position() == 15);
+    CHECK(src.reads >= 2);
+}
+
+TEST_CASE("StreamReaderT matches ByteReaderT for big-endian data") {
+    const auto data = iota_bytes(200);
+    MemorySource src{data.data(), data.size(), 5};
+    uint8_t window[16];
+    BEStreamReader<MemorySource> r(src, window, sizeof(window));
+    BEReader ref(data.data(), data.size());
+
+    uint16_t u16 = 0, e16 = 0;
+    REQUIRE(r.read_u16(u16));
+    REQUIRE(ref.read_u16(e16));
+    CHECK(u16 == e16);
+    float f = 0, ef = 0;
+    REQUIRE(r.read_f32(f));
+    REQUIRE(ref.read_f32(ef));
+    CHECK(std::memcmp(&f, &ef, sizeof(f)) == 0);
+    uint32_t arr[20] = {}, earr[20] = {};
+    REQUIRE(r.read_u32_array(arr, 20));  // longer than the window
+    REQUIRE(ref.read_u32_array(earr, 20));
+    CHECK(std::memcmp(arr, earr, sizeof(arr)) == 0);
+    int64_t i64 = 0, ei64 = 0;
+    REQUIRE(r.read_i64(i64));
+    REQUIRE(ref.read_i64(ei64));
+    CHECK(i64 == ei64);
+    CHECK(r.position() == ref.position());
+}
+
+TEST_CASE("StreamReaderT read_bytes larger than the window") {
+    const auto data = iota_bytes(100);
+    MemorySource src{data.data(), data.size(), 7};
+    uint8_t window[16];
+    LEStreamReader<MemorySource> r(src, window, sizeof(window));
+
+    uint8_t head = 0;
+    REQUIRE(r.read_u8(head));
+    uint8_t out[90] = {};
+    REQUIRE(r.read_bytes(out, sizeof(out)));
+    CHECK(std::memcmp(out, data.data() + 1, sizeof(out)) == 0);
+    uint8_t tail[9] = {};
+    REQUIRE(r.read_bytes(tail, sizeof(tail)));
+    CHECK(tail[8] == 99);
+    CHECK(r.position() == 100);
+    CHECK_FALSE(r.read_u8(head));
+}
+
+TEST_CASE("StreamReaderT skip seeks past the window") {
+    const auto data = iota_bytes(1000);
+    MemorySource src{data.data(), data.size()};
+    uint8_t window[32];
+    LEStreamReader<MemorySource> r(src, window, sizeof(window));
+
+    uint8_t v = 0;
+    REQUIRE(r.read_u8(v));
+    REQUIRE(r.skip(3));  // inside the window
+    CHECK(src.seeks == 0);
+    REQUIRE(r.read_u8(v));
+    CHECK(v == 4);
+    REQUIRE(r.skip(500));
+    CHECK(src.seeks == 1);
+    CHECK(r.position() == 505);
+    REQUIRE(r.read_u8(v));
+    CHECK(v == static_cast<uint8_t>(505));
+    CHECK_FALSE(r.skip(1000));
+}
+
+TEST_CASE("StreamReaderT skip falls back to reading") {
+    const auto data = iota_bytes(300);
+    MemorySource src{data.data(), data.size(), SIZE_MAX, false};
+    uint8_t window[16];
+    LEStreamReader<MemorySource> r(src, window, sizeof(window));
+
+    REQUIRE(r.skip(250));
+    CHECK(r.position() == 250);
+    uint8_t v = 0;
+    REQUIRE(r.read_u8(v));
+    CHECK(v == 250);
+    CHECK_FALSE(r.skip(50));
+}
+
+TEST_CASE("StreamReaderT failed scalar reads consume nothing") {
+    const uint8_t data[] = {1, 2, 3};
+    MemorySource src{data, sizeof(data)};
+    uint8_t window[8];
+    LEStreamReader<MemorySource> r(src, window, sizeof(window));
+
+    uint32_t v = 0;
+    CHECK_FALSE(r.read_u32(v));
+    CHECK(r.position() == 0);
+    uint16_t w = 0;
+    REQUIRE(r.read_u16(w));
+    CHECK(w == 0x0201);
+}
+
+TEST_CASE("StreamReaderT failed reads that fit in the window consume nothing") {
+    const uint8_t data[] = {1, 2, 3, 4, 5};
+    MemorySource src{data, sizeof(data)};
+    uint8_t window[16];
+    LEStreamReader<MemorySource> r(src, window, sizeof(window));
+
+    uint8_t b = 0;
+    REQUIRE(r.read_u8(b));
+    uint8_t out[8] = {};
+    CHECK_FALSE(r.read_bytes(out, sizeof(out)));  // 4 bytes buffered
+    CHECK(r.position() == 1);
+    uint16_t words[3] = {};
+    CHECK_FALSE(r.read_u16_array(words, 3));
+    CHECK(r.position() == 1);
+    REQUIRE(r.read_bytes(out, 4));
+    CHECK(out[0] == 2);
+    CHECK(out[3] == 5);
+}
+
+TEST_CASE("StreamReaderT ensure and load_*_at use the window") {
+    const auto data = iota_bytes(40);
+    MemorySource src{data.data(), data.size(), 3};
+    uint8_t window[16];
+    LEStreamReader<MemorySource> r(src, window, sizeof(window));
+
+    r.advance(0);
+    REQUIRE(r.ensure(12));
+    CHECK(r.buffered() >= 12);
+    CHECK(r.load_u8_at(0) == 0);
+    CHECK(r.load_u32_at(4) == 0x07060504u);
+    uint16_t words[2] = {};
+    r.load_u16_array_at(8, words, 2);
+    CHECK(words[1] == 0x0B0A);
+    r.advance(12);
+    CHECK(r.position() == 12);
+    CHECK_FALSE(r.ensure(17));  // larger than the window
+    REQUIRE(r.ensure(16));
+    CHECK(r.load_u8_at(15) == 27);
+}
+
+TEST_CASE("StreamReaderT over std::istream") {
+    std::string bytes;
+    for (int i = 0; i < 64; ++i) bytes.push_back(static_cast<char>(i));
+    std::istringstream in(bytes);
+    IStreamSource src(in);
+    uint8_t window[8];
+    LEStreamReader<IStreamSource> r(src, window, sizeof(window));
+
+    uint32_t v = 0;
+    REQUIRE(r.read_u32(v));
+    CHECK(v == 0x03020100u);
+    REQUIRE(r.skip(40));
+    REQUIRE(r.read_u32(v));
+    CHECK(v == 0x2F2E2D2Cu);
+    uint8_t rest[12] = {};
+    REQUIRE(r.read_bytes(rest, sizeof(rest)));
+    CHECK(rest[11] == 59);
+    CHECK_FALSE(r.skip(100));  // seek refused, drains the stream instead
+    CHECK(r.position() == 64);
+    uint8_t b = 0;
+    CHECK_FALSE(r.read_u8(b));
+}
+
+TEST_CASE("StreamReaderT skips relative to where a std::istream started") {
+    std::string bytes;
+    for (int i = 0; i < 256; ++i) bytes.push_back(static_cast<char>(i));
+    std::istringstream in(bytes);
+    in.seekg(50);
+    IStreamSource src(in);
+    uint8_t window[8];
+    LEStreamReader<IStreamSource> r(src, window, sizeof(window));
+
+    uint8_t v = 0;
+    REQUIRE(r.read_u8(v));
+    CHECK(v == 50);
+    REQUIRE(r.skip(100));
+    REQUIRE(r.read_u8(v));
+    CHECK(v == 151);
+    CHECK(r.position() == 102);
+    CHECK_FALSE(r.skip(205));  // one past the end
+}
+
+#if defined(BIO_HAS_FD_SOURCE)
+TEST_CASE("StreamReaderT over a file descriptor") {
+    std::FILE* file = std::tmpfile();
+    REQUIRE(file != nullptr);
+    const auto data = iota_bytes(256);
+    REQUIRE(std::fwrite(data.data(), 1, data.size(), file) == data.size());
+    REQUIRE(std::fflush(file) == 0);
+
+    FdSource src(fileno(file));
+    uint8_t window[16];
+    BEStreamReader<FdSource> r(src, window, sizeof(window));
+    uint16_t v = 0;
+    REQUIRE(r.read_u16(v));
+    CHECK(v == 0x0001);
+    REQUIRE(r.skip(200));
+    REQUIRE(r.read_u16(v));
+    CHECK(v == 0xCACB);
+    uint8_t rest[52] = {};
+    REQUIRE(r.read_bytes(rest, sizeof(rest)));
+    CHECK(rest[51] == 255);
+    CHECK_FALSE(r.read_u16(v));
+    CHECK_FALSE(r.skip(1));
+    std::fclose(file);
+}
+
+TEST_CASE("StreamReaderT skips relative to a file descriptor's start offset") {
+    std::FILE* file = std::tmpfile();
+    REQUIRE(file != nullptr);
+    const auto data = iota_bytes(256);
+    REQUIRE(std::fwrite(data.data(), 1, data.size(), file) == data.size());
+    REQUIRE(std::fflush(file) == 0);
+
+    FdSource src(fileno(file), 50);
+    uint8_t window[8];
+    LEStreamReader<FdSource> r(src, window, sizeof(window));
+    uint8_t v = 0;
+    REQUIRE(r.read_u8(v));
+    CHECK(v == 50);
+    REQUIRE(r.skip(100));
+    REQUIRE(r.read_u8(v));
+    CHECK(v == 151);
+    REQUIRE(r.skip(104));  // lands exactly on the end
+    CHECK_FALSE(r.read_u8(v));
+    CHECK(r.position() == 206);
+    std::fclose(file);
+}
+#endif
+
+// ============================================================================
+// MappedFile
+// ============================================================================
+
+namespace {
+
+/// Writes @p data to a fresh temporary file and removes it on destruction.
+struct TempFile {
+    std::string path;
+
+    explicit TempFile(const std::vector<uint8_t>& data) {
+        char name[] = "/tmp/bio_mapped_XXXXXX";
+        const int fd = ::mkstemp(name);
+        REQUIRE(fd >= 0);
+        path = name;
+        std::FILE* file = ::fdopen(fd, "wb");
+        REQUIRE(file != nullptr);
+        if (!data.empty()) {
+            REQUIRE(std::fwrite(data.data(), 1, data.size(), file) ==
+                    data.size());
+        }
+        std::fclose(file);
+    }
+
+    ~TempFile() { std::remove(path.c_str()); }
+};
+
+}  // namespace
+
+#if !defined(_WIN32)
+TEST_CASE("MappedFile maps a file for reading") {
+    const auto data = iota_bytes(5000);
+    TempFile tmp(data);
+    MappedFile file;
+    REQUIRE(file.open(tmp.path.c_str()));
+    REQUIRE(file.size() == data.size());
+    CHECK(std::memcmp(file.data(), data.data(), data.size()) == 0);
+    CHECK(file.view().size() == data.size());
+
+    auto le = file.le_reader();
+    uint32_t v = 0;
+    REQUIRE(le.read_u32(v));
+    CHECK(v == 0x03020100u);
+    auto be = file.be_reader();
+    REQUIRE(be.read_u32(v));
+    CHECK(v == 0x00010203u);
+    CHECK(be.remaining() == data.size() - 4);
+}
+
+TEST_CASE("MappedFile hints and prefetch") {
+    const auto data = iota_bytes(3 * 4096 + 17);
+    TempFile tmp(data);
+    MappedFile file;
+    REQUIRE(file.open(tmp.path.c_str()));
+    file.advise(MappedFile::Access::Sequential);
+    file.advise(MappedFile::Access::Random);
+    file.advise(MappedFile::Access::Normal);
+    file.will_need(100, 10000);
+    file.will_need(data.size(), 1);  // past the end: ignored
+
+    auto reader = file.le_reader();
+    uint64_t sum = 0;
+    bool ok = true;
+    while (reader.remaining() != 0) {
+        file.prefetch(reader, 1024);
+        uint8_t b = 0;
+        ok &= static_cast<bool>(reader.read_u8(b));
+        sum += b;
+    }
+    CHECK(ok);
+    uint64_t expected = 0;
+    for (uint8_t b : data) expected += b;
+    CHECK(sum == expected);
+}
+
+TEST_CASE("MappedFile empty file, failure and move") {
+    TempFile empty(std::vector<uint8_t>{});
+    MappedFile file;
+    REQUIRE(file.open(empty.path.c_str()));
+    CHECK(file.size() == 0);
+    CHECK(file.data() == nullptr);
+    CHECK(file.le_reader().remaining() == 0);
+
+    CHECK_FALSE(file.open("/nonexistent/bio_mapped_file"));
+    CHECK(file.size() == 0);
+
+    const auto data = iota_bytes(64);
+    TempFile tmp(data);
+    REQUIRE(file.open(tmp.path.c_str()));
+    MappedFile moved(std::move(file));
+    CHECK(file.data() == nullptr);
+    REQUIRE(moved.size() == 64);
+    CHECK(moved.data()[63] == 63);
+    MappedFile assigned;
+    assigned = std::move(moved);
+    CHECK(assigned.size() == 64);
+    assigned.close();
+    CHECK(assigned.data() == nullptr);
+}
+#endif
+
+// ============================================================================
+// CRC-32 / CRC-32C
+// ============================================================================
+
+namespace {
+
+uint32_t reference_crc(const uint8_t* p, size_t n, uint32_t poly) {
+    uint32_t crc = ~0u;
+    for (size_t i = 0; i < n; ++i) {
+        crc ^= p[i];
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ ((crc & 1u) != 0 ? poly : 0u);
+        }
+    }
+    return ~crc;
+}
+
+std::vector<uint8_t> pseudo_random_bytes(size_t n) {
+    std::vector<uint8_t> v(n);
+    uint32_t x = 0x12345678u;
+    for (auto& b : v) {
+        x = x * 1664525u + 1013904223u;
+        b = static_cast<uint8_t>(x >> 24);
+    }
+    return v;
+}
+
+}  // namespace
+
+TEST_CASE("crc32 / crc32c check values") {
+    const char* check = "123456789";
+    CHECK(crc32(check, 9) == 0xCBF43926u);
+    CHECK(crc32c(check, 9) == 0xE3069283u);
+    CHECK(crc32(nullptr, 0) == 0u);
+    CHECK(crc32c(nullptr, 0) == 0u);
+}
+
+TEST_CASE("crc32 / crc32c match a bitwise reference") {
+    const auto data = pseudo_random_bytes(1100);
+    // Lengths around the 8-byte step and the 16/64-byte folding blocks, at
+    // every alignment.
+    for (size_t offset = 0; offset < 8; ++offset) {
+        for (size_t n = 0; n + offset <= data.size(); n += n < 160 ? 1 : 61) {
+            const uint8_t* p = data.data() + offset;
+            CHECK(crc32(p, n) == reference_crc(p, n, 0xEDB88320u));
+            CHECK(crc32c(p, n) == reference_crc(p, n, 0x82F63B78u));
+        }
+    }
+}
+
+TEST_CASE("crc32 continues across pieces") {
+    const auto data = pseudo_random_bytes(777);
+    const uint32_t whole = crc32(data.data(), data.size());
+    const uint32_t whole_c = crc32c(data.data(), data.size());
+    for (size_t split : {size_t{0}, size_t{1}, size_t{63}, size_t{64},
+                         size_t{500}, data.size()}) {
+        const uint32_t head = crc32(data.data(), split);
+        CHECK(crc32(data.data() + split, data.size() - split, head) == whole);
+        const uint32_t head_c = crc32c(data.data(), split);
+        CHECK(crc32c(data.data() + split, data.size() - split, head_c) ==
+              whole_c);
+    }
+    Crc32 running;
+    running.update(data.data(), 100);
+    running.update(data.data() + 100, data.size() - 100);
+    CHECK(running.value() == whole);
+    running.reset();
+    CHECK(running.value() == 0u);
+}
+
+TEST_CASE("ChecksumReaderT checksums consumed bytes") {
+    const auto data = pseudo_random_bytes(300);
+    ChecksumReaderT<BigEndianCodec, Crc32c> r(data.data(), data.size());
+    uint16_t u16 = 0;
+    REQUIRE(r.read_u16(u16));
+    CHECK(r.checksum() == crc32c(data.data(), 2));
+
+    uint32_t words[40] = {};
+    REQUIRE(r.read_u32_array(words, 40));
+    REQUIRE(r.skip(10));
+    REQUIRE(r.ensure(8));
+    CHECK(r.load_u64_at(0) == BEReader(data.data() + 172, 8).load_u64_at(0));
+    r.advance(8);
+    double f64 = 0;
+    REQUIRE(r.read_f64(f64));
+    CHECK(r.position() == 188);
+    CHECK(r.checksum() == crc32c(data.data(), 188));
+
+    uint8_t too_many[200] = {};
+    CHECK_FALSE(r.read_bytes(too_many, sizeof(too_many)));
+    CHECK(r.checksum() == crc32c(data.data(), 188));
+
+    r.reset_checksum();
+    ByteView rest;
+    REQUIRE(r.read_view(rest, r.remaining()));
+    CHECK(r.checksum() == crc32c(data.data() + 188, 112));
+}
+
+TEST_CASE("ChecksumWriterT checksums written bytes") {
+    std::vector<uint8_t> buf(256);
+    LECrc32Writer w(buf.data(), buf.size());
+    REQUIRE(w.write_u32(0xDEADBEEFu));
+    const int16_t samples[50] = {1, -2, 3, -4};
+    REQUIRE(w.write_i16_array(samples, 50));
+    REQUIRE(w.ensure(6));
+    w.store_u16_at(0, 0x1234);
+    w.store_f32_at(2, 1.5f);
+    w.advance(6);
+    REQUIRE(w.write_bytes("tail", 4));
+    CHECK(w.position() == 114);
+    CHECK(w.checksum() == crc32(buf.data(), 114));
+
+    // The familiar trailer pattern: checksum everything written so far.
+    const uint32_t crc = w.checksum();
+    REQUIRE(w.write_u32(crc));
+    LECrc32Reader r(buf.data(), w.position());
+    REQUIRE(r.skip(114));
+    const uint32_t computed = r.checksum();
+    uint32_t stored = 0;
+    REQUIRE(r.read_u32(stored));
+    CHECK(stored == computed);
+}
+
+TEST_CASE("ChecksumReaderT::verify_checksum compares a stored trailer") {
+    std::vector<uint8_t> buf(64);
+    LECrc32Writer w(buf.data(), buf.size());
+    REQUIRE(w.write_bytes("payload", 7));
+    REQUIRE(w.write_u32(w.checksum()));
+    const size_t size = w.position();
+
+    LECrc32Reader good(buf.data(), size);
+    REQUIRE(good.skip(7));
+    CHECK(good.verify_checksum());
+    CHECK(good.remaining() == 0);
+
+    buf[2] ^= 0x10;
+    LECrc32Reader bad(buf.data(), size);
+    REQUIRE(bad.skip(7));
+    const Status s = bad.verify_checksum();
+    CHECK(s.code == StatusCode::ChecksumMismatch);
+    CHECK(s.position == 7);
+
+    LECrc32Reader cut(buf.data(), size - 1);
+    REQUIRE(cut.skip(7));
+    CHECK(cut.verify_checksum().code == StatusCode::OutOfRange);
+}
+
+// ============================================================================
+// BitReaderT / BitWriterT
+// ============================================================================
+
+TEST_CASE("MsbBitReader reads fields from the top bit down") {
+    const uint8_t data[] = {0xB4, 0x5F};  // 1011 0100 0101 1111
+    MsbBitReader r(data, sizeof(data));
+    uint8_t a = 0, b = 0, c = 0;
+    bool flag = false;
+    REQUIRE(r.read_bits(3, a));
+    REQUIRE(r.read_bits(1, flag));
+    REQUIRE(r.read_bits(6, b));
+    REQUIRE(r.read_bits(6, c));
+    CHECK(a == 0x5);
+    CHECK(flag);
+    CHECK(b == 0x11);
+    CHECK(c == 0x1F);
+    CHECK(r.remaining_bits() == 0);
+    CHECK_FALSE(r.read_bits(1, a));
+}
+
+TEST_CASE("LsbBitReader reads fields from the bottom bit up") {
+    const uint8_t data[] = {0xB4, 0x5F};
+    LsbBitReader r(data, sizeof(data));
+    uint8_t a = 0, b = 0;
+    uint16_t c = 0;
+    REQUIRE(r.read_bits(3, a));
+    REQUIRE(r.read_bits(4, b));
+    REQUIRE(r.read_bits(9, c));
+    CHECK(a == 0x4);
+    CHECK(b == 0x6);
+    CHECK(c == 0xBF);
+    CHECK(r.position_bits() == 16);
+}
+
+TEST_CASE("BitReaderT sign-extends signed fields") {
+    const uint8_t data[] = {0xE0, 0x00};  // 111 0000000000000
+    MsbBitReader r(data, sizeof(data));
+    int8_t v = 0;
+    REQUIRE(r.read_bits(3, v));
+    CHECK(v == -1);
+    int16_t w = 0;
+    REQUIRE(r.read_bits(13, w));
+    CHECK(w == 0);
+}
+
+TEST_CASE("BitWriterT matches BitReaderT for every width and order") {
+    std::vector<uint8_t> buf(2048);
+    const auto pattern = [](unsigned i) {
+        uint64_t x = 0x9E3779B97F4A7C15ull * (i + 1);
+        return x ^ (x >> 29);
+    };
+    const auto mask = [](unsigned w) { return ~uint64_t{0} >> (64 - w); };
+
+    MsbBitWriter mw(buf.data(), buf.size() / 2);
+    LsbBitWriter lw(buf.data() + buf.size() / 2, buf.size() / 2);
+    size_t total = 0;
+    for (unsigned w = 1; w <= 64; ++w) {
+        REQUIRE(mw.write_bits(w, pattern(w)));
+        REQUIRE(lw.write_bits(w, pattern(w)));
+        total += w;
+    }
+    CHECK(mw.position_bits() == total);
+    mw.flush();
+    lw.flush();
+    CHECK(mw.position_bytes() == (total + 7) / 8);
+
+    MsbBitReader mr(buf.data(), mw.position_bytes());
+    LsbBitReader lr(buf.data() + buf.size() / 2, lw.position_bytes());
+    for (unsigned w = 1; w <= 64; ++w) {
+        uint64_t mv = 0, lv = 0;
+        REQUIRE(mr.read_bits(w, mv));
+        REQUIRE(lr.read_bits(w, lv));
+        CHECK(mv == (pattern(w) & mask(w)));
+        CHECK(lv == (pattern(w) & mask(w)));
+    }
+    CHECK(mr.remaining_bits() < 8);
+}
+
+TEST_CASE("BitWriterT byte layout and bounds") {
+    uint8_t buf[2] = {0xAA, 0xAA};
+    MsbBitWriter w(buf, sizeof(buf));
+    REQUIRE(w.write_bits(3, 0x5u));
+    REQUIRE(w.write_bits(1, true));
+    REQUIRE(w.write_bits(6, 0x11u));
+    CHECK(w.remaining_bits() == 6);
+    CHECK_FALSE(w.write_bits(7, 0u));
+    w.flush();
+    CHECK(buf[0] == 0xB4);
+    CHECK(buf[1] == 0x40);
+    CHECK(w.remaining_bits() == 0);
+
+    uint8_t lbuf[1] = {};
+    LsbBitWriter l(lbuf, sizeof(lbuf));
+    REQUIRE(l.write_bits(3, 0x4u));
+    REQUIRE(l.write_bits(5, 0x16u));
+    l.flush();
+    CHECK(lbuf[0] == 0xB4);
+}
+
+TEST_CASE("BitWriterT 64-bit fields use the stream's byte order") {
+    uint8_t buf[8] = {};
+    LsbBitWriter l(buf, sizeof(buf));
+    REQUIRE(l.write_bits(64, 0x0123456789ABCDEFull));
+    l.flush();
+    CHECK(LEReader(buf, 8).load_u64_at(0) == 0x0123456789ABCDEFull);
+
+    MsbBitWriter m(buf, sizeof(buf));
+    REQUIRE(m.write_bits(60, 0x0123456789ABCDEull));
+    REQUIRE(m.write_bits(4, 0xFu));
+    m.flush();
+    CHECK(BEReader(buf, 8).load_u64_at(0) == 0x0123456789ABCDEFull);
+
+    LsbBitReader lr(buf, sizeof(buf));
+    uint64_t v = 0;
+    REQUIRE(lr.read_bits(64, v));
+    CHECK(v == LEReader(buf, 8).load_u64_at(0));
+}
+
+TEST_CASE("BitReaderT skip, align and unchecked takes") {
+    std::vector<uint8_t> data(40);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<uint8_t>(i);
+    MsbBitReader r(data.data(), data.size());
+    uint8_t v = 0;
+    REQUIRE(r.read_bits(4, v));
+    r.align();
+    CHECK(r.position_bits() == 8);
+    REQUIRE(r.skip_bits(8 * 20 + 4));  // past the accumulator
+    REQUIRE(r.read_bits(4, v));
+    CHECK(v == 21 % 16);
+    REQUIRE(r.ensure_bits(16));
+    CHECK(r.take_bits(8) == 22);
+    CHECK(r.take_bits(8) == 23);
+    CHECK_FALSE(r.skip_bits(r.remaining_bits() + 1));
+    CHECK(r.position_bytes() == 24);
+    REQUIRE(r.skip_bits(r.remaining_bits()));
+    CHECK(r.remaining_bits() == 0);
+}
+
+#if defined(__cpp_lib_bit_cast) && defined(__cpp_lib_is_constant_evaluated)
+template <typename Order>
+constexpr bool bit_fields_roundtrip() {
+    std::array<uint8_t, 16> buf{};
+    BitWriterT<Order> w(buf.data(), buf.size());
+    if (!w.write_bits(3, 5u) || !w.write_bits(1, true) ||
+        !w.write_bits(12, 0xABCu) || !w.write_bits(60, 0x0FEDCBA987654321ull))
+        return false;
+    w.flush();
+    BitReaderT<Order> r(buf.data(), w.position_bytes());
+    uint8_t a = 0;
+    bool b = false;
+    int16_t c = 0;
+    uint64_t d = 0;
+    return r.read_bits(3, a) && a == 5 && r.read_bits(1, b) && b &&
+           r.read_bits(12, c) && c == -0x544 && r.read_bits(60, d) &&
+           d == 0x0FEDCBA987654321ull && r.remaining_bits() == 4 &&
+           !r.read_bits(5, a);
+}
+
+static_assert(bit_fields_roundtrip<MsbFirst>());
+static_assert(bit_fields_roundtrip<LsbFirst>());
+#endif
+
+// ============================================================================
+// Varints
+// ============================================================================
+
+namespace {
+
+/// Values at every encoded length boundary, plus the extremes.
+std::vector<uint64_t> varint_samples() {
+    std::vector<uint64_t> v = {0, 1, 0x7F, 0x80, 300,
+                               std::numeric_limits<uint64_t>::max()};
+    for (unsigned bits = 7; bits < 64; bits += 7) {
+        v.push_back((uint64_t{1} << bits) - 1);
+        v.push_back(uint64_t{1} << bits);
+    }
+    v.push_back(uint64_t{1} << 63);
+    return v;
+}
+
+}  // namespace
+
+TEST_CASE("write_varuint uses LEB128") {
+    uint8_t buf[16] = {};
+    LEWriter w(buf, sizeof(buf));
+    REQUIRE(w.write_varuint(1));
+    REQUIRE(w.write_varuint(300));
+    CHECK(w.position() == 3);
+    CHECK(buf[0] == 0x01);
+    CHECK(buf[1] == 0xAC);
+    CHECK(buf[2] == 0x02);
+
+    BEWriter b(buf, sizeof(buf));
+    REQUIRE(b.write_varuint(std::numeric_limits<uint64_t>::max()));
+    CHECK(b.position() == 10);
+    CHECK(buf[8] == 0xFF);
+    CHECK(buf[9] == 0x01);
+}
+
+TEST_CASE("read_varuint round-trips every length on both decode paths") {
+    for (uint64_t value : varint_samples()) {
+        uint8_t buf[20] = {};
+        LEWriter w(buf, sizeof(buf));
+        REQUIRE(w.write_varuint(value));
+        const size_t len = w.position();
+        LESizeCounter counter;
+        REQUIRE(counter.write_varuint(value));
+        CHECK(counter.size() == len);
+
+        // Padded buffer: word-at-a-time path. Exact buffer: byte path for
+        // short encodings near the end.
+        for (size_t size : {sizeof(buf), len}) {
+            LEReader r(buf, size);
+            uint64_t out = 0;
+            REQUIRE(r.read_varuint(out));
+            CHECK(out == value);
+            CHECK(r.position() == len);
+        }
+        LEReader truncated(buf, len - 1);
+        uint64_t out = 0;
+        CHECK_FALSE(truncated.read_varuint(out));
+        CHECK(truncated.position() == 0);
+    }
+}
+
+TEST_CASE("read_varint zigzag-decodes signed values") {
+    const int64_t values[] = {0, -1, 1, -64, 64, -65,
+                              std::numeric_limits<int64_t>::min(),
+                              std::numeric_limits<int64_t>::max()};
+    uint8_t buf[128] = {};
+    LEWriter w(buf, sizeof(buf));
+    for (int64_t v : values) REQUIRE(w.write_varint(v));
+    CHECK(buf[0] == 0x00);
+    CHECK(buf[1] == 0x01);  // -1
+    CHECK(buf[2] == 0x02);  // 1
+    CHECK(buf[3] == 0x7F);  // -64
+    REQUIRE(buf[4] == 0x80);  // 64 needs two bytes
+
+    LEReader r(buf, w.position());
+    for (int64_t v : values) {
+        int64_t out = 0;
+        REQUIRE(r.read_varint(out));
+        CHECK(out == v);
+    }
+    CHECK(r.remaining() == 0);
+}
+
+TEST_CASE("read_varuint rejects encodings longer than 64 bits") {
+    uint8_t eleven[16];
+    std::memset(eleven, 0x80, sizeof(eleven));
+    eleven[10] = 0x00;
+    LEReader r(eleven, sizeof(eleven));
+    uint64_t out = 7;
+    CHECK_FALSE(r.read_varuint(out));
+    CHECK(out == 7);
+
+    uint8_t overflow[16] = {};
+    std::memset(overflow, 0xFF, 9);
+    overflow[9] = 0x02;  // bit 64
+    LEReader o(overflow, sizeof(overflow));
+    CHECK_FALSE(o.read_varuint(out));
+}
+
+TEST_CASE("ChunkedReaderT reads varints across segment boundaries") {
+    uint8_t buf[256] = {};
+    LEWriter w(buf, sizeof(buf));
+    const auto samples = varint_samples();
+    for (uint64_t v : samples) REQUIRE(w.write_varuint(v));
+    const size_t total = w.position();
+    for (size_t split = 0; split <= total; ++split) {
+        const ByteSegment segments[] = {{buf, split},
+                                        {buf + split, total - split}};
+        LEChunkedReader r(segments, 2);
+        bool ok = true;
+        for (uint64_t v : samples) {
+            uint64_t out = 0;
+            ok = ok && r.read_varuint(out) && out == v;
+        }
+        CHECK(ok);
+        CHECK(r.remaining() == 0);
+    }
+}
+
+TEST_CASE("StreamReaderT and checksum wrappers read varints") {
+    uint8_t buf[256] = {};
+    LEWriter w(buf, sizeof(buf));
+    const auto samples = varint_samples();
+    for (uint64_t v : samples) REQUIRE(w.write_varuint(v));
+    REQUIRE(w.write_varint(-300));
+
+    MemorySource src{buf, w.position(), 3};
+    uint8_t window[16];
+    LEStreamReader<MemorySource> s(src, window, sizeof(window));
+    LECrc32Reader c(buf, w.position());
+    for (uint64_t v : samples) {
+        uint64_t a = 0;
+        uint64_t b = 0;
+        REQUIRE(s.read_varuint(a));
+        REQUIRE(c.read_varuint(b));
+        CHECK(a == v);
+        CHECK(b == v);
+    }
+    int64_t tail = 0;
+    REQUIRE(s.read_varint(tail));
+    CHECK(tail == -300);
+    CHECK_FALSE(s.read_varint(tail));
+    REQUIRE(c.read_varint(tail));
+    CHECK(c.checksum() == crc32(buf, w.position()));
+}
+
+// ============================================================================
+// Delta and frame-of-reference array coding
+// ============================================================================
+
+namespace {
+
+/// A slowly rising series with a little noise, wrapped to T.
+template <typename T>
+std::vector<T> series(size_t n, int64_t start, int64_t step) {
+    std::vector<T> v(n);
+    uint32_t x = 0x9E3779B9u;
+    int64_t value = start;
+    for (auto& e : v) {
+        x = x * 1664525u + 1013904223u;
+        value += step + static_cast<int64_t>(x >> 29) - 3;
+        e = static_cast<T>(value);
+    }
+    return v;
+}
+
+template <typename T>
+void check_array_round_trip(const std::vector<T>& in) {
+    DynamicLEWriter w;
+    REQUIRE(write_delta_array(w, in.data(), in.size()));
+    const size_t delta_size = w.size();
+    REQUIRE(write_for_array(w, in.data(), in.size()));
+
+    LESizeCounter c;
+    REQUIRE(write_delta_array(c, in.data(), in.size()));
+    REQUIRE(write_for_array(c, in.data(), in.size()));
+    CHECK(c.position() == w.size());
+
+    LEReader r(w.data(), w.size());
+    std::vector<T> delta(in.size());
+    std::vector<T> ref(in.size());
+    REQUIRE(read_delta_array(r, delta.data(), delta.size()));
+    CHECK(r.position() == delta_size);
+    REQUIRE(read_for_array(r, ref.data(), ref.size()));
+    CHECK(r.remaining() == 0);
+    CHECK(delta == in);
+    CHECK(ref == in);
+}
+
+}  // namespace
+
+TEST_CASE("Array coding round-trips every element type and block boundary") {
+    for (size_t n : {0, 1, 2, 63, 64, 65, 129, 200}) {
+        check_array_round_trip(series<uint8_t>(n, 0, 1));
+        check_array_round_trip(series<uint16_t>(n, 60000, 7));
+        check_array_round_trip(series<uint32_t>(n, 1700000000, 1000));
+        check_array_round_trip(series<uint64_t>(n, -5, 1 << 20));
+        check_array_round_trip(series<int16_t>(n, 20, -2));
+        check_array_round_trip(series<int32_t>(n, -100000, 3));
+        check_array_round_trip(series<int64_t>(n, 0, -77));
+    }
+}
+
+TEST_CASE("Array coding handles extreme and wrapping values") {
+    check_array_round_trip(std::vector<int64_t>{
+        std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max(),
+        0, -1, std::numeric_limits<int64_t>::min()});
+    check_array_round_trip(std::vector<uint32_t>{0xFFFFFFFFu, 0, 0xFFFFFFFFu});
+    check_array_round_trip(std::vector<int8_t>{-128, 127, -128, 0});
+
+    std::vector<uint64_t> wide(130);
+    uint64_t x = 1;
+    for (auto& v : wide) {
+        x = x * 6364136223846793005u + 1442695040888963407u;
+        v = x;
+    }
+    check_array_round_trip(wide);
+}
+
+TEST_CASE("Array coding packs at the narrowest common width") {
+    // Timestamps one tick apart: a zero-width delta run after the header.
+    std::vector<uint32_t> ticks(100);
+    for (size_t i = 0; i < ticks.size(); ++i) {
+        ticks[i] = 5000 + static_cast<uint32_t>(i);
+    }
+    uint8_t buf[512];
+    LEWriter w(buf, sizeof(buf));
+    REQUIRE(write_delta_array(w, ticks.data(), ticks.size()));
+    // Deltas of +1 zigzag to 2, which needs two bits.
+    CHECK(w.position() == 4 + 1 + (99 * 2 + 7) / 8);
+    CHECK(buf[4] == 2);
+
+    const std::vector<int16_t> flat(70, -3);
+    LEWriter f(buf, sizeof(buf));
+    REQUIRE(write_for_array(f, flat.data(), flat.size()));
+    REQUIRE(write_delta_array(f, flat.data(), flat.size()));
+    CHECK(f.position() == 2 * (2 + 1));
+
+    const std::vector<uint16_t> range = {1000, 1015, 1003, 1008};
+    LEWriter g(buf, sizeof(buf));
+    REQUIRE(write_for_array(g, range.data(), range.size()));
+    REQUIRE(g.position() == 2 + 1 + 2);
+    CHECK(buf[0] == 0xE8);
+    CHECK(buf[1] == 0x03);
+    CHECK(buf[2] == 4);
+    // Offsets 0, 15, 3, 8 packed four bits each, low bits first.
+    CHECK(buf[3] == 0xF0);
+    CHECK(buf[4] == 0x83);
+}
+
+TEST_CASE("Array decoding rejects truncated input and bad widths") {
+    const auto in = series<uint32_t>(80, 0, 100000);
+    uint8_t buf[512];
+    LEWriter w(buf, sizeof(buf));
+    REQUIRE(write_delta_array(w, in.data(), in.size()));
+    std::vector<uint32_t> out(in.size());
+    for (size_t len = 0; len < w.position(); ++len) {
+        LEReader r(buf, len);
+        CHECK_FALSE(read_delta_array(r, out.data(), out.size()));
+    }
+
+    LEWriter small(buf, 6);
+    CHECK_FALSE(write_for_array(small, in.data(), in.size()));
+
+    const uint8_t bad[] = {0x00, 0x00, 0x00, 0x00, 33, 0xFF, 0xFF};
+    LEReader r(bad, sizeof(bad));
+    CHECK_FALSE(read_for_array(r, out.data(), 2));
+}
+
+TEST_CASE("Array coding reads across chunked segments") {
+    const auto in = series<int32_t>(150, -40, 9);
+    DynamicBEWriter w;
+    REQUIRE(write_delta_array(w, in.data(), in.size()));
+    REQUIRE(write_for_array(w, in.data(), in.size()));
+    const size_t total = w.size();
+    for (size_t split = 0; split <= total; split += 7) {
+        const ByteSegment segments[] = {{w.data(), split},
+                                        {w.data() + split, total - split}};
+        BEChunkedReader r(segments, 2);
+        std::vector<int32_t> a(in.size());
+        std::vector<int32_t> b(in.size());
+        REQUIRE(read_delta_array(r, a.data(), a.size()));
+        REQUIRE(read_for_array(r, b.data(), b.size()));
+        CHECK(a == in);
+        CHECK(b == in);
+        CHECK(r.remaining() == 0);
+    }
+}
+
+#if defined(__cpp_lib_bit_cast) && defined(__cpp_lib_is_constant_evaluated)
+template <typename Codec>
+constexpr bool coded_arrays_roundtrip() {
+    std::array<int32_t, 100> in{};
+    for (size_t i = 0; i < in.size(); ++i) {
+        in[i] = static_cast<int32_t>(i * i) - 3000;
+    }
+    std::array<uint8_t, 512> buf{};
+    ByteWriterT<Codec> w(buf.data(), buf.size());
+    if (!write_delta_array(w, in.data(), in.size()) ||
+        !write_for_array(w, in.data(), in.size()))
+        return false;
+    std::array<int32_t, 100> delta{};
+    std::array<int32_t, 100> offsets{};
+    ByteReaderT<Codec> r(buf.data(), w.position());
+    return read_delta_array(r, delta.data(), delta.size()) &&
+           read_for_array(r, offsets.data(), offsets.size()) &&
+           r.remaining() == 0 && delta == in && offsets == in &&
+           w.position() < sizeof(int32_t) * in.size();
+}
+
+static_assert(coded_arrays_roundtrip<LittleEndianCodec>());
+static_assert(coded_arrays_roundtrip<BigEndianCodec>());
+#endif
+
+// ============================================================================
+// Frame pipeline
+// ============================================================================
+
+namespace {
+
+// magic u32, seq u16, payload length u16, then the payload.
+constexpr FrameFormat kTestFrames{0xC0FFEE11u, 0, 8, 6, 2};
+
+void append_frame(DynamicLEWriter& w, uint16_t seq, size_t payload) {
+    REQUIRE(w.write_u32(kTestFrames.magic));
+    REQUIRE(w.write_u16(seq));
+    REQUIRE(w.write_u16(static_cast<uint16_t>(payload)));
+    for (size_t i = 0; i < payload; ++i) {
+        REQUIRE(w.write_u8(static_cast<uint8_t>(seq + i)));
+    }
+}
+
+struct TestRecord {
+    uint16_t seq = 0;
+    uint32_t sum = 0;
+};
+
+Status decode_record(LEReader& r, TestRecord& out) {
+    uint32_t magic = 0;
+    uint16_t length = 0;
+    Status s = r.read_u32(magic);
+    if (!s) return s;
+    s = r.read_u16(out.seq);
+    if (!s) return s;
+    s = r.read_u16(length);
+    if (!s) return s;
+    if (out.seq == 0xFFFF) return Status::BadMagic(r.position()).in_field(7);
+    for (uint16_t i = 0; i < length; ++i) {
+        uint8_t b = 0;
+        s = r.read_u8(b);
+        if (!s) return s;
+        out.sum += b;
+    }
+    return Status::Ok();
+}
+
+}  // namespace
+
+TEST_CASE("split_frames finds back-to-back frames") {
+    DynamicLEWriter w;
+    for (uint16_t seq = 0; seq < 5; ++seq) append_frame(w, seq, seq * 3u);
+    REQUIRE(w.write_u16(0xAAAA));  // cut-off header
+
+    const auto split = split_frames<LittleEndianCodec>(
+        ByteView(w.data(), w.size()), kTestFrames);
+    REQUIRE(split.frames.size() == 5);
+    size_t offset = 0;
+    for (size_t i = 0; i < 5; ++i) {
+        CHECK(split.frames[i].offset == offset);
+        CHECK(split.frames[i].size == 8 + i * 3);
+        offset += split.frames[i].size;
+    }
+    CHECK(split.resyncs == 0);
+    CHECK(split.skipped == 0);
+    CHECK(split.trailing == 2);
+}
+
+TEST_CASE("split_frames resynchronizes on the magic after corruption") {
+    DynamicLEWriter w;
+    append_frame(w, 1, 4);
+    REQUIRE(w.write_u8(0x11));  // stray byte that starts like the magic
+    REQUIRE(w.write_u8(0x00));
+    append_frame(w, 2, 4);
+    // A good magic with a length past the end of the buffer.
+    REQUIRE(w.write_u32(kTestFrames.magic));
+    REQUIRE(w.write_u32(0xFFFF0000u));
+    append_frame(w, 3, 1);
+    append_frame(w, 4, 9);
+    std::vector<uint8_t> buf(w.data(), w.data() + w.size());
+    buf.resize(buf.size() - 3);  // the last payload is cut short
+
+    const auto split = split_frames<LittleEndianCodec>(
+        ByteView(buf.data(), buf.size()), kTestFrames);
+    REQUIRE(split.frames.size() == 3);
+    CHECK(split.frames[0].offset == 0);
+    CHECK(split.frames[1].offset == 14);
+    CHECK(split.frames[2].offset == 34);
+    CHECK(split.resyncs == 2);
+    CHECK(split.skipped == 2 + 8);
+    CHECK(split.trailing == 8 + 9 - 3);
+
+    FrameFormat capped = kTestFrames;
+    capped.max_payload = 3;
+    const auto small = split_frames<LittleEndianCodec>(
+        ByteView(buf.data(), buf.size()), capped);
+    REQUIRE(small.frames.size() == 1);
+    CHECK(small.frames[0].offset == 34);
+}
+
+TEST_CASE("split_frames gives the same frames on every thread count") {
+    // Several MiB of frames with garbage between some of them and the magic
+    // planted inside payloads, so slice walks start out of step.
+    DynamicLEWriter w;
+    uint32_t x = 0x2545F491u;
+    uint16_t seq = 0;
+    while (w.size() < 6u << 20) {
+        x = x * 1664525u + 1013904223u;
+        const size_t payload = (x >> 8) % 300;
+        if ((x & 0xF) == 0) {
+            for (size_t i = 0; i < (x >> 4) % 40; ++i) {
+                REQUIRE(w.write_u8(static_cast<uint8_t>(x >> (i % 24))));
+            }
+        }
+        REQUIRE(w.write_u32(kTestFrames.magic));
+        REQUIRE(w.write_u16(seq++));
+        REQUIRE(w.write_u16(static_cast<uint16_t>(payload)));
+        std::vector<uint8_t> bytes(payload);
+        for (size_t i = 0; i < payload; ++i) {
+            bytes[i] = static_cast<uint8_t>(i * 7);
+        }
+        if (payload >= 12 && (x & 0x30) == 0) {
+            LittleEndianCodec::StoreU32(&bytes[payload - 12],
+                                        kTestFrames.magic);
+        }
+        REQUIRE(w.write_bytes(bytes.data(), bytes.size()));
+    }
+    const ByteView data(w.data(), w.size());
+    const auto serial = split_frames<LittleEndianCodec>(data, kTestFrames);
+    REQUIRE(serial.resyncs > 0);
+
+    FrameSplit split;
+    for (size_t threads : {2, 3, 5, 6}) {
+        split_frames<LittleEndianCodec>(data, kTestFrames, split, threads);
+        REQUIRE(split.frames.size() == serial.frames.size());
+        bool same = true;
+        for (size_t i = 0; i < split.frames.size(); ++i) {
+            same = same && split.frames[i].offset == serial.frames[i].offset &&
+                   split.frames[i].size == serial.frames[i].size;
+        }
+        CHECK(same);
+        CHECK(split.skipped == serial.skipped);
+        CHECK(split.resyncs == serial.resyncs);
+        CHECK(split.trailing == serial.trailing);
+    }
+}
+
+TEST_CASE("split_frames reads big-endian headers") {
+    DynamicBEWriter w;
+    REQUIRE(w.write_u8(0));
+    REQUIRE(w.write_u32(0xFEEDFACEu));
+    REQUIRE(w.write_u8(2));  // payload length
+    REQUIRE(w.write_u16(0xBEEF));
+    const FrameFormat format{0xFEEDFACEu, 1, 6, 5, 1};
+    const auto split =
+        split_frames<BigEndianCodec>(ByteView(w.data(), w.size()), format);
+    REQUIRE(split.frames.size() == 1);
+    CHECK(split.frames[0].size == 8);
+    CHECK(split.trailing == 0);
+}
+
+TEST_CASE("decode_frames returns results in capture order") {
+    DynamicLEWriter w;
+    constexpr uint16_t kFrames = 3000;
+    for (uint16_t seq = 0; seq < kFrames; ++seq) append_frame(w, seq, seq % 17);
+    const ByteView data(w.data(), w.size());
+    const auto split = split_frames<LittleEndianCodec>(data, kTestFrames);
+    REQUIRE(split.frames.size() == kFrames);
+
+    for (size_t threads : {1, 3, 8}) {
+        std::vector<TestRecord> records;
+        REQUIRE(decode_frames<LEReader>(data, split.frames, records,
+                                        decode_record, threads));
+        REQUIRE(records.size() == kFrames);
+        bool in_order = true;
+        for (uint16_t seq = 0; seq < kFrames; ++seq) {
+            uint32_t sum = 0;
+            for (size_t i = 0; i < seq % 17u; ++i) {
+                sum += static_cast<uint8_t>(seq + i);
+            }
+            in_order = in_order && records[seq].seq == seq &&
+                       records[seq].sum == sum;
+        }
+        CHECK(in_order);
+    }
+
+    std::vector<TestRecord> none;
+    CHECK(decode_frames<LEReader>(data, {}, none, decode_record));
+    CHECK(none.empty());
+}
+
+TEST_CASE("decode_frames reports the first failing frame") {
+    DynamicLEWriter w;
+    for (uint16_t seq = 0; seq < 2000; ++seq) {
+        const bool bad = seq == 700 || seq == 1500;
+        append_frame(w, bad ? 0xFFFF : seq, 5);
+    }
+    const ByteView data(w.data(), w.size());
+    const auto split = split_frames<LittleEndianCodec>(data, kTestFrames);
+    for (size_t threads : {1, 4}) {
+        std::vector<TestRecord> records;
+        const Status s = decode_frames<LEReader>(data, split.frames, records,
+                                                 decode_record, threads);
+        CHECK_FALSE(s);
+        CHECK(s.code == StatusCode::BadMagic);
+        CHECK(s.position == split.frames[700].offset + 8);
+        CHECK(s.field == 7);
+        CHECK(records[699].seq == 699);
+    }
+}
+
+// ============================================================================
+// Frame batches
+// ============================================================================
+
+namespace {
+
+// The kTestFrames header as a serializable struct.
+struct TestFrameHeader {
+    uint16_t seq = 0;
+
+    template <typename Writer>
+    Status serialize(Writer& w) const {
+        Status s = w.write_u32(kTestFrames.magic);
+        if (!s) return s;
+        s = w.write_u16(seq);
+        if (!s) return s;
+        return w.write_u16(0);  // length, backpatched by the batch
+    }
+};
+
+struct TestFramePayload {
+    uint16_t seq = 0;
+    size_t size = 0;
+
+    template <typename Writer>
+    Status serialize(Writer& w) const {
+        for (size_t i = 0; i < size; ++i) {
+            const Status s = w.write_u8(static_cast<uint8_t>(seq + i));
+            if (!s) return s;
+        }
+        return Status::Ok();
+    }
+};
+
+// Big-endian header: sync u16, command u16, payload size u16.
+struct TestCommandHeader {
+    uint16_t command = 0;
+
+    template <typename Writer>
+    Status serialize(Writer& w) const {
+        Status s = w.write_u16(0xAA55);
+        if (!s) return s;
+        s = w.write_u16(command);
+        if (!s) return s;
+        return w.write_u16(0);
+    }
+};
+
+constexpr FrameFormat kTestCommands{0, 0, 6, 4, 2};
+
+}  // namespace
+
+TEST_CASE("FrameBatchWriterT output splits and decodes like a capture") {
+    FrameBatchWriterT<LittleEndianCodec> batch(kTestFrames, 4096);
+    for (uint16_t seq = 0; seq < 20; ++seq) {
+        REQUIRE(batch.append(TestFrameHeader{seq},
+                             TestFramePayload{seq, seq * 5u}));
+    }
+    CHECK(batch.frame_count() == 20);
+
+    const auto split = split_frames<LittleEndianCodec>(batch.view(),
+                                                       kTestFrames);
+    REQUIRE(split.frames.size() == 20);
+    CHECK(split.skipped == 0);
+    CHECK(split.trailing == 0);
+    std::vector<TestRecord> records;
+    REQUIRE(decode_frames<LEReader>(batch.view(), split.frames, records,
+                                    decode_record));
+    for (uint16_t seq = 0; seq < 20; ++seq) {
+        const ByteSegment& frame = batch.frames()[seq];
+        CHECK(frame.data == batch.view().data() + split.frames[seq].offset);
+        CHECK(frame.size == split.frames[seq].size);
+        uint32_t sum = 0;
+        for (size_t i = 0; i < seq * 5u; ++i) sum += uint8_t(seq + i);
+        CHECK(records[seq].seq == seq);
+        CHECK(records[seq].sum == sum);
+    }
+}
+
+TEST_CASE("FrameBatchWriterT end_frame() without a header writes the magic") {
+    FrameBatchWriterT<LittleEndianCodec> batch(kTestFrames, 64);
+    REQUIRE(batch.begin_frame());
+    REQUIRE(batch.writer().write_u16(0xBEEF));
+    REQUIRE(batch.writer().patch_u16(4, 9));  // seq, inside the header
+    REQUIRE(batch.end_frame());
+    LEReader r(batch.view().data(), batch.view().size());
+    TestRecord record;
+    REQUIRE(decode_record(r, record));
+    CHECK(record.seq == 9);
+    CHECK(record.sum == 0xBE + 0xEF);
+    CHECK(r.remaining() == 0);
+}
+
+TEST_CASE("FrameBatchWriterT appends a checksum trailer per frame") {
+    FrameBatchWriterT<BigEndianCodec, Crc32> batch(kTestCommands, 256);
+    REQUIRE(batch.append(TestCommandHeader{2},
+                         TestFramePayload{0x10, 7}));
+    REQUIRE(batch.append(TestCommandHeader{1}, TestFramePayload{}));
+    REQUIRE(batch.frame_count() == 2);
+    CHECK(batch.frames()[0].size == 6 + 7 + 4);
+    CHECK(batch.frames()[1].size == 6 + 0 + 4);
+    CHECK(batch.size() == 27);
+
+    const ByteSegment& frame = batch.frames()[0];
+    const auto* bytes = static_cast<const uint8_t*>(frame.data);
+    CHECK(BigEndianCodec::LoadU16(bytes) == 0xAA55);
+    CHECK(BigEndianCodec::LoadU16(bytes + 2) == 2);
+    CHECK(BigEndianCodec::LoadU16(bytes + 4) == 7);
+    ChecksumReaderT<BigEndianCodec> r(frame.data, frame.size);
+    REQUIRE(r.skip(6 + 7));
+    CHECK(r.verify_checksum());
+    CHECK(r.remaining() == 0);
+}
+
+TEST_CASE("FrameBatchWriterT discards frames that do not fit") {
+    FrameBatchWriterT<BigEndianCodec, Crc32> batch(kTestCommands, 40);
+    REQUIRE(batch.append(TestCommandHeader{1}, TestFramePayload{0, 10}));
+    CHECK(batch.size() == 20);
+
+    // The payload fits, the trailer does not.
+    Status s = batch.append(TestCommandHeader{1}, TestFramePayload{0, 12});
+    CHECK_FALSE(s);
+    CHECK(s.code == StatusCode::OutOfRange);
+    CHECK(batch.frame_count() == 1);
+    CHECK(batch.size() == 20);
+
+    // A smaller frame still fits where the discarded one was.
+    REQUIRE(batch.append(TestCommandHeader{3}, TestFramePayload{0, 10}));
+    CHECK(batch.frame_count() == 2);
+    CHECK(batch.size() == 40);
+
+    batch.clear();
+    CHECK(batch.empty());
+    CHECK(batch.size() == 0);
+    REQUIRE(batch.append(TestCommandHeader{1}, TestFramePayload{0, 30}));
+    CHECK(batch.frames()[0].data == batch.view().data());
+}
+
+TEST_CASE("FrameBatchWriterT rejects payloads longer than the length field") {
+    FrameFormat narrow = kTestFrames;
+    narrow.length_size = 1;
+    narrow.length_offset = 6;
+    FrameBatchWriterT<LittleEndianCodec> batch(narrow, 1024);
+    CHECK_FALSE(batch.append(TestFrameHeader{1}, TestFramePayload{0, 256}));
+    CHECK(batch.empty());
+    CHECK(batch.append(TestFrameHeader{1}, TestFramePayload{0, 255}));
+
+    narrow.max_payload = 16;
+    FrameBatchWriterT<LittleEndianCodec> capped(narrow, 1024);
+    CHECK_FALSE(capped.append(TestFrameHeader{1}, TestFramePayload{0, 17}));
+    CHECK(capped.append(TestFrameHeader{1}, TestFramePayload{0, 16}));
+}
+
+TEST_CASE("FrameBatchWriterT begin_frame() drops an unfinished frame") {
+    FrameBatchWriterT<LittleEndianCodec> batch(kTestFrames, 64);
+    REQUIRE(batch.begin_frame());
+    REQUIRE(batch.writer().write_u32(0xDEADBEEFu));
+    REQUIRE(batch.begin_frame());
+    CHECK(batch.writer().position() == kTestFrames.header_size);
+    batch.abort_frame();
+    CHECK(batch.writer().position() == 0);
+    CHECK(batch.empty());
+}
+
+#if !defined(_WIN32)
+TEST_CASE("FrameBatchWriterT fills one iovec per frame") {
+    FrameBatchWriterT<LittleEndianCodec> batch(kTestFrames, 1024);
+    for (uint16_t seq = 0; seq < 5; ++seq) {
+        REQUIRE(batch.append(TestFrameHeader{seq},
+                             TestFramePayload{seq, seq + 1u}));
+    }
+    iovec iov[3];
+    CHECK(batch.fill_iovecs(iov, 3) == 3);
+    CHECK(iov[0].iov_base == batch.frames()[0].data);
+    CHECK(iov[2].iov_len == 8 + 3);
+    CHECK(batch.fill_iovecs(iov, 3, 3) == 2);
+    CHECK(iov[0].iov_base == batch.frames()[3].data);
+    CHECK(iov[1].iov_len == 8 + 5);
+    CHECK(batch.fill_iovecs(iov, 3, 5) == 0);
+}
+#endif
+
+// ============================================================================
+// Field descriptors
+// ============================================================================
+
+namespace {
+
+enum class Mode : uint8_t { Idle = 1, Run = 2, Stop = 3 };
+
+constexpr Mode decode_mode(uint8_t raw) {
+    return raw >= 1 && raw <= 3 ? static_cast<Mode>(raw) : Mode::Idle;
+}
+
+struct ReflectPoint {
+    int16_t x{};
+    int16_t y{};
+
+    using codec_type = BigEndianCodec;
+    static constexpr size_t kWireSize = 4;
+    static constexpr auto kFields = std::make_tuple(
+        Field<&ReflectPoint::x, WireType::I16, 0>{"x", 7},
+        Field<&ReflectPoint::y, WireType::I16, 2>{"y", 8});
+};
+
+// magic u32 | mode u8 | flags u8 (bit 0 armed, bits 1-3 gain) | pad u16 |
+// temperature f32 | samples u16[3] | tag char[4] | modes u8[2] | points
+struct ReflectFrame {
+    uint32_t magic{};
+    Mode mode{};
+    bool armed{};
+    uint8_t gain{};
+    float temperature{};
+    std::array<uint16_t, 3> samples{};
+    std::array<char, 4> tag{};
+    std::array<Mode, 2> modes{};
+    std::array<ReflectPoint, 2> points{};
+
+    using codec_type = BigEndianCodec;
+    static constexpr size_t kWireSize = 32;
+    static constexpr auto kFields = std::make_tuple(
+        Expected<&ReflectFrame::magic, WireType::U32, 0, 0xC0DE5EEDu>{
+            "magic", 1},
+        Field<&ReflectFrame::mode, WireType::U8, 4, &decode_mode>{"mode", 2},
+        Bits<WireType::U8, 5, Bit<&ReflectFrame::armed, 0, 1>,
+             Bit<&ReflectFrame::gain, 1, 3>>{"flags", 3},
+        Padding<6, 2>{"reserved", 4},
+        Field<&ReflectFrame::temperature, WireType::F32, 8>{"temperature",
+                                                            5},
+        Field<&ReflectFrame::samples, WireType::U16, 12>{"samples", 6},
+        Field<&ReflectFrame::tag, WireType::Bytes, 18>{"tag", 9},
+        Field<&ReflectFrame::modes, WireType::U8, 22, &decode_mode>{"modes",
+                                                                   10},
+        Field<&ReflectFrame::points, WireType::Struct, 24>{"points", 11});
+};
+
+// No kFields: decode()/encode() use the struct's own parse()/serialize().
+struct ReflectVarint {
+    uint64_t value = 0;
+
+    template <typename Reader>
+    Status parse(Reader& r) { return r.read_varuint(value); }
+    template <typename Writer>
+    Status serialize(Writer& w) const { return w.write_varuint(value); }
+};
+
+ReflectFrame sample_reflect_frame() {
+    ReflectFrame f;
+    f.magic = 0xC0DE5EEDu;
+    f.mode = Mode::Run;
+    f.armed = true;
+    f.gain = 5;
+    f.temperature = 21.5f;
+    f.samples = {1, 0x1234, 0xFFFF};
+    f.tag = {'T', 'E', 'S', 'T'};
+    f.modes = {Mode::Stop, Mode::Idle};
+    f.points = {ReflectPoint{-1, 2}, ReflectPoint{300, -400}};
+    return f;
+}
+
+std::vector<uint8_t> hand_encode(const ReflectFrame& f) {
+    std::vector<uint8_t> buf(ReflectFrame::kWireSize, 0);
+    BEWriter w(buf.data(), buf.size());
+    static_cast<void>(w.write_u32(f.magic));
+    static_cast<void>(w.write_u8(static_cast<uint8_t>(f.mode)));
+    static_cast<void>(w.write_u8(
+        static_cast<uint8_t>((f.armed ? 1 : 0) | (f.gain << 1))));
+    static_cast<void>(w.skip(2));
+    static_cast<void>(w.write_f32(f.temperature));
+    static_cast<void>(w.write_u16_array(f.samples.data(), 3));
+    static_cast<void>(w.write_bytes(f.tag.data(), 4));
+    for (Mode m : f.modes) {
+        static_cast<void>(w.write_u8(static_cast<uint8_t>(m)));
+    }
+    for (const ReflectPoint& p : f.points) {
+        static_cast<void>(w.write_i16(p.x));
+        static_cast<void>(w.write_i16(p.y));
+    }
+    return buf;
+}
+
+}  // namespace
+
+static_assert(kHasFields<ReflectFrame> && !kHasFields<ReflectVarint>);
+static_assert(std::tuple_element_t<8, decltype(ReflectFrame::kFields)>::size ==
+              8);
+
+TEST_CASE("encode() stores every described field at its offset") {
+    const ReflectFrame f = sample_reflect_frame();
+    std::vector<uint8_t> buf(ReflectFrame::kWireSize + 2, 0);
+    BEWriter w(buf.data(), buf.size());
+    REQUIRE(encode(w, f));
+    CHECK(w.position() == ReflectFrame::kWireSize);
+    buf.resize(ReflectFrame::kWireSize);
+    CHECK(buf == hand_encode(f));
+
+    BEWriter small(buf.data(), ReflectFrame::kWireSize - 1);
+    CHECK(encode(small, f).code == StatusCode::OutOfRange);
+    CHECK(small.position() == 0);
+
+    BESizeCounter counter;
+    CHECK(encode(counter, f));
+    CHECK(counter.size() == ReflectFrame::kWireSize);
+}
+
+TEST_CASE("decode() reverses encode() and checks expected values") {
+    const std::vector<uint8_t> buf = hand_encode(sample_reflect_frame());
+    BEReader r(buf.data(), buf.size());
+    ReflectFrame f;
+    REQUIRE(decode(r, f));
+    CHECK(r.remaining() == 0);
+    CHECK(f.mode == Mode::Run);
+    CHECK(f.armed);
+    CHECK(f.gain == 5);
+    CHECK(f.temperature == 21.5f);
+    CHECK(f.samples[1] == 0x1234);
+    CHECK(std::string(f.tag.data(), 4) == "TEST");
+    CHECK(f.modes[0] == Mode::Stop);
+    CHECK(f.points[1].x == 300);
+    CHECK(f.points[1].y == -400);
+
+    std::vector<uint8_t> bad = buf;
+    bad[2] ^= 0xFF;
+    BEReader rb(bad.data(), bad.size());
+    Status s = decode(rb, f);
+    CHECK(s.code == StatusCode::BadMagic);
+    CHECK(s.field == 1);
+    CHECK(s.position == 0);
+    CHECK(rb.position() == 0);
+
+    // Unknown enum values map through the decoder
+    bad = buf;
+    bad[4] = 9;
+    BEReader re(bad.data(), bad.size());
+    CHECK(decode(re, f));
+    CHECK(f.mode == Mode::Idle);
+
+    BEReader cut(buf.data(), buf.size() - 1);
+    CHECK(decode(cut, f).code == StatusCode::OutOfRange);
+}
+
+TEST_CASE("decode()/encode() fall back to parse()/serialize()") {
+    DynamicBEWriter w;
+    REQUIRE(encode(w, ReflectVarint{300}));
+    CHECK(w.size() == 2);
+    BEReader r(w.data(), w.size());
+    ReflectVarint v;
+    REQUIRE(decode(r, v));
+    CHECK(v.value == 300);
+}
+
+TEST_CASE("for_each_field visits descriptors in wire order") {
+    std::string names;
+    size_t total = 0;
+    for_each_field<ReflectFrame>([&](const auto& field) {
+        names += field.name;
+        names += ' ';
+        total += field.size;
+        CHECK(field.offset + field.size <= ReflectFrame::kWireSize);
+    });
+    CHECK(names ==
+          "magic mode flags reserved temperature samples tag modes points ");
+    CHECK(total == ReflectFrame::kWireSize);
+}
+
+#if defined(__cpp_lib_bit_cast) && defined(__cpp_lib_is_constant_evaluated)
+
+namespace {
+
+constexpr std::array<uint8_t, ReflectPoint::kWireSize> encode_point() {
+    std::array<uint8_t, ReflectPoint::kWireSize> out{};
+    BEWriter w(out.data(), out.size());
+    if (!encode(w, ReflectPoint{-2, 0x1234})) out[0] = 0;
+    return out;
+}
+
+constexpr bool decode_point_roundtrips() {
+    constexpr auto bytes = encode_point();
+    BEReader r(bytes.data(), bytes.size());
+    ReflectPoint p;
+    return decode(r, p) && p.x == -2 && p.y == 0x1234;
+}
+
+}  // namespace
+
+static_assert(encode_point()[0] == 0xFF && encode_point()[2] == 0x12);
+static_assert(decode_point_roundtrips());
+
+#endif
+
+
+// ============================================================================
+// Instrumentation
+// ============================================================================
+
+namespace {
+
+struct ProbeRecord {
+    std::string site;
+    size_t bytes;
+    bool ok;
+    uint64_t cycles;
+};
+
+std::vector<ProbeRecord>& probe_log() {
+    static std::vector<ProbeRecord> log;
+    return log;
+}
+
+struct LoggingInstrument {
+    static constexpr bool kEnabled = true;
+    static uint64_t Now() { return ++ticks; }
+    static void Record(const char* site, size_t bytes, bool ok,
+                       uint64_t cycles) {
+        probe_log().push_back({site, bytes, ok, cycles});
+    }
+    static inline uint64_t ticks = 0;
+};
+
+using LoggedReader = ByteReaderT<LittleEndianCodec, LoggingInstrument>;
+using LoggedWriter = ByteWriterT<LittleEndianCodec, LoggingInstrument>;
+
+template <typename Reader>
+Status probed_pair(Reader& reader, uint16_t& a, uint32_t& b) {
+    InstrumentProbe<Reader> probe(reader, "pair::parse");
+    Status s = reader.read_u16(a);
+    if (!s) return s;
+    s = reader.read_u32(b);
+    if (!s) return s;
+    probe.succeed();
+    return Status::Ok();
+}
+
+template <typename Writer>
+Status probed_write(Writer& writer, uint32_t v) {
+    InstrumentProbe<Writer> probe(writer, "word::serialize");
+    const Status s = writer.write_u32(v);
+    if (s) probe.succeed();
+    return s;
+}
+
+}  // namespace
+
+static_assert(std::is_same_v<InstrumentOfT<LEReader>, NoInstrument>);
+static_assert(std::is_same_v<InstrumentOfT<LEChunkedReader>, NoInstrument>);
+static_assert(std::is_same_v<InstrumentOfT<LoggedReader>, LoggingInstrument>);
+static_assert(std::is_empty_v<InstrumentProbe<LEReader>>);
+static_assert(sizeof(LoggedReader) == sizeof(LEReader));
+static_assert(sizeof(ByteWriterT<BigEndianCodec, StatsInstrument<>>) ==
+              sizeof(BEWriter));
+
+TEST_CASE("InstrumentProbe reports bytes, outcome and clock to the policy") {
+    probe_log().clear();
+    const uint8_t buf[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    LoggedReader r(buf, sizeof(buf));
+    uint16_t a = 0;
+    uint32_t b = 0;
+    CHECK(probed_pair(r, a, b));
+    CHECK_FALSE(probed_pair(r, a, b));
+    REQUIRE(probe_log().size() == 2);
+    CHECK(probe_log()[0].site == "pair::parse");
+    CHECK(probe_log()[0].bytes == 6);
+    CHECK(probe_log()[0].ok);
+    CHECK(probe_log()[0].cycles == 1);
+    // The failed read of b still counts the u16 it consumed.
+    CHECK(probe_log()[1].bytes == 2);
+    CHECK_FALSE(probe_log()[1].ok);
+
+    uint8_t out[6] = {};
+    LoggedWriter w(out, sizeof(out));
+    CHECK(probed_write(w, 0xDEADBEEFu));
+    CHECK_FALSE(probed_write(w, 1));
+    REQUIRE(probe_log().size() == 4);
+    CHECK(probe_log()[2].site == "word::serialize");
+    CHECK(probe_log()[2].bytes == 4);
+    CHECK(probe_log()[2].ok);
+    CHECK(probe_log()[3].bytes == 0);
+    CHECK_FALSE(probe_log()[3].ok);
+
+    // Plain readers carry NoInstrument, so the same code records nothing.
+    LEReader plain(buf, sizeof(buf));
+    CHECK(probed_pair(plain, a, b));
+    CHECK(probe_log().size() == 4);
+}
+
+TEST_CASE("StatsInstrument aggregates per-thread counters by site") {
+    using Reader = ByteReaderT<BigEndianCodec, StatsInstrument<CycleClock>>;
+    static const char kSite[] = "stats-test::pair::parse";
+    const uint8_t buf[] = {0, 1, 0, 0, 0, 2, 0xFF};
+    auto work = [&](int rounds) {
+        for (int i = 0; i < rounds; ++i) {
+            Reader r(buf, sizeof(buf));
+            InstrumentProbe<Reader> ok(r, kSite);
+            uint16_t a = 0;
+            uint32_t b = 0;
+            if (r.read_u16(a) && r.read_u32(b)) ok.succeed();
+        }
+        Reader cut(buf, 3);
+        InstrumentProbe<Reader> fail(cut, kSite);
+        uint32_t b = 0;
+        if (cut.read_u32(b)) fail.succeed();
+    };
+    auto find = [&] {
+        for (const SiteStats& s : collect_stats()) {
+            if (std::string_view(s.site) == kSite) return s;
+        }
+        return SiteStats{kSite, 0, 0, 0, 0};
+    };
+    const SiteStats before = find();
+    std::thread t1(work, 100);
+    std::thread t2(work, 50);
+    work(10);
+    t1.join();
+    t2.join();
+    const SiteStats after = find();
+    CHECK(after.calls - before.calls == 163);
+    CHECK(after.failures - before.failures == 3);
+    CHECK(after.bytes - before.bytes == 160 * 6);
+
+    size_t tables_with_site = 0;
+    visit_stats([&](const SiteStats& s) {
+        if (s.site == kSite) ++tables_with_site;
+    });
+    CHECK(tables_with_site >= 1);
+    CHECK(tables_with_site <= 3);
+}
+
+TEST_CASE("StatsInstrument counts records that find no free slot") {
+    static char sites[300][2];
+    const uint64_t before = dropped_stats();
+    std::thread([] {
+        for (auto& site : sites) {
+            StatsInstrument<>::Record(site, 1, true, 0);
+        }
+    }).join();
+    CHECK(dropped_stats() - before >= 300 - 256);
+}
+
+// ============================================================================
+// ZIP example: ZipIndex
+// ============================================================================
+
+namespace {
+
+// ZIP64 extra-field bits: which 32-bit central-directory fields to saturate.
+constexpr unsigned kZipUsize = 1;
+constexpr unsigned kZipCsize = 2;
+constexpr unsigned kZipOffset = 4;
+
+struct TestZipFile {
+    std::string name;
+    std::string data;
+    bool descriptor = false;        // CRC and sizes only in a data descriptor
+    unsigned saturate = 0;          // kZip* fields moved to a ZIP64 extra
+    std::vector<uint8_t> foreign{}; // extra blocks before the ZIP64 one
+    size_t local_extra = 0;         // extra bytes in the local header only
+    uint16_t method = 0;            // recorded method; data is stored as-is
+};
+
+struct TestZipOptions {
+    bool zip64 = false;    // EOCD saturated, ZIP64 locator and EOCD64 added
+    std::string comment{}; // archive comment after the EOCD
+};
+
+// Build an archive of uncompressed data; the central directory lists the
+// files in the given order.
+std::vector<uint8_t> make_test_zip(const std::vector<TestZipFile>& files,
+                                   const TestZipOptions& options = {}) {
+    DynamicLEWriter w;
+    std::vector<uint32_t> offsets;
+    for (const TestZipFile& f : files) {
+        const auto size = static_cast<uint32_t>(f.data.size());
+        const uint32_t crc = crc32(f.data.data(), f.data.size());
+        offsets.push_back(static_cast<uint32_t>(w.position()));
+        REQUIRE(w.write_u32(zip::ZipIndex::kLocalHeaderMagic));
+        REQUIRE(w.write_u16(20));
+        REQUIRE(w.write_u16(f.descriptor ? 0x0008 : 0));
+        REQUIRE(w.write_u16(f.method));
+        REQUIRE(w.write_u32(0));  // time and date
+        REQUIRE(w.write_u32(f.descriptor ? 0 : crc));
+        REQUIRE(w.write_u32(f.descriptor ? 0 : size));
+        REQUIRE(w.write_u32(f.descriptor ? 0 : size));
+        REQUIRE(w.write_u16(static_cast<uint16_t>(f.name.size())));
+        REQUIRE(w.write_u16(static_cast<uint16_t>(f.local_extra)));
+        REQUIRE(w.write_bytes(f.name.data(), f.name.size()));
+        for (size_t i = 0; i < f.local_extra; ++i) REQUIRE(w.write_u8(0xEE));
+        REQUIRE(w.write_bytes(f.data.data(), f.data.size()));
+        if (f.descriptor) {
+            REQUIRE(w.write_u32(0x08074b50));
+            REQUIRE(w.write_u32(crc));
+            REQUIRE(w.write_u32(size));
+            REQUIRE(w.write_u32(size));
+        }
+    }
+
+    const size_t dir_offset = w.position();
+    for (size_t i = 0; i < files.size(); ++i) {
+        const TestZipFile& f = files[i];
+        const auto size = static_cast<uint32_t>(f.data.size());
+        const auto field = [&](unsigned bit, uint32_t value) {
+            return (f.saturate & bit) != 0 ? 0xFFFFFFFF : value;
+        };
+        std::vector<uint64_t> zip64;
+        if ((f.saturate & kZipUsize) != 0) zip64.push_back(size);
+        if ((f.saturate & kZipCsize) != 0) zip64.push_back(size);
+        if ((f.saturate & kZipOffset) != 0) zip64.push_back(offsets[i]);
+        const size_t extra =
+            f.foreign.size() + (zip64.empty() ? 0 : 4 + 8 * zip64.size());
+        REQUIRE(w.write_u32(zip::ZipIndex::kCentralHeaderMagic));
+        REQUIRE(w.write_u16(45));
+        REQUIRE(w.write_u16(45));
+        REQUIRE(w.write_u16(f.descriptor ? 0x0008 : 0));
+        REQUIRE(w.write_u16(f.method));
+        REQUIRE(w.write_u32(0));
+        REQUIRE(w.write_u32(crc32(f.data.data(), f.data.size())));
+        REQUIRE(w.write_u32(field(kZipCsize, size)));
+        REQUIRE(w.write_u32(field(kZipUsize, size)));
+        REQUIRE(w.write_u16(static_cast<uint16_t>(f.name.size())));
+        REQUIRE(w.write_u16(static_cast<uint16_t>(extra)));
+        REQUIRE(w.write_u16(0));  // comment
+        REQUIRE(w.write_u16(0));  // disk
+        REQUIRE(w.write_u16(0));  // internal attributes
+        REQUIRE(w.write_u32(0));  // external attributes
+        REQUIRE(w.write_u32(field(kZipOffset, offsets[i])));
+        REQUIRE(w.write_bytes(f.name.data(), f.name.size()));
+        REQUIRE(w.write_bytes(f.foreign.data(), f.foreign.size()));
+        if (!zip64.empty()) {
+            REQUIRE(w.write_u16(0x0001));
+            REQUIRE(w.write_u16(static_cast<uint16_t>(8 * zip64.size())));
+            for (uint64_t v : zip64) REQUIRE(w.write_u64(v));
+        }
+    }
+    const size_t dir_size = w.position() - dir_offset;
+
+    if (options.zip64) {
+        const size_t eocd64 = w.position();
+        REQUIRE(w.write_u32(zip::ZipIndex::kZip64EndOfCentralDirMagic));
+        REQUIRE(w.write_u64(44));
+        REQUIRE(w.write_u16(45));
+        REQUIRE(w.write_u16(45));
+        REQUIRE(w.write_u32(0));
+        REQUIRE(w.write_u32(0));
+        REQUIRE(w.write_u64(files.size()));
+        REQUIRE(w.write_u64(files.size()));
+        REQUIRE(w.write_u64(dir_size));
+        REQUIRE(w.write_u64(dir_offset));
+        REQUIRE(w.write_u32(zip::ZipIndex::kZip64LocatorMagic));
+        REQUIRE(w.write_u32(0));
+        REQUIRE(w.write_u64(eocd64));
+        REQUIRE(w.write_u32(1));
+    }
+    const auto count = static_cast<uint16_t>(files.size());
+    REQUIRE(w.write_u32(zip::ZipIndex::kEndOfCentralDirMagic));
+    REQUIRE(w.write_u16(0));
+    REQUIRE(w.write_u16(0));
+    REQUIRE(w.write_u16(options.zip64 ? 0xFFFF : count));
+    REQUIRE(w.write_u16(options.zip64 ? 0xFFFF : count));
+    REQUIRE(w.write_u32(options.zip64 ? 0xFFFFFFFF
+                                      : static_cast<uint32_t>(dir_size)));
+    REQUIRE(w.write_u32(options.zip64 ? 0xFFFFFFFF
+                                      : static_cast<uint32_t>(dir_offset)));
+    REQUIRE(w.write_u16(static_cast<uint16_t>(options.comment.size())));
+    REQUIRE(w.write_bytes(options.comment.data(), options.comment.size()));
+    return std::vector<uint8_t>(w.data(), w.data() + w.size());
+}
+
+// Overwrite a little-endian field of a built archive.
+template <typename T>
+void poke(std::vector<uint8_t>& zip, size_t pos, T value) {
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        zip[pos + i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+std::string entry_text(const zip::ZipIndex& index, std::string_view name) {
+    const zip::ZipEntry* entry = index.find(name);
+    ByteView data;
+    if (entry == nullptr || !index.data(*entry, data)) return "<missing>";
+    return std::string(data.begin(), data.end());
+}
+
+}  // namespace
+
+TEST_CASE("ZipIndex sorts entries and resolves their data") {
+    const auto zip = make_test_zip({{"b.txt", "bravo"},
+                                    {"dir/c.txt", "charlie!"},
+                                    {"a.txt", ""}});
+    zip::ZipIndex index;
+    REQUIRE(index.build(zip.data(), zip.size()));
+    REQUIRE(index.entries().size() == 3);
+    CHECK(index.entries()[0].name == "a.txt");
+    CHECK(index.entries()[1].name == "b.txt");
+    CHECK(index.entries()[2].name == "dir/c.txt");
+
+    const zip::ZipEntry* c = index.find("dir/c.txt");
+    REQUIRE(c != nullptr);
+    CHECK(c->compressed_size == 8);
+    CHECK(c->uncompressed_size == 8);
+    CHECK(c->crc32 == crc32("charlie!", 8));
+    CHECK(entry_text(index, "b.txt") == "bravo");
+    CHECK(entry_text(index, "dir/c.txt") == "charlie!");
+    CHECK(entry_text(index, "a.txt").empty());
+    CHECK(index.find("c.txt") == nullptr);
+    CHECK(index.find("zzz") == nullptr);
+}
+
+TEST_CASE("ZipIndex finds the EOCD in front of an archive comment") {
+    // The comment holds a decoy EOCD whose comment length does not reach the
+    // end of the archive; the scan must skip it.
+    std::string comment = "note ";
+    comment += std::string("PK\x05\x06", 4) + std::string(18, '\0') + " end";
+    TestZipOptions options;
+    options.comment = comment;
+    const auto zip = make_test_zip({{"x", "data"}}, options);
+    zip::ZipIndex index;
+    REQUIRE(index.build(zip.data(), zip.size()));
+    REQUIRE(index.entries().size() == 1);
+    CHECK(entry_text(index, "x") == "data");
+
+    // The full 64 KiB comment puts the EOCD at the start of the scan window.
+    options.comment = std::string(0xFFFF, 'c');
+    const auto long_comment = make_test_zip({{"x", "data"}}, options);
+    REQUIRE(index.build(long_comment.data(), long_comment.size()));
+    CHECK(entry_text(index, "x") == "data");
+
+    // Bytes after the comment hide the EOCD.
+    auto trailing = zip;
+    trailing.push_back(0);
+    CHECK_FALSE(index.build(trailing.data(), trailing.size()));
+    CHECK(index.entries().empty());
+    CHECK_FALSE(index.build(zip.data(), 21));
+}
+
+TEST_CASE("ZipIndex reads ZIP64 locator, EOCD64 and extra fields") {
+    TestZipOptions options;
+    options.zip64 = true;
+    const auto zip = make_test_zip(
+        {{"big", "0123456789", false, kZipUsize | kZipCsize | kZipOffset},
+         {"small", "abc"}},
+        options);
+    zip::ZipIndex index;
+    REQUIRE(index.build(zip.data(), zip.size()));
+    REQUIRE(index.entries().size() == 2);
+    const zip::ZipEntry* big = index.find("big");
+    REQUIRE(big != nullptr);
+    CHECK(big->compressed_size == 10);
+    CHECK(big->uncompressed_size == 10);
+    CHECK(big->local_header_offset == 0);
+    CHECK(entry_text(index, "big") == "0123456789");
+    CHECK(entry_text(index, "small") == "abc");
+
+    SUBCASE("a locator that names more than one disk is rejected") {
+        auto bad = zip;
+        poke<uint32_t>(bad, bad.size() - 22 - 4, 2);
+        CHECK_FALSE(index.build(bad.data(), bad.size()));
+    }
+    SUBCASE("a locator pointing past the EOCD64 is rejected") {
+        auto bad = zip;
+        poke<uint64_t>(bad, bad.size() - 22 - 12, bad.size());
+        CHECK_FALSE(index.build(bad.data(), bad.size()));
+    }
+    SUBCASE("a bad EOCD64 signature is rejected") {
+        auto bad = zip;
+        poke<uint32_t>(bad, bad.size() - 22 - 20 - 56, 0);
+        CHECK_FALSE(index.build(bad.data(), bad.size()));
+    }
+}
+
+TEST_CASE("ZipIndex applies the ZIP64 extra to saturated fields only") {
+    // Only the offset is saturated, so the extra holds just one u64 and the
+    // 32-bit sizes stay authoritative. A foreign block comes first.
+    const std::vector<uint8_t> foreign = {0x55, 0x54, 3, 0, 1, 2, 3};
+    zip::ZipIndex index;
+    const auto zip = make_test_zip(
+        {{"a", "first"}, {"b", "second", false, kZipOffset, foreign}});
+    REQUIRE(index.build(zip.data(), zip.size()));
+    const zip::ZipEntry* b = index.find("b");
+    REQUIRE(b != nullptr);
+    CHECK(b->compressed_size == 6);
+    CHECK(b->local_header_offset == 30 + 1 + 5);
+    CHECK(entry_text(index, "b") == "second");
+
+    // b's record is the last one: 46 bytes, its name and 7 + 12 extra bytes.
+    const size_t central = zip.size() - 22 - (46 + 1 + 7 + 12);
+    REQUIRE(zip[central] == 0x50);
+    SUBCASE("a ZIP64 extra missing a saturated field is rejected") {
+        // Claim the compressed size too; the extra has no second u64.
+        auto bad = zip;
+        poke<uint32_t>(bad, central + 20, 0xFFFFFFFF);
+        CHECK_FALSE(index.build(bad.data(), bad.size()));
+    }
+    SUBCASE("an extra block running past the extra field is rejected") {
+        auto bad = zip;
+        poke<uint16_t>(bad, central + 46 + 1 + 2, 50);
+        CHECK_FALSE(index.build(bad.data(), bad.size()));
+    }
+}
+
+TEST_CASE("ZipIndex takes sizes of data-descriptor entries from the CD") {
+    const auto zip = make_test_zip(
+        {{"streamed", "written before its size was known", true},
+         {"after", "next"}});
+    zip::ZipIndex index;
+    REQUIRE(index.build(zip.data(), zip.size()));
+    const zip::ZipEntry* e = index.find("streamed");
+    REQUIRE(e != nullptr);
+    CHECK(e->flags == 0x0008);
+    CHECK(e->compressed_size == 33);
+    CHECK(e->crc32 == crc32("written before its size was known", 33));
+    CHECK(entry_text(index, "streamed") == "written before its size was known");
+    CHECK(entry_text(index, "after") == "next");
+}
+
+TEST_CASE("ZipIndex rejects corrupt entry counts") {
+    const auto zip = make_test_zip({{"a", "1"}, {"b", "2"}});
+    const size_t eocd = zip.size() - 22;
+    zip::ZipIndex index;
+
+    // More records than the directory holds, but below the size bound.
+    auto more = zip;
+    poke<uint16_t>(more, eocd + 10, 3);
+    CHECK_FALSE(index.build(more.data(), more.size()));
+    CHECK(index.entries().empty());
+
+    // A count no directory of this size can hold fails before reserving.
+    auto huge = zip;
+    poke<uint16_t>(huge, eocd + 10, 0xFFFE);
+    CHECK_FALSE(index.build(huge.data(), huge.size()));
+
+    TestZipOptions options;
+    options.zip64 = true;
+    auto huge64 = make_test_zip({{"a", "1"}}, options);
+    poke<uint64_t>(huge64, huge64.size() - 22 - 20 - 56 + 32,
+                   uint64_t{1} << 60);
+    CHECK_FALSE(index.build(huge64.data(), huge64.size()));
+}
+
+TEST_CASE("ZipIndex rejects truncated or corrupt central directories") {
+    const auto zip = make_test_zip({{"a", "1"}, {"bb", "22"}});
+    const size_t eocd = zip.size() - 22;
+    const size_t dir = 2 * 30 + 1 + 1 + 2 + 2;
+    zip::ZipIndex index;
+    REQUIRE(index.build(zip.data(), zip.size()));
+
+    SUBCASE("directory size past the end") {
+        auto bad = zip;
+        poke<uint32_t>(bad, eocd + 12, static_cast<uint32_t>(zip.size()));
+        CHECK_FALSE(index.build(bad.data(), bad.size()));
+    }
+    SUBCASE("directory offset past the end") {
+        auto bad = zip;
+        poke<uint32_t>(bad, eocd + 16, static_cast<uint32_t>(zip.size() + 1));
+        CHECK_FALSE(index.build(bad.data(), bad.size()));
+    }
+    SUBCASE("directory shorter than its records") {
+        auto bad = zip;
+        poke<uint32_t>(bad, eocd + 12, 46 + 1 + 46);
+        CHECK_FALSE(index.build(bad.data(), bad.size()));
+    }
+    SUBCASE("name running past the directory") {
+        auto bad = zip;
+        poke<uint16_t>(bad, dir + 46 + 1 + 28, 100);
+        CHECK_FALSE(index.build(bad.data(), bad.size()));
+    }
+    SUBCASE("bad record signature") {
+        auto bad = zip;
+        poke<uint32_t>(bad, dir + 46 + 1, zip::ZipIndex::kLocalHeaderMagic);
+        CHECK_FALSE(index.build(bad.data(), bad.size()));
+    }
+    SUBCASE("multi-disk archive") {
+        auto bad = zip;
+        poke<uint16_t>(bad, eocd + 4, 1);
+        CHECK_FALSE(index.build(bad.data(), bad.size()));
+    }
+    CHECK(index.entries().empty());
+}
+
+TEST_CASE("ZipIndex::data() checks the local header bounds") {
+    TestZipFile padded{"p", "payload"};
+    padded.local_extra = 5;
+    const auto zip = make_test_zip({padded, {"q", "tail"}});
+    zip::ZipIndex index;
+    REQUIRE(index.build(zip.data(), zip.size()));
+    // The local extra field is longer than the central one.
+    CHECK(entry_text(index, "p") == "payload");
+
+    zip::ZipEntry entry = *index.find("q");
+    ByteView data;
+    REQUIRE(index.data(entry, data));
+
+    entry.local_header_offset = zip.size();
+    CHECK_FALSE(index.data(entry, data));  // no room for the header
+    entry.local_header_offset = zip.size() + 1;
+    CHECK_FALSE(index.data(entry, data));
+    entry.local_header_offset = zip.size() - 29;
+    CHECK_FALSE(index.data(entry, data));
+    entry.local_header_offset = 1;
+    CHECK_FALSE(index.data(entry, data));  // bad signature
+
+    entry = *index.find("q");
+    entry.compressed_size = zip.size();
+    CHECK_FALSE(index.data(entry, data));  // data past the end
+
+    auto bad = zip;
+    const size_t q = 30 + 1 + 5 + 7;
+    poke<uint16_t>(bad, q + 28, 0xFFFF);  // local extra past the end
+    REQUIRE(index.build(bad.data(), bad.size()));
+    CHECK_FALSE(index.data(*index.find("q"), data));
+}
+
+// ============================================================================
+// ZIP example: parallel validation
+// ============================================================================
+
+TEST_CASE("ThreadPool::parallel_for calls every index exactly once") {
+    zip::ThreadPool pool(4);
+    REQUIRE(pool.size() == 4);
+    // One pool serves every call, including counts below the worker count.
+    for (size_t count : {size_t{0}, size_t{1}, size_t{3}, size_t{1000},
+                         size_t{17}, size_t{1000}}) {
+        std::vector<std::atomic<int>> hits(count);
+        std::atomic<bool> bad_worker{false};
+        pool.parallel_for(count, [&](size_t i, size_t worker) {
+            hits[i].fetch_add(1, std::memory_order_relaxed);
+            if (worker >= pool.size()) bad_worker = true;
+        });
+        size_t once = 0;
+        for (const auto& h : hits) once += h.load() == 1 ? 1 : 0;
+        CHECK(once == count);
+        CHECK_FALSE(bad_worker.load());
+    }
+
+    zip::ThreadPool single(1);
+    REQUIRE(single.size() == 1);
+    size_t sum = 0;
+    single.parallel_for(100, [&](size_t i, size_t worker) {
+        CHECK(worker == 0);
+        sum += i;
+    });
+    CHECK(sum == 4950);
+}
+
+TEST_CASE("ThreadPool steals from a worker stuck on a slow index") {
+    // Worker 0 owns [0, 100). Whoever runs index 0 blocks there while
+    // holding at most [0, 16), so [16, 100) finishes only through stealing.
+    zip::ThreadPool pool(4);
+    std::vector<size_t> ran_on(400, SIZE_MAX);
+    std::atomic<size_t> rest{0};
+    std::atomic<bool> rest_ran{false};
+    pool.parallel_for(400, [&](size_t i, size_t worker) {
+        ran_on[i] = worker;
+        if (i >= 16 && i < 100) rest.fetch_add(1);
+        if (i != 0) return;
+        const auto deadline =
+            std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (rest.load() != 84 &&
+               std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+        rest_ran = rest.load() == 84;
+    });
+    CHECK(rest_ran.load());
+    size_t moved = 0;
+    for (size_t i = 0; i < 100; ++i) moved += ran_on[i] != 0 ? 1 : 0;
+    CHECK(moved > 0);
+    for (size_t worker : ran_on) CHECK(worker < pool.size());
+}
+
+TEST_CASE("validate() reports entries whose data fails the check") {
+    std::vector<TestZipFile> files;
+    for (int i = 0; i < 40; ++i) {
+        files.push_back({"f" + std::to_string(100 + i),
+                         std::string(size_t(i) * 7, char('a' + i % 26))});
+    }
+    files[5].method = 8;  // deflate: the CRC cannot be checked
+    auto zip = make_test_zip(files);
+    zip::ZipIndex index;
+    REQUIRE(index.build(zip.data(), zip.size()));
+
+    const zip::ZipEntry* crc = index.find("f112");
+    const zip::ZipEntry* header = index.find("f130");
+    REQUIRE(crc != nullptr);
+    REQUIRE(header != nullptr);
+    zip[crc->local_header_offset + 30 + 4 + 3] ^= 0x01;
+    zip[header->local_header_offset] = 0;
+
+    zip::ThreadPool pool(3);
+    for (int round = 0; round < 2; ++round) {
+        const zip::ValidationReport report = zip::validate(index, pool);
+        CHECK(report.ok == 37);
+        CHECK(report.not_verified == 1);
+        CHECK(report.failed == std::vector<size_t>{12, 30});
+    }
+    CHECK(zip::validate_entry(index, *crc) == zip::EntryStatus::BadCrc);
+    CHECK(zip::validate_entry(index, *header) == zip::EntryStatus::BadHeader);
+    CHECK(zip::validate_entry(index, *index.find("f105")) ==
+          zip::EntryStatus::NotVerified);
+    CHECK(zip::validate_entry(index, *index.find("f100")) ==
+          zip::EntryStatus::Ok);
+}